@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <vector>
 #include "ck/host/device_gemm_multiple_d/operation.hpp"
+#include "ck/host/device_grouped_conv_fwd_multiple_abd/operation.hpp"
 #include "ck/host/stringutils.hpp"
 
 using ck::host::Transform;
@@ -46,6 +47,8 @@ int main(int argc, const char* argv[])
     Emitters e;
     e.Register<ck::host::device_gemm_multiple_d::Operation_Xdl_CShuffle>(
         "DeviceGemmMultipleD_Xdl_CShuffle");
+    e.Register<ck::host::device_grouped_conv_fwd_multiple_abd::Operation_Xdl_CShuffle>(
+        "DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle");
 
     if(args.empty() or std::any_of(args.begin(), args.end(), [](auto arg) {
            return arg == "-h" or arg == "--help";
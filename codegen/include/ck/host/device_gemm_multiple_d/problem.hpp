@@ -7,6 +7,7 @@
 #include <vector>
 #include <string>
 #include "ck/host/types.hpp"
+#include "ck/host/operation/cost_model.hpp"
 
 namespace ck {
 namespace host {
@@ -32,6 +33,10 @@ struct Problem
     std::string GetIncludeHeader() const;
 
     std::vector<Solution> GetSolutions(const std::string& arch) const;
+
+    // The top_n valid solutions (all when 0), best first, scored by operation::EstimateGemmCost.
+    std::vector<operation::RankedSolution> GetRankedSolutions(const std::string& arch,
+                                                              std::size_t top_n = 0) const;
 };
 
 } // namespace device_gemm_multiple_d
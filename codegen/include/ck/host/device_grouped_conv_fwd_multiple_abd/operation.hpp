@@ -0,0 +1,48 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include "ck/host/types.hpp"
+#include "ck/host/operation/gemm.hpp"
+#include "ck/host/device_grouped_conv_fwd_multiple_abd/problem.hpp"
+
+namespace ck {
+namespace host {
+namespace device_grouped_conv_fwd_multiple_abd {
+
+struct Operation_Xdl_CShuffle
+{
+    static std::vector<std::vector<Operation_Xdl_CShuffle>> CreateOperations();
+    static std::vector<Operation_Xdl_CShuffle> CreateOperations(const Problem& prob);
+    std::size_t num_dim                = 2;
+    std::string a_layout               = "";
+    std::string b_layout               = "";
+    std::vector<std::string> ds_layout = {};
+    std::string e_layout               = "";
+    DataType a_data_type               = DataType::Half;
+    DataType b_data_type               = DataType::Half;
+    DataType acc                       = DataType::Float;
+    DataType cs_type                   = DataType::Half;
+    std::vector<DataType> ds_data_type = {};
+    DataType e_data_type               = DataType::Half;
+    std::string a_elem_op              = PassThrough;
+    std::string b_elem_op              = PassThrough;
+    std::string cde_elem_op            = PassThrough;
+    ConvFwdSpecialization conv_specialization{};
+    std::string gemm_specialization = "ck::tensor_operation::device::GemmSpecialization::Default";
+    operation::TileDesc tile_desc{};
+    operation::BlockTransferDesc a_block_transfer{};
+    operation::BlockTransferDesc b_block_transfer{};
+    operation::CShuffleDesc cshuffle{};
+    operation::CBlockTransferDesc c_block_transfer{};
+
+    Solution ToSolution() const;
+};
+
+} // namespace device_grouped_conv_fwd_multiple_abd
+} // namespace host
+} // namespace ck
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include "ck/host/types.hpp"
+#include "ck/host/operation/cost_model.hpp"
+
+namespace ck {
+namespace host {
+namespace device_grouped_conv_fwd_multiple_abd {
+
+// Grouped convolution forward, E = cde_op(conv(a_op(A), b_op(B)), Ds...).
+//
+// Layouts are names from ck::tensor_layout::convolution with the channel dimension innermost:
+// C for A and B, K for E and the Ds (e.g. NHWGC, GKYXC, NHWGK, or G_K for a bias). Spatial
+// vectors hold NumDim entries in (D)HW order. Empty strides and dilations mean 1, empty pads
+// mean 0. Sizes left at 0 are unknown, which makes the solutions pad every GEMM dimension and
+// use the widest vector accesses the data types allow.
+struct Problem
+{
+    std::size_t NumDim                            = 2;
+    std::size_t G                                 = 1;
+    std::size_t N                                 = 0;
+    std::size_t C                                 = 0;
+    std::size_t K                                 = 0;
+    std::vector<std::size_t> InputSpatialLengths  = {};
+    std::vector<std::size_t> FilterSpatialLengths = {};
+    std::vector<std::size_t> ConvStrides          = {};
+    std::vector<std::size_t> ConvDilations        = {};
+    std::vector<std::size_t> InLeftPads           = {};
+    std::vector<std::size_t> InRightPads          = {};
+    std::string ALayout                           = "NHWGC";
+    std::string BLayout                           = "GKYXC";
+    std::string ELayout                           = "NHWGK";
+    std::vector<std::string> DsLayout             = {};
+    DataType ADataType                            = DataType::Half;
+    DataType BDataType                            = DataType::Half;
+    DataType EDataType                            = DataType::Half;
+    std::vector<DataType> DsDataType              = {};
+    std::string AElementOp                        = PassThrough;
+    std::string BElementOp                        = PassThrough;
+    std::string CDEElementOp                      = PassThrough;
+
+    std::vector<std::size_t> GetOutputSpatialLengths() const;
+
+    // Implicit GEMM sizes of one group: M = N * output pixels, N = K, K = C * filter taps.
+    // Each is 0 when unknown.
+    std::size_t GetGemmM() const;
+    std::size_t GetGemmN() const;
+    std::size_t GetGemmK() const;
+
+    // The most specialized kernel variant valid for the problem geometry.
+    ConvFwdSpecialization GetConvSpecialization() const;
+
+    std::string GetIncludeHeader() const;
+
+    std::vector<Solution> GetSolutions(const std::string& arch) const;
+
+    // The top_n valid solutions (all when 0), best first, scored by operation::EstimateGemmCost.
+    std::vector<operation::RankedSolution> GetRankedSolutions(const std::string& arch,
+                                                              std::size_t top_n = 0) const;
+};
+
+} // namespace device_grouped_conv_fwd_multiple_abd
+} // namespace host
+} // namespace ck
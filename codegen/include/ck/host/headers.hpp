@@ -12,7 +12,21 @@
 namespace ck {
 namespace host {
 
+// All embedded ck headers, keyed by their path relative to the include root.
 std::unordered_map<std::string_view, std::string_view> GetHeaders();
 
+// The subset of GetHeaders() reachable from roots through #include directives, plus ck/config.h.
+// Pass the Problem's GetIncludeHeader() to get the headers needed to compile its Solutions.
+std::unordered_map<std::string_view, std::string_view>
+GetHeaders(const std::vector<std::string>& roots);
+
+struct IncludeDirective
+{
+    std::string name;
+    bool quoted;
+};
+
+std::vector<IncludeDirective> GetIncludeDirectives(std::string_view content);
+
 } // namespace host
 } // namespace ck
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "ck/host/types.hpp"
+#include "ck/host/operation/gemm.hpp"
+
+namespace ck {
+namespace host {
+namespace operation {
+
+struct HardwareModel
+{
+    std::size_t num_cu             = 1;
+    std::size_t lds_bytes          = 65536; // per CU
+    std::size_t vgprs_per_lane     = 512;   // architected + accumulation registers
+    std::size_t simds_per_cu       = 4;
+    std::size_t wave_size          = 64;
+    std::size_t max_waves_per_simd = 8;
+
+    // fraction of a CU's throughput reached by one resident workgroup
+    double single_wg_throughput = 0.5;
+    // MPerBlock * NPerBlock / (MPerBlock + NPerBlock) above which tiles are compute bound
+    double balanced_intensity = 80;
+
+    // Returns the model of the given xdlops architecture, or a 1 CU model for unknown ones.
+    static HardwareModel FromArch(const std::string& arch);
+};
+
+// A vectorized global access: legal when the contiguous length (0 when unknown) is a multiple of
+// the vector width.
+struct VectorAccess
+{
+    int scalar_per_vector;
+    std::size_t contiguous_length;
+};
+
+struct GemmCost
+{
+    bool valid         = false;
+    std::string reason = ""; // why the tile is rejected
+    // Modelled fraction of the machine doing useful work, in (0, 1]
+    double score = 0;
+
+    double tile_efficiency = 0; // useful / computed MNK, from padding the last tiles
+    std::size_t waves      = 0;
+    double wave_efficiency = 0; // occupied / available workgroup slots over all waves
+    std::size_t occupancy  = 0; // workgroups resident per CU
+    std::size_t lds_bytes  = 0;
+    std::size_t vgprs      = 0; // estimated per lane
+};
+
+// Analytic cost of running a GEMM of batch x (M x N x K) with one tile configuration. Sizes of 0
+// are unknown and treated as a single perfectly quantized tile.
+//
+// The model charges every launched tile its full padded MNK and runs ceil(tiles / slots) waves
+// of num_cu * occupancy workgroups. Tiles below the balanced arithmetic intensity only reach
+// part of a CU's throughput, and so does a CU with too few resident workgroups. Occupancy is
+// bounded by LDS and an estimate of the register budget: the fp32 accumulators plus the
+// registers staging one K slice of A and B. It is meant for ordering solutions, not for
+// predicting absolute times.
+GemmCost EstimateGemmCost(const TileDesc& tile,
+                          std::size_t batch,
+                          std::size_t M,
+                          std::size_t N,
+                          std::size_t K,
+                          DataType ab_data_type,
+                          const std::vector<VectorAccess>& accesses,
+                          const HardwareModel& hw);
+
+struct RankedSolution
+{
+    Solution solution;
+    GemmCost cost;
+};
+
+// Drops invalid candidates, orders the rest by decreasing score (stable, so ties keep the
+// order of the tile table) and keeps the first top_n (all of them when top_n is 0).
+std::vector<RankedSolution> RankSolutions(std::vector<RankedSolution> candidates,
+                                          std::size_t top_n);
+
+} // namespace operation
+} // namespace host
+} // namespace ck
@@ -43,6 +43,8 @@ enum class DataType
 
 std::string ToString(DataType dt);
 
+std::size_t SizeOf(DataType dt);
+
 enum class Layout
 {
     Row,
@@ -58,6 +60,16 @@ enum class GemmType
 
 std::string ToString(GemmType gt);
 
+enum class ConvFwdSpecialization
+{
+    Default,
+    Filter1x1Pad0,
+    Filter1x1Stride1Pad0,
+    OddC
+};
+
+std::string ToString(ConvFwdSpecialization cs);
+
 struct TensorDesc
 {
     DataType element;
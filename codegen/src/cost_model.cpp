@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "ck/host/operation/cost_model.hpp"
+#include "ck/host/utils.hpp"
+#include <algorithm>
+
+namespace ck {
+namespace host {
+namespace operation {
+
+HardwareModel HardwareModel::FromArch(const std::string& arch)
+{
+    HardwareModel hw;
+    if(arch == "gfx908")
+        hw.num_cu = 120;
+    else if(arch == "gfx90a")
+        hw.num_cu = 110;
+    else if(arch == "gfx940")
+        hw.num_cu = 228;
+    else if(arch == "gfx942")
+        hw.num_cu = 304;
+    return hw;
+}
+
+GemmCost EstimateGemmCost(const TileDesc& tile,
+                          std::size_t batch,
+                          std::size_t M,
+                          std::size_t N,
+                          std::size_t K,
+                          DataType ab_data_type,
+                          const std::vector<VectorAccess>& accesses,
+                          const HardwareModel& hw)
+{
+    GemmCost cost;
+
+    for(const auto& access : accesses)
+    {
+        if(access.contiguous_length % access.scalar_per_vector != 0)
+        {
+            cost.reason = "vector width " + std::to_string(access.scalar_per_vector) +
+                          " does not divide " + std::to_string(access.contiguous_length);
+            return cost;
+        }
+    }
+
+    const std::size_t block_size = tile.block_size;
+    const std::size_t m_tile     = tile.m_per_block;
+    const std::size_t n_tile     = tile.n_per_block;
+    const std::size_t k_tile     = tile.k_per_block;
+
+    cost.lds_bytes              = (m_tile + n_tile) * k_tile * SizeOf(ab_data_type);
+    const std::size_t acc_vgprs = m_tile * n_tile / block_size;
+    const std::size_t load_vgprs =
+        integer_divide_ceil((m_tile + n_tile) * k_tile * SizeOf(ab_data_type), 4 * block_size);
+    // addresses, loop counters and epilogue temporaries
+    cost.vgprs = integer_divide_ceil(acc_vgprs + load_vgprs + 32, 8) * 8;
+
+    if(cost.vgprs > hw.vgprs_per_lane)
+    {
+        cost.reason = "needs about " + std::to_string(cost.vgprs) + " registers per lane";
+        return cost;
+    }
+
+    const std::size_t waves_per_simd =
+        std::min(hw.max_waves_per_simd, hw.vgprs_per_lane / cost.vgprs);
+    const std::size_t waves_per_workgroup = integer_divide_ceil(block_size, hw.wave_size);
+    cost.occupancy = std::min(hw.lds_bytes / cost.lds_bytes,
+                              hw.simds_per_cu * waves_per_simd / waves_per_workgroup);
+    if(cost.occupancy == 0)
+    {
+        cost.reason = "does not fit on a CU";
+        return cost;
+    }
+
+    const auto padded = [](std::size_t x, std::size_t tile_length) {
+        return x == 0 ? tile_length : integer_divide_ceil(x, tile_length) * tile_length;
+    };
+    const double m = M == 0 ? m_tile : M;
+    const double n = N == 0 ? n_tile : N;
+    const double k = K == 0 ? k_tile : K;
+
+    const std::size_t tiles = std::max<std::size_t>(batch, 1) * (padded(M, m_tile) / m_tile) *
+                              (padded(N, n_tile) / n_tile);
+    const std::size_t slots = hw.num_cu * cost.occupancy;
+
+    cost.tile_efficiency = m * n * k / (static_cast<double>(padded(M, m_tile)) *
+                                        padded(N, n_tile) * padded(K, k_tile));
+    cost.waves           = integer_divide_ceil(tiles, slots);
+    cost.wave_efficiency = static_cast<double>(tiles) / (cost.waves * slots);
+
+    // Tiles with a low arithmetic intensity are bound by the bandwidth feeding the CU, and a
+    // single resident workgroup cannot hide its own load latency.
+    const double intensity          = static_cast<double>(m_tile * n_tile) / (m_tile + n_tile);
+    const double bandwidth_fraction = std::min(1.0, intensity / hw.balanced_intensity);
+
+    // A wave keeping r workgroups on every CU lasts as long as r tiles at the throughput they
+    // reach together. The last wave may leave CUs with fewer workgroups.
+    const double tile_macs = static_cast<double>(m_tile) * n_tile * padded(K, k_tile);
+    const auto wave_time   = [&](std::size_t resident) {
+        return resident * tile_macs /
+               (std::min(1.0, resident * hw.single_wg_throughput) * bandwidth_fraction);
+    };
+    const std::size_t last_wave = tiles % slots;
+    double time                 = (tiles / slots) * wave_time(cost.occupancy);
+    if(last_wave != 0)
+        time += wave_time(integer_divide_ceil(last_wave, hw.num_cu));
+
+    // Useful MACs over the MAC capacity of all CUs for the modelled time
+    cost.score = std::max<std::size_t>(batch, 1) * m * n * k / (hw.num_cu * time);
+    cost.valid = true;
+    return cost;
+}
+
+std::vector<RankedSolution> RankSolutions(std::vector<RankedSolution> candidates,
+                                          std::size_t top_n)
+{
+    candidates.erase(std::remove_if(candidates.begin(),
+                                    candidates.end(),
+                                    [](const auto& c) { return not c.cost.valid; }),
+                     candidates.end());
+    std::stable_sort(candidates.begin(), candidates.end(), [](const auto& x, const auto& y) {
+        return x.cost.score > y.cost.score;
+    });
+    if(top_n != 0 and candidates.size() > top_n)
+        candidates.resize(top_n);
+    return candidates;
+}
+
+} // namespace operation
+} // namespace host
+} // namespace ck
@@ -28,6 +28,30 @@ std::vector<Solution> Problem::GetSolutions(const std::string& arch) const
     return result;
 }
 
+std::vector<operation::RankedSolution> Problem::GetRankedSolutions(const std::string& arch,
+                                                                  std::size_t top_n) const
+{
+    if(get_xdlop_archs().count(arch) == 0)
+        return {};
+    const auto hw = operation::HardwareModel::FromArch(arch);
+    std::vector<operation::RankedSolution> candidates;
+    for(const auto& op : Operation_Xdl_CShuffle::CreateOperations(*this))
+    {
+        // A is M x K and B is K x N in row-major order; the transposed layouts are contiguous
+        // along the other dimension. E and the Ds are written along N.
+        std::vector<operation::VectorAccess> accesses = {
+            {op.a_block_transfer.src_scalar_per_vector, TransA ? M : K},
+            {op.b_block_transfer.src_scalar_per_vector, TransB ? K : N}};
+        if(not TransE)
+            accesses.push_back({op.c_block_transfer.scalar_per_vector_n_wave_n_per_Xdl, N});
+
+        candidates.push_back(
+            {op.ToSolution(),
+             operation::EstimateGemmCost(op.tile_desc, 1, M, N, K, ADataType, accesses, hw)});
+    }
+    return operation::RankSolutions(std::move(candidates), top_n);
+}
+
 } // namespace device_gemm_multiple_d
 } // namespace host
 } // namespace ck
\ No newline at end of file
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "ck/host/device_grouped_conv_fwd_multiple_abd/problem.hpp"
+#include "ck/host/device_grouped_conv_fwd_multiple_abd/operation.hpp"
+#include "ck/host/utils.hpp"
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+
+namespace ck {
+namespace host {
+namespace device_grouped_conv_fwd_multiple_abd {
+
+static std::size_t Get(const std::vector<std::size_t>& v, std::size_t i, std::size_t default_value)
+{
+    return v.empty() ? default_value : v.at(i);
+}
+
+static std::size_t Product(const std::vector<std::size_t>& v)
+{
+    return std::accumulate(v.begin(), v.end(), std::size_t{1}, std::multiplies<std::size_t>{});
+}
+
+std::vector<std::size_t> Problem::GetOutputSpatialLengths() const
+{
+    if(InputSpatialLengths.empty() or FilterSpatialLengths.empty())
+        return {};
+    std::vector<std::size_t> result;
+    for(std::size_t i = 0; i < NumDim; i++)
+    {
+        const auto padded = InputSpatialLengths.at(i) + Get(InLeftPads, i, 0) +
+                            Get(InRightPads, i, 0);
+        const auto window = Get(ConvDilations, i, 1) * (FilterSpatialLengths.at(i) - 1) + 1;
+        if(padded < window)
+            throw std::runtime_error("Filter is larger than the padded input");
+        result.push_back((padded - window) / Get(ConvStrides, i, 1) + 1);
+    }
+    return result;
+}
+
+std::size_t Problem::GetGemmM() const
+{
+    const auto out = GetOutputSpatialLengths();
+    return out.empty() ? 0 : N * Product(out);
+}
+
+std::size_t Problem::GetGemmN() const { return K; }
+
+std::size_t Problem::GetGemmK() const
+{
+    return FilterSpatialLengths.empty() ? 0 : C * Product(FilterSpatialLengths);
+}
+
+ConvFwdSpecialization Problem::GetConvSpecialization() const
+{
+    if(FilterSpatialLengths.empty())
+        return ConvFwdSpecialization::Default;
+
+    bool filter1x1 = true;
+    bool stride1   = true;
+    for(std::size_t i = 0; i < NumDim; i++)
+    {
+        filter1x1 = filter1x1 and FilterSpatialLengths.at(i) == 1 and
+                    Get(InLeftPads, i, 0) == 0 and Get(InRightPads, i, 0) == 0;
+        stride1 = stride1 and Get(ConvStrides, i, 1) == 1;
+    }
+    if(filter1x1)
+        return stride1 ? ConvFwdSpecialization::Filter1x1Stride1Pad0
+                       : ConvFwdSpecialization::Filter1x1Pad0;
+    return ConvFwdSpecialization::Default;
+}
+
+std::string Problem::GetIncludeHeader() const
+{
+    return "ck/tensor_operation/gpu/device/impl/"
+           "device_grouped_conv_fwd_multiple_abd_xdl_cshuffle.hpp";
+}
+
+std::vector<Solution> Problem::GetSolutions(const std::string& arch) const
+{
+    if(get_xdlop_archs().count(arch) == 0)
+        return {};
+    auto ops = Operation_Xdl_CShuffle::CreateOperations(*this);
+    std::vector<Solution> result;
+    std::transform(ops.begin(), ops.end(), std::back_inserter(result), [&](const auto& op) {
+        return op.ToSolution();
+    });
+    return result;
+}
+
+std::vector<operation::RankedSolution> Problem::GetRankedSolutions(const std::string& arch,
+                                                                  std::size_t top_n) const
+{
+    if(get_xdlop_archs().count(arch) == 0)
+        return {};
+    const auto hw = operation::HardwareModel::FromArch(arch);
+    std::vector<operation::RankedSolution> candidates;
+    for(const auto& op : Operation_Xdl_CShuffle::CreateOperations(*this))
+    {
+        std::vector<operation::VectorAccess> accesses = {
+            {op.a_block_transfer.src_scalar_per_vector, C},
+            {op.b_block_transfer.src_scalar_per_vector, C},
+            {op.c_block_transfer.scalar_per_vector_n_wave_n_per_Xdl, K}};
+
+        candidates.push_back({op.ToSolution(),
+                              operation::EstimateGemmCost(op.tile_desc,
+                                                          G,
+                                                          GetGemmM(),
+                                                          GetGemmN(),
+                                                          GetGemmK(),
+                                                          ADataType,
+                                                          accesses,
+                                                          hw)});
+    }
+    return operation::RankSolutions(std::move(candidates), top_n);
+}
+
+} // namespace device_grouped_conv_fwd_multiple_abd
+} // namespace host
+} // namespace ck
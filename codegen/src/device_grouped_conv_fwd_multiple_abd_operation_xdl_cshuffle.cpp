@@ -0,0 +1,333 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "ck/host/device_grouped_conv_fwd_multiple_abd/operation.hpp"
+#include "ck/host/stringutils.hpp"
+#include "ck/host/utils.hpp"
+#include <cassert>
+#include <stdexcept>
+
+namespace ck {
+namespace host {
+namespace device_grouped_conv_fwd_multiple_abd {
+
+// Unknown (0) sizes are padded
+static std::string GetGemmSpec(const std::size_t m,
+                               const std::size_t n,
+                               const std::size_t k,
+                               const std::size_t m_per_block,
+                               const std::size_t n_per_block,
+                               const std::size_t k_per_block)
+{
+    std::string spec = "";
+    if(m == 0 or integer_divide_ceil(m, m_per_block) * m_per_block - m != 0)
+        spec += "M";
+    if(n == 0 or integer_divide_ceil(n, n_per_block) * n_per_block - n != 0)
+        spec += "N";
+    if(k == 0 or integer_divide_ceil(k, k_per_block) * k_per_block - k != 0)
+        spec += "K";
+    if(spec == "")
+        return "ck::tensor_operation::device::GemmSpecialization::Default";
+
+    return "ck::tensor_operation::device::GemmSpecialization::" + spec + "Padding";
+}
+
+// Widest vector of at most `max_vector` elements and 16 bytes whose width divides the
+// contiguous length (unknown when 0).
+static int GetScalarPerVector(int max_vector, DataType dt, std::size_t contiguous_length)
+{
+    int vector = max_vector;
+    while(vector > 1 and
+          (static_cast<std::size_t>(vector) * SizeOf(dt) > 16 or
+           (contiguous_length != 0 and contiguous_length % vector != 0)))
+        vector /= 2;
+    return vector;
+}
+
+static void CheckLayout(const std::string& layout, std::size_t num_dim, char innermost)
+{
+    // Bias-like layouts (e.g. G_K) broadcast over the spatial dimensions
+    const bool broadcast = layout.find('_') != std::string::npos;
+    if(layout.empty() or layout.back() != innermost or
+       (not broadcast and layout.size() != num_dim + 3))
+        throw std::runtime_error("Unsupported " + std::to_string(num_dim) +
+                                 "D conv layout: " + layout);
+}
+
+static DataType GetAccDataType(DataType dt)
+{
+    return dt == DataType::Int8 ? DataType::Int32 : DataType::Float;
+}
+
+std::vector<Operation_Xdl_CShuffle> Operation_Xdl_CShuffle::CreateOperations(const Problem& prob)
+{
+    CheckLayout(prob.ALayout, prob.NumDim, 'C');
+    CheckLayout(prob.BLayout, prob.NumDim, 'C');
+    CheckLayout(prob.ELayout, prob.NumDim, 'K');
+    for(const auto& layout : prob.DsLayout)
+        CheckLayout(layout, prob.NumDim, 'K');
+    if(prob.DsLayout.size() != prob.DsDataType.size())
+        throw std::runtime_error("Ds layouts and data types do not match");
+
+    std::vector<Operation_Xdl_CShuffle> result;
+
+    std::vector<operation::TileDesc> tile_descriptions = {
+        // clang-format off
+//  Block|  MPer|  NPer|  KPer| AK1| BK1| MPer| NPer| MXdl| NXdl| NumGemmK|
+//   Size| Block| Block| Block|    |    |  XDL|  XDL|  Per|  Per| Prefetch|
+//       |      |      |      |    |    |     |     | Wave| Wave|    Stage|
+//       |      |      |      |    |    |     |     |     |     |         |
+  {   256,   256,   128,    32,   8,   8,   32,   32,    4,    2,        1},
+  {   256,   128,   256,    32,   8,   8,   32,   32,    2,    4,        1},
+  {   128,   128,   128,    32,   8,   8,   32,   32,    4,    2,        1},
+  {   256,   128,   128,    32,   8,   8,   32,   32,    2,    2,        1},
+  {   128,   128,    64,    32,   8,   8,   32,   32,    2,    2,        1},
+  {   128,    64,   128,    32,   8,   8,   32,   32,    2,    2,        1},
+  {    64,    64,    64,    32,   8,   8,   32,   32,    2,    2,        1},
+  {   256,   128,    64,    32,   8,   8,   32,   32,    2,    1,        1},
+  {   256,    64,   128,    32,   8,   8,   32,   32,    1,    2,        1},
+  {   128,   128,    32,    32,   8,   8,   32,   32,    2,    1,        1},
+  {   128,    32,   128,    32,   8,   8,   32,   32,    1,    2,        1},
+  {    64,    64,    32,    32,   8,   8,   32,   32,    2,    1,        1},
+  {    64,    32,    64,    32,   8,   8,   32,   32,    1,    2,        1},
+        // clang-format on
+    };
+
+    // A and B are both read along C, so they share their transfer descriptions
+    std::vector<operation::BlockTransferDesc> ab_block_descriptions = {
+        // clang-format off
+//   BlockTransfer|  BlockTransfer|  BlockTransfer|  BlockTransfer|  BlockTransfer|  BlockTransfer|  BlockLds|
+//   ThreadCluster|  ThreadCluster| SrcAccessOrder|   SrcVectorDim|      SrcScalar|      DstScalar|  AddExtra|
+// Lengths_K0_M_K1|   ArrangeOrder|               |               |      PerVector|   PerVector_K1|       M/N|
+//                |               |               |               |               |               |          |
+  {    S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 32, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 32, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 32, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 16, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 64, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 32, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 32, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 16, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+  {    S<4, 16, 1>,     S<1, 0, 2>,     S<1, 0, 2>,              2,              8,              8,         1},
+        // clang-format on
+    };
+
+    std::vector<operation::CShuffleDesc> cshuffle_descriptions = {
+        // clang-format off
+//    CShuffle|    CShuffle|
+// MXdlPerWave| NXdlPerWave|
+//  PerShuffle|  PerShuffle|
+//            |            |
+  {          1,           1},
+  {          1,           1},
+  {          1,           1},
+  {          1,           1},
+  {          1,           1},
+  {          1,           1},
+  {          1,           1},
+  {          1,           1},
+  {          1,           1},
+  {          1,           1},
+  {          1,           1},
+  {          1,           1},
+  {          1,           1},
+        // clang-format on
+    };
+
+    std::vector<operation::CBlockTransferDesc> c_block_descriptions = {
+        // clang-format off
+// CBlockTransferClusterLengths|  CBlockTransfer
+//         _MBlock_MWaveMPerXdl| ScalarPerVector
+//         _NBlock_NWaveNPerXdl|   _NWaveNPerXdl
+//                             |
+  {              S<1, 32, 1, 8>,               8},
+  {              S<1, 32, 1, 8>,               8},
+  {              S<1, 16, 1, 8>,               8},
+  {              S<1, 32, 1, 8>,               8},
+  {              S<1, 32, 1, 4>,               8},
+  {              S<1, 16, 1, 8>,               8},
+  {              S<1, 16, 1, 4>,               8},
+  {              S<1, 32, 1, 8>,               8},
+  {              S<1, 32, 1, 8>,               8},
+  {              S<1, 32, 1, 4>,               8},
+  {              S<1, 16, 1, 8>,               8},
+  {              S<1, 16, 1, 4>,               8},
+  {              S<1, 16, 1, 4>,               8},
+        // clang-format on
+    };
+
+    assert(tile_descriptions.size() == ab_block_descriptions.size());
+    assert(tile_descriptions.size() == cshuffle_descriptions.size());
+    assert(tile_descriptions.size() == c_block_descriptions.size());
+
+    for(std::size_t i = 0; i < tile_descriptions.size(); i++)
+    {
+        Operation_Xdl_CShuffle x;
+        x.tile_desc           = tile_descriptions[i];
+        x.a_block_transfer    = ab_block_descriptions[i];
+        x.b_block_transfer    = ab_block_descriptions[i];
+        x.cshuffle            = cshuffle_descriptions[i];
+        x.c_block_transfer    = c_block_descriptions[i];
+        x.num_dim             = prob.NumDim;
+        x.a_layout            = prob.ALayout;
+        x.b_layout            = prob.BLayout;
+        x.ds_layout           = prob.DsLayout;
+        x.e_layout            = prob.ELayout;
+        x.a_data_type         = prob.ADataType;
+        x.b_data_type         = prob.BDataType;
+        x.acc                 = GetAccDataType(prob.ADataType);
+        x.cs_type             = prob.EDataType;
+        x.ds_data_type        = prob.DsDataType;
+        x.e_data_type         = prob.EDataType;
+        x.a_elem_op           = prob.AElementOp;
+        x.b_elem_op           = prob.BElementOp;
+        x.cde_elem_op         = prob.CDEElementOp;
+        x.conv_specialization = prob.GetConvSpecialization();
+        x.gemm_specialization = GetGemmSpec(prob.GetGemmM(),
+                                            prob.GetGemmN(),
+                                            prob.GetGemmK(),
+                                            x.tile_desc.m_per_block,
+                                            x.tile_desc.n_per_block,
+                                            x.tile_desc.k_per_block);
+
+        // Vector accesses must not straddle a group: A and B are read along C, E and the Ds
+        // are written along K.
+        x.a_block_transfer.src_scalar_per_vector =
+            GetScalarPerVector(x.a_block_transfer.src_scalar_per_vector, prob.ADataType, prob.C);
+        x.b_block_transfer.src_scalar_per_vector =
+            GetScalarPerVector(x.b_block_transfer.src_scalar_per_vector, prob.BDataType, prob.C);
+        auto& e_vector = x.c_block_transfer.scalar_per_vector_n_wave_n_per_Xdl;
+        e_vector       = GetScalarPerVector(e_vector, prob.EDataType, prob.K);
+        for(auto dt : prob.DsDataType)
+            e_vector = GetScalarPerVector(e_vector, dt, prob.K);
+
+        result.push_back(x);
+    }
+    return result;
+}
+
+std::vector<std::vector<Operation_Xdl_CShuffle>> Operation_Xdl_CShuffle::CreateOperations()
+{
+    const std::vector<std::vector<std::string>> layouts = {
+        {"NWGC", "GKXC", "NWGK"}, {"NHWGC", "GKYXC", "NHWGK"}, {"NDHWGC", "GKZYXC", "NDHWGK"}};
+
+    std::vector<Problem> problems;
+    for(std::size_t num_dim : {1, 2, 3})
+        for(auto spec : {ConvFwdSpecialization::Default,
+                         ConvFwdSpecialization::Filter1x1Pad0,
+                         ConvFwdSpecialization::Filter1x1Stride1Pad0})
+        {
+            Problem prob;
+            prob.NumDim  = num_dim;
+            prob.ALayout = layouts[num_dim - 1][0];
+            prob.BLayout = layouts[num_dim - 1][1];
+            prob.ELayout = layouts[num_dim - 1][2];
+            if(spec != ConvFwdSpecialization::Default)
+            {
+                prob.FilterSpatialLengths = std::vector<std::size_t>(num_dim, 1);
+                prob.ConvStrides          = std::vector<std::size_t>(
+                    num_dim, spec == ConvFwdSpecialization::Filter1x1Pad0 ? 2 : 1);
+            }
+            problems.push_back(prob);
+        }
+    return Transform(problems, [](const Problem& p) { return CreateOperations(p); });
+}
+
+static const char* const DeviceGroupedConvFwdMultipleABD_Xdl_CShuffleTemplate =
+    "ck::tensor_operation::device::DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle<${NumDimSpatial}, "
+    "${LayoutA}, ${LayoutB}, ${LayoutDs}, ${LayoutE}, ${ADataType}, ${BDataType}, "
+    "${AccDataType}, ${CShuffleDataType}, ${DsDataType}, ${EDataType}, ${AElementwiseOperation}, "
+    "${BElementwiseOperation}, ${CDEElementwiseOperation}, ${ConvSpecialization}, "
+    "${GemmSpecialization}, ${NumGemmkPrefetchStage}, ${BlockSize}, ${MPerBlock}, ${NPerBlock}, "
+    "${KPerBlock}, ${AK1}, ${BK1}, ${MPerXDL}, ${NPerXDL}, ${MXdlPerWave}, ${NXdlPerWave}, "
+    "${ABlockTransferThreadClusterLengths_AK0_M_AK1}, ${ABlockTransferThreadClusterArrangeOrder}, "
+    "${ABlockTransferSrcAccessOrder}, ${ABlockTransferSrcVectorDim}, "
+    "${ABlockTransferSrcScalarPerVector}, ${ABlockTransferDstScalarPerVector_AK1}, "
+    "${ABlockLdsExtraM}, ${BBlockTransferThreadClusterLengths_BK0_N_BK1}, "
+    "${BBlockTransferThreadClusterArrangeOrder}, ${BBlockTransferSrcAccessOrder}, "
+    "${BBlockTransferSrcVectorDim}, ${BBlockTransferSrcScalarPerVector}, "
+    "${BBlockTransferDstScalarPerVector_BK1}, ${BBlockLdsExtraN}, "
+    "${CShuffleMXdlPerWavePerShuffle}, ${CShuffleNXdlPerWavePerShuffle}, "
+    "${CDEBlockTransferClusterLengths_MBlock_MPerBlock_NBlock_NPerBlock}, "
+    "${CDEBlockTransferScalarPerVector_NPerBlock}>";
+
+static std::string ToConvLayout(const std::string& layout)
+{
+    return "ck::tensor_layout::convolution::" + layout;
+}
+
+Solution Operation_Xdl_CShuffle::ToSolution() const
+{
+    std::unordered_map<std::string, std::string> values = {
+        {"NumDimSpatial", std::to_string(this->num_dim)},
+        {"LayoutA", ToConvLayout(this->a_layout)},
+        {"LayoutB", ToConvLayout(this->b_layout)},
+        {"LayoutDs", MakeTuple(Transform(this->ds_layout, ToConvLayout))},
+        {"LayoutE", ToConvLayout(this->e_layout)},
+        {"ADataType", ToString(this->a_data_type)},
+        {"BDataType", ToString(this->b_data_type)},
+        {"AccDataType", ToString(this->acc)},
+        {"CShuffleDataType", ToString(this->cs_type)},
+        {"DsDataType",
+         MakeTuple(Transform(this->ds_data_type, [](auto dt) { return ToString(dt); }))},
+        {"EDataType", ToString(this->e_data_type)},
+        {"AElementwiseOperation", this->a_elem_op},
+        {"BElementwiseOperation", this->b_elem_op},
+        {"CDEElementwiseOperation", this->cde_elem_op},
+        {"ConvSpecialization", ToString(this->conv_specialization)},
+        {"GemmSpecialization", this->gemm_specialization},
+        {"NumGemmkPrefetchStage", std::to_string(this->tile_desc.num_gemmk_prefetch_stage)},
+        {"BlockSize", std::to_string(this->tile_desc.block_size)},
+        {"MPerBlock", std::to_string(this->tile_desc.m_per_block)},
+        {"NPerBlock", std::to_string(this->tile_desc.n_per_block)},
+        {"KPerBlock", std::to_string(this->tile_desc.k_per_block)},
+        {"AK1", std::to_string(this->tile_desc.ak1)},
+        {"BK1", std::to_string(this->tile_desc.bk1)},
+        {"MPerXDL", std::to_string(this->tile_desc.m_per_XDL)},
+        {"NPerXDL", std::to_string(this->tile_desc.n_per_XDL)},
+        {"MXdlPerWave", std::to_string(this->tile_desc.m_Xdl_per_wave)},
+        {"NXdlPerWave", std::to_string(this->tile_desc.n_Xdl_per_wave)},
+        {"ABlockTransferThreadClusterLengths_AK0_M_AK1",
+         this->a_block_transfer.thread_cluster_length},
+        {"ABlockTransferThreadClusterArrangeOrder",
+         this->a_block_transfer.thread_cluster_arrange_order},
+        {"ABlockTransferSrcAccessOrder", this->a_block_transfer.src_access_order},
+        {"ABlockTransferSrcVectorDim", std::to_string(this->a_block_transfer.src_vec_dim)},
+        {"ABlockTransferSrcScalarPerVector",
+         std::to_string(this->a_block_transfer.src_scalar_per_vector)},
+        {"ABlockTransferDstScalarPerVector_AK1",
+         std::to_string(this->a_block_transfer.dst_scalar_per_vector_k1)},
+        {"ABlockLdsExtraM", std::to_string(this->a_block_transfer.lds_add_extra_dim)},
+        {"BBlockTransferThreadClusterLengths_BK0_N_BK1",
+         this->b_block_transfer.thread_cluster_length},
+        {"BBlockTransferThreadClusterArrangeOrder",
+         this->b_block_transfer.thread_cluster_arrange_order},
+        {"BBlockTransferSrcAccessOrder", this->b_block_transfer.src_access_order},
+        {"BBlockTransferSrcVectorDim", std::to_string(this->b_block_transfer.src_vec_dim)},
+        {"BBlockTransferSrcScalarPerVector",
+         std::to_string(this->b_block_transfer.src_scalar_per_vector)},
+        {"BBlockTransferDstScalarPerVector_BK1",
+         std::to_string(this->b_block_transfer.dst_scalar_per_vector_k1)},
+        {"BBlockLdsExtraN", std::to_string(this->b_block_transfer.lds_add_extra_dim)},
+        {"CShuffleMXdlPerWavePerShuffle",
+         std::to_string(this->cshuffle.m_Xdl_per_wave_per_shuffle)},
+        {"CShuffleNXdlPerWavePerShuffle",
+         std::to_string(this->cshuffle.n_Xdl_per_wave_per_shuffle)},
+        {"CDEBlockTransferClusterLengths_MBlock_MPerBlock_NBlock_NPerBlock",
+         this->c_block_transfer.cluster_lengths_m_block_m_wave_m_per_Xdl_n_block_n_wave_n_per_Xdl},
+        {"CDEBlockTransferScalarPerVector_NPerBlock",
+         std::to_string(this->c_block_transfer.scalar_per_vector_n_wave_n_per_Xdl)},
+    };
+
+    return Solution{
+        InterpolateString(DeviceGroupedConvFwdMultipleABD_Xdl_CShuffleTemplate, values),
+        std::move(values)};
+}
+
+} // namespace device_grouped_conv_fwd_multiple_abd
+} // namespace host
+} // namespace ck
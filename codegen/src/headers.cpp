@@ -1,5 +1,8 @@
 #include "ck/host/headers.hpp"
 #include "ck_headers.hpp"
+#include <cctype>
+#include <filesystem>
+#include <unordered_set>
 
 namespace ck {
 namespace host {
@@ -13,5 +16,76 @@ std::unordered_map<std::string_view, std::string_view> GetHeaders()
     return headers;
 }
 
+std::vector<IncludeDirective> GetIncludeDirectives(std::string_view content)
+{
+    std::vector<IncludeDirective> result;
+    std::size_t pos = 0;
+    while(pos < content.size())
+    {
+        auto eol = content.find('\n', pos);
+        if(eol == std::string_view::npos)
+            eol = content.size();
+        auto line = content.substr(pos, eol - pos);
+        pos       = eol + 1;
+
+        auto skip_space = [&] {
+            while(not line.empty() and std::isspace(static_cast<unsigned char>(line.front())))
+                line.remove_prefix(1);
+        };
+        skip_space();
+        if(line.empty() or line.front() != '#')
+            continue;
+        line.remove_prefix(1);
+        skip_space();
+        if(line.substr(0, 7) != "include")
+            continue;
+        line.remove_prefix(7);
+        skip_space();
+        if(line.empty() or (line.front() != '"' and line.front() != '<'))
+            continue;
+        const bool quoted = line.front() == '"';
+        auto last         = line.find(quoted ? '"' : '>', 1);
+        if(last == std::string_view::npos)
+            continue;
+        result.push_back({std::string{line.substr(1, last - 1)}, quoted});
+    }
+    return result;
+}
+
+std::unordered_map<std::string_view, std::string_view>
+GetHeaders(const std::vector<std::string>& roots)
+{
+    const auto all = GetHeaders();
+    std::unordered_map<std::string_view, std::string_view> result;
+
+    // Every include directive is followed, including those in disabled preprocessor branches,
+    // so the set may be larger than needed but never misses a header.
+    std::vector<std::string_view> stack;
+    auto visit = [&](const std::string& name) {
+        auto it = all.find(name);
+        if(it != all.end() and result.insert(*it).second)
+            stack.push_back(it->first);
+    };
+
+    for(const auto& root : roots)
+        visit(root);
+    visit("ck/config.h");
+
+    while(not stack.empty())
+    {
+        auto name = stack.back();
+        stack.pop_back();
+        const auto dir = std::filesystem::path{name}.parent_path();
+        for(const auto& inc : GetIncludeDirectives(result.at(name)))
+        {
+            // Quoted includes are looked up next to the including header first, as the
+            // compiler does, and then from the include root.
+            auto local = (dir / inc.name).lexically_normal().generic_string();
+            visit(inc.quoted and all.count(local) > 0 ? local : inc.name);
+        }
+    }
+    return result;
+}
+
 } // namespace host
-} // namespace ck
\ No newline at end of file
+} // namespace ck
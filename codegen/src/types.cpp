@@ -29,6 +29,18 @@ std::string ToString(DataType dt)
     throw std::runtime_error("Incorrect data type");
 }
 
+std::size_t SizeOf(DataType dt)
+{
+    switch(dt)
+    {
+    case DataType::Float: return 4;
+    case DataType::Half: return 2;
+    case DataType::Int8: return 1;
+    case DataType::Int32: return 4;
+    }
+    throw std::runtime_error("Incorrect data type");
+}
+
 std::string ToString(Layout dl)
 {
     switch(dl)
@@ -48,6 +60,19 @@ std::string ToString(GemmType gt)
     throw std::runtime_error("Incorrect gemm type");
 }
 
+std::string ToString(ConvFwdSpecialization cs)
+{
+    const std::string prefix = "ck::tensor_operation::device::ConvolutionForwardSpecialization::";
+    switch(cs)
+    {
+    case ConvFwdSpecialization::Default: return prefix + "Default";
+    case ConvFwdSpecialization::Filter1x1Pad0: return prefix + "Filter1x1Pad0";
+    case ConvFwdSpecialization::Filter1x1Stride1Pad0: return prefix + "Filter1x1Stride1Pad0";
+    case ConvFwdSpecialization::OddC: return prefix + "OddC";
+    }
+    throw std::runtime_error("Incorrect conv fwd specialization");
+}
+
 std::string SequenceStr(const std::vector<int>& v)
 {
     return "ck::Sequence<" +
@@ -0,0 +1,244 @@
+#include <rtc/code_object_cache.hpp>
+#include <rtc/compile_kernel.hpp>
+#include <rtc/tmp_dir.hpp>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <test.hpp>
+
+// These tests run the RTC compile path with a shell script standing in for the compiler, so
+// they do not need ROCm or a GPU. The stub concatenates its .cpp inputs and the command line
+// into the output object and counts its invocations.
+struct stub_compiler
+{
+    rtc::tmp_dir dir{"stub"};
+    std::string cmd;
+
+    explicit stub_compiler(const std::string& version = "1.0") { write(version); }
+
+    // (Re)writes the script in place, so that only the reported version changes
+    void write(const std::string& version)
+    {
+        auto script = dir.path / "cc.sh";
+        std::ofstream os(script);
+        os << "#!/bin/sh\n"
+           << "if [ \"$1\" = \"--version\" ]; then echo \"stub clang " << version
+           << "\"; exit 0; fi\n"
+           << "for a in \"$@\"; do if [ \"$a\" = \"-emit-pch\" ]; then\n"
+           << "  echo pch >> " << (dir.path / "pch_count").string() << "\n"
+           << "  cat *.hpp > prelude.pch; exit 0; fi; done\n"
+           << "echo x >> " << (dir.path / "count").string() << "\n"
+           << "out=''; for a in \"$@\"; do [ \"$prev\" = \"-o\" ] && out=$a; prev=$a; done\n"
+           << "cat *.cpp > $out; echo \"$@\" >> $out\n";
+        os.close();
+        std::filesystem::permissions(script, std::filesystem::perms::owner_all);
+        cmd = script.string();
+    }
+
+    std::size_t invocations(const std::string& counter = "count") const
+    {
+        std::ifstream is(dir.path / counter);
+        std::size_t n = 0;
+        std::string line;
+        while(std::getline(is, line))
+            n++;
+        return n;
+    }
+};
+
+rtc::compile_options stub_options(const stub_compiler& cc, const std::string& flags = "")
+{
+    rtc::compile_options options;
+    options.flags    = flags;
+    options.compiler = cc.cmd;
+    options.arch     = "gfx90a";
+    return options;
+}
+
+const std::string header = "#define VALUE 1\n";
+const std::string source = "#include <value.hpp>\nint f() { return VALUE; }\n";
+
+std::vector<rtc::src_file> sources(const std::string& main = source)
+{
+    return {{"include/value.hpp", header}, {"main.cpp", main}};
+}
+
+std::string as_string(const std::vector<char>& obj) { return {obj.begin(), obj.end()}; }
+
+TEST_CASE(compile_without_cache)
+{
+    stub_compiler cc;
+    auto obj = rtc::compile_object(sources(), stub_options(cc), nullptr);
+    EXPECT(as_string(obj).find("int f()") != std::string::npos);
+    EXPECT(as_string(obj).find("--offload-arch=gfx90a") != std::string::npos);
+    EXPECT(cc.invocations() == 1u);
+}
+
+TEST_CASE(key_covers_inputs)
+{
+    stub_compiler cc;
+    auto key = rtc::compile_key(sources(), stub_options(cc));
+    EXPECT(key.size() == 32u);
+    EXPECT(key == rtc::compile_key(sources(), stub_options(cc)));
+    EXPECT(key != rtc::compile_key(sources(source + "\n"), stub_options(cc)));
+    EXPECT(key != rtc::compile_key(sources(), stub_options(cc, "-DX")));
+
+    auto other_arch = stub_options(cc);
+    other_arch.arch = "gfx942";
+    EXPECT(key != rtc::compile_key(sources(), other_arch));
+
+    std::vector<rtc::src_file> other_header = {{"include/value.hpp", "#define VALUE 2\n"},
+                                               {"main.cpp", source}};
+    EXPECT(key != rtc::compile_key(other_header, stub_options(cc)));
+
+    std::vector<rtc::src_file> moved_header = {{"include/other.hpp", header},
+                                               {"main.cpp", source}};
+    EXPECT(key != rtc::compile_key(moved_header, stub_options(cc)));
+
+    // the same compiler path upgraded in place, to a version string of another length so that the
+    // script changes size even within the timestamp resolution of the file system
+    cc.write("2.0.1");
+    EXPECT(key != rtc::compile_key(sources(), stub_options(cc)));
+}
+
+TEST_CASE(memo_and_disk_hits)
+{
+    stub_compiler cc;
+    rtc::tmp_dir dir{"cache"};
+    auto options = stub_options(cc);
+    std::vector<char> first;
+    {
+        rtc::code_object_cache cache{dir.path};
+        first = rtc::compile_object(sources(), options, &cache);
+        EXPECT(cache.misses() == 1u);
+        EXPECT(rtc::compile_object(sources(), options, &cache) == first);
+        EXPECT(cache.memo_hits() == 1u);
+        EXPECT(cc.invocations() == 1u);
+
+        cache.clear_memo();
+        EXPECT(rtc::compile_object(sources(), options, &cache) == first);
+        EXPECT(cache.disk_hits() == 1u);
+        EXPECT(cc.invocations() == 1u);
+    }
+    // A new cache on the same directory, as in a new process
+    rtc::code_object_cache cache{dir.path};
+    EXPECT(rtc::compile_object(sources(), options, &cache) == first);
+    EXPECT(cache.disk_hits() == 1u);
+    EXPECT(cache.misses() == 0u);
+
+    rtc::compile_object(sources(), stub_options(cc, "-DX"), &cache);
+    EXPECT(cache.misses() == 1u);
+    EXPECT(cc.invocations() == 2u);
+}
+
+TEST_CASE(compile_failure_is_not_cached)
+{
+    rtc::tmp_dir dir{"cache"};
+    rtc::code_object_cache cache{dir.path};
+    bool threw = false;
+    try
+    {
+        cache.get_or_compile("00", []() -> std::vector<char> { throw std::runtime_error("x"); });
+    }
+    catch(const std::runtime_error&)
+    {
+        threw = true;
+    }
+    EXPECT(threw);
+    EXPECT(cache.load("00") == nullptr);
+    auto obj = cache.get_or_compile("00", [] { return std::vector<char>{'a'}; });
+    EXPECT(obj->size() == 1u);
+    EXPECT(cache.misses() == 2u);
+}
+
+TEST_CASE(disk_lru_eviction)
+{
+    rtc::tmp_dir dir{"cache"};
+    rtc::code_object_cache cache{dir.path, 3000, 0};
+    auto object = [](char c) { return [=] { return std::vector<char>(1000, c); }; };
+
+    cache.get_or_compile("aa", object('a'));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cache.get_or_compile("bb", object('b'));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cache.get_or_compile("cc", object('c'));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    // Touch "aa" so that "bb" becomes the least recently used
+    EXPECT(cache.get_or_compile("aa", object('x'))->front() == 'a');
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cache.get_or_compile("dd", object('d'));
+
+    EXPECT(cache.load("aa") != nullptr);
+    EXPECT(cache.load("bb") == nullptr);
+    EXPECT(cache.load("cc") != nullptr);
+    EXPECT(cache.load("dd") != nullptr);
+}
+
+TEST_CASE(memo_lru_limit)
+{
+    rtc::tmp_dir dir{"cache"};
+    rtc::code_object_cache cache{dir.path, 1 << 20, 2000};
+    auto object = [](char c) { return [=] { return std::vector<char>(1000, c); }; };
+
+    cache.get_or_compile("aa", object('a'));
+    cache.get_or_compile("bb", object('b'));
+    cache.get_or_compile("aa", object('a'));
+    cache.get_or_compile("cc", object('c'));
+    EXPECT(cache.memo_hits() == 1u);
+    // "bb" was dropped from the memo but is still on disk
+    cache.get_or_compile("bb", object('x'));
+    EXPECT(cache.memo_hits() == 1u);
+    EXPECT(cache.disk_hits() == 1u);
+    cache.get_or_compile("cc", object('x'));
+    EXPECT(cache.memo_hits() == 2u);
+}
+
+TEST_CASE(concurrent_misses_compile_once)
+{
+    stub_compiler cc;
+    rtc::tmp_dir dir{"cache"};
+    auto options = stub_options(cc);
+    std::vector<std::thread> threads;
+    std::vector<std::vector<char>> results(8);
+    for(std::size_t i = 0; i < results.size(); i++)
+    {
+        threads.emplace_back([&, i] {
+            // One cache per thread, as separate processes sharing the directory would have
+            rtc::code_object_cache cache{dir.path};
+            results[i] = rtc::compile_object(sources(), options, &cache);
+        });
+    }
+    for(auto& t : threads)
+        t.join();
+    EXPECT(cc.invocations() == 1u);
+    for(const auto& r : results)
+        EXPECT(r == results.front());
+}
+
+TEST_CASE(prelude_is_precompiled_once)
+{
+    stub_compiler cc;
+    rtc::tmp_dir dir{"cache"};
+    rtc::code_object_cache cache{dir.path};
+    auto options    = stub_options(cc);
+    options.prelude = "prelude.hpp";
+    auto srcs       = [](const std::string& main) {
+        return std::vector<rtc::src_file>{{"include/value.hpp", header},
+                                          {"prelude.hpp", "#include <value.hpp>\n"},
+                                          {"main.cpp", main}};
+    };
+
+    auto a = as_string(rtc::compile_object(srcs(source), options, &cache));
+    auto b = as_string(rtc::compile_object(srcs(source + "int g();\n"), options, &cache));
+    EXPECT(a.find("-include-pch") != std::string::npos);
+    EXPECT(b.find("-include-pch") != std::string::npos);
+    EXPECT(cc.invocations() == 2u);
+    EXPECT(cc.invocations("pch_count") == 1u);
+
+    // Without a cache there is nothing to reuse the PCH across compiles
+    auto c = as_string(rtc::compile_object(srcs(source), options, nullptr));
+    EXPECT(c.find("-include-pch") == std::string::npos);
+    EXPECT(cc.invocations("pch_count") == 1u);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
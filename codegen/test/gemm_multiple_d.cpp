@@ -14,14 +14,17 @@
 using half = _Float16;
 // using half = __fp16;
 
-std::vector<rtc::src_file> get_headers_for_test()
+std::vector<rtc::src_file> get_headers_for_test(const std::string& include,
+                                                const std::string& prelude)
 {
     std::vector<rtc::src_file> result;
-    auto hs = ck::host::GetHeaders();
+    auto hs = ck::host::GetHeaders({include});
     std::transform(
         hs.begin(), hs.end(), std::back_inserter(result), [&](const auto& p) -> rtc::src_file {
             return {p.first, p.second};
         });
+    // Precompiled once and shared by every solution of the problem
+    result.push_back({"prelude.hpp", prelude});
     return result;
 }
 
@@ -158,6 +161,7 @@ TEST_CASE(test_problem_kernel)
     auto a = to_gpu(generate_buffer<half>(1024 * 1024, 0));
     auto b = to_gpu(generate_buffer<half>(1024 * 1024, 1));
     auto c = to_gpu(generate_buffer<half>(1024 * 1024, 2));
+    const std::string prelude = "#include <" + prob.GetIncludeHeader() + ">\n";
 
     for(auto solution : prob.GetSolutions("gfx90a"))
     {
@@ -167,10 +171,11 @@ TEST_CASE(test_problem_kernel)
                                                 {"m", std::to_string(prob.M)},
                                                 {"n", std::to_string(prob.N)},
                                                 {"k", std::to_string(prob.K)}});
-        auto srcs = get_headers_for_test();
+        auto srcs = get_headers_for_test(prob.GetIncludeHeader(), prelude);
         srcs.push_back({"main.cpp", src});
         rtc::compile_options options;
         options.kernel_name = "f";
+        options.prelude     = "prelude.hpp";
         auto k              = rtc::compile_kernel(srcs, options);
         auto block_size     = solution.GetTemplateParameter<std::size_t>("BlockSize");
         auto m_per_block    = solution.GetTemplateParameter<std::size_t>("MPerBlock");
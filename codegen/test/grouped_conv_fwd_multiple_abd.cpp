@@ -0,0 +1,145 @@
+#include "ck/host/device_grouped_conv_fwd_multiple_abd/problem.hpp"
+#include "ck/host/device_grouped_conv_fwd_multiple_abd/operation.hpp"
+#include <stdexcept>
+#include <test.hpp>
+
+using namespace ck::host::device_grouped_conv_fwd_multiple_abd;
+using ck::host::ConvFwdSpecialization;
+using ck::host::DataType;
+using ck::host::ToString;
+
+Problem conv2d_3x3()
+{
+    Problem prob;
+    prob.G                    = 4;
+    prob.N                    = 2;
+    prob.C                    = 64;
+    prob.K                    = 128;
+    prob.InputSpatialLengths  = {28, 28};
+    prob.FilterSpatialLengths = {3, 3};
+    prob.InLeftPads           = {1, 1};
+    prob.InRightPads          = {1, 1};
+    return prob;
+}
+
+std::string conv_spec(const Problem& prob) { return ToString(prob.GetConvSpecialization()); }
+
+TEST_CASE(conv_geometry)
+{
+    auto prob = conv2d_3x3();
+    EXPECT(prob.GetOutputSpatialLengths() == std::vector<std::size_t>{28, 28});
+    EXPECT(prob.GetGemmM() == 2u * 28 * 28);
+    EXPECT(prob.GetGemmN() == 128u);
+    EXPECT(prob.GetGemmK() == 64u * 9);
+    EXPECT(conv_spec(prob) == ToString(ConvFwdSpecialization::Default));
+
+    prob.ConvStrides   = {2, 2};
+    prob.ConvDilations = {2, 2};
+    EXPECT(prob.GetOutputSpatialLengths() == std::vector<std::size_t>{13, 13});
+
+    prob.FilterSpatialLengths = {1, 1};
+    EXPECT(conv_spec(prob) == ToString(ConvFwdSpecialization::Default));
+    prob.InLeftPads  = {};
+    prob.InRightPads = {};
+    EXPECT(conv_spec(prob) == ToString(ConvFwdSpecialization::Filter1x1Pad0));
+    prob.ConvStrides = {1, 1};
+    EXPECT(conv_spec(prob) == ToString(ConvFwdSpecialization::Filter1x1Stride1Pad0));
+}
+
+TEST_CASE(golden_conv2d)
+{
+    auto solutions = conv2d_3x3().GetSolutions("gfx90a");
+    EXPECT(solutions.size() == 13u);
+    EXPECT(solutions.front().ToTemplateString() ==
+           "ck::tensor_operation::device::DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle<2, "
+           "ck::tensor_layout::convolution::NHWGC, ck::tensor_layout::convolution::GKYXC, "
+           "ck::Tuple<>, ck::tensor_layout::convolution::NHWGK, ck::half_t, ck::half_t, float, "
+           "ck::half_t, ck::Tuple<>, ck::half_t, ck::tensor_operation::element_wise::PassThrough, "
+           "ck::tensor_operation::element_wise::PassThrough, "
+           "ck::tensor_operation::element_wise::PassThrough, "
+           "ck::tensor_operation::device::ConvolutionForwardSpecialization::Default, "
+           "ck::tensor_operation::device::GemmSpecialization::MPadding, 1, 256, 256, 128, 32, 8, "
+           "8, 32, 32, 4, 2, ck::Sequence<4, 64, 1>, ck::Sequence<1, 0, 2>, "
+           "ck::Sequence<1, 0, 2>, 2, 8, 8, 1, ck::Sequence<4, 64, 1>, ck::Sequence<1, 0, 2>, "
+           "ck::Sequence<1, 0, 2>, 2, 8, 8, 1, 1, 1, ck::Sequence<1, 32, 1, 8>, 8>");
+    EXPECT(conv2d_3x3().GetSolutions("gfx1100").empty());
+}
+
+TEST_CASE(golden_conv3d_bias_relu)
+{
+    Problem prob;
+    prob.NumDim               = 3;
+    prob.N                    = 1;
+    prob.C                    = 3;
+    prob.K                    = 6;
+    prob.InputSpatialLengths  = {8, 8, 8};
+    prob.FilterSpatialLengths = {1, 1, 1};
+    prob.ALayout              = "NDHWGC";
+    prob.BLayout              = "GKZYXC";
+    prob.ELayout              = "NDHWGK";
+    prob.DsLayout             = {"G_K"};
+    prob.DsDataType           = {DataType::Half};
+    prob.CDEElementOp         = "ck::tensor_operation::element_wise::AddRelu";
+
+    auto solutions = prob.GetSolutions("gfx942");
+    EXPECT(solutions.size() == 13u);
+    const auto& s = solutions.back();
+    EXPECT(s.ToTemplateString() ==
+           "ck::tensor_operation::device::DeviceGroupedConvFwdMultipleABD_Xdl_CShuffle<3, "
+           "ck::tensor_layout::convolution::NDHWGC, ck::tensor_layout::convolution::GKZYXC, "
+           "ck::Tuple<ck::tensor_layout::convolution::G_K>, "
+           "ck::tensor_layout::convolution::NDHWGK, ck::half_t, ck::half_t, float, ck::half_t, "
+           "ck::Tuple<ck::half_t>, ck::half_t, ck::tensor_operation::element_wise::PassThrough, "
+           "ck::tensor_operation::element_wise::PassThrough, "
+           "ck::tensor_operation::element_wise::AddRelu, "
+           "ck::tensor_operation::device::ConvolutionForwardSpecialization::Filter1x1Stride1Pad0, "
+           "ck::tensor_operation::device::GemmSpecialization::NKPadding, 1, 64, 32, 64, 32, 8, 8, "
+           "32, 32, 1, 2, ck::Sequence<4, 16, 1>, ck::Sequence<1, 0, 2>, ck::Sequence<1, 0, 2>, "
+           "2, 1, 8, 1, ck::Sequence<4, 16, 1>, ck::Sequence<1, 0, 2>, ck::Sequence<1, 0, 2>, 2, "
+           "1, 8, 1, 1, 1, ck::Sequence<1, 16, 1, 4>, 2>");
+    // C = 3 only allows scalar reads, K = 6 pairs of halves
+    EXPECT(s.GetTemplateParameter<int>("ABlockTransferSrcScalarPerVector") == 1);
+    EXPECT(s.GetTemplateParameter<int>("BBlockTransferSrcScalarPerVector") == 1);
+    EXPECT(s.GetTemplateParameter<int>("CDEBlockTransferScalarPerVector_NPerBlock") == 2);
+}
+
+TEST_CASE(vector_width_follows_data_type)
+{
+    auto prob      = conv2d_3x3();
+    prob.ADataType = DataType::Float;
+    prob.BDataType = DataType::Float;
+    prob.EDataType = DataType::Float;
+    for(const auto& s : prob.GetSolutions("gfx90a"))
+    {
+        EXPECT(s.GetTemplateParameter<int>("ABlockTransferSrcScalarPerVector") == 4);
+        EXPECT(s.GetTemplateParameter<int>("CDEBlockTransferScalarPerVector_NPerBlock") == 4);
+    }
+}
+
+TEST_CASE(unsupported_layout)
+{
+    auto prob    = conv2d_3x3();
+    prob.ALayout = "NGCHW";
+    bool threw   = false;
+    try
+    {
+        prob.GetSolutions("gfx90a");
+    }
+    catch(const std::runtime_error&)
+    {
+        threw = true;
+    }
+    EXPECT(threw);
+}
+
+TEST_CASE(driver_operations)
+{
+    auto ops = Operation_Xdl_CShuffle::CreateOperations();
+    EXPECT(ops.size() == 9u);
+    for(const auto& group : ops)
+        for(const auto& op : group)
+            EXPECT(op.gemm_specialization ==
+                   "ck::tensor_operation::device::GemmSpecialization::MNKPadding");
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
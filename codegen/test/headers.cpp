@@ -0,0 +1,56 @@
+#include "ck/host/device_gemm_multiple_d/problem.hpp"
+#include "ck/host/headers.hpp"
+#include <algorithm>
+#include <filesystem>
+#include <test.hpp>
+
+TEST_CASE(parse_include_directives)
+{
+    auto incs = ck::host::GetIncludeDirectives("#include \"a.hpp\"\n"
+                                               "  #  include <ck/b.hpp> // comment\n"
+                                               "// #include \"commented.hpp\"\n"
+                                               "#define X 1\n"
+                                               "#include_next <c.hpp>\n"
+                                               "#include \"unterminated.hpp\n"
+                                               "#include<d.hpp>");
+    EXPECT(incs.size() == 3u);
+    EXPECT(incs[0].name == "a.hpp");
+    EXPECT(incs[0].quoted);
+    EXPECT(incs[1].name == "ck/b.hpp");
+    EXPECT(not incs[1].quoted);
+    EXPECT(incs[2].name == "d.hpp");
+}
+
+TEST_CASE(pruned_headers_are_closed)
+{
+    ck::host::device_gemm_multiple_d::Problem prob;
+    const auto all     = ck::host::GetHeaders();
+    const auto include = prob.GetIncludeHeader();
+    const auto pruned  = ck::host::GetHeaders({include});
+
+    EXPECT(pruned.count(include) == 1u);
+    EXPECT(pruned.count("ck/config.h") == 1u);
+    EXPECT(pruned.size() < all.size());
+    for(const auto& [name, content] : pruned)
+    {
+        EXPECT(all.at(name) == content);
+        const auto dir = std::filesystem::path{name}.parent_path();
+        for(const auto& inc : ck::host::GetIncludeDirectives(content))
+        {
+            auto local = (dir / inc.name).lexically_normal().generic_string();
+            if(inc.quoted and all.count(local) > 0)
+                EXPECT(pruned.count(local) == 1u);
+            else if(all.count(inc.name) > 0)
+                EXPECT(pruned.count(inc.name) == 1u);
+        }
+    }
+}
+
+TEST_CASE(unknown_root)
+{
+    auto pruned = ck::host::GetHeaders({"does/not/exist.hpp"});
+    EXPECT(pruned.size() == 1u);
+    EXPECT(pruned.count("ck/config.h") == 1u);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
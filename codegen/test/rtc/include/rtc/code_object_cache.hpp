@@ -0,0 +1,96 @@
+#ifndef GUARD_HOST_TEST_RTC_INCLUDE_RTC_CODE_OBJECT_CACHE
+#define GUARD_HOST_TEST_RTC_INCLUDE_RTC_CODE_OBJECT_CACHE
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rtc {
+
+// Incremental 128-bit hash (two independent 64-bit FNV-1a lanes) used to key compiled code
+// objects. Every field is length-prefixed so that ("ab", "c") and ("a", "bc") differ.
+struct content_hash
+{
+    content_hash& add(std::string_view s);
+    content_hash& add(std::uint64_t x);
+    std::string str() const;
+
+    private:
+    void add_bytes(const char* p, std::size_t n);
+    std::uint64_t h0 = 0xcbf29ce484222325ull;
+    std::uint64_t h1 = 0x84222325cbf29ce4ull;
+};
+
+// Persistent, content-addressed store of compiled code objects.
+//
+// Objects live in `path` as <key>.o. Writers publish through a temporary file and an atomic
+// rename, so readers never see partial objects. Misses are compiled under a striped flock
+// (locks/<first two key digits>.lock), so concurrent processes asking for the same key compile
+// it once and the others pick it up from disk. A hit refreshes the mtime of the object, and the
+// directory is trimmed back to `max_bytes` by evicting the least recently used objects.
+//
+// In front of the disk sits an in-process memo holding up to `max_memory_bytes` of objects,
+// also evicted in LRU order.
+struct code_object_cache
+{
+    using object = std::shared_ptr<const std::vector<char>>;
+
+    std::filesystem::path path;
+    std::uintmax_t max_bytes        = std::uintmax_t{1} << 30;
+    std::uintmax_t max_memory_bytes = std::uintmax_t{256} << 20;
+
+    explicit code_object_cache(std::filesystem::path p);
+    code_object_cache(std::filesystem::path p,
+                      std::uintmax_t max_disk_bytes,
+                      std::uintmax_t max_mem_bytes);
+
+    code_object_cache(code_object_cache const&) = delete;
+    code_object_cache& operator=(code_object_cache const&) = delete;
+
+    // Returns the object stored under key, calling compile() and storing its result on a miss.
+    // Exceptions thrown by compile() propagate and nothing is stored.
+    object get_or_compile(const std::string& key,
+                          const std::function<std::vector<char>()>& compile);
+
+    // Disk lookup only; returns nullptr on a miss.
+    object load(const std::string& key);
+    void store(const std::string& key, const std::vector<char>& obj);
+    void evict();
+
+    void clear_memo();
+
+    // Counters of where requests were served from, for diagnostics and tests.
+    std::size_t memo_hits() const;
+    std::size_t disk_hits() const;
+    std::size_t misses() const;
+
+    private:
+    std::filesystem::path object_path(const std::string& key) const;
+    object memo_find(const std::string& key);
+    void memo_insert(const std::string& key, object obj);
+
+    mutable std::mutex mutex;
+    std::list<std::pair<std::string, object>> memo_lru;
+    std::unordered_map<std::string, std::list<std::pair<std::string, object>>::iterator> memo;
+    std::uintmax_t memo_bytes = 0;
+    std::size_t n_memo_hits   = 0;
+    std::size_t n_disk_hits   = 0;
+    std::size_t n_misses      = 0;
+};
+
+// The cache used by compile_kernel. Configured from the environment on first use:
+//   CK_RTC_CACHE_DIR       cache directory (default: <temp dir>/ck-rtc-cache)
+//   CK_RTC_CACHE_MAX_SIZE  disk limit in bytes (default: 1 GiB)
+// Returns nullptr when CK_RTC_DISABLE_CACHE is set to a non-zero value.
+code_object_cache* default_code_object_cache();
+
+} // namespace rtc
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef GUARD_HOST_TEST_RTC_INCLUDE_RTC_COMPILE_KERNEL
 #define GUARD_HOST_TEST_RTC_INCLUDE_RTC_COMPILE_KERNEL
 
+#include <rtc/code_object_cache.hpp>
 #include <rtc/kernel.hpp>
 #include <filesystem>
 #include <string>
@@ -17,8 +18,29 @@ struct compile_options
 {
     std::string flags       = "";
     std::string kernel_name = "main";
+    // Offload arch to compile for; empty means the current device.
+    std::string arch = "";
+    // Compiler command; empty means $CK_RTC_COMPILER, or the ROCm clang when that is unset.
+    std::string compiler = "";
+    // Header among the sources to precompile once and reuse across compiles with the same
+    // headers and flags, typically one including the device op. Only used with a cache, which
+    // also stores the precompiled header.
+    std::string prelude = "";
 };
 
+// Key of the code object built from srcs with options, covering the sources, the flags, the
+// offload arch and the compiler identity (its command and `--version` output).
+std::string compile_key(const std::vector<src_file>& srcs, const compile_options& options);
+
+// Compiles srcs to a code object, looking it up in cache first when cache is not null.
+std::vector<char> compile_object(const std::vector<src_file>& srcs,
+                                 compile_options options,
+                                 code_object_cache* cache);
+
+// Same as above, using default_code_object_cache().
+std::vector<char> compile_object(const std::vector<src_file>& srcs,
+                                 compile_options options = compile_options{});
+
 kernel compile_kernel(const std::vector<src_file>& src,
                       compile_options options = compile_options{});
 
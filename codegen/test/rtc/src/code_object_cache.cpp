@@ -0,0 +1,289 @@
+#include <rtc/code_object_cache.hpp>
+#include <rtc/tmp_dir.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <unistd.h>
+
+namespace rtc {
+
+void content_hash::add_bytes(const char* p, std::size_t n)
+{
+    for(std::size_t i = 0; i < n; i++)
+    {
+        const auto c = static_cast<unsigned char>(p[i]);
+        h0           = (h0 ^ c) * 0x100000001b3ull;
+        h1           = (h1 ^ c) * 0x100000001b3ull;
+        h1 ^= h1 >> 29;
+    }
+}
+
+content_hash& content_hash::add(std::uint64_t x)
+{
+    char bytes[sizeof(x)];
+    for(std::size_t i = 0; i < sizeof(x); i++)
+        bytes[i] = static_cast<char>((x >> (8 * i)) & 0xff);
+    add_bytes(bytes, sizeof(x));
+    return *this;
+}
+
+content_hash& content_hash::add(std::string_view s)
+{
+    add(std::uint64_t{s.size()});
+    add_bytes(s.data(), s.size());
+    return *this;
+}
+
+std::string content_hash::str() const
+{
+    std::stringstream ss;
+    ss << std::hex << std::setfill('0') << std::setw(16) << h0 << std::setw(16) << h1;
+    return ss.str();
+}
+
+struct file_lock
+{
+    explicit file_lock(const std::filesystem::path& p)
+        : fd(::open(p.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0666))
+    {
+        if(fd < 0)
+            throw std::runtime_error("Failed to open lock file: " + p.string());
+        while(::flock(fd, LOCK_EX) != 0)
+        {
+            if(errno != EINTR)
+            {
+                ::close(fd);
+                throw std::runtime_error("Failed to lock: " + p.string());
+            }
+        }
+    }
+
+    file_lock(file_lock const&) = delete;
+    file_lock& operator=(file_lock const&) = delete;
+
+    ~file_lock()
+    {
+        ::flock(fd, LOCK_UN);
+        ::close(fd);
+    }
+
+    private:
+    int fd;
+};
+
+code_object_cache::code_object_cache(std::filesystem::path p) : path(std::move(p))
+{
+    std::filesystem::create_directories(path / "locks");
+}
+
+code_object_cache::code_object_cache(std::filesystem::path p,
+                                     std::uintmax_t max_disk_bytes,
+                                     std::uintmax_t max_mem_bytes)
+    : code_object_cache(std::move(p))
+{
+    max_bytes        = max_disk_bytes;
+    max_memory_bytes = max_mem_bytes;
+}
+
+std::filesystem::path code_object_cache::object_path(const std::string& key) const
+{
+    return path / (key + ".o");
+}
+
+code_object_cache::object code_object_cache::memo_find(const std::string& key)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    auto it = memo.find(key);
+    if(it == memo.end())
+        return nullptr;
+    memo_lru.splice(memo_lru.begin(), memo_lru, it->second);
+    n_memo_hits++;
+    return it->second->second;
+}
+
+void code_object_cache::memo_insert(const std::string& key, object obj)
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    if(memo.count(key) > 0 or obj->size() > max_memory_bytes)
+        return;
+    memo_lru.emplace_front(key, obj);
+    memo[key] = memo_lru.begin();
+    memo_bytes += obj->size();
+    while(memo_bytes > max_memory_bytes)
+    {
+        memo_bytes -= memo_lru.back().second->size();
+        memo.erase(memo_lru.back().first);
+        memo_lru.pop_back();
+    }
+}
+
+void code_object_cache::clear_memo()
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    memo.clear();
+    memo_lru.clear();
+    memo_bytes = 0;
+}
+
+code_object_cache::object code_object_cache::load(const std::string& key)
+{
+    auto p = object_path(key);
+    std::ifstream is(p, std::ios::binary | std::ios::ate);
+    if(not is)
+        return nullptr;
+    auto n = is.tellg();
+    if(n <= 0)
+        return nullptr;
+    auto obj = std::make_shared<std::vector<char>>(static_cast<std::size_t>(n));
+    is.seekg(0, std::ios::beg);
+    if(not is.read(obj->data(), n))
+        return nullptr;
+    // Refresh the LRU timestamp. The object may have been evicted concurrently, which is fine
+    // since we already hold its contents.
+    std::error_code ec;
+    std::filesystem::last_write_time(p, std::filesystem::file_time_type::clock::now(), ec);
+    return obj;
+}
+
+void code_object_cache::store(const std::string& key, const std::vector<char>& obj)
+{
+    auto tmp = path / (unique_string("tmp") + ".part");
+    {
+        std::ofstream os(tmp, std::ios::binary);
+        os.write(obj.data(), obj.size());
+        if(not os)
+        {
+            std::error_code ec;
+            std::filesystem::remove(tmp, ec);
+            throw std::runtime_error("Failed to write code object: " + tmp.string());
+        }
+    }
+    std::filesystem::rename(tmp, object_path(key));
+}
+
+void code_object_cache::evict()
+{
+    file_lock lock{path / "locks" / "evict.lock"};
+
+    struct entry
+    {
+        std::filesystem::file_time_type time;
+        std::uintmax_t size;
+        std::filesystem::path path;
+    };
+    std::vector<entry> entries;
+    std::uintmax_t total = 0;
+    std::error_code ec;
+    for(const auto& f : std::filesystem::directory_iterator(path, ec))
+    {
+        if(f.path().extension() != ".o")
+            continue;
+        auto size = f.file_size(ec);
+        if(ec)
+            continue;
+        auto time = f.last_write_time(ec);
+        if(ec)
+            continue;
+        entries.push_back({time, size, f.path()});
+        total += size;
+    }
+    if(total <= max_bytes)
+        return;
+
+    std::sort(entries.begin(), entries.end(), [](const entry& x, const entry& y) {
+        return x.time < y.time;
+    });
+    for(const auto& e : entries)
+    {
+        if(total <= max_bytes)
+            break;
+        if(std::filesystem::remove(e.path, ec))
+            total -= e.size;
+    }
+}
+
+code_object_cache::object
+code_object_cache::get_or_compile(const std::string& key,
+                                  const std::function<std::vector<char>()>& compile)
+{
+    if(auto obj = memo_find(key))
+        return obj;
+
+    auto disk_hit = [&](object obj) {
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            n_disk_hits++;
+        }
+        memo_insert(key, obj);
+        return obj;
+    };
+
+    if(auto obj = load(key))
+        return disk_hit(obj);
+
+    object result;
+    {
+        // Whoever takes the stripe first compiles; the others find the object once it is done.
+        file_lock lock{path / "locks" / (key.substr(0, 2) + ".lock")};
+        if(auto obj = load(key))
+            return disk_hit(obj);
+        {
+            std::lock_guard<std::mutex> guard(mutex);
+            n_misses++;
+        }
+        result = std::make_shared<const std::vector<char>>(compile());
+        store(key, *result);
+    }
+    memo_insert(key, result);
+    evict();
+    return result;
+}
+
+std::size_t code_object_cache::memo_hits() const
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    return n_memo_hits;
+}
+
+std::size_t code_object_cache::disk_hits() const
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    return n_disk_hits;
+}
+
+std::size_t code_object_cache::misses() const
+{
+    std::lock_guard<std::mutex> guard(mutex);
+    return n_misses;
+}
+
+static bool enabled(const char* name)
+{
+    const char* v = std::getenv(name);
+    return v != nullptr and std::string{v} != "" and std::string{v} != "0";
+}
+
+code_object_cache* default_code_object_cache()
+{
+    static std::unique_ptr<code_object_cache> cache = []() -> std::unique_ptr<code_object_cache> {
+        if(enabled("CK_RTC_DISABLE_CACHE"))
+            return nullptr;
+        const char* dir = std::getenv("CK_RTC_CACHE_DIR");
+        auto result     = std::make_unique<code_object_cache>(
+            dir != nullptr and *dir != '\0'
+                    ? std::filesystem::path{dir}
+                    : std::filesystem::temp_directory_path() / "ck-rtc-cache");
+        if(const char* size = std::getenv("CK_RTC_CACHE_MAX_SIZE"))
+            result->max_bytes = std::stoull(size);
+        return result;
+    }();
+    return cache.get();
+}
+
+} // namespace rtc
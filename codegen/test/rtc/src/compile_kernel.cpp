@@ -4,7 +4,13 @@
 #include <stdexcept>
 #include <iostream>
 #include <fstream>
+#include <array>
 #include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <unordered_map>
 
 namespace rtc {
 
@@ -55,40 +61,190 @@ void write_string(const std::string& filename, const std::string_view& buffer)
     write_buffer(filename, buffer.data(), buffer.size());
 }
 
-std::string compiler() { return "/opt/rocm/llvm/bin/clang++ -x hip --cuda-device-only"; }
+std::string compiler()
+{
+    const char* cc = std::getenv("CK_RTC_COMPILER");
+    if(cc != nullptr and *cc != '\0')
+        return cc;
+    return "/opt/rocm/llvm/bin/clang++ -x hip --cuda-device-only";
+}
 
-kernel compile_kernel(const std::vector<src_file>& srcs, compile_options options)
+// The command with the modification time and size of its executable, so that a compiler replaced
+// in place is queried again
+static std::string compiler_stamp(const std::string& cc)
 {
-    assert(not srcs.empty());
-    tmp_dir td{"compile"};
-    options.flags += " -I. -O3";
-    options.flags += " -std=c++17";
-    options.flags += " --offload-arch=" + get_device_name();
-    std::string out;
+    std::error_code ec;
+    std::filesystem::path exe = cc.substr(0, cc.find(' '));
+    auto time                 = std::filesystem::last_write_time(exe, ec);
+    if(ec)
+        return cc;
+    auto size = std::filesystem::file_size(exe, ec);
+    return cc + '\n' + std::to_string(time.time_since_epoch().count()) + '\n' +
+           std::to_string(ec ? 0 : size);
+}
+
+std::string compiler_version(const std::string& cc)
+{
+    static std::mutex m;
+    static std::unordered_map<std::string, std::string> versions;
+    const auto stamp = compiler_stamp(cc);
+    std::lock_guard<std::mutex> guard(m);
+    auto it = versions.find(stamp);
+    if(it != versions.end())
+        return it->second;
+
+    std::string version;
+    if(FILE* pipe = popen((cc + " --version 2>&1").c_str(), "r"))
+    {
+        std::array<char, 256> buf;
+        while(std::fgets(buf.data(), buf.size(), pipe) != nullptr)
+            version += buf.data();
+        pclose(pipe);
+    }
+    return versions.emplace(stamp, version).first->second;
+}
+
+static void resolve(compile_options& options)
+{
+    if(options.compiler.empty())
+        options.compiler = compiler();
+    if(options.arch.empty())
+        options.arch = get_device_name();
+}
 
+static bool is_source(const src_file& src) { return src.path.extension().string() == ".cpp"; }
+
+static std::string
+hash_inputs(const std::vector<src_file>& srcs, compile_options options, bool headers_only)
+{
+    resolve(options);
+
+    content_hash h;
+    h.add(headers_only ? "prelude" : "object");
+    h.add(options.compiler).add(compiler_version(options.compiler));
+    h.add(options.arch).add(options.flags).add(options.prelude);
+    for(const auto& src : srcs)
+    {
+        if(headers_only and is_source(src))
+            continue;
+        h.add(src.path.generic_string()).add(src.content);
+    }
+    return h.str();
+}
+
+std::string compile_key(const std::vector<src_file>& srcs, const compile_options& options)
+{
+    return hash_inputs(srcs, options, false);
+}
+
+static std::string common_flags(const compile_options& options)
+{
+    return " " + options.flags + " -I. -O3 -std=c++17 --offload-arch=" + options.arch;
+}
+
+static void write_sources(const tmp_dir& td, const std::vector<src_file>& srcs, bool headers_only)
+{
     for(const auto& src : srcs)
     {
+        if(headers_only and is_source(src))
+            continue;
         std::filesystem::path full_path   = td.path / src.path;
         std::filesystem::path parent_path = full_path.parent_path();
         std::filesystem::create_directories(parent_path);
         write_string(full_path.string(), src.content);
-        if(src.path.extension().string() == ".cpp")
+    }
+}
+
+// Serializes the AST of options.prelude, parsed with the same flags as the kernel sources.
+static std::vector<char> compile_prelude(const std::vector<src_file>& srcs,
+                                         const compile_options& options)
+{
+    tmp_dir td{"prelude"};
+    write_sources(td, srcs, true);
+    td.execute(options.compiler + common_flags(options) +
+               " -fsyntax-only -Xclang -emit-pch -Xclang -o -Xclang prelude.pch " +
+               options.prelude);
+
+    auto out_path = td.path / "prelude.pch";
+    if(not std::filesystem::exists(out_path))
+        throw std::runtime_error("Failed to precompile prelude: " + options.prelude);
+    return read_buffer(out_path.string());
+}
+
+static std::vector<char> compile_uncached(const std::vector<src_file>& srcs,
+                                          const compile_options& options,
+                                          const std::vector<char>* pch = nullptr)
+{
+    assert(not srcs.empty());
+    tmp_dir td{"compile"};
+    auto flags = common_flags(options);
+    std::string out;
+
+    write_sources(td, srcs, false);
+    for(const auto& src : srcs)
+    {
+        if(is_source(src))
         {
-            options.flags += " -c " + src.path.filename().string();
+            flags += " -c " + src.path.filename().string();
             if(out.empty())
                 out = src.path.stem().string() + ".o";
         }
     }
 
-    options.flags += " -o " + out;
-    td.execute(compiler() + options.flags);
+    if(pch != nullptr)
+    {
+        write_buffer((td.path / "prelude.pch").string(), *pch);
+        // The headers are rewritten into a fresh directory for every compile, so their
+        // timestamps never match the ones recorded in the PCH.
+        flags += " -Xclang -include-pch -Xclang prelude.pch -Xclang -fno-validate-pch";
+    }
+
+    flags += " -o " + out;
+    td.execute(options.compiler + flags);
 
     auto out_path = td.path / out;
     if(not std::filesystem::exists(out_path))
         throw std::runtime_error("Output file missing: " + out);
 
-    auto obj = read_buffer(out_path.string());
+    return read_buffer(out_path.string());
+}
 
+std::vector<char> compile_object(const std::vector<src_file>& srcs,
+                                 compile_options options,
+                                 code_object_cache* cache)
+{
+    resolve(options);
+    if(cache == nullptr)
+        return compile_uncached(srcs, options);
+    auto obj = cache->get_or_compile(compile_key(srcs, options), [&] {
+        if(options.prelude.empty())
+            return compile_uncached(srcs, options);
+        code_object_cache::object pch;
+        try
+        {
+            // The prefix keeps the PCH off the lock stripes of code objects (whose keys are hex),
+            // one of which is held while we are here.
+            pch = cache->get_or_compile("pch-" + hash_inputs(srcs, options, true),
+                                        [&] { return compile_prelude(srcs, options); });
+        }
+        catch(const std::runtime_error&)
+        {
+            // Not every compiler can precompile the prelude; compile it from source instead.
+            return compile_uncached(srcs, options);
+        }
+        return compile_uncached(srcs, options, pch.get());
+    });
+    return *obj;
+}
+
+std::vector<char> compile_object(const std::vector<src_file>& srcs, compile_options options)
+{
+    return compile_object(srcs, std::move(options), default_code_object_cache());
+}
+
+kernel compile_kernel(const std::vector<src_file>& srcs, compile_options options)
+{
+    auto obj = compile_object(srcs, options);
     return kernel{obj.data(), options.kernel_name};
 }
 
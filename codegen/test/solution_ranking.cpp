@@ -0,0 +1,111 @@
+#include "ck/host/device_gemm_multiple_d/problem.hpp"
+#include "ck/host/device_grouped_conv_fwd_multiple_abd/problem.hpp"
+#include "ck/host/operation/cost_model.hpp"
+#include <test.hpp>
+
+using ck::host::DataType;
+using ck::host::operation::EstimateGemmCost;
+using ck::host::operation::HardwareModel;
+using ck::host::operation::TileDesc;
+
+ck::host::device_gemm_multiple_d::Problem gemm(std::size_t m, std::size_t n, std::size_t k)
+{
+    ck::host::device_gemm_multiple_d::Problem prob;
+    prob.M = m;
+    prob.N = n;
+    prob.K = k;
+    return prob;
+}
+
+TEST_CASE(ranked_solutions_are_sorted)
+{
+    auto prob   = gemm(4096, 4096, 4096);
+    auto ranked = prob.GetRankedSolutions("gfx90a", 3);
+    EXPECT(ranked.size() == 3u);
+    for(std::size_t i = 0; i < ranked.size(); i++)
+    {
+        EXPECT(ranked[i].cost.valid);
+        EXPECT(ranked[i].cost.score > 0);
+        EXPECT(ranked[i].cost.score <= 1);
+        if(i > 0)
+            EXPECT(ranked[i - 1].cost.score >= ranked[i].cost.score);
+    }
+    EXPECT(prob.GetRankedSolutions("gfx90a").size() == prob.GetSolutions("gfx90a").size());
+    EXPECT(prob.GetRankedSolutions("gfx1100").empty());
+    // Large square problems are best served by the largest tiles
+    EXPECT(ranked.front().solution.GetTemplateParameter<int>("MPerBlock") *
+               ranked.front().solution.GetTemplateParameter<int>("NPerBlock") ==
+           256 * 128);
+}
+
+TEST_CASE(small_problems_prefer_small_tiles)
+{
+    // A single 256 x 128 tile would leave all but one CU idle
+    auto best = gemm(256, 256, 8192).GetRankedSolutions("gfx90a", 1);
+    EXPECT(best.size() == 1u);
+    EXPECT(best.front().solution.GetTemplateParameter<int>("MPerBlock") *
+               best.front().solution.GetTemplateParameter<int>("NPerBlock") ==
+           128 * 64);
+}
+
+TEST_CASE(quantization_waste)
+{
+    // M = 384 wastes a quarter of a 256-row tile but fits 128-row tiles exactly
+    HardwareModel hw;
+    hw.num_cu = 4;
+    TileDesc t256{256, 256, 128, 32, 8, 8, 32, 32, 4, 2, 1};
+    TileDesc t128{256, 128, 256, 32, 8, 8, 32, 32, 2, 4, 1};
+    auto c256 = EstimateGemmCost(t256, 1, 384, 4096, 4096, DataType::Half, {}, hw);
+    auto c128 = EstimateGemmCost(t128, 1, 384, 4096, 4096, DataType::Half, {}, hw);
+    EXPECT(c256.tile_efficiency < 0.8);
+    EXPECT(c128.tile_efficiency == 1.0);
+    EXPECT(c128.score > c256.score);
+}
+
+TEST_CASE(vector_width_legality)
+{
+    // Row-major A is read 8 halves at a time along K
+    EXPECT(gemm(1024, 1024, 1020).GetRankedSolutions("gfx90a").empty());
+    auto prob   = gemm(1024, 1024, 1020);
+    prob.TransA = true;
+    EXPECT(not prob.GetRankedSolutions("gfx90a").empty());
+
+    TileDesc tile{256, 128, 128, 32, 8, 8, 32, 32, 2, 2, 1};
+    auto hw   = HardwareModel::FromArch("gfx90a");
+    auto cost = EstimateGemmCost(tile, 1, 128, 128, 128, DataType::Half, {{4, 6}}, hw);
+    EXPECT(not cost.valid);
+    EXPECT(cost.reason == "vector width 4 does not divide 6");
+}
+
+TEST_CASE(register_and_lds_budget)
+{
+    auto hw = HardwareModel::FromArch("gfx90a");
+    TileDesc huge{64, 256, 256, 64, 8, 8, 32, 32, 4, 4, 1};
+    auto cost = EstimateGemmCost(huge, 1, 4096, 4096, 4096, DataType::Half, {}, hw);
+    EXPECT(not cost.valid);
+
+    TileDesc tile{256, 256, 128, 32, 8, 8, 32, 32, 4, 2, 1};
+    cost = EstimateGemmCost(tile, 1, 4096, 4096, 4096, DataType::Half, {}, hw);
+    EXPECT(cost.valid);
+    EXPECT(cost.lds_bytes == (256u + 128u) * 32u * 2u);
+    EXPECT(cost.occupancy >= 1u);
+}
+
+TEST_CASE(ranked_conv_solutions)
+{
+    ck::host::device_grouped_conv_fwd_multiple_abd::Problem prob;
+    prob.G                    = 32;
+    prob.N                    = 1;
+    prob.C                    = 32;
+    prob.K                    = 32;
+    prob.InputSpatialLengths  = {14, 14};
+    prob.FilterSpatialLengths = {3, 3};
+    prob.InLeftPads           = {1, 1};
+    prob.InRightPads          = {1, 1};
+    auto ranked               = prob.GetRankedSolutions("gfx942", 2);
+    EXPECT(ranked.size() == 2u);
+    // K = 32 per group: wider N tiles mostly compute padding
+    EXPECT(ranked.front().solution.GetTemplateParameter<int>("NPerBlock") == 32);
+}
+
+int main(int argc, const char* argv[]) { test::run(argc, argv); }
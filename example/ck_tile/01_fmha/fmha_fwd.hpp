@@ -267,4 +267,9 @@ struct fmha_fwd_traits
     bool do_fp8_static_quant;
     // TODO: padding check is inside this api
 };
+
+using fmha_fwd_kernel_launcher = float (*)(const ck_tile::stream_config&, fmha_fwd_args);
+
+// the kernel fmha_fwd() launches for these traits and arguments, or nullptr if none supports them
+fmha_fwd_kernel_launcher fmha_fwd_dispatch(const fmha_fwd_traits&, const fmha_fwd_args&);
 float fmha_fwd(fmha_fwd_traits, fmha_fwd_args, const ck_tile::stream_config&);
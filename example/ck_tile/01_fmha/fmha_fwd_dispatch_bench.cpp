@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+// Measures the host latency of selecting a kernel in fmha_fwd(), without launching it.
+
+#include "fmha_fwd.hpp"
+#include "ck_tile/host.hpp"
+#include "mask.hpp"
+#include "bias.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+auto create_args(int argc, char* argv[])
+{
+    ck_tile::ArgParser arg_parser;
+    arg_parser.insert("prec", "all", "data type. fp16/bf16/fp8, or all")
+        .insert("d", "0", "head dim for q, k, v. 0 means a mix of 64/80/128/256")
+        .insert("repeat", "1000", "number of passes over all the problems");
+
+    bool result = arg_parser.parse(argc, argv);
+    return std::make_tuple(result, arg_parser);
+}
+
+int main(int argc, char* argv[])
+{
+    auto [result, arg_parser] = create_args(argc, argv);
+    if(!result)
+        return -1;
+
+    const std::string prec = arg_parser.get_str("prec");
+    const int d            = arg_parser.get_int("d");
+    const int repeat       = arg_parser.get_int("repeat");
+
+    const std::vector<std::string> data_types =
+        prec == "all" ? std::vector<std::string>{"fp16", "bf16", "fp8"}
+                      : std::vector<std::string>{prec};
+    const std::vector<int> hdims = d == 0 ? std::vector<int>{64, 80, 128, 256} : std::vector<int>{d};
+    const std::vector<int> seqlens{128, 1000, 4096};
+
+    // every combination of traits fmha_fwd() dispatches on, with padded and unpadded lengths
+    std::vector<std::pair<fmha_fwd_traits, fmha_fwd_args>> problems;
+    for(const auto& data_type : data_types)
+        for(int hdim : hdims)
+            for(bool group : {false, true})
+                for(bool v_rowmajor : {true, false})
+                    for(auto mask : {mask_enum::no_mask, mask_enum::mask_top_left})
+                        for(auto bias : {bias_enum::no_bias, bias_enum::alibi})
+                            for(bool lse : {false, true})
+                                for(int seqlen : seqlens)
+                                {
+                                    const bool squant = data_type == "fp8";
+                                    fmha_fwd_traits t{hdim,
+                                                      hdim,
+                                                      data_type,
+                                                      group,
+                                                      v_rowmajor,
+                                                      mask,
+                                                      bias,
+                                                      lse && !squant,
+                                                      squant};
+                                    fmha_fwd_args a{};
+                                    a.seqlen_q = seqlen;
+                                    a.seqlen_k = seqlen;
+                                    a.hdim_q   = hdim;
+                                    a.hdim_v   = hdim;
+                                    problems.emplace_back(t, a);
+                                }
+
+    std::size_t supported = 0;
+    for(const auto& [t, a] : problems)
+        supported += fmha_fwd_dispatch(t, a) != nullptr ? 1 : 0;
+
+    // keep the result observable so the lookups are not optimized away
+    std::size_t checksum = 0;
+    const auto start     = std::chrono::steady_clock::now();
+    for(int r = 0; r < repeat; ++r)
+        for(const auto& [t, a] : problems)
+            checksum += reinterpret_cast<std::size_t>(fmha_fwd_dispatch(t, a));
+    const auto stop = std::chrono::steady_clock::now();
+
+    const double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+    const double dispatches = static_cast<double>(problems.size()) * repeat;
+
+    std::cout << "problems: " << problems.size() << ", supported: " << supported
+              << ", dispatches: " << static_cast<std::size_t>(dispatches) << std::fixed
+              << std::setprecision(1) << ", " << ns / dispatches << " ns/dispatch"
+              << " (checksum " << (checksum & 0xffff) << ")" << std::endl;
+    return 0;
+}
@@ -3,7 +3,11 @@
 # generate kernel instances to speed up compilation
 
 import argparse
+import hashlib
 import itertools
+import json
+import os
+from concurrent.futures import ThreadPoolExecutor
 from pathlib import Path
 from typing import List, Optional, Tuple
 from dataclasses import dataclass
@@ -164,39 +168,144 @@ float fmha_fwd_<trait_{F_idx}>(const ck_tile::stream_config& s, fmha_fwd_args a)
 """
 
 FMHA_FWD_API_FILENAME="fmha_fwd_api.cpp"
+# fmha_fwd() looks up the candidate kernels in a table indexed by the enum-encoded traits,
+# then returns the first of them whose residual padding predicate accepts the arguments.
+# The candidates of one key only differ in padding, and are tried in get_pipelines() order.
 FMHA_FWD_API="""
-float fmha_fwd(fmha_fwd_traits t, fmha_fwd_args a, const ck_tile::stream_config& s){{
-    float r = -1;
-{F_dispatch}
-    return r;
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace {{
+
+struct fmha_fwd_candidate_
+{{
+    bool (*check)(const fmha_fwd_args&);
+    fmha_fwd_kernel_launcher launch;
+}};
+
+struct fmha_fwd_key_range_
+{{
+    std::uint32_t key;
+    std::uint16_t begin;
+    std::uint16_t end;
+}};
+
+// clang-format off
+{F_checks}
+constexpr fmha_fwd_candidate_ fmha_fwd_candidates[] = {{
+{F_candidates}
+}};
+
+// sorted by key
+constexpr fmha_fwd_key_range_ fmha_fwd_key_ranges[] = {{
+{F_key_ranges}
+}};
+
+// hdim buckets of every data type, tried in order, 0 terminated
+constexpr int fmha_fwd_hdims[{F_num_dtypes}][{F_max_hdims}] = {{
+{F_hdims}
+}};
+// clang-format on
+
+constexpr std::uint32_t fmha_fwd_num_keys = {F_num_keys};
+
+// dense key -> candidate range table, {{0, 0}} for keys without kernels
+constexpr auto fmha_fwd_table = [] {{
+    std::array<fmha_fwd_key_range_, fmha_fwd_num_keys> table{{}};
+    for(const auto& r : fmha_fwd_key_ranges)
+        table[r.key] = r;
+    return table;
+}}();
+
+// switch on the length, then compare fixed-size byte strings which the compiler inlines
+int fmha_fwd_dtype_id(const std::string& data_type)
+{{
+    switch(data_type.size())
+    {{
+{F_dtype_ids}
+    default: break;
+    }}
+    return -1;
 }}
-"""
 
-FMHA_FWD_API_PER_DTYPE="""    {F_if}(t.data_type.compare(\"{F_dtype}\") == 0){{
-{F_hdim_case}
+int fmha_fwd_mask_id(mask_enum mask_type)
+{{
+    switch(mask_type)
+    {{
+{F_mask_ids}
     }}
+    return -1;
+}}
+
+int fmha_fwd_bias_id(bias_enum bias_type)
+{{
+    switch(bias_type)
+    {{
+{F_bias_ids}
+    }}
+    return -1;
+}}
+
+}} // namespace
+
+fmha_fwd_kernel_launcher fmha_fwd_dispatch(const fmha_fwd_traits& t, const fmha_fwd_args& a)
+{{
+    const int dtype = fmha_fwd_dtype_id(t.data_type);
+    const int mask  = fmha_fwd_mask_id(t.mask_type);
+    const int bias  = fmha_fwd_bias_id(t.bias_type);
+    if(dtype < 0 || mask < 0 || bias < 0)
+        return nullptr;
+
+    int hdim = 0;
+    while(hdim < {F_max_hdims} && fmha_fwd_hdims[dtype][hdim] != 0 &&
+          !(t.hdim_q <= fmha_fwd_hdims[dtype][hdim] && t.hdim_v <= fmha_fwd_hdims[dtype][hdim]))
+        ++hdim;
+    if(hdim == {F_max_hdims} || fmha_fwd_hdims[dtype][hdim] == 0)
+        return nullptr;
+
+{F_key}
+    const auto& range = fmha_fwd_table[key];
+    for(auto i = range.begin; i < range.end; ++i)
+    {{
+        if(fmha_fwd_candidates[i].check(a))
+            return fmha_fwd_candidates[i].launch;
+    }}
+    return nullptr;
+}}
+
+float fmha_fwd(fmha_fwd_traits t, fmha_fwd_args a, const ck_tile::stream_config& s){{
+    const auto launch = fmha_fwd_dispatch(t, a);
+    return launch == nullptr ? -1 : launch(s, a);
+}}
 """
-FMHA_FWD_API_PER_HDIM_CASE="""        {F_if} (t.hdim_q <= {F_hdim} && t.hdim_v <= {F_hdim}) {{
-{F_inner_dispatch}
-        }}
-"""
-MASK_CHECK_MAP = {
-    "no" : "t.mask_type == mask_enum::no_mask",
-    "causal" : "t.mask_type == mask_enum::mask_top_left || t.mask_type == mask_enum::mask_bottom_right",
-    "generic" : "t.mask_type == mask_enum::window_generic",
+
+FMHA_FWD_API_EMPTY="""
+fmha_fwd_kernel_launcher fmha_fwd_dispatch(const fmha_fwd_traits&, const fmha_fwd_args&)
+{
+    return nullptr;
 }
 
-MASK_SIMPLIFIED_CHECK_MAP = {
-    "s_no" : "t.mask_type == mask_enum::no_mask",
-    "s_mask" : "t.mask_type != mask_enum::no_mask",
+float fmha_fwd(fmha_fwd_traits, fmha_fwd_args, const ck_tile::stream_config&){
+    return -1;
 }
+"""
 
-FMHA_FWD_API_INNER_DISPATCH="""            {F_if}((t.is_group_mode == {F_mode}) && (t.is_v_rowmajor == {F_vlayout}) && ({F_mask_check}) && (t.bias_type == {F_bias_check}) && (t.has_lse == {F_lse}) && (t.do_fp8_static_quant == {F_squant}) &&
-                        ({F_scheck}) && ({F_skcheck}) && ({F_dcheck}) && ({F_dvcheck})) {{
-                using trait_ = fmha_fwd_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_bm0}, {F_bn0}, {F_bk0}, {F_bn1}, {F_bk1}, {F_bk0blen}, {F_vlayout}, {F_pipeline_enum}, {F_mask}, {F_bias}, {F_lse}, {F_squant}, {F_spad}, {F_skpad}, {F_dpad}, {F_dvpad}>;
-                return fmha_fwd_<trait_>(s, a);
-            }}
+FMHA_FWD_API_CHECK="""bool fmha_fwd_check_{F_idx}(const fmha_fwd_args&{F_arg}) {{ return {F_predicate}; }}
 """
+FMHA_FWD_API_CANDIDATE="""    {{fmha_fwd_check_{F_check}, fmha_fwd_<fmha_fwd_traits_<{F_hdim}, {F_dtype}, {F_mode}, {F_bm0}, {F_bn0}, {F_bk0}, {F_bn1}, {F_bk1}, {F_bk0blen}, {F_vlayout}, {F_pipeline_enum}, {F_mask}, {F_bias}, {F_lse}, {F_squant}, {F_spad}, {F_skpad}, {F_dpad}, {F_dvpad}>>}},"""
+
+# mask_enum values accepted by every mask trait, in the order of get_mask_map()
+MASK_ENUM_MAP = {
+    "no" : ["mask_enum::no_mask"],
+    "causal" : ["mask_enum::mask_top_left", "mask_enum::mask_bottom_right"],
+    "generic" : ["mask_enum::window_generic"],
+}
+
+MASK_SIMPLIFIED_ENUM_MAP = {
+    "s_no" : ["mask_enum::no_mask"],
+    "s_mask" : ["mask_enum::mask_top_left", "mask_enum::mask_bottom_right", "mask_enum::window_generic"],
+}
 
 def get_mask_map(mask : str):
     if mask == "generic":
@@ -207,11 +316,11 @@ def get_mask_map(mask : str):
         assert False
         return None
 
-def get_mask_check_map(mask : str):
+def get_mask_enum_map(mask : str):
     if mask == "generic":
-        return MASK_CHECK_MAP
+        return MASK_ENUM_MAP
     elif mask == "simplified":
-        return MASK_SIMPLIFIED_CHECK_MAP
+        return MASK_SIMPLIFIED_ENUM_MAP
     else:
         assert False
         return None
@@ -338,29 +447,102 @@ class FmhaFwdApiPool:
 
         self.pool[trait.dtype][trait.hdim].append(copy.copy(trait))
 
+    # radix of every field of the dispatch key, from the most significant
+    def key_fields(self) -> List[Tuple[str, int]]:
+        return [('dtype', len(self.pool)),
+                ('hdim', max(len(hdims) for hdims in self.pool.values())),
+                ('mode', len(MODE_MAP)),
+                ('vlayout', len(LAYOUT_MAP)),
+                ('mask', len(get_mask_map(self.mask_impl))),
+                ('bias', len(BIAS_MAP)),
+                ('lse', len(BOOL_MAP)),
+                ('squant', len(BOOL_MAP))]
+
+    def key(self, dtype_id : int, hdim_id : int, trait : FmhaFwdApiTrait) -> int:
+        digits = {'dtype'   : dtype_id,
+                  'hdim'    : hdim_id,
+                  'mode'    : list(MODE_MAP.keys()).index(trait.mode),
+                  'vlayout' : [LAYOUT_MAP[l] for l in LAYOUT_MAP.keys()].index(LAYOUT_MAP[trait.vlayout]),
+                  'mask'    : list(get_mask_map(self.mask_impl).keys()).index(trait.mask),
+                  'bias'    : list(BIAS_CHECK_MAP.keys()).index(trait.bias),
+                  'lse'     : list(BOOL_MAP.keys()).index(trait.lse),
+                  'squant'  : list(BOOL_MAP.keys()).index(trait.squant)}
+        key = 0
+        for name, radix in self.key_fields():
+            assert digits[name] < radix
+            key = key * radix + digits[name]
+        return key
+
+    # C++ expression of the key, with the digits encoded the same way as key()
+    def key_expr(self) -> str:
+        digits = {'dtype'   : 'dtype',
+                  'hdim'    : 'hdim',
+                  'mode'    : '(t.is_group_mode ? {} : {})'.format(*[list(MODE_MAP.values()).index(v) for v in ['true', 'false']]),
+                  'vlayout' : '(t.is_v_rowmajor ? {} : {})'.format(*[list(LAYOUT_MAP.values()).index(v) for v in ['true', 'false']]),
+                  'mask'    : 'mask',
+                  'bias'    : 'bias',
+                  'lse'     : '(t.has_lse ? {} : {})'.format(*[list(BOOL_MAP.values()).index(v) for v in ['true', 'false']]),
+                  'squant'  : '(t.do_fp8_static_quant ? {} : {})'.format(*[list(BOOL_MAP.values()).index(v) for v in ['true', 'false']])}
+        expr = ''
+        for name, radix in self.key_fields():
+            expr = digits[name] if expr == '' else f'({expr}) * {radix} + {digits[name]}'
+        return f'    const std::uint32_t key = static_cast<std::uint32_t>({expr});'
+
     @property
     def api(self) -> str:
-        per_dtypes=str()
+        if not self.pool:
+            return FMHA_FWD_KERNEL_HEADER + FMHA_FWD_API_EMPTY
+        # candidates of the same key, in registration order
+        per_key = dict()
         for i, dtype in enumerate(self.pool.keys()):
-            per_hdim_case=str()
             for j, hdim in enumerate(self.pool[dtype].keys()):
-                traits=self.pool[dtype][hdim]
-                inners=str()
-                for k, trait in enumerate(traits):
-                    if_k = 'if' if k == 0 else 'else if'
-                    inners = inners + FMHA_FWD_API_INNER_DISPATCH.format(F_if=if_k, F_mode=MODE_MAP[trait.mode], F_vlayout=LAYOUT_MAP[trait.vlayout],
+                for trait in self.pool[dtype][hdim]:
+                    per_key.setdefault(self.key(i, j, trait), list()).append((hdim, dtype, trait))
+
+        checks = dict()
+        candidates = list()
+        key_ranges = list()
+        for key in sorted(per_key.keys()):
+            begin = len(candidates)
+            for hdim, dtype, trait in per_key[key]:
+                # padding predicates which always hold are folded away
+                terms = [c for c in [trait.scheck, trait.skcheck, trait.dcheck, trait.dvcheck] if not c.startswith('true')]
+                predicate = ' && '.join(f'({c})' for c in terms) if terms else 'true'
+                check = checks.setdefault(predicate, len(checks))
+                candidates.append(FMHA_FWD_API_CANDIDATE.format(F_check=check, F_mode=MODE_MAP[trait.mode], F_vlayout=LAYOUT_MAP[trait.vlayout],
                                    F_pipeline_enum=PIPELINE_ENUM_MAP[trait.pipeline_tag], F_mask=get_mask_map(self.mask_impl)[trait.mask],
-                                   F_mask_check=get_mask_check_map(self.mask_impl)[trait.mask], F_bias_check=BIAS_CHECK_MAP[trait.bias], F_bias=BIAS_MAP[trait.bias],
-                                   F_lse=BOOL_MAP[trait.lse],
-                                   F_squant=BOOL_MAP[trait.squant], F_scheck=trait.scheck, F_skcheck=trait.skcheck, F_dcheck=trait.dcheck, F_dvcheck=trait.dvcheck,
+                                   F_bias=BIAS_MAP[trait.bias], F_lse=BOOL_MAP[trait.lse], F_squant=BOOL_MAP[trait.squant],
                                    F_spad=BOOL_MAP[trait.spad], F_skpad=BOOL_MAP[trait.skpad], F_dpad=BOOL_MAP[trait.dpad], F_dvpad=BOOL_MAP[trait.dvpad],
                                    F_bm0=trait.bm0, F_bn0=trait.bn0, F_bk0=trait.bk0, F_bn1=trait.bn1, F_bk1=trait.bk1, F_bk0blen=trait.bk0blen,
-                                   F_hdim=hdim, F_dtype=DTYPE_MAP[dtype])
-                if_j = 'if' if j == 0 else 'else if'
-                per_hdim_case = per_hdim_case + FMHA_FWD_API_PER_HDIM_CASE.format(F_if=if_j, F_hdim=hdim, F_inner_dispatch=inners)
-            if_i = 'if' if i == 0 else 'else if'
-            per_dtypes = per_dtypes + FMHA_FWD_API_PER_DTYPE.format(F_if=if_i, F_dtype=dtype, F_hdim_case=per_hdim_case)
-        return FMHA_FWD_KERNEL_HEADER + FMHA_FWD_API.format(F_dispatch = per_dtypes)
+                                   F_hdim=hdim, F_dtype=DTYPE_MAP[dtype]))
+            key_ranges.append(f'    {{{key}, {begin}, {len(candidates)}}},')
+        assert len(candidates) < 2**16
+
+        check_defs = str()
+        for predicate, idx in checks.items():
+            check_defs += FMHA_FWD_API_CHECK.format(F_idx=idx, F_arg='' if predicate == 'true' else ' a', F_predicate=predicate)
+
+        max_hdims = max(len(hdims) for hdims in self.pool.values())
+        hdims = '\n'.join('    {' + ', '.join(list(self.pool[dtype].keys()) + ['0'] * (max_hdims - len(self.pool[dtype]))) + '},'
+                          for dtype in self.pool.keys())
+        dtype_ids = str()
+        for length in sorted(set(len(dtype) for dtype in self.pool.keys())):
+            dtype_ids += f'    case {length}:\n'
+            for i, dtype in enumerate(self.pool.keys()):
+                if len(dtype) == length:
+                    dtype_ids += f'        if(std::memcmp(data_type.data(), "{dtype}", {length}) == 0)\n            return {i};\n'
+            dtype_ids += '        break;\n'
+        mask_ids = '\n'.join(f'    case {e}: return {i};' for i, values in enumerate(get_mask_enum_map(self.mask_impl).values()) for e in values)
+        bias_ids = '\n'.join(f'    case {e}: return {i};' for i, e in enumerate(BIAS_CHECK_MAP.values()))
+
+        num_keys = 1
+        for _, radix in self.key_fields():
+            num_keys *= radix
+
+        return FMHA_FWD_KERNEL_HEADER + FMHA_FWD_API.format(F_checks=check_defs, F_candidates='\n'.join(candidates),
+                                   F_key_ranges='\n'.join(key_ranges), F_num_dtypes=len(self.pool), F_max_hdims=max_hdims,
+                                   F_hdims=hdims, F_num_keys=num_keys, F_dtype_ids=dtype_ids.rstrip('\n'), F_mask_ids=mask_ids,
+                                   F_bias_ids=bias_ids, F_key=self.key_expr())
 
 @dataclass
 class FmhaFwdTileSize:
@@ -556,13 +738,43 @@ def get_blobs(kernel_filter : Optional[str], receipt, mask_impl) -> Tuple[FmhaFw
 
     return (api_pool, gen)
 
-def write_single_kernel(kernel: FmhaFwdKernel, autogen_dir: Path) -> None:
-    (autogen_dir / kernel.filename).write_text(kernel.template)
-
-def write_api(api_pool : FmhaFwdApiPool, autogen_dir: Path) -> None:
-    (autogen_dir / FMHA_FWD_API_FILENAME).write_text(api_pool.api)
-
-def write_blobs(output_dir : Optional[str], kernel_filter : Optional[str], receipt, mask_impl) -> None:
+# records the content hash of every blob written to an output dir, to skip unchanged blobs and
+# to remove the ones a later run no longer generates
+BLOB_MANIFEST_FILENAME = "fmha_fwd_blobs.json"
+BLOB_MANIFEST_VERSION = 1
+
+def content_hash(text : str) -> str:
+    return hashlib.sha1(text.encode()).hexdigest()
+
+def write_if_changed(path : Path, text : str, known_hash : Optional[str] = None) -> bool:
+    # leave unchanged files alone, so that their timestamp doesn't trigger a rebuild
+    if path.exists():
+        if known_hash is not None and known_hash == content_hash(text):
+            return False
+        if path.read_text() == text:
+            return False
+    # write through a temporary file, so that an interrupted run never leaves a partial blob
+    tmp = path.with_name(path.name + f'.{os.getpid()}.tmp')
+    tmp.write_text(text)
+    os.replace(tmp, path)
+    return True
+
+def read_blob_manifest(output_dir : Path) -> dict:
+    try:
+        manifest = json.loads((output_dir / BLOB_MANIFEST_FILENAME).read_text())
+        if manifest.get('version') == BLOB_MANIFEST_VERSION:
+            return manifest['blobs']
+    except (OSError, ValueError, KeyError):
+        pass
+    return dict()
+
+def write_single_kernel(kernel: FmhaFwdKernel, autogen_dir: Path, known_hash : Optional[str] = None) -> bool:
+    return write_if_changed(autogen_dir / kernel.filename, kernel.template, known_hash)
+
+def write_api(api_pool : FmhaFwdApiPool, autogen_dir: Path, known_hash : Optional[str] = None) -> bool:
+    return write_if_changed(autogen_dir / FMHA_FWD_API_FILENAME, api_pool.api, known_hash)
+
+def write_blobs(output_dir : Optional[str], kernel_filter : Optional[str], receipt, mask_impl, jobs : Optional[int] = None) -> None:
     if output_dir is None:
         output_dir = Path(__file__).parent
     else:
@@ -570,19 +782,38 @@ def write_blobs(output_dir : Optional[str], kernel_filter : Optional[str], recei
 
     output_dir.mkdir(parents=True, exist_ok=True)
     api_pool, kernels = get_blobs(kernel_filter, receipt, mask_impl)
-    for kernel in kernels:
-        write_single_kernel(kernel, output_dir)
-    write_api(api_pool, output_dir)
+    old_hashes = read_blob_manifest(output_dir)
 
-# list all the files that will be generated
+    def render(blob) -> Tuple[str, str]:
+        if isinstance(blob, FmhaFwdKernel):
+            filename, text = blob.filename, blob.template
+        else:
+            filename, text = FMHA_FWD_API_FILENAME, blob.api
+        write_if_changed(output_dir / filename, text, old_hashes.get(filename))
+        return filename, content_hash(text)
+
+    with ThreadPoolExecutor(max_workers=jobs) as pool:
+        new_hashes = dict(pool.map(render, kernels + [api_pool]))
+
+    # blobs generated by a previous run, e.g. with a different filter, would otherwise linger
+    for filename in old_hashes.keys() - new_hashes.keys():
+        try:
+            (output_dir / filename).unlink()
+        except FileNotFoundError:
+            pass
+
+    if new_hashes != old_hashes:
+        write_if_changed(output_dir / BLOB_MANIFEST_FILENAME,
+                         json.dumps({'version' : BLOB_MANIFEST_VERSION, 'blobs' : new_hashes}, indent=1, sort_keys=True))
+
+# list all the files that will be generated, one per line. the list is only rewritten when it
+# changes, so that CMake can depend on it without reconfiguring for nothing
 def list_blobs(output_file : Optional[str], kernel_filter : Optional[str], receipt, mask_impl) -> None:
     assert output_file is not None
     file_path = Path(output_file)
-    with file_path.open('a') as f:
-        _, kernels = get_blobs(kernel_filter, receipt, mask_impl)
-        for kernel in kernels:
-            f.write(str(file_path.parent / GEN_DIR / kernel.filename) + "\n")
-        f.write(str(file_path.parent / GEN_DIR / FMHA_FWD_API_FILENAME) + "\n")
+    _, kernels = get_blobs(kernel_filter, receipt, mask_impl)
+    filenames = [kernel.filename for kernel in kernels] + [FMHA_FWD_API_FILENAME]
+    write_if_changed(file_path, ''.join(str(file_path.parent / GEN_DIR / f) + "\n" for f in filenames))
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser(
@@ -626,8 +857,17 @@ if __name__ == "__main__":
              "  1: generate more instance to cover all hdim"
     )
 
+    parser.add_argument(
+        "-j",
+        "--jobs",
+        type=int,
+        default=None,
+        required=False,
+        help="number of blobs written in parallel, default to the number of processors"
+    )
+
     args = parser.parse_args()
     if args.list_blobs is not None:
         list_blobs(args.list_blobs, args.filter, args.receipt, mask_impl=args.mask)
     else:
-        write_blobs(args.output_dir, args.filter, args.receipt, mask_impl=args.mask)
+        write_blobs(args.output_dir, args.filter, args.receipt, mask_impl=args.mask, jobs=args.jobs)
@@ -51,6 +51,26 @@ inline std::string get_device_name()
     return name;
 }
 
+// number of compute units of the current device, 0 if it cannot be queried
+inline int get_device_cu_count()
+{
+    hipDeviceProp_t props{};
+    int device;
+    auto status = hipGetDevice(&device);
+    if(status != hipSuccess)
+    {
+        return 0;
+    }
+
+    status = hipGetDeviceProperties(&props, device);
+    if(status != hipSuccess)
+    {
+        return 0;
+    }
+
+    return props.multiProcessorCount;
+}
+
 inline bool is_xdl_supported()
 {
     return ck::get_device_name() == "gfx908" || ck::get_device_name() == "gfx90a" ||
@@ -0,0 +1,386 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ck/utility/env.hpp"
+
+// Host-side tracing of dispatch costs (argument construction, support checks, workspace queries,
+// type strings, kernel launches).
+//
+// Spans are compiled in only when CK_HOST_TRACE is defined to non-zero (cmake -DUSE_HOST_TRACE=ON),
+// otherwise every CK_TRACE_* macro expands to nothing / the bare expression. When compiled in, the
+// recorder is still inactive until one of the environment variables below is set:
+//   export CK_HOST_TRACE_FILE=trace.json    write Chrome-trace/Perfetto JSON at exit
+//   export CK_HOST_TRACE_SUMMARY=1          print a per-span latency histogram to stderr at exit
+//   export CK_HOST_TRACE_MAX_EVENTS=N       cap on buffered timeline events (default 1M); the
+//                                           histogram keeps aggregating past the cap
+CK_DECLARE_ENV_VAR_STR(CK_HOST_TRACE_FILE)
+CK_DECLARE_ENV_VAR_BOOL(CK_HOST_TRACE_SUMMARY)
+CK_DECLARE_ENV_VAR_UINT64(CK_HOST_TRACE_MAX_EVENTS)
+
+#ifndef CK_HOST_TRACE
+#define CK_HOST_TRACE 0
+#endif
+
+namespace ck {
+namespace trace {
+
+using Clock = std::chrono::steady_clock;
+
+struct TraceEvent
+{
+    enum struct Kind
+    {
+        Span,
+        Counter
+    };
+
+    Kind kind;
+    const char* name;
+    std::string detail;
+    std::size_t thread_id;
+    int64_t begin_ns;
+    // duration for spans, sampled value for counters
+    int64_t value;
+};
+
+// Log2-bucketed latency histogram: bucket i holds durations in [2^(i-1), 2^i) ns.
+struct SpanHistogram
+{
+    static constexpr int NumBuckets = 48;
+
+    uint64_t count   = 0;
+    int64_t total_ns = 0;
+    int64_t min_ns   = std::numeric_limits<int64_t>::max();
+    int64_t max_ns   = 0;
+    std::array<uint64_t, NumBuckets> buckets{};
+
+    static int GetBucket(int64_t ns)
+    {
+        int b = 0;
+        for(auto v = static_cast<uint64_t>(std::max<int64_t>(ns, 0)); v != 0; v >>= 1)
+            ++b;
+        return std::min(b, NumBuckets - 1);
+    }
+
+    void Add(int64_t ns)
+    {
+        ++count;
+        total_ns += ns;
+        min_ns = std::min(min_ns, ns);
+        max_ns = std::max(max_ns, ns);
+        ++buckets[GetBucket(ns)];
+    }
+
+    // upper bound of the bucket containing the requested quantile, clamped to the observed range
+    int64_t GetQuantileNs(double q) const
+    {
+        if(count == 0)
+            return 0;
+
+        const auto target = static_cast<uint64_t>(q * static_cast<double>(count - 1)) + 1;
+        uint64_t seen     = 0;
+        for(int b = 0; b < NumBuckets; ++b)
+        {
+            seen += buckets[b];
+            if(seen >= target)
+                return std::clamp<int64_t>(b == 0 ? 0 : (int64_t{1} << b) - 1, min_ns, max_ns);
+        }
+        return max_ns;
+    }
+};
+
+inline std::string EscapeJson(const std::string& s)
+{
+    std::ostringstream oss;
+    for(const char c : s)
+    {
+        switch(c)
+        {
+        case '"': oss << "\\\""; break;
+        case '\\': oss << "\\\\"; break;
+        case '\n': oss << "\\n"; break;
+        case '\t': oss << "\\t"; break;
+        default:
+            if(static_cast<unsigned char>(c) < 0x20)
+                oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c)
+                    << std::dec;
+            else
+                oss << c;
+        }
+    }
+    return oss.str();
+}
+
+class TraceRecorder
+{
+    public:
+    static TraceRecorder& Instance()
+    {
+        static TraceRecorder recorder;
+        return recorder;
+    }
+
+    bool IsActive() const { return active_.load(std::memory_order_relaxed); }
+
+    void SetActive(bool active) { active_.store(active, std::memory_order_relaxed); }
+
+    int64_t NowNs() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - origin_)
+            .count();
+    }
+
+    void RecordSpan(const char* name, int64_t begin_ns, int64_t dur_ns, std::string detail = {})
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        histograms_[name].Add(dur_ns);
+        Push(TraceEvent{
+            TraceEvent::Kind::Span, name, std::move(detail), GetThreadId(), begin_ns, dur_ns});
+    }
+
+    void RecordCounter(const char* name, int64_t value)
+    {
+        const auto now = NowNs();
+        std::lock_guard<std::mutex> lock(mutex_);
+        Push(TraceEvent{TraceEvent::Kind::Counter, name, {}, GetThreadId(), now, value});
+    }
+
+    std::size_t GetNumEvents() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return events_.size();
+    }
+
+    std::size_t GetNumDroppedEvents() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dropped_;
+    }
+
+    std::map<std::string, SpanHistogram> GetHistograms() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return histograms_;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        events_.clear();
+        histograms_.clear();
+        dropped_ = 0;
+    }
+
+    // Chrome trace event format, loadable by chrome://tracing and ui.perfetto.dev
+    void WriteChromeTrace(std::ostream& os) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        os << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+        bool first = true;
+        for(const auto& e : events_)
+        {
+            os << (first ? "\n" : ",\n");
+            first = false;
+
+            os << "{\"name\":\"" << EscapeJson(e.name) << "\",\"cat\":\"ck\",\"pid\":1,\"tid\":"
+               << e.thread_id << ",\"ts\":" << FormatUs(e.begin_ns);
+            if(e.kind == TraceEvent::Kind::Span)
+            {
+                os << ",\"ph\":\"X\",\"dur\":" << FormatUs(e.value);
+                if(!e.detail.empty())
+                    os << ",\"args\":{\"detail\":\"" << EscapeJson(e.detail) << "\"}";
+            }
+            else
+            {
+                os << ",\"ph\":\"C\",\"args\":{\"value\":" << e.value << "}";
+            }
+            os << "}";
+        }
+        os << "\n]}\n";
+    }
+
+    void WriteHistogram(std::ostream& os) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const auto flags = os.flags();
+        os << std::left << std::setw(32) << "span" << std::right << std::setw(10) << "count"
+           << std::setw(14) << "total(us)" << std::setw(12) << "mean(us)" << std::setw(12)
+           << "min(us)" << std::setw(12) << "p50(us)" << std::setw(12) << "p90(us)"
+           << std::setw(12) << "p99(us)" << std::setw(12) << "max(us)" << std::endl;
+
+        os << std::fixed << std::setprecision(3);
+        for(const auto& [name, h] : histograms_)
+        {
+            os << std::left << std::setw(32) << name << std::right << std::setw(10) << h.count
+               << std::setw(14) << h.total_ns * 1e-3 << std::setw(12)
+               << (h.count ? h.total_ns * 1e-3 / h.count : 0.0) << std::setw(12)
+               << h.min_ns * 1e-3 << std::setw(12) << h.GetQuantileNs(0.5) * 1e-3
+               << std::setw(12) << h.GetQuantileNs(0.9) * 1e-3 << std::setw(12)
+               << h.GetQuantileNs(0.99) * 1e-3 << std::setw(12) << h.max_ns * 1e-3 << std::endl;
+        }
+        if(dropped_ > 0)
+            os << "(" << dropped_ << " timeline events dropped, see CK_HOST_TRACE_MAX_EVENTS)"
+               << std::endl;
+        os.flags(flags);
+    }
+
+    void Flush() const
+    {
+        const auto& path = EnvGetString(CK_ENV(CK_HOST_TRACE_FILE));
+        if(!path.empty())
+        {
+            std::ofstream ofs(path);
+            if(ofs)
+                WriteChromeTrace(ofs);
+            else
+                std::cerr << "CK_HOST_TRACE_FILE: cannot open " << path << std::endl;
+        }
+        if(EnvIsEnabled(CK_ENV(CK_HOST_TRACE_SUMMARY)))
+            WriteHistogram(std::cerr);
+    }
+
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    ~TraceRecorder() { Flush(); }
+
+    private:
+    TraceRecorder() : origin_(Clock::now())
+    {
+        max_events_ = EnvValue(CK_ENV(CK_HOST_TRACE_MAX_EVENTS));
+        if(max_events_ == 0)
+            max_events_ = std::size_t{1} << 20;
+
+        active_ = !EnvGetString(CK_ENV(CK_HOST_TRACE_FILE)).empty() ||
+                  EnvIsEnabled(CK_ENV(CK_HOST_TRACE_SUMMARY));
+    }
+
+    static std::size_t GetThreadId()
+    {
+        static std::atomic<std::size_t> next_id{0};
+        thread_local const std::size_t id = next_id++;
+        return id;
+    }
+
+    static std::string FormatUs(int64_t ns)
+    {
+        std::ostringstream oss;
+        oss << ns / 1000 << "." << std::setw(3) << std::setfill('0') << ns % 1000;
+        return oss.str();
+    }
+
+    void Push(TraceEvent&& e)
+    {
+        if(events_.size() < max_events_)
+            events_.push_back(std::move(e));
+        else
+            ++dropped_;
+    }
+
+    Clock::time_point origin_;
+    std::atomic<bool> active_{false};
+    std::size_t max_events_ = 0;
+    std::size_t dropped_    = 0;
+    std::vector<TraceEvent> events_;
+    // keyed by name so the summary is stable across runs
+    std::map<std::string, SpanHistogram> histograms_;
+    mutable std::mutex mutex_;
+};
+
+// RAII span; the optional detail generator only runs when the recorder is active
+struct ScopedSpan
+{
+    explicit ScopedSpan(const char* name) : ScopedSpan(name, [] { return std::string{}; }) {}
+
+    template <typename DetailGen>
+    ScopedSpan(const char* name, DetailGen&& detail_gen)
+        : name_(name), active_(TraceRecorder::Instance().IsActive())
+    {
+        if(active_)
+        {
+            detail_   = detail_gen();
+            begin_ns_ = TraceRecorder::Instance().NowNs();
+        }
+    }
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+    ~ScopedSpan()
+    {
+        if(active_)
+        {
+            auto& recorder = TraceRecorder::Instance();
+            recorder.RecordSpan(name_, begin_ns_, recorder.NowNs() - begin_ns_, std::move(detail_));
+        }
+    }
+
+    private:
+    const char* name_;
+    bool active_;
+    int64_t begin_ns_ = 0;
+    std::string detail_;
+};
+
+template <typename F>
+decltype(auto) TraceCall(const char* name, F&& f)
+{
+    ScopedSpan span{name};
+    return f();
+}
+
+inline void RecordCounter(const char* name, int64_t value)
+{
+    auto& recorder = TraceRecorder::Instance();
+    if(recorder.IsActive())
+        recorder.RecordCounter(name, value);
+}
+
+} // namespace trace
+} // namespace ck
+
+#define CK_TRACE_CONCAT_IMPL(a, b) a##b
+#define CK_TRACE_CONCAT(a, b) CK_TRACE_CONCAT_IMPL(a, b)
+
+#if CK_HOST_TRACE
+// span covering the rest of the enclosing scope
+#define CK_TRACE_SPAN(name) \
+    const ck::trace::ScopedSpan CK_TRACE_CONCAT(ck_trace_span_, __LINE__) { name }
+// as above, with a detail string that is only built when tracing is active
+#define CK_TRACE_SPAN_DETAIL(name, detail)                               \
+    const ck::trace::ScopedSpan CK_TRACE_CONCAT(ck_trace_span_, __LINE__) \
+    {                                                                    \
+        name, [&] { return std::string(detail); }                        \
+    }
+// evaluates an expression inside a span and yields its value
+#define CK_TRACE_CALL(name, ...) \
+    ck::trace::TraceCall(name, [&]() -> decltype(auto) { return __VA_ARGS__; })
+#define CK_TRACE_COUNTER(name, value) ck::trace::RecordCounter(name, static_cast<int64_t>(value))
+#else
+#define CK_TRACE_SPAN(name) static_cast<void>(0)
+#define CK_TRACE_SPAN_DETAIL(name, detail) static_cast<void>(0)
+#define CK_TRACE_CALL(name, ...) (__VA_ARGS__)
+#define CK_TRACE_COUNTER(name, value) static_cast<void>(0)
+#endif
@@ -8,6 +8,7 @@
 #include "ck/ck.hpp"
 #include "ck/stream_config.hpp"
 #include "ck/host_utility/hip_check_error.hpp"
+#include "ck/host_utility/host_trace.hpp"
 
 template <typename... Args, typename F>
 float launch_and_time_kernel(const StreamConfig& stream_config,
@@ -17,6 +18,7 @@ float launch_and_time_kernel(const StreamConfig& stream_config,
                              std::size_t lds_byte,
                              Args... args)
 {
+    CK_TRACE_SPAN("launch_and_time_kernel");
 #if CK_TIME_KERNEL
     if(stream_config.time_kernel_)
     {
@@ -92,6 +94,7 @@ float launch_and_time_kernel_with_preprocess(const StreamConfig& stream_config,
                                              std::size_t lds_byte,
                                              Args... args)
 {
+    CK_TRACE_SPAN("launch_and_time_kernel");
 #if CK_TIME_KERNEL
     if(stream_config.time_kernel_)
     {
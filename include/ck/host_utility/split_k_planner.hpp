@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "ck/ck.hpp"
+
+namespace ck {
+
+// Host-side model for picking the split-K factor (KBatch) of a GEMM, or of a group of GEMMs
+// sharing one KBatch, without sweeping it on the device.
+//
+// Every (C tile, K batch) pair is one workgroup running ceil(K / (KBatch * KPerBlock)) main loop
+// iterations. Workgroups are dispatched in order, num_cu * occupancy at a time. A wave keeping
+// r workgroups resident on every CU lasts r * (slowest workgroup) / min(1, r *
+// single_wg_throughput): a CU shares its throughput among its resident workgroups, and a single
+// workgroup cannot saturate it on its own. Splitting K therefore helps while it fills idle CUs
+// or raises the residency of the last wave, and stops paying off once the extra prologues,
+// atomic epilogues and the clearing of the output outweigh that. All costs are expressed in
+// main loop iterations of one workgroup.
+struct SplitKModel
+{
+    index_t num_cu    = 1;
+    index_t occupancy = 1; // workgroups resident per CU
+
+    // fraction of the CU throughput reached by one resident workgroup
+    double single_wg_throughput = 0.5;
+
+    double tile_overhead = 4.0; // prologue + epilogue of every workgroup
+    // extra epilogue cost of a workgroup accumulating its partial tile with atomics
+    double atomic_epilogue = 4.0;
+    // zeroing one C tile before atomic accumulation; spread over all CUs
+    double clear_cost_per_tile = 0.5;
+    double clear_launch_cost   = 8.0; // the extra memset launch
+
+    index_t max_k_batch = 32;
+    // do not split below this many main loop iterations per workgroup
+    index_t min_k_iters_per_batch = 2;
+    // among candidates within this relative distance of the best cost, take the smallest KBatch
+    double tolerance = 0.02;
+};
+
+struct SplitKProblem
+{
+    index_t M;
+    index_t N;
+    index_t K;
+};
+
+struct SplitKPlan
+{
+    index_t k_batch = 1;
+    double cost     = 0; // modelled time, in main loop iterations
+    // useful main loop iterations / (num_cu * cost)
+    double efficiency = 0;
+};
+
+enum struct SplitKReduction
+{
+    // KBatch == 1 stores C, KBatch > 1 clears C and accumulates with atomics
+    // (DeviceGemmXdlSplitKCShuffle)
+    AtomicOnSplit,
+    // always clears a workspace, accumulates with atomics and runs a second elementwise stage
+    // (DeviceGroupedGemmMultipleDSplitKXdlCShuffleTwoStage), so only the number of partial tiles
+    // depends on KBatch
+    AlwaysAtomic,
+};
+
+inline double split_k_cost(const std::vector<SplitKProblem>& problems,
+                           index_t MPerBlock,
+                           index_t NPerBlock,
+                           index_t KPerBlock,
+                           index_t k_batch,
+                           const SplitKModel& model,
+                           SplitKReduction reduction = SplitKReduction::AtomicOnSplit)
+{
+    const bool atomic        = reduction == SplitKReduction::AlwaysAtomic || k_batch > 1;
+    const std::int64_t slots = std::int64_t{model.num_cu} * model.occupancy;
+
+    const auto wave_time = [&](std::int64_t resident, double slowest_workgroup) {
+        return resident * slowest_workgroup /
+               std::min(1.0, resident * model.single_wg_throughput);
+    };
+
+    double time         = 0;
+    std::int64_t filled = 0;
+    double slowest      = 0;
+    std::int64_t tiles  = 0;
+
+    for(const auto& problem : problems)
+    {
+        const index_t m_tiles  = (problem.M + MPerBlock - 1) / MPerBlock;
+        const index_t n_tiles  = (problem.N + NPerBlock - 1) / NPerBlock;
+        const index_t k_iters  = (problem.K + KPerBlock - 1) / KPerBlock;
+        const index_t k_per_wg = (k_iters + k_batch - 1) / k_batch;
+
+        const double workgroup_cost =
+            k_per_wg + model.tile_overhead + (atomic ? model.atomic_epilogue : 0.0);
+
+        tiles += std::int64_t{m_tiles} * n_tiles;
+
+        for(std::int64_t left = std::int64_t{m_tiles} * n_tiles * k_batch; left > 0;)
+        {
+            const std::int64_t take = std::min(left, slots - filled);
+
+            filled += take;
+            left -= take;
+            slowest = std::max(slowest, workgroup_cost);
+
+            if(filled == slots)
+            {
+                time += wave_time(model.occupancy, slowest);
+                filled  = 0;
+                slowest = 0;
+            }
+        }
+    }
+
+    if(filled > 0)
+    {
+        time += wave_time((filled + model.num_cu - 1) / model.num_cu, slowest);
+    }
+
+    if(atomic)
+    {
+        time += model.clear_launch_cost +
+                static_cast<double>(tiles) * model.clear_cost_per_tile / model.num_cu;
+    }
+
+    return time;
+}
+
+// Returns the modelled best KBatch in [1, model.max_k_batch] among those accepted by
+// is_valid_k_batch (e.g. the instance's K padding constraints). Falls back to KBatch = 1.
+template <typename IsValidKBatch>
+SplitKPlan plan_split_k(const std::vector<SplitKProblem>& problems,
+                        index_t MPerBlock,
+                        index_t NPerBlock,
+                        index_t KPerBlock,
+                        const SplitKModel& model,
+                        SplitKReduction reduction,
+                        IsValidKBatch is_valid_k_batch)
+{
+    double useful_iters = 0;
+    index_t max_k_iters = 0;
+
+    for(const auto& problem : problems)
+    {
+        const index_t m_tiles = (problem.M + MPerBlock - 1) / MPerBlock;
+        const index_t n_tiles = (problem.N + NPerBlock - 1) / NPerBlock;
+        const index_t k_iters = (problem.K + KPerBlock - 1) / KPerBlock;
+
+        useful_iters += static_cast<double>(m_tiles) * n_tiles * k_iters;
+        max_k_iters = std::max(max_k_iters, k_iters);
+    }
+
+    std::vector<std::pair<index_t, double>> candidates;
+    double best_cost = std::numeric_limits<double>::max();
+
+    for(index_t k_batch = 1; k_batch <= std::max(model.max_k_batch, 1); ++k_batch)
+    {
+        if(k_batch > 1 && max_k_iters / k_batch < model.min_k_iters_per_batch)
+        {
+            break;
+        }
+        if(!is_valid_k_batch(k_batch))
+        {
+            continue;
+        }
+
+        const double cost =
+            split_k_cost(problems, MPerBlock, NPerBlock, KPerBlock, k_batch, model, reduction);
+
+        candidates.emplace_back(k_batch, cost);
+        best_cost = std::min(best_cost, cost);
+    }
+
+    SplitKPlan plan;
+
+    for(const auto& candidate : candidates)
+    {
+        if(candidate.second <= best_cost * (1 + model.tolerance))
+        {
+            plan.k_batch = candidate.first;
+            plan.cost    = candidate.second;
+            break;
+        }
+    }
+
+    if(candidates.empty())
+    {
+        plan.cost = split_k_cost(problems, MPerBlock, NPerBlock, KPerBlock, 1, model, reduction);
+    }
+
+    if(plan.cost > 0)
+    {
+        plan.efficiency = useful_iters / (model.num_cu * plan.cost);
+    }
+
+    return plan;
+}
+
+inline SplitKPlan plan_split_k(const std::vector<SplitKProblem>& problems,
+                               index_t MPerBlock,
+                               index_t NPerBlock,
+                               index_t KPerBlock,
+                               const SplitKModel& model,
+                               SplitKReduction reduction = SplitKReduction::AtomicOnSplit)
+{
+    return plan_split_k(
+        problems, MPerBlock, NPerBlock, KPerBlock, model, reduction, [](index_t) { return true; });
+}
+
+} // namespace ck
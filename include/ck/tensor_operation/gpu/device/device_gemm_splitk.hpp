@@ -39,6 +39,14 @@ struct DeviceGemmSplitK : public BaseOperator
                                                               ck::index_t KBatch) = 0;
 
     virtual std::unique_ptr<BaseInvoker> MakeInvokerPointer() = 0;
+
+    // KBatch the instance's split-K model (ck/host_utility/split_k_planner.hpp) expects to be
+    // fastest for this problem on the current device; 1 for instances without a model
+    virtual ck::index_t
+    GetOptimalKBatch(ck::index_t /* M */, ck::index_t /* N */, ck::index_t /* K */)
+    {
+        return 1;
+    }
 };
 
 template <typename ALayout,
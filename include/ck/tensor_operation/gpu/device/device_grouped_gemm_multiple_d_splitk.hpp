@@ -112,6 +112,18 @@ struct DeviceGroupedGemmMultipleDSplitK : public DeviceGroupedGemm<ALayout,
     ///
     virtual void SetKBatchSize(BaseArgument* p_arg, index_t kbatch) const = 0;
 
+    //----------------------------------------------------------------------------------------------
+    /// @brief      Gets the k batch size the split-K model expects to be fastest.
+    ///
+    /// @note       The model is in ck/host_utility/split_k_planner.hpp. Pass the result to
+    ///             SetKBatchSize.
+    ///
+    /// @param[in]  p_arg  The pointer to the Device op Argument.
+    ///
+    /// @return     The kbatch value, 1 for instances without a model.
+    ///
+    virtual index_t GetOptimalKBatch(const BaseArgument* /* p_arg */) const { return 1; }
+
     //----------------------------------------------------------------------------------------------
     /// @brief      Sets the device kernel arguments pointer.
     ///
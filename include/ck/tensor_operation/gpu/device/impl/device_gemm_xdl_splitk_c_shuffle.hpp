@@ -15,6 +15,7 @@
 #include "ck/tensor_operation/gpu/grid/gridwise_gemm_xdlops_v2r4r2.hpp"
 #include "ck/host_utility/device_prop.hpp"
 #include "ck/host_utility/kernel_launch.hpp"
+#include "ck/host_utility/split_k_planner.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -359,6 +360,34 @@ struct DeviceGemmXdlSplitKCShuffle : public DeviceGemmSplitK<ALayout,
 
     static auto MakeInvoker() { return Invoker{}; }
 
+    // split factor the split-K model expects to be fastest for num_cu/occupancy in model,
+    // restricted to KBatch values this instance supports for the given problem
+    static SplitKPlan PlanKBatch(index_t M, index_t N, index_t K, const SplitKModel& model)
+    {
+        return plan_split_k({SplitKProblem{M, N, K}},
+                            MPerBlock,
+                            NPerBlock,
+                            K0PerBlock * K1,
+                            model,
+                            SplitKReduction::AtomicOnSplit,
+                            [&](index_t k_batch) {
+                                return GridwiseGemm::CheckValidity(
+                                    MakeArgument(nullptr,
+                                                 nullptr,
+                                                 nullptr,
+                                                 M,
+                                                 N,
+                                                 K,
+                                                 0,
+                                                 0,
+                                                 0,
+                                                 AElementwiseOperation{},
+                                                 BElementwiseOperation{},
+                                                 CElementwiseOperation{},
+                                                 k_batch));
+                            });
+    }
+
     // polymorphic
     std::unique_ptr<BaseArgument> MakeArgumentPointer(const void* p_a,
                                                       const void* p_b,
@@ -399,6 +428,33 @@ struct DeviceGemmXdlSplitKCShuffle : public DeviceGemmSplitK<ALayout,
         return std::make_unique<Invoker>(Invoker{});
     }
 
+    // polymorphic
+    index_t GetOptimalKBatch(index_t M, index_t N, index_t K) override
+    {
+        const auto kernel =
+            kernel_gemm_xdlops_v2r4r2_simplified<GridwiseGemm,
+                                                 true,
+                                                 InMemoryDataOperationEnum::AtomicAdd,
+                                                 DefaultBlock2CTileMap,
+                                                 AElementwiseOperation,
+                                                 BElementwiseOperation,
+                                                 CElementwiseOperation>;
+        int occupancy;
+        hip_check_error(
+            hipOccupancyMaxActiveBlocksPerMultiprocessor(&occupancy, kernel, BlockSize, 0));
+
+        SplitKModel model;
+        model.num_cu    = get_device_cu_count();
+        model.occupancy = occupancy;
+
+        if(model.num_cu <= 0 || model.occupancy <= 0)
+        {
+            return 1;
+        }
+
+        return PlanKBatch(M, N, K, model).k_batch;
+    }
+
     // polymorphic
     std::string GetTypeString() const override
     {
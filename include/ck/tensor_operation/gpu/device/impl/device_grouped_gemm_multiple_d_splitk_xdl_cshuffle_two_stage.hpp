@@ -11,6 +11,7 @@
 #include "ck/host_utility/device_prop.hpp"
 #include "ck/host_utility/kernel_launch.hpp"
 #include "ck/host_utility/hip_check_error.hpp"
+#include "ck/host_utility/split_k_planner.hpp"
 #include "ck/utility/common_header.hpp"
 #include <ck/utility/loop_scheduler.hpp>
 #include "ck/utility/tuple.hpp"
@@ -981,6 +982,74 @@ struct DeviceGroupedGemmMultipleDSplitKXdlCShuffleTwoStage
         return SetKBatchSize(*dynamic_cast<Argument*>(p_arg), kbatch);
     }
 
+    ///
+    /// @brief      Runs the split-K model over all groups of the argument.
+    ///
+    /// @note       All groups share one kbatch. The workspace is always cleared and reduced by
+    ///             the elementwise stage, so only the number of partial tiles depends on it.
+    ///
+    /// @param[in]  arg    The structure containing kernel arguments (in host memory).
+    /// @param[in]  model  The model, with num_cu and occupancy of the target device.
+    ///
+    /// @return     The modelled best kbatch supported by every group, and its cost.
+    ///
+    static SplitKPlan PlanKBatch(const Argument& arg, const SplitKModel& model)
+    {
+        std::vector<SplitKProblem> problems;
+        for(const auto& gemm_arg : arg.gemm_kernel_args_)
+        {
+            problems.push_back({gemm_arg.karg_.M, gemm_arg.karg_.N, gemm_arg.karg_.K});
+        }
+
+        const auto is_valid_k_batch = [&](index_t k_batch) {
+            for(const auto& gemm_arg : arg.gemm_kernel_args_)
+            {
+                auto karg     = gemm_arg.karg_;
+                karg.KPadded  = GridwiseGemm::CalculateKPadded(karg.K, k_batch);
+                karg.K0Padded = GridwiseGemm::CalculateK0Padded(karg.K, k_batch);
+                karg.k_batch  = k_batch;
+                if(!GridwiseGemm::CheckValidity(karg))
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+
+        return plan_split_k(problems,
+                            MPerBlock,
+                            NPerBlock,
+                            KPerBlock,
+                            model,
+                            SplitKReduction::AlwaysAtomic,
+                            is_valid_k_batch);
+    }
+
+    index_t GetOptimalKBatch(const BaseArgument* p_arg) const override
+    {
+        const auto kernel = kernel_grouped_gemm_xdl_splitk<GridwiseGemm,
+                                                           GemmTransKernelArg,
+                                                           true,
+                                                           InMemoryDataOperationEnum::AtomicAdd,
+                                                           AElementwiseOperation,
+                                                           BElementwiseOperation,
+                                                           PassThrough>;
+        int occupancy;
+        hip_check_error(
+            hipOccupancyMaxActiveBlocksPerMultiprocessor(&occupancy, kernel, BlockSize, 0));
+
+        SplitKModel model;
+        model.num_cu    = get_device_cu_count();
+        model.occupancy = occupancy;
+
+        if(model.num_cu <= 0 || model.occupancy <= 0)
+        {
+            return 1;
+        }
+
+        return PlanKBatch(*dynamic_cast<const Argument*>(p_arg), model).k_batch;
+    }
+
     size_t GetDeviceKernelArgSize(const BaseArgument* p_arg) const override
     {
         return dynamic_cast<const Argument*>(p_arg)->gemm_kernel_args_.size() *
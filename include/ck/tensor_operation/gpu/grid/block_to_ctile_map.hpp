@@ -1190,7 +1190,7 @@ struct BlockToCTileMap_GemmStreamK
         return __builtin_amdgcn_readfirstlane(blockIdx.x);
     }
 
-    __device__ void
+    __host__ __device__ void
     get_block_itr(uint32_t block_idx, uint32_t& iter_start, uint32_t& iter_end) const
     {
         if(block_idx < sk_num_big_blocks)
@@ -1213,9 +1213,9 @@ struct BlockToCTileMap_GemmStreamK
         }
     }
 
-    __device__ uint32_t get_current_iter_length(uint32_t iter_start,
-                                                uint32_t iter_end,
-                                                uint32_t total_iter_length) const
+    __host__ __device__ uint32_t get_current_iter_length(uint32_t iter_start,
+                                                         uint32_t iter_end,
+                                                         uint32_t total_iter_length) const
     {
         uint32_t iter_length_mod, iter_length_quo /*unused*/;
         k_iters_per_tile.divmod(iter_end, iter_length_quo, iter_length_mod);
@@ -1224,15 +1224,18 @@ struct BlockToCTileMap_GemmStreamK
         return current_iter_length;
     }
 
-    __device__ uint32_t get_tile_idx(uint32_t iter) const { return k_iters_per_tile.div(iter); }
+    __host__ __device__ uint32_t get_tile_idx(uint32_t iter) const
+    {
+        return k_iters_per_tile.div(iter);
+    }
 
-    __device__ void
+    __host__ __device__ void
     get_tile_idx_with_offset(uint32_t iter, uint32_t& tile_idx, uint32_t& iter_offset) const
     {
         k_iters_per_tile.divmod(iter, tile_idx, iter_offset);
     }
 
-    __device__ auto tile_to_spatial(uint32_t tile_idx, uint32_t m, uint32_t n) const
+    __host__ __device__ auto tile_to_spatial(uint32_t tile_idx, uint32_t m, uint32_t n) const
     {
         uint32_t m_tile_idx, n_tile_idx;
         uint32_t n_tiles_value = math::integer_divide_ceil(n, NPerBlock);
@@ -1311,7 +1314,7 @@ struct BlockToCTileMap_GemmStreamK
         return sk_num_blocks + total_intersec_big + total_intersec_little;
     }
 
-    __device__ uint32_t get_acc_buffer_offset_from_tile(uint32_t tile_idx_) const
+    __host__ __device__ uint32_t get_acc_buffer_offset_from_tile(uint32_t tile_idx_) const
     {
         // TODO: from big to little
         uint32_t tiles_cover_big_blocks =
@@ -1337,7 +1340,7 @@ struct BlockToCTileMap_GemmStreamK
         }
     }
 
-    __device__ uint32_t get_acc_buffer_offset_from_block(uint32_t block_idx_) const
+    __host__ __device__ uint32_t get_acc_buffer_offset_from_block(uint32_t block_idx_) const
     {
         uint32_t iters_per_big_sk_block    = k_iters_per_big_block;
         uint32_t iters_per_little_sk_block = k_iters_per_big_block - 1;
@@ -19,7 +19,7 @@ struct static_for_impl<Sequence<Is...>>
     template <class F>
     __host__ __device__ constexpr void operator()(F f) const
     {
-        swallow{(f(Number<Is>{}), 0)...};
+        (f(Number<Is>{}), ...);
     }
 };
 
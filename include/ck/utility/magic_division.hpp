@@ -155,6 +155,41 @@ struct MagicDivision
         uint32_t tmp          = static_cast<uint64_t>(dividend_u32) * multiplier >> 32;
         return (tmp + dividend_u32) >> shift;
     }
+
+    // uint64_t, for host index math on tensors with more than 2^31 elements
+    // Same scheme as the uint32_t version with a 64-bit multiplier: the result is correct if the
+    // dividend is within 63-bit value range.
+    __host__ static constexpr auto CalculateMagicNumbers64(uint64_t divisor)
+    {
+        if(divisor >= 1 && divisor <= INT64_MAX + uint64_t{1})
+        {
+            uint32_t shift = 0;
+            for(shift = 0; shift < 64; ++shift)
+            {
+                if((uint64_t{1} << shift) >= divisor)
+                {
+                    break;
+                }
+            }
+
+            using uint128_t      = unsigned __int128;
+            uint128_t one        = 1;
+            uint128_t multiplier = ((one << 64) * ((one << shift) - divisor)) / divisor + 1;
+
+            return make_tuple(uint64_t(multiplier), shift);
+        }
+        else
+        {
+            return make_tuple(uint64_t(0), uint32_t(0));
+        }
+    }
+
+    __host__ static constexpr uint64_t
+    DoMagicDivision64(uint64_t dividend, uint64_t multiplier, uint32_t shift)
+    {
+        uint64_t tmp = static_cast<unsigned __int128>(dividend) * multiplier >> 64;
+        return (tmp + dividend) >> shift;
+    }
 };
 
 struct MDiv
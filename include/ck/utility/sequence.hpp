@@ -4,6 +4,7 @@
 #pragma once
 
 #include <ostream>
+#include <utility>
 
 #include "ck/utility/integral_constant.hpp"
 #include "ck/utility/type.hpp"
@@ -36,6 +37,87 @@ __host__ __device__ constexpr auto sequence_pop_front(Sequence<I, Is...>);
 template <typename Seq>
 __host__ __device__ constexpr auto sequence_pop_back(Seq);
 
+namespace detail {
+
+template <typename T, T... Is>
+struct integer_sequence_to_sequence
+{
+    using type = Sequence<static_cast<index_t>(Is)...>;
+};
+
+template <typename IntegerSequence>
+struct std_integer_sequence_to_sequence;
+
+template <typename T, T... Is>
+struct std_integer_sequence_to_sequence<std::integer_sequence<T, Is...>>
+{
+    using type = Sequence<static_cast<index_t>(Is)...>;
+};
+
+// Sequence<0, 1, ..., N - 1> in a single instantiation. Everything below that needs an index pack
+// is built on top of this instead of recursive splitting/merging.
+#if __has_builtin(__make_integer_seq)
+template <index_t N>
+using make_index_sequence =
+    typename __make_integer_seq<integer_sequence_to_sequence, index_t, N>::type;
+#else
+template <index_t N>
+using make_index_sequence =
+    typename std_integer_sequence_to_sequence<std::make_integer_sequence<index_t, N>>::type;
+#endif
+
+// fixed-size scratch storage for sequence algorithms that run as constexpr loops
+template <index_t N>
+struct sequence_array
+{
+    __host__ __device__ constexpr index_t& operator[](index_t i) { return mData[i]; }
+
+    __host__ __device__ constexpr const index_t& operator[](index_t i) const { return mData[i]; }
+
+    // the last dummy element is to prevent compiler complain about empty array, when N = 0
+    index_t mData[N + 1];
+};
+
+// Gen{}() returns a sequence_array; it is evaluated once per Gen, however many sequences are read
+// out of the result
+template <typename Gen>
+struct sequence_array_constant
+{
+    static constexpr auto value = Gen{}();
+};
+
+template <typename Gen, index_t Offset, typename Ids>
+struct sequence_from_array;
+
+template <typename Gen, index_t Offset, index_t... Ids>
+struct sequence_from_array<Gen, Offset, Sequence<Ids...>>
+{
+    using type = Sequence<sequence_array_constant<Gen>::value[Offset + Ids]...>;
+};
+
+// Sequence<r[Offset], ..., r[Offset + N - 1]> where r = Gen{}()
+template <typename Gen, index_t N, index_t Offset = 0>
+using sequence_from_array_t =
+    typename sequence_from_array<Gen, Offset, make_index_sequence<N>>::type;
+
+template <typename Seq, index_t I, index_t X>
+struct sequence_modify_gen
+{
+    __host__ __device__ constexpr auto operator()() const
+    {
+        sequence_array<Seq::Size()> r{};
+
+        for(index_t i = 0; i < Seq::Size(); ++i)
+        {
+            r[i] = (i == I) ? X : Seq::At(i);
+        }
+
+        return r;
+    }
+};
+
+} // namespace detail
+
 template <index_t... Is>
 struct Sequence
 {
@@ -83,7 +165,7 @@ struct Sequence
 
         static_assert(is_valid_sequence_map<Sequence<IRs...>>::value, "wrong! invalid reorder map");
 
-        return Sequence<Type::At(Number<IRs>{})...>{};
+        return Sequence<Type::At(IRs)...>{};
     }
 
     // MapOld2New is Sequence<...>
@@ -146,13 +228,17 @@ struct Sequence
     template <index_t... Ns>
     __host__ __device__ static constexpr auto Extract(Number<Ns>...)
     {
-        return Sequence<Type::At(Number<Ns>{})...>{};
+        static_assert(((Ns < mSize) && ...), "wrong! I too large");
+
+        return Sequence<Type::At(Ns)...>{};
     }
 
     template <index_t... Ns>
     __host__ __device__ static constexpr auto Extract(Sequence<Ns...>)
     {
-        return Sequence<Type::At(Number<Ns>{})...>{};
+        static_assert(((Ns < mSize) && ...), "wrong! I too large");
+
+        return Sequence<Type::At(Ns)...>{};
     }
 
     template <index_t I, index_t X>
@@ -160,11 +246,7 @@ struct Sequence
     {
         static_assert(I < Size(), "wrong!");
 
-        using seq_split          = sequence_split<Type, I>;
-        constexpr auto seq_left  = typename seq_split::left_type{};
-        constexpr auto seq_right = typename seq_split::right_type{}.PopFront();
-
-        return seq_left.PushBack(Number<X>{}).PushBack(seq_right);
+        return detail::sequence_from_array_t<detail::sequence_modify_gen<Type, I, X>, mSize>{};
     }
 
     template <typename F>
@@ -183,113 +265,118 @@ struct Sequence
 };
 
 // merge sequence
+// consumes up to four sequences per step, so the instantiation depth is a quarter of the number
+// of sequences instead of one level per sequence
 template <typename Seq, typename... Seqs>
-struct sequence_merge
+struct sequence_merge;
+
+template <typename Seq>
+struct sequence_merge<Seq>
 {
-    using type = typename sequence_merge<Seq, typename sequence_merge<Seqs...>::type>::type;
+    using type = Seq;
 };
 
-template <index_t... Xs, index_t... Ys>
-struct sequence_merge<Sequence<Xs...>, Sequence<Ys...>>
+template <index_t... Xs, index_t... Ys, typename... Seqs>
+struct sequence_merge<Sequence<Xs...>, Sequence<Ys...>, Seqs...>
 {
-    using type = Sequence<Xs..., Ys...>;
+    using type = typename sequence_merge<Sequence<Xs..., Ys...>, Seqs...>::type;
 };
 
-template <typename Seq>
-struct sequence_merge<Seq>
+template <index_t... Ws, index_t... Xs, index_t... Ys, index_t... Zs, typename... Seqs>
+struct sequence_merge<Sequence<Ws...>, Sequence<Xs...>, Sequence<Ys...>, Sequence<Zs...>, Seqs...>
 {
-    using type = Seq;
+    using type = typename sequence_merge<Sequence<Ws..., Xs..., Ys..., Zs...>, Seqs...>::type;
 };
 
-// generate sequence
-template <index_t NSize, typename F>
-struct sequence_gen
+namespace detail {
+
+template <typename F, typename Ids>
+struct sequence_gen_impl;
+
+template <typename F, index_t... Ids>
+struct sequence_gen_impl<F, Sequence<Ids...>>
 {
-    template <index_t IBegin, index_t NRemain, typename G>
-    struct sequence_gen_impl
-    {
-        static constexpr index_t NRemainLeft  = NRemain / 2;
-        static constexpr index_t NRemainRight = NRemain - NRemainLeft;
-        static constexpr index_t IMiddle      = IBegin + NRemainLeft;
+    using type = Sequence<F{}(Number<Ids>{})...>;
+};
 
-        using type = typename sequence_merge<
-            typename sequence_gen_impl<IBegin, NRemainLeft, G>::type,
-            typename sequence_gen_impl<IMiddle, NRemainRight, G>::type>::type;
-    };
+template <index_t IBegin, index_t Increment, typename Ids>
+struct arithmetic_sequence_gen_impl;
 
-    template <index_t I, typename G>
-    struct sequence_gen_impl<I, 1, G>
-    {
-        static constexpr index_t Is = G{}(Number<I>{});
-        using type                  = Sequence<Is>;
-    };
+template <index_t IBegin, index_t Increment, index_t... Ids>
+struct arithmetic_sequence_gen_impl<IBegin, Increment, Sequence<Ids...>>
+{
+    using type = Sequence<(Ids * Increment + IBegin)...>;
+};
 
-    template <index_t I, typename G>
-    struct sequence_gen_impl<I, 0, G>
-    {
-        using type = Sequence<>;
-    };
+template <index_t I, typename Ids>
+struct uniform_sequence_gen_impl;
 
-    using type = typename sequence_gen_impl<0, NSize, F>::type;
+template <index_t I, index_t... Ids>
+struct uniform_sequence_gen_impl<I, Sequence<Ids...>>
+{
+    using type = Sequence<(static_cast<void>(Ids), I)...>;
+};
+
+} // namespace detail
+
+// generate sequence
+template <index_t NSize, typename F>
+struct sequence_gen
+{
+    using type = typename detail::sequence_gen_impl<F, detail::make_index_sequence<NSize>>::type;
 };
 
 // arithmetic sequence
 template <index_t IBegin, index_t IEnd, index_t Increment>
 struct arithmetic_sequence_gen
 {
-    struct F
-    {
-        __host__ __device__ constexpr index_t operator()(index_t i) const
-        {
-            return i * Increment + IBegin;
-        }
-    };
-
-    using type0 = typename sequence_gen<(IEnd - IBegin) / Increment, F>::type;
-    using type1 = Sequence<>;
-
     static constexpr bool kHasContent =
         (Increment > 0 && IBegin < IEnd) || (Increment < 0 && IBegin > IEnd);
 
-    using type = typename conditional<kHasContent, type0, type1>::type;
+    static constexpr index_t kSize = kHasContent ? (IEnd - IBegin) / Increment : 0;
+
+    using type = typename detail::
+        arithmetic_sequence_gen_impl<IBegin, Increment, detail::make_index_sequence<kSize>>::type;
 };
 
 // uniform sequence
 template <index_t NSize, index_t I>
 struct uniform_sequence_gen
 {
-    struct F
-    {
-        __host__ __device__ constexpr index_t operator()(index_t) const { return I; }
-    };
-
-    using type = typename sequence_gen<NSize, F>::type;
+    using type =
+        typename detail::uniform_sequence_gen_impl<I, detail::make_index_sequence<NSize>>::type;
 };
 
-// reverse inclusive scan (with init) sequence
-template <typename, typename, index_t>
-struct sequence_reverse_inclusive_scan;
+namespace detail {
 
-template <index_t I, index_t... Is, typename Reduce, index_t Init>
-struct sequence_reverse_inclusive_scan<Sequence<I, Is...>, Reduce, Init>
+template <typename Seq, typename Reduce, index_t Init>
+struct sequence_reverse_inclusive_scan_gen
 {
-    using old_scan = typename sequence_reverse_inclusive_scan<Sequence<Is...>, Reduce, Init>::type;
+    __host__ __device__ constexpr auto operator()() const
+    {
+        detail::sequence_array<Seq::Size()> r{};
 
-    static constexpr index_t new_reduce = Reduce{}(I, old_scan{}.Front());
+        index_t acc = Init;
 
-    using type = typename sequence_merge<Sequence<new_reduce>, old_scan>::type;
-};
+        for(index_t i = Seq::Size() - 1; i >= 0; --i)
+        {
+            acc  = Reduce{}(Seq::At(i), acc);
+            r[i] = acc;
+        }
 
-template <index_t I, typename Reduce, index_t Init>
-struct sequence_reverse_inclusive_scan<Sequence<I>, Reduce, Init>
-{
-    using type = Sequence<Reduce{}(I, Init)>;
+        return r;
+    }
 };
 
-template <typename Reduce, index_t Init>
-struct sequence_reverse_inclusive_scan<Sequence<>, Reduce, Init>
+} // namespace detail
+
+// reverse inclusive scan (with init) sequence
+template <typename Seq, typename Reduce, index_t Init>
+struct sequence_reverse_inclusive_scan
 {
-    using type = Sequence<>;
+    using type = detail::
+        sequence_from_array_t<detail::sequence_reverse_inclusive_scan_gen<Seq, Reduce, Init>,
+                              Seq::Size()>;
 };
 
 // split sequence
@@ -311,22 +398,8 @@ struct sequence_reverse
 {
     static constexpr index_t NSize = Seq{}.Size();
 
-    using seq_split = sequence_split<Seq, NSize / 2>;
-    using type      = typename sequence_merge<
-        typename sequence_reverse<typename seq_split::right_type>::type,
-        typename sequence_reverse<typename seq_split::left_type>::type>::type;
-};
-
-template <index_t I>
-struct sequence_reverse<Sequence<I>>
-{
-    using type = Sequence<I>;
-};
-
-template <index_t I0, index_t I1>
-struct sequence_reverse<Sequence<I0, I1>>
-{
-    using type = Sequence<I1, I0>;
+    using type =
+        decltype(Seq::Extract(typename arithmetic_sequence_gen<NSize - 1, -1, -1>::type{}));
 };
 
 #if 1
@@ -351,269 +424,156 @@ struct sequence_reduce<Reduce, Seq>
 };
 #endif
 
-template <typename Values, typename Ids, typename Compare>
-struct sequence_sort_impl
-{
-    template <typename LeftValues,
-              typename LeftIds,
-              typename RightValues,
-              typename RightIds,
-              typename MergedValues,
-              typename MergedIds,
-              typename Comp>
-    struct sorted_sequence_merge_impl
-    {
-        static constexpr bool choose_left = LeftValues::Front() < RightValues::Front();
-
-        static constexpr index_t chosen_value =
-            choose_left ? LeftValues::Front() : RightValues::Front();
-        static constexpr index_t chosen_id = choose_left ? LeftIds::Front() : RightIds::Front();
-
-        using new_merged_values = decltype(MergedValues::PushBack(Number<chosen_value>{}));
-        using new_merged_ids    = decltype(MergedIds::PushBack(Number<chosen_id>{}));
-
-        using new_left_values =
-            typename conditional<choose_left, decltype(LeftValues::PopFront()), LeftValues>::type;
-        using new_left_ids =
-            typename conditional<choose_left, decltype(LeftIds::PopFront()), LeftIds>::type;
-
-        using new_right_values =
-            typename conditional<choose_left, RightValues, decltype(RightValues::PopFront())>::type;
-        using new_right_ids =
-            typename conditional<choose_left, RightIds, decltype(RightIds::PopFront())>::type;
-
-        using merge = sorted_sequence_merge_impl<new_left_values,
-                                                 new_left_ids,
-                                                 new_right_values,
-                                                 new_right_ids,
-                                                 new_merged_values,
-                                                 new_merged_ids,
-                                                 Comp>;
-        // this is output
-        using merged_values = typename merge::merged_values;
-        using merged_ids    = typename merge::merged_ids;
-    };
-
-    template <typename LeftValues,
-              typename LeftIds,
-              typename MergedValues,
-              typename MergedIds,
-              typename Comp>
-    struct sorted_sequence_merge_impl<LeftValues,
-                                      LeftIds,
-                                      Sequence<>,
-                                      Sequence<>,
-                                      MergedValues,
-                                      MergedIds,
-                                      Comp>
-    {
-        using merged_values = typename sequence_merge<MergedValues, LeftValues>::type;
-        using merged_ids    = typename sequence_merge<MergedIds, LeftIds>::type;
-    };
-
-    template <typename RightValues,
-              typename RightIds,
-              typename MergedValues,
-              typename MergedIds,
-              typename Comp>
-    struct sorted_sequence_merge_impl<Sequence<>,
-                                      Sequence<>,
-                                      RightValues,
-                                      RightIds,
-                                      MergedValues,
-                                      MergedIds,
-                                      Comp>
+namespace detail {
+
+// Insertion sort of (value, id) pairs as a single constexpr loop. Elements comparing equal end up
+// in reverse of their original order, the same as the merge sort this replaced, so
+// sorted2unsorted_map does not change for existing users.
+// Result layout: [0, N) sorted values, [N, 2N) their original ids, [2N] number of unique values
+template <typename Values, typename Compare>
+struct sequence_sort_gen
+{
+    static constexpr index_t nsize = Values::Size();
+
+    __host__ __device__ static constexpr bool
+    IsBefore(index_t value_x, index_t id_x, index_t value_y, index_t id_y)
     {
-        using merged_values = typename sequence_merge<MergedValues, RightValues>::type;
-        using merged_ids    = typename sequence_merge<MergedIds, RightIds>::type;
-    };
-
-    template <typename LeftValues,
-              typename LeftIds,
-              typename RightValues,
-              typename RightIds,
-              typename Comp>
-    struct sorted_sequence_merge
+        return Compare{}(value_x, value_y) || (!Compare{}(value_y, value_x) && id_x > id_y);
+    }
+
+    __host__ __device__ constexpr auto operator()() const
     {
-        using merge = sorted_sequence_merge_impl<LeftValues,
-                                                 LeftIds,
-                                                 RightValues,
-                                                 RightIds,
-                                                 Sequence<>,
-                                                 Sequence<>,
-                                                 Comp>;
-
-        using merged_values = typename merge::merged_values;
-        using merged_ids    = typename merge::merged_ids;
-    };
+        sequence_array<2 * nsize + 1> r{};
 
-    static constexpr index_t nsize = Values::Size();
+        for(index_t i = 0; i < nsize; ++i)
+        {
+            const index_t value = Values::At(i);
 
-    using split_unsorted_values = sequence_split<Values, nsize / 2>;
-    using split_unsorted_ids    = sequence_split<Ids, nsize / 2>;
+            index_t j = i;
 
-    using left_unsorted_values = typename split_unsorted_values::left_type;
-    using left_unsorted_ids    = typename split_unsorted_ids::left_type;
-    using left_sort          = sequence_sort_impl<left_unsorted_values, left_unsorted_ids, Compare>;
-    using left_sorted_values = typename left_sort::sorted_values;
-    using left_sorted_ids    = typename left_sort::sorted_ids;
+            for(; j > 0 && IsBefore(value, i, r[j - 1], r[nsize + j - 1]); --j)
+            {
+                r[j]         = r[j - 1];
+                r[nsize + j] = r[nsize + j - 1];
+            }
 
-    using right_unsorted_values = typename split_unsorted_values::right_type;
-    using right_unsorted_ids    = typename split_unsorted_ids::right_type;
-    using right_sort = sequence_sort_impl<right_unsorted_values, right_unsorted_ids, Compare>;
-    using right_sorted_values = typename right_sort::sorted_values;
-    using right_sorted_ids    = typename right_sort::sorted_ids;
+            r[j]         = value;
+            r[nsize + j] = i;
+        }
 
-    using merged_sorted = sorted_sequence_merge<left_sorted_values,
-                                                left_sorted_ids,
-                                                right_sorted_values,
-                                                right_sorted_ids,
-                                                Compare>;
+        for(index_t i = 0; i < nsize; ++i)
+        {
+            r[2 * nsize] += (i == 0 || r[i] != r[i - 1]) ? 1 : 0;
+        }
 
-    using sorted_values = typename merged_sorted::merged_values;
-    using sorted_ids    = typename merged_sorted::merged_ids;
+        return r;
+    }
 };
 
-template <index_t ValueX, index_t ValueY, index_t IdX, index_t IdY, typename Compare>
-struct sequence_sort_impl<Sequence<ValueX, ValueY>, Sequence<IdX, IdY>, Compare>
+// keep the first element of every run of equal values in sorted order
+// Result layout: [0, N) unique values, [N, 2N) their original ids
+template <typename Values, typename Less>
+struct sequence_unique_sort_gen
 {
-    static constexpr bool choose_x = Compare{}(ValueX, ValueY);
+    static constexpr index_t nsize = Values::Size();
 
-    using sorted_values =
-        typename conditional<choose_x, Sequence<ValueX, ValueY>, Sequence<ValueY, ValueX>>::type;
-    using sorted_ids = typename conditional<choose_x, Sequence<IdX, IdY>, Sequence<IdY, IdX>>::type;
+    __host__ __device__ constexpr auto operator()() const
+    {
+        constexpr auto sorted = sequence_array_constant<sequence_sort_gen<Values, Less>>::value;
+
+        sequence_array<2 * nsize> r{};
+
+        index_t n = 0;
+
+        for(index_t i = 0; i < nsize; ++i)
+        {
+            if(i == 0 || sorted[i] != sorted[i - 1])
+            {
+                r[n]         = sorted[i];
+                r[nsize + n] = sorted[nsize + i];
+                ++n;
+            }
+        }
+
+        return r;
+    }
 };
 
-template <index_t Value, index_t Id, typename Compare>
-struct sequence_sort_impl<Sequence<Value>, Sequence<Id>, Compare>
+template <typename SeqMap>
+__host__ __device__ constexpr bool is_valid_sequence_map_impl()
 {
-    using sorted_values = Sequence<Value>;
-    using sorted_ids    = Sequence<Id>;
-};
+    constexpr index_t nsize = SeqMap::Size();
+
+    bool seen[nsize + 1] = {};
 
-template <typename Compare>
-struct sequence_sort_impl<Sequence<>, Sequence<>, Compare>
+    for(index_t i = 0; i < nsize; ++i)
+    {
+        const index_t x = SeqMap::At(i);
+
+        if(x < 0 || x >= nsize || seen[x])
+        {
+            return false;
+        }
+
+        seen[x] = true;
+    }
+
+    return true;
+}
+
+template <typename SeqMap>
+struct sequence_map_inverse_gen
 {
-    using sorted_values = Sequence<>;
-    using sorted_ids    = Sequence<>;
+    __host__ __device__ constexpr auto operator()() const
+    {
+        sequence_array<SeqMap::Size()> y2x{};
+
+        for(index_t x = 0; x < SeqMap::Size(); ++x)
+        {
+            y2x[SeqMap::At(x)] = x;
+        }
+
+        return y2x;
+    }
 };
 
+} // namespace detail
+
 template <typename Values, typename Compare>
 struct sequence_sort
 {
-    using unsorted_ids = typename arithmetic_sequence_gen<0, Values::Size(), 1>::type;
-    using sort         = sequence_sort_impl<Values, unsorted_ids, Compare>;
+    using sort = detail::sequence_sort_gen<Values, Compare>;
 
     // this is output
-    using type                = typename sort::sorted_values;
-    using sorted2unsorted_map = typename sort::sorted_ids;
+    using type                = detail::sequence_from_array_t<sort, sort::nsize>;
+    using sorted2unsorted_map = detail::sequence_from_array_t<sort, sort::nsize, sort::nsize>;
 };
 
 template <typename Values, typename Less, typename Equal>
 struct sequence_unique_sort
 {
-    template <typename RemainValues,
-              typename RemainIds,
-              typename UniquifiedValues,
-              typename UniquifiedIds,
-              typename Eq>
-    struct sorted_sequence_uniquify_impl
-    {
-        static constexpr index_t current_value = RemainValues::Front();
-        static constexpr index_t current_id    = RemainIds::Front();
-
-        static constexpr bool is_unique_value = (current_value != UniquifiedValues::Back());
-
-        using new_remain_values = decltype(RemainValues::PopFront());
-        using new_remain_ids    = decltype(RemainIds::PopFront());
-
-        using new_uniquified_values =
-            typename conditional<is_unique_value,
-                                 decltype(UniquifiedValues::PushBack(Number<current_value>{})),
-                                 UniquifiedValues>::type;
-
-        using new_uniquified_ids =
-            typename conditional<is_unique_value,
-                                 decltype(UniquifiedIds::PushBack(Number<current_id>{})),
-                                 UniquifiedIds>::type;
-
-        using uniquify = sorted_sequence_uniquify_impl<new_remain_values,
-                                                       new_remain_ids,
-                                                       new_uniquified_values,
-                                                       new_uniquified_ids,
-                                                       Eq>;
-
-        // this is output
-        using uniquified_values = typename uniquify::uniquified_values;
-        using uniquified_ids    = typename uniquify::uniquified_ids;
-    };
-
-    template <typename UniquifiedValues, typename UniquifiedIds, typename Eq>
-    struct sorted_sequence_uniquify_impl<Sequence<>,
-                                         Sequence<>,
-                                         UniquifiedValues,
-                                         UniquifiedIds,
-                                         Eq>
-    {
-        using uniquified_values = UniquifiedValues;
-        using uniquified_ids    = UniquifiedIds;
-    };
-
-    template <typename SortedValues, typename SortedIds, typename Eq>
-    struct sorted_sequence_uniquify
-    {
-        using uniquify = sorted_sequence_uniquify_impl<decltype(SortedValues::PopFront()),
-                                                       decltype(SortedIds::PopFront()),
-                                                       Sequence<SortedValues::Front()>,
-                                                       Sequence<SortedIds::Front()>,
-                                                       Eq>;
-
-        using uniquified_values = typename uniquify::uniquified_values;
-        using uniquified_ids    = typename uniquify::uniquified_ids;
-    };
+    using uniquify = detail::sequence_unique_sort_gen<Values, Less>;
 
-    using sort          = sequence_sort<Values, Less>;
-    using sorted_values = typename sort::type;
-    using sorted_ids    = typename sort::sorted2unsorted_map;
-
-    using uniquify = sorted_sequence_uniquify<sorted_values, sorted_ids, Equal>;
+    static constexpr index_t nunique =
+        detail::sequence_array_constant<detail::sequence_sort_gen<Values, Less>>::value
+            [2 * uniquify::nsize];
 
     // this is output
-    using type                = typename uniquify::uniquified_values;
-    using sorted2unsorted_map = typename uniquify::uniquified_ids;
+    using type                = detail::sequence_from_array_t<uniquify, nunique>;
+    using sorted2unsorted_map = detail::sequence_from_array_t<uniquify, nunique, uniquify::nsize>;
 };
 
 template <typename SeqMap>
-struct is_valid_sequence_map : is_same<typename arithmetic_sequence_gen<0, SeqMap::Size(), 1>::type,
-                                       typename sequence_sort<SeqMap, math::less<index_t>>::type>
+struct is_valid_sequence_map
+    : integral_constant<bool, detail::is_valid_sequence_map_impl<SeqMap>()>
 {
 };
 
 template <typename SeqMap>
 struct sequence_map_inverse
 {
-    template <typename X2Y, typename WorkingY2X, index_t XBegin, index_t XRemain>
-    struct sequence_map_inverse_impl
-    {
-        static constexpr auto new_y2x =
-            WorkingY2X::Modify(X2Y::At(Number<XBegin>{}), Number<XBegin>{});
-
-        using type =
-            typename sequence_map_inverse_impl<X2Y, decltype(new_y2x), XBegin + 1, XRemain - 1>::
-                type;
-    };
-
-    template <typename X2Y, typename WorkingY2X, index_t XBegin>
-    struct sequence_map_inverse_impl<X2Y, WorkingY2X, XBegin, 0>
-    {
-        using type = WorkingY2X;
-    };
-
     using type =
-        typename sequence_map_inverse_impl<SeqMap,
-                                           typename uniform_sequence_gen<SeqMap::Size(), 0>::type,
-                                           0,
-                                           SeqMap::Size()>::type;
+        detail::sequence_from_array_t<detail::sequence_map_inverse_gen<SeqMap>, SeqMap::Size()>;
 };
 
 template <index_t... Xs, index_t... Ys>
@@ -732,7 +692,7 @@ template <typename Seq>
 __host__ __device__ constexpr auto sequence_pop_back(Seq)
 {
     static_assert(Seq::Size() > 0, "wrong! cannot pop an empty Sequence!");
-    return sequence_pop_front(Seq::Reverse()).Reverse();
+    return Seq::Extract(detail::make_index_sequence<Seq::Size() - 1>{});
 }
 
 template <typename... Seqs>
@@ -791,27 +751,30 @@ __host__ __device__ constexpr auto pick_sequence_elements_by_ids(Seq, Sequence<I
     return Sequence<Seq::At(Number<Is>{})...>{};
 }
 
-#if 1
 namespace detail {
-template <typename WorkSeq, typename RemainSeq, typename RemainMask>
-struct pick_sequence_elements_by_mask_impl
+// Result layout: [0, N) picked elements, [N] number of picked elements
+template <typename Seq, typename Mask>
+struct pick_sequence_elements_by_mask_gen
 {
-    using new_work_seq = typename conditional<RemainMask::Front(),
-                                              decltype(WorkSeq::PushBack(RemainSeq::Front())),
-                                              WorkSeq>::type;
+    __host__ __device__ constexpr auto operator()() const
+    {
+        sequence_array<Seq::Size() + 1> r{};
 
-    using type =
-        typename pick_sequence_elements_by_mask_impl<new_work_seq,
-                                                     decltype(RemainSeq::PopFront()),
-                                                     decltype(RemainMask::PopFront())>::type;
-};
+        index_t n = 0;
 
-template <typename WorkSeq>
-struct pick_sequence_elements_by_mask_impl<WorkSeq, Sequence<>, Sequence<>>
-{
-    using type = WorkSeq;
-};
+        for(index_t i = 0; i < Seq::Size(); ++i)
+        {
+            if(Mask::At(i))
+            {
+                r[n++] = Seq::At(i);
+            }
+        }
+
+        r[Seq::Size()] = n;
 
+        return r;
+    }
+};
 } // namespace detail
 
 template <typename Seq, typename Mask>
@@ -819,25 +782,33 @@ __host__ __device__ constexpr auto pick_sequence_elements_by_mask(Seq, Mask)
 {
     static_assert(Seq::Size() == Mask::Size(), "wrong!");
 
-    return typename detail::pick_sequence_elements_by_mask_impl<Sequence<>, Seq, Mask>::type{};
+    using gen = detail::pick_sequence_elements_by_mask_gen<Seq, Mask>;
+
+    constexpr index_t npick = detail::sequence_array_constant<gen>::value[Seq::Size()];
+
+    return detail::sequence_from_array_t<gen, npick>{};
 }
 
 namespace detail {
-template <typename WorkSeq, typename RemainValues, typename RemainIds>
-struct modify_sequence_elements_by_ids_impl
+template <typename Seq, typename Values, typename Ids>
+struct modify_sequence_elements_by_ids_gen
 {
-    using new_work_seq = decltype(WorkSeq::Modify(RemainIds::Front(), RemainValues::Front()));
+    __host__ __device__ constexpr auto operator()() const
+    {
+        sequence_array<Seq::Size()> r{};
 
-    using type =
-        typename modify_sequence_elements_by_ids_impl<new_work_seq,
-                                                      decltype(RemainValues::PopFront()),
-                                                      decltype(RemainIds::PopFront())>::type;
-};
+        for(index_t i = 0; i < Seq::Size(); ++i)
+        {
+            r[i] = Seq::At(i);
+        }
 
-template <typename WorkSeq>
-struct modify_sequence_elements_by_ids_impl<WorkSeq, Sequence<>, Sequence<>>
-{
-    using type = WorkSeq;
+        for(index_t i = 0; i < Ids::Size(); ++i)
+        {
+            r[Ids::At(i)] = Values::At(i);
+        }
+
+        return r;
+    }
 };
 } // namespace detail
 
@@ -846,9 +817,10 @@ __host__ __device__ constexpr auto modify_sequence_elements_by_ids(Seq, Values,
 {
     static_assert(Values::Size() == Ids::Size() && Seq::Size() >= Values::Size(), "wrong!");
 
-    return typename detail::modify_sequence_elements_by_ids_impl<Seq, Values, Ids>::type{};
+    using gen = detail::modify_sequence_elements_by_ids_gen<Seq, Values, Ids>;
+
+    return detail::sequence_from_array_t<gen, Seq::Size()>{};
 }
-#endif
 
 template <typename Seq, typename Reduce, index_t Init>
 __host__ __device__ constexpr index_t
@@ -204,6 +204,15 @@ struct tuple_element
     using type = decltype(detail::get_tuple_element_data<detail::TupleElementKey<I>>(TTuple{}));
 };
 
+#if __has_builtin(__type_pack_element)
+// direct pack indexing instead of overload resolution over all element bases
+template <index_t I, typename... Xs>
+struct tuple_element<I, Tuple<Xs...>>
+{
+    using type = __type_pack_element<I, Xs...>;
+};
+#endif
+
 template <index_t I, typename TTuple>
 using tuple_element_t = typename tuple_element<I, TTuple>::type;
 
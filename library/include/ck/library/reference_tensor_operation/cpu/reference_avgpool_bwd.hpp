@@ -5,10 +5,14 @@
 
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_sliding_window.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -58,8 +62,6 @@ struct ReferenceAvgPoolBwd : public device::BaseOperator
     {
         using Argument = ReferenceAvgPoolBwd::Argument;
 
-        template <ck::index_t NDimSpatial_,
-                  typename std::enable_if<NDimSpatial_ == 1, bool>::type = false>
         float RunAvgPoolBwd(const Argument& arg)
         {
             // Let input = x, outpu = y
@@ -70,9 +72,6 @@ struct ReferenceAvgPoolBwd : public device::BaseOperator
             // y1 = 1/5 * (x1 + x2 + x3 + x4 + x5)
             // ...
             // y5 = 1/5 * (x5 + x6 + x7 + x8 + x9)
-            // y6 = 1/5 * (x6 + x7 + x8 + x9)
-            // ...
-            // y9 = 1/5 * (x9)
 
             // Backward:
             // shape of dy = [6], dx = [10]
@@ -83,200 +82,52 @@ struct ReferenceAvgPoolBwd : public device::BaseOperator
             // dx4 = 1/5 * (dy0 + dy1 + dy2 + dy3 + dy4)
             // dx5 = 1/5 * (dy1 + dy2 + dy3 + dy4 + dy5)
             // ...
-            // dx9 = 1/5 * (dy5 + dy6 + dy7 + dy8 + dy9)
-
-            auto f_ncw = [&](auto n, auto c, auto wi) {
-                std::size_t X  = arg.window_spatial_lengths_[0];
-                std::size_t Wo = arg.doutput_.GetLengths()[2];
-
-                float v_acc = 0;
-
-                for(std::size_t x = 0; x < X; ++x)
-                {
-                    // Out_Position = (In_Position + pad - x * dilation) / stride
-                    auto w_tmp = static_cast<ck::long_index_t>(wi) +
-                                 static_cast<ck::long_index_t>(arg.in_left_pads_[0]) -
-                                 static_cast<ck::long_index_t>(x * arg.window_dilations_[0]);
-
-                    // Check the input pixel validity (in perspective of being affected by some
-                    // doutput pixel)
-                    if(w_tmp % arg.window_strides_[0] == 0)
-                    {
-                        auto wo = static_cast<ck::long_index_t>(w_tmp) /
-                                  static_cast<ck::long_index_t>(arg.window_strides_[0]);
-
-                        // Get the doutput pixel in valid range to accumulate the gradients for this
-                        // input pixel
-                        if(wo >= 0 && ck::type_convert<std::size_t>(wo) < Wo)
-                        {
-                            v_acc += ck::type_convert<float>(arg.doutput_(n, c, wo));
-                        }
-                    }
-                }
-
-                v_acc /= ck::type_convert<float>(X);
-                arg.dinput_(n, c, wi) = ck::type_convert<DInDataType>(v_acc);
-            };
-
-            make_ParallelTensorFunctor(f_ncw,
-                                       arg.dinput_.GetLengths()[0],
-                                       arg.dinput_.GetLengths()[1],
-                                       arg.dinput_.GetLengths()[2])(
-                std::thread::hardware_concurrency());
+            // dx9 = 1/5 * (dy5)
 
-            return 0;
-        }
+            // The window sum of the forward pass is separable, and so is its adjoint: every
+            // spatial axis of dy is expanded to the dx positions in turn, each position gathering
+            // the contiguous range of outputs whose windows reach it from prefix sums. The cost is
+            // independent of the window size and the tasks never write to the same element.
+            using detail::SlidingWindow;
 
-        template <ck::index_t NDimSpatial_,
-                  typename std::enable_if<NDimSpatial_ == 2, bool>::type = false>
-        float RunAvgPoolBwd(const Argument& arg)
-        {
-            auto f_nchw = [&](auto n, auto c, auto hi, auto wi) {
-                std::size_t Y = arg.window_spatial_lengths_[0];
-                std::size_t X = arg.window_spatial_lengths_[1];
-
-                std::size_t Ho = arg.doutput_.GetLengths()[2];
-                std::size_t Wo = arg.doutput_.GetLengths()[3];
-
-                float v_acc = 0;
-
-                for(std::size_t y = 0; y < Y; ++y)
-                {
-                    // Out_Position = (In_Position + pad - x * dilation) / stride
-                    auto h_tmp = static_cast<ck::long_index_t>(hi) +
-                                 static_cast<ck::long_index_t>(arg.in_left_pads_[0]) -
-                                 static_cast<ck::long_index_t>(y * arg.window_dilations_[0]);
-
-                    // Check the input pixel validity (in perspective of being affected by some
-                    // doutput pixel)
-                    if(h_tmp % arg.window_strides_[0] == 0)
-                    {
-                        auto ho = static_cast<ck::long_index_t>(h_tmp) /
-                                  static_cast<ck::long_index_t>(arg.window_strides_[0]);
-
-                        // Get the doutput pixel in valid range to accumulate the gradients for this
-                        // input pixel
-                        if(ho >= 0 && ck::type_convert<std::size_t>(ho) < Ho)
-                        {
-                            for(std::size_t x = 0; x < X; ++x)
-                            {
-                                auto w_tmp =
-                                    static_cast<ck::long_index_t>(wi) +
-                                    static_cast<ck::long_index_t>(arg.in_left_pads_[1]) -
-                                    static_cast<ck::long_index_t>(x * arg.window_dilations_[1]);
-                                if(w_tmp % arg.window_strides_[1] == 0)
-                                {
-                                    auto wo = static_cast<ck::long_index_t>(w_tmp) /
-                                              static_cast<ck::long_index_t>(arg.window_strides_[1]);
-                                    if(wo >= 0 && ck::type_convert<std::size_t>(wo) < Wo)
-                                    {
-                                        v_acc +=
-                                            ck::type_convert<float>(arg.doutput_(n, c, ho, wo));
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-
-                v_acc /= ck::type_convert<float>(Y * X);
-                arg.dinput_(n, c, hi, wi) = ck::type_convert<DInDataType>(v_acc);
-            };
-
-            make_ParallelTensorFunctor(f_nchw,
-                                       arg.dinput_.GetLengths()[0],
-                                       arg.dinput_.GetLengths()[1],
-                                       arg.dinput_.GetLengths()[2],
-                                       arg.dinput_.GetLengths()[3])(
-                std::thread::hardware_concurrency());
+            const std::size_t num_thread = std::thread::hardware_concurrency();
 
-            return 0;
-        }
+            std::vector<std::size_t> lengths = arg.doutput_.GetLengths();
+            std::vector<double> buf(arg.doutput_.GetElementSize());
 
-        template <ck::index_t NDimSpatial_,
-                  typename std::enable_if<NDimSpatial_ == 3, bool>::type = false>
-        float RunAvgPoolBwd(const Argument& arg)
-        {
-            auto f_ncdhw = [&](auto n, auto c, auto di, auto hi, auto wi) {
-                std::size_t Z = arg.window_spatial_lengths_[0];
-                std::size_t Y = arg.window_spatial_lengths_[1];
-                std::size_t X = arg.window_spatial_lengths_[2];
-
-                std::size_t Do = arg.doutput_.GetLengths()[2];
-                std::size_t Ho = arg.doutput_.GetLengths()[3];
-                std::size_t Wo = arg.doutput_.GetLengths()[4];
-
-                float v_acc = 0;
-
-                for(std::size_t z = 0; z < Z; ++z)
-                {
-                    // Out_Position = (In_Position + pad - x * dilation) / stride
-                    auto d_tmp = static_cast<ck::long_index_t>(di) +
-                                 static_cast<ck::long_index_t>(arg.in_left_pads_[0]) -
-                                 static_cast<ck::long_index_t>(z * arg.window_dilations_[0]);
-
-                    // Check the input pixel validity (in perspective of being affected by some
-                    // doutput pixel)
-                    if(d_tmp % arg.window_strides_[0] == 0)
-                    {
-                        auto do_ = static_cast<ck::long_index_t>(d_tmp) /
-                                   static_cast<ck::long_index_t>(arg.window_strides_[0]);
-
-                        // Get the doutput pixel in valid range to accumulate the gradients for this
-                        // input pixel
-                        if(do_ >= 0 && ck::type_convert<std::size_t>(do_) < Do)
-                        {
-                            for(std::size_t y = 0; y < Y; ++y)
-                            {
-                                auto h_tmp =
-                                    static_cast<ck::long_index_t>(hi) +
-                                    static_cast<ck::long_index_t>(arg.in_left_pads_[1]) -
-                                    static_cast<ck::long_index_t>(y * arg.window_dilations_[1]);
-                                if(h_tmp % arg.window_strides_[1] == 0)
-                                {
-                                    auto ho = static_cast<ck::long_index_t>(h_tmp) /
-                                              static_cast<ck::long_index_t>(arg.window_strides_[1]);
-                                    if(ho >= 0 && ck::type_convert<std::size_t>(ho) < Ho)
-                                    {
-                                        for(std::size_t x = 0; x < X; ++x)
-                                        {
-                                            auto w_tmp = static_cast<ck::long_index_t>(wi) +
-                                                         static_cast<ck::long_index_t>(
-                                                             arg.in_left_pads_[2]) -
-                                                         static_cast<ck::long_index_t>(
-                                                             x * arg.window_dilations_[2]);
-
-                                            if(w_tmp % arg.window_strides_[2] == 0)
-                                            {
-                                                auto wo = static_cast<ck::long_index_t>(w_tmp) /
-                                                          static_cast<ck::long_index_t>(
-                                                              arg.window_strides_[2]);
-                                                if(wo >= 0 &&
-                                                   ck::type_convert<std::size_t>(wo) < Wo)
-                                                {
-                                                    v_acc += ck::type_convert<float>(
-                                                        arg.doutput_(n, c, do_, ho, wo));
-                                                }
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-
-                v_acc /= ck::type_convert<float>(Z * Y * X);
-                arg.dinput_(n, c, di, hi, wi) = ck::type_convert<DInDataType>(v_acc);
-            };
-
-            make_ParallelTensorFunctor(f_ncdhw,
-                                       arg.dinput_.GetLengths()[0],
-                                       arg.dinput_.GetLengths()[1],
-                                       arg.dinput_.GetLengths()[2],
-                                       arg.dinput_.GetLengths()[3],
-                                       arg.dinput_.GetLengths()[4])(
-                std::thread::hardware_concurrency());
+            make_ParallelTensorFunctor(
+                [&](auto i) {
+                    buf[i] = detail::to_double(
+                        arg.doutput_.mData[detail::packed_to_offset(i, arg.doutput_.mDesc)]);
+                },
+                buf.size())(num_thread);
+
+            double window_size = 1;
+            for(ck::index_t i = 0; i < NDimSpatial; ++i)
+            {
+                const SlidingWindow window{arg.window_spatial_lengths_[i],
+                                           arg.window_strides_[i],
+                                           arg.window_dilations_[i],
+                                           arg.in_left_pads_[i]};
+
+                buf = detail::transform_axis(buf,
+                                             lengths,
+                                             2 + i,
+                                             arg.dinput_.GetLengths()[2 + i],
+                                             [&](const auto& in, auto& out) {
+                                                 detail::sliding_window_sum_transposed(
+                                                     in, out, window);
+                                             });
+
+                window_size *= arg.window_spatial_lengths_[i];
+            }
+
+            make_ParallelTensorFunctor(
+                [&](auto i) {
+                    arg.dinput_.mData[detail::packed_to_offset(i, arg.dinput_.mDesc)] =
+                        detail::from_double<DInDataType>(buf[i] / window_size);
+                },
+                buf.size())(num_thread);
 
             return 0;
         }
@@ -289,7 +140,7 @@ struct ReferenceAvgPoolBwd : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
-            return RunAvgPoolBwd<NDimSpatial>(arg);
+            return RunAvgPoolBwd(arg);
         }
 
         float Run(const device::BaseArgument* p_arg,
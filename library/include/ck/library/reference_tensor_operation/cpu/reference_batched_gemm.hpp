@@ -3,11 +3,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_blocked_gemm.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -25,9 +29,9 @@ struct ReferenceBatchedGemm : public device::BaseOperator
     // Argument
     struct Argument : public device::BaseArgument
     {
-        Argument(const Tensor<ADataType>& a_g_m_k,
-                 const Tensor<BDataType>& b_g_k_n,
-                 Tensor<CDataType>& c_g_m_n,
+        Argument(TensorView<const ADataType> a_g_m_k,
+                 TensorView<const BDataType> b_g_k_n,
+                 TensorView<CDataType> c_g_m_n,
                  AElementwiseOperation a_element_op,
                  BElementwiseOperation b_element_op,
                  CElementwiseOperation c_element_op)
@@ -40,9 +44,9 @@ struct ReferenceBatchedGemm : public device::BaseOperator
         {
         }
 
-        const Tensor<ADataType>& a_g_m_k_;
-        const Tensor<BDataType>& b_g_k_n_;
-        Tensor<CDataType>& c_g_m_n_;
+        TensorView<const ADataType> a_g_m_k_;
+        TensorView<const BDataType> b_g_k_n_;
+        TensorView<CDataType> c_g_m_n_;
 
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
@@ -103,9 +107,9 @@ struct ReferenceBatchedGemm : public device::BaseOperator
 
     bool IsSupportedArgument(const device::BaseArgument*) override { return true; }
 
-    static auto MakeArgument(const Tensor<ADataType>& a_g_m_k,
-                             const Tensor<BDataType>& b_g_k_n,
-                             Tensor<CDataType>& c_g_m_n,
+    static auto MakeArgument(TensorView<const ADataType> a_g_m_k,
+                             TensorView<const BDataType> b_g_k_n,
+                             TensorView<CDataType> c_g_m_n,
                              AElementwiseOperation a_element_op,
                              BElementwiseOperation b_element_op,
                              CElementwiseOperation c_element_op)
@@ -133,6 +137,89 @@ struct ReferenceBatchedGemm : public device::BaseOperator
     }
 };
 
+namespace detail {
+
+// C[g0, g1] = A[g0, g1] * B[g0, g1 * kv_heads / G1] for the [G0, G1, M, K] queries A sharing the
+// [G0, kv_heads, K, N] key/value heads B. Every B[g0, kv] is converted to AccDataType and packed
+// into a K x N panel once; the query heads of kv then run against it with blocked_gemm() in row
+// blocks of MPerTile, parallelized over (g0, kv, M tile).
+template <typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename AccDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation,
+          typename CElementwiseOperation>
+void run_shared_panel_batched_gemm(TensorView<const ADataType> a_g0_g1_m_k,
+                                   TensorView<const BDataType> b_g0_gkv_k_n,
+                                   TensorView<CDataType> c_g0_g1_m_n,
+                                   std::size_t kv_heads,
+                                   AElementwiseOperation a_element_op,
+                                   BElementwiseOperation b_element_op,
+                                   CElementwiseOperation c_element_op)
+{
+    constexpr std::size_t MPerTile = 16;
+
+    const std::size_t G0 = c_g0_g1_m_n.GetLengths()[0];
+    const std::size_t G1 = c_g0_g1_m_n.GetLengths()[1];
+    const std::size_t M  = c_g0_g1_m_n.GetLengths()[2];
+    const std::size_t N  = c_g0_g1_m_n.GetLengths()[3];
+    const std::size_t K  = a_g0_g1_m_k.GetLengths()[3];
+
+    const std::size_t num_thread = std::thread::hardware_concurrency();
+
+    // b_panels[(g0 * kv_heads + kv) * K * N + k * N + n]
+    std::vector<AccDataType> b_panels(G0 * kv_heads * K * N);
+
+    auto f_pack_b = [&](auto g0, auto kv) {
+        AccDataType* p_panel = &b_panels[(g0 * kv_heads + kv) * K * N];
+        for(std::size_t k = 0; k < K; ++k)
+            for(std::size_t n = 0; n < N; ++n)
+            {
+                BDataType v_b;
+                b_element_op(v_b, b_g0_gkv_k_n(g0, kv, k, n));
+                p_panel[k * N + n] = ck::type_convert<AccDataType>(v_b);
+            }
+    };
+
+    make_ParallelTensorFunctor(f_pack_b, G0, kv_heads)(num_thread);
+
+    auto f_tile = [&](auto g0, auto kv, auto m_tile) {
+        const AccDataType* p_panel = &b_panels[(g0 * kv_heads + kv) * K * N];
+
+        const std::size_t m_begin = m_tile * MPerTile;
+        const std::size_t m_end   = std::min(M, m_begin + MPerTile);
+
+        // query heads g1 with g1 * kv_heads / G1 == kv
+        const std::size_t g1_begin = (kv * G1 + kv_heads - 1) / kv_heads;
+        const std::size_t g1_end   = ((kv + 1) * G1 + kv_heads - 1) / kv_heads;
+
+        std::vector<AccDataType> a_panel(MPerTile * K);
+
+        for(std::size_t g1 = g1_begin; g1 < g1_end; ++g1)
+        {
+            for(std::size_t m = m_begin; m < m_end; ++m)
+                for(std::size_t k = 0; k < K; ++k)
+                {
+                    ADataType v_a;
+                    a_element_op(v_a, a_g0_g1_m_k(g0, g1, m, k));
+                    a_panel[(m - m_begin) * K + k] = ck::type_convert<AccDataType>(v_a);
+                }
+
+            blocked_gemm(
+                a_panel.data(), p_panel, m_end - m_begin, N, K, [&](auto i, auto n, auto acc) {
+                    AccDataType v_c;
+                    c_element_op(v_c, acc);
+                    c_g0_g1_m_n(g0, g1, m_begin + i, n) = ck::type_convert<CDataType>(v_c);
+                });
+        }
+    };
+
+    make_ParallelTensorFunctor(f_tile, G0, kv_heads, (M + MPerTile - 1) / MPerTile)(num_thread);
+}
+
+} // namespace detail
+
 template <typename ADataType,
           typename BDataType,
           typename CDataType,
@@ -145,9 +232,9 @@ struct ReferenceBatchedGemm_MQA : public device::BaseOperator
     // Argument
     struct Argument : public device::BaseArgument
     {
-        Argument(const Tensor<ADataType>& a_g0_g1_m_k,
-                 const Tensor<BDataType>& b_g0_1_k_n,
-                 Tensor<CDataType>& c_g0_g1_m_n,
+        Argument(TensorView<const ADataType> a_g0_g1_m_k,
+                 TensorView<const BDataType> b_g0_1_k_n,
+                 TensorView<CDataType> c_g0_g1_m_n,
                  AElementwiseOperation a_element_op,
                  BElementwiseOperation b_element_op,
                  CElementwiseOperation c_element_op)
@@ -160,9 +247,9 @@ struct ReferenceBatchedGemm_MQA : public device::BaseOperator
         {
         }
 
-        const Tensor<ADataType>& a_g0_g1_m_k_;
-        const Tensor<BDataType>& b_g0_1_k_n_;
-        Tensor<CDataType>& c_g0_g1_m_n_;
+        TensorView<const ADataType> a_g0_g1_m_k_;
+        TensorView<const BDataType> b_g0_1_k_n_;
+        TensorView<CDataType> c_g0_g1_m_n_;
 
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
@@ -176,36 +263,14 @@ struct ReferenceBatchedGemm_MQA : public device::BaseOperator
 
         float Run(const Argument& arg)
         {
-            auto f_g0g1mk_g01kn_g0g1mn = [&](auto g0, auto g1, auto m, auto n) {
-                const int K = arg.a_g0_g1_m_k_.mDesc.GetLengths()[3];
-
-                AccDataType v_acc = 0;
-
-                for(int k = 0; k < K; ++k)
-                {
-                    ADataType v_a;
-                    BDataType v_b;
-
-                    arg.a_element_op_(v_a, arg.a_g0_g1_m_k_(g0, g1, m, k));
-                    arg.b_element_op_(v_b, arg.b_g0_1_k_n_(g0, 0, k, n));
-
-                    v_acc +=
-                        ck::type_convert<AccDataType>(v_a) * ck::type_convert<AccDataType>(v_b);
-                }
-
-                AccDataType v_c;
-
-                arg.c_element_op_(v_c, v_acc);
-
-                arg.c_g0_g1_m_n_(g0, g1, m, n) = ck::type_convert<CDataType>(v_c);
-            };
-
-            make_ParallelTensorFunctor(f_g0g1mk_g01kn_g0g1mn,
-                                       arg.c_g0_g1_m_n_.mDesc.GetLengths()[0],
-                                       arg.c_g0_g1_m_n_.mDesc.GetLengths()[1],
-                                       arg.c_g0_g1_m_n_.mDesc.GetLengths()[2],
-                                       arg.c_g0_g1_m_n_.mDesc.GetLengths()[3])(
-                std::thread::hardware_concurrency());
+            detail::run_shared_panel_batched_gemm<ADataType, BDataType, CDataType, AccDataType>(
+                arg.a_g0_g1_m_k_,
+                arg.b_g0_1_k_n_,
+                arg.c_g0_g1_m_n_,
+                1,
+                arg.a_element_op_,
+                arg.b_element_op_,
+                arg.c_element_op_);
             return 0;
         }
 
@@ -224,9 +289,9 @@ struct ReferenceBatchedGemm_MQA : public device::BaseOperator
 
     bool IsSupportedArgument(const device::BaseArgument*) override { return true; }
 
-    static auto MakeArgument(const Tensor<ADataType>& a_g0_g1_m_k,
-                             const Tensor<BDataType>& b_g0_1_k_n,
-                             Tensor<CDataType>& c_g0_g1_m_n,
+    static auto MakeArgument(TensorView<const ADataType> a_g0_g1_m_k,
+                             TensorView<const BDataType> b_g0_1_k_n,
+                             TensorView<CDataType> c_g0_g1_m_n,
                              AElementwiseOperation a_element_op,
                              BElementwiseOperation b_element_op,
                              CElementwiseOperation c_element_op)
@@ -268,9 +333,9 @@ struct ReferenceBatchedGemm_GQA : public device::BaseOperator
     // Argument
     struct Argument : public device::BaseArgument
     {
-        Argument(const Tensor<ADataType>& a_g0_g1_m_k,
-                 const Tensor<BDataType>& b_g0_gq_k_n,
-                 Tensor<CDataType>& c_g0_g1_m_n,
+        Argument(TensorView<const ADataType> a_g0_g1_m_k,
+                 TensorView<const BDataType> b_g0_gq_k_n,
+                 TensorView<CDataType> c_g0_g1_m_n,
                  AElementwiseOperation a_element_op,
                  BElementwiseOperation b_element_op,
                  CElementwiseOperation c_element_op)
@@ -283,9 +348,9 @@ struct ReferenceBatchedGemm_GQA : public device::BaseOperator
         {
         }
 
-        const Tensor<ADataType>& a_g0_g1_m_k_;
-        const Tensor<BDataType>& b_g0_gq_k_n_;
-        Tensor<CDataType>& c_g0_g1_m_n_;
+        TensorView<const ADataType> a_g0_g1_m_k_;
+        TensorView<const BDataType> b_g0_gq_k_n_;
+        TensorView<CDataType> c_g0_g1_m_n_;
 
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
@@ -299,37 +364,14 @@ struct ReferenceBatchedGemm_GQA : public device::BaseOperator
 
         float Run(const Argument& arg)
         {
-            auto f_g0g1mk_g0gqkn_g0g1mn = [&](auto g0, auto g1, auto m, auto n) {
-                const int G1 = arg.a_g0_g1_m_k_.mDesc.GetLengths()[1];
-                const int K  = arg.a_g0_g1_m_k_.mDesc.GetLengths()[3];
-
-                AccDataType v_acc = 0;
-
-                for(int k = 0; k < K; ++k)
-                {
-                    ADataType v_a;
-                    BDataType v_b;
-
-                    arg.a_element_op_(v_a, arg.a_g0_g1_m_k_(g0, g1, m, k));
-                    arg.b_element_op_(v_b, arg.b_g0_gq_k_n_(g0, g1 * QueryGroupNumber / G1, k, n));
-
-                    v_acc +=
-                        ck::type_convert<AccDataType>(v_a) * ck::type_convert<AccDataType>(v_b);
-                }
-
-                AccDataType v_c;
-
-                arg.c_element_op_(v_c, v_acc);
-
-                arg.c_g0_g1_m_n_(g0, g1, m, n) = ck::type_convert<CDataType>(v_c);
-            };
-
-            make_ParallelTensorFunctor(f_g0g1mk_g0gqkn_g0g1mn,
-                                       arg.c_g0_g1_m_n_.mDesc.GetLengths()[0],
-                                       arg.c_g0_g1_m_n_.mDesc.GetLengths()[1],
-                                       arg.c_g0_g1_m_n_.mDesc.GetLengths()[2],
-                                       arg.c_g0_g1_m_n_.mDesc.GetLengths()[3])(
-                std::thread::hardware_concurrency());
+            detail::run_shared_panel_batched_gemm<ADataType, BDataType, CDataType, AccDataType>(
+                arg.a_g0_g1_m_k_,
+                arg.b_g0_gq_k_n_,
+                arg.c_g0_g1_m_n_,
+                QueryGroupNumber,
+                arg.a_element_op_,
+                arg.b_element_op_,
+                arg.c_element_op_);
             return 0;
         }
 
@@ -348,9 +390,9 @@ struct ReferenceBatchedGemm_GQA : public device::BaseOperator
 
     bool IsSupportedArgument(const device::BaseArgument*) override { return true; }
 
-    static auto MakeArgument(const Tensor<ADataType>& a_g0_g1_m_k,
-                             const Tensor<BDataType>& b_g0_gq_k_n,
-                             Tensor<CDataType>& c_g0_g1_m_n,
+    static auto MakeArgument(TensorView<const ADataType> a_g0_g1_m_k,
+                             TensorView<const BDataType> b_g0_gq_k_n,
+                             TensorView<CDataType> c_g0_g1_m_n,
                              AElementwiseOperation a_element_op,
                              BElementwiseOperation b_element_op,
                              CElementwiseOperation c_element_op)
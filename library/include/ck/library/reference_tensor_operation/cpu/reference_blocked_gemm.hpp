@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+namespace detail {
+
+// Register-blocked GEMM kernel of the host references: C = A * B for the row-major m_size x K
+// panel `a` and the row-major K x N panel `b`, both already converted to AccDataType, calling
+// store(i, n, acc) for every element of C. The accumulators of a MPerBlock x NPerBlock block stay
+// in registers across k, and every element is accumulated over k in order.
+template <typename AccDataType, typename Store>
+void blocked_gemm(const AccDataType* a,
+                  const AccDataType* b,
+                  std::size_t m_size,
+                  std::size_t N,
+                  std::size_t K,
+                  Store&& store)
+{
+    constexpr std::size_t MPerBlock = 4;
+    constexpr std::size_t NPerBlock = 64;
+
+    for(std::size_t m0 = 0; m0 < m_size; m0 += MPerBlock)
+        for(std::size_t n0 = 0; n0 < N; n0 += NPerBlock)
+        {
+            const std::size_t m_block = std::min(MPerBlock, m_size - m0);
+            const std::size_t n_block = std::min(NPerBlock, N - n0);
+
+            AccDataType acc[MPerBlock][NPerBlock] = {};
+
+            for(std::size_t k = 0; k < K; ++k)
+            {
+                const AccDataType* p_b = b + k * N + n0;
+                for(std::size_t i = 0; i < m_block; ++i)
+                {
+                    const AccDataType v_a = a[(m0 + i) * K + k];
+                    for(std::size_t j = 0; j < n_block; ++j)
+                        acc[i][j] += v_a * p_b[j];
+                }
+            }
+
+            for(std::size_t i = 0; i < m_block; ++i)
+                for(std::size_t j = 0; j < n_block; ++j)
+                    store(m0 + i, n0 + j, acc[i][j]);
+        }
+}
+
+} // namespace detail
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <vector>
 
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_blocked_gemm.hpp"
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
 
@@ -14,6 +17,17 @@ namespace ck {
 namespace tensor_operation {
 namespace host {
 
+// Real multiplications per complex multiplication of ReferenceCGemm. Gauss3M computes
+//   Re C = Br (Ar + Ai) - Ai (Br + Bi),  Im C = Br (Ar + Ai) + Ar (Bi - Br)
+// with three real GEMMs, whose cancellation costs some accuracy when the real and imaginary
+// parts differ much in magnitude. Exact4M computes Ar Br - Ai Bi and Ar Bi + Ai Br with four,
+// for checks with tight tolerances.
+enum struct CGemmAlgorithm
+{
+    Gauss3M,
+    Exact4M,
+};
+
 // FIXME: support arbitrary elementwise operation for A/B/C
 template <
     typename ADataType,
@@ -40,7 +54,8 @@ struct ReferenceCGemm : public device::BaseOperator
                  Tensor<CDataType>& c_m_n_imag,
                  AElementwiseOperation a_element_op,
                  BElementwiseOperation b_element_op,
-                 CElementwiseOperation c_element_op)
+                 CElementwiseOperation c_element_op,
+                 CGemmAlgorithm algorithm = CGemmAlgorithm::Gauss3M)
             : a_m_k_real_{a_m_k_real},
               a_m_k_imag_{a_m_k_imag},
               b_k_n_real_{b_k_n_real},
@@ -49,7 +64,8 @@ struct ReferenceCGemm : public device::BaseOperator
               c_m_n_imag_{c_m_n_imag},
               a_element_op_{a_element_op},
               b_element_op_{b_element_op},
-              c_element_op_{c_element_op}
+              c_element_op_{c_element_op},
+              algorithm_{algorithm}
         {
         }
 
@@ -63,6 +79,8 @@ struct ReferenceCGemm : public device::BaseOperator
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
         CElementwiseOperation c_element_op_;
+
+        CGemmAlgorithm algorithm_;
     };
 
     // Invoker
@@ -79,46 +97,96 @@ struct ReferenceCGemm : public device::BaseOperator
                 throw std::runtime_error("wrong! Incompatible real and imag sizes in CGEMM");
             }
 
-            auto f_mk_kn_mn_real = [&](auto m, auto n) {
-                float v_c_real = 0;
+            constexpr std::size_t MPerTile = 16;
 
-                for(std::size_t k = 0; k < K; ++k)
-                {
-                    float v_a_real = ck::type_convert<float>(arg.a_m_k_real_(m, k));
-                    float v_a_imag = ck::type_convert<float>(arg.a_m_k_imag_(m, k));
-                    float v_b_real = ck::type_convert<float>(arg.b_k_n_real_(k, n));
-                    float v_b_imag = ck::type_convert<float>(arg.b_k_n_imag_(k, n));
+            const std::size_t M = arg.c_m_n_real_.mDesc.GetLengths()[0];
+            const std::size_t N = arg.c_m_n_real_.mDesc.GetLengths()[1];
 
-                    v_c_real += v_a_real * v_b_real - v_a_imag * v_b_imag;
-                }
+            const bool gauss = arg.algorithm_ == CGemmAlgorithm::Gauss3M;
 
-                arg.c_m_n_real_(m, n) = ck::type_convert<CDataType>(v_c_real);
-            };
+            const std::size_t num_thread = std::thread::hardware_concurrency();
 
-            auto f_mk_kn_mn_imag = [&](auto m, auto n) {
-                float v_c_imag = 0;
+            // B is read once into K x N panels: Br and Bi, or for Gauss3M Br, Bi - Br (in b_imag)
+            // and Br + Bi
+            std::vector<float> b_real(K * N), b_imag(K * N);
+            std::vector<float> b_sum(gauss ? K * N : 0);
 
-                for(std::size_t k = 0; k < K; ++k)
+            auto f_pack_b = [&](auto k) {
+                for(std::size_t n = 0; n < N; ++n)
                 {
-                    float v_a_real = ck::type_convert<float>(arg.a_m_k_real_(m, k));
-                    float v_a_imag = ck::type_convert<float>(arg.a_m_k_imag_(m, k));
-                    float v_b_real = ck::type_convert<float>(arg.b_k_n_real_(k, n));
-                    float v_b_imag = ck::type_convert<float>(arg.b_k_n_imag_(k, n));
+                    const float v_b_real = ck::type_convert<float>(arg.b_k_n_real_(k, n));
+                    const float v_b_imag = ck::type_convert<float>(arg.b_k_n_imag_(k, n));
+
+                    b_real[k * N + n] = v_b_real;
+                    if(gauss)
+                    {
+                        b_imag[k * N + n] = v_b_imag - v_b_real;
+                        b_sum[k * N + n]  = v_b_real + v_b_imag;
+                    }
+                    else
+                        b_imag[k * N + n] = v_b_imag;
+                }
+            };
 
-                    v_c_imag += v_a_real * v_b_imag + v_a_imag * v_b_real;
+            make_ParallelTensorFunctor(f_pack_b, K)(num_thread);
+
+            // one sweep over the M tiles computes both parts of C from A tiles read once
+            auto f_tile = [&](auto m_tile) {
+                const std::size_t m_begin = m_tile * MPerTile;
+                const std::size_t m_size  = std::min(MPerTile, M - m_begin);
+
+                std::vector<float> a_real(m_size * K), a_imag(m_size * K);
+                std::vector<float> a_sum(gauss ? m_size * K : 0);
+
+                for(std::size_t i = 0; i < m_size; ++i)
+                    for(std::size_t k = 0; k < K; ++k)
+                    {
+                        const float v_a_real =
+                            ck::type_convert<float>(arg.a_m_k_real_(m_begin + i, k));
+                        const float v_a_imag =
+                            ck::type_convert<float>(arg.a_m_k_imag_(m_begin + i, k));
+
+                        a_real[i * K + k] = v_a_real;
+                        a_imag[i * K + k] = v_a_imag;
+                        if(gauss)
+                            a_sum[i * K + k] = v_a_real + v_a_imag;
+                    }
+
+                std::vector<float> c_real(m_size * N), c_imag(m_size * N);
+
+                // f(re, im, t) folds the element t of A * B into the elements re and im of C
+                auto gemm = [&](const std::vector<float>& a, const std::vector<float>& b, auto f) {
+                    detail::blocked_gemm(
+                        a.data(), b.data(), m_size, N, K, [&](auto i, auto n, auto t) {
+                            f(c_real[i * N + n], c_imag[i * N + n], t);
+                        });
+                };
+
+                if(gauss)
+                {
+                    gemm(a_sum, b_real, [](auto& re, auto& im, auto t) { re = im = t; });
+                    gemm(a_imag, b_sum, [](auto& re, auto&, auto t) { re -= t; });
+                    gemm(a_real, b_imag, [](auto&, auto& im, auto t) { im += t; });
+                }
+                else
+                {
+                    gemm(a_real, b_real, [](auto& re, auto&, auto t) { re = t; });
+                    gemm(a_imag, b_imag, [](auto& re, auto&, auto t) { re -= t; });
+                    gemm(a_real, b_imag, [](auto&, auto& im, auto t) { im = t; });
+                    gemm(a_imag, b_real, [](auto&, auto& im, auto t) { im += t; });
                 }
 
-                arg.c_m_n_imag_(m, n) = ck::type_convert<CDataType>(v_c_imag);
+                for(std::size_t i = 0; i < m_size; ++i)
+                    for(std::size_t n = 0; n < N; ++n)
+                    {
+                        arg.c_m_n_real_(m_begin + i, n) =
+                            ck::type_convert<CDataType>(c_real[i * N + n]);
+                        arg.c_m_n_imag_(m_begin + i, n) =
+                            ck::type_convert<CDataType>(c_imag[i * N + n]);
+                    }
             };
 
-            make_ParallelTensorFunctor(f_mk_kn_mn_real,
-                                       arg.c_m_n_real_.mDesc.GetLengths()[0],
-                                       arg.c_m_n_real_.mDesc.GetLengths()[1])(
-                std::thread::hardware_concurrency());
-            make_ParallelTensorFunctor(f_mk_kn_mn_imag,
-                                       arg.c_m_n_imag_.mDesc.GetLengths()[0],
-                                       arg.c_m_n_imag_.mDesc.GetLengths()[1])(
-                std::thread::hardware_concurrency());
+            make_ParallelTensorFunctor(f_tile, (M + MPerTile - 1) / MPerTile)(num_thread);
 
             return 0;
         }
@@ -146,7 +214,8 @@ struct ReferenceCGemm : public device::BaseOperator
                              Tensor<CDataType>& c_m_n_imag,
                              AElementwiseOperation a_element_op,
                              BElementwiseOperation b_element_op,
-                             CElementwiseOperation c_element_op)
+                             CElementwiseOperation c_element_op,
+                             CGemmAlgorithm algorithm = CGemmAlgorithm::Gauss3M)
     {
         return Argument{a_m_k_real,
                         a_m_k_imag,
@@ -156,7 +225,8 @@ struct ReferenceCGemm : public device::BaseOperator
                         c_m_n_imag,
                         a_element_op,
                         b_element_op,
-                        c_element_op};
+                        c_element_op,
+                        algorithm};
     }
 
     static auto MakeInvoker() { return Invoker{}; }
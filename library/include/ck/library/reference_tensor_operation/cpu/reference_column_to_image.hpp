@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <type_traits>
 #include <sstream>
@@ -10,6 +11,8 @@
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/numeric.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_image_column_runs.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -98,175 +101,63 @@ struct ReferenceColumnToImage : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
-            const index_t G = arg.output_.GetLengths()[0];
-            const index_t N = arg.output_.GetLengths()[1];
-            const index_t C = arg.output_.GetLengths()[2];
-
-            if constexpr(NDimSpatial == 1)
-            {
-                const index_t Wo = arg.output_spatial_lengths_[0];
-                auto func        = [&](auto g, auto n) {
-                    for(index_t wo = 0; wo < Wo; ++wo)
-                    {
-                        index_t row    = n * Wo + wo;
-                        index_t column = 0;
-
-                        for(index_t x = 0; x < arg.filter_spatial_lengths_[0]; ++x)
-                        {
-                            auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[0]) +
-                                      static_cast<ck::long_index_t>(x * arg.conv_dilations_[0]) -
-                                      static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-
-                            for(index_t c = 0; c < C; ++c)
-                            {
-                                if(wi >= 0 &&
-                                   ck::type_convert<std::size_t>(wi) < arg.output_.GetLengths()[3])
-                                {
-                                    float v_in =
-                                        ck::type_convert<float>(arg.input_(g, row, column));
-                                    float v_out = ck::type_convert<float>(arg.output_(g, n, c, wi));
-                                    arg.output_(g, n, c, wi) =
-                                        ck::type_convert<OutDataType>(v_in + v_out);
-                                }
-                                column++;
-                            }
-                        }
-                    }
-                };
-
-                make_ParallelTensorFunctor(func, G, N)(std::thread::hardware_concurrency());
-
-                return 0;
-            }
-            else if constexpr(NDimSpatial == 2)
-            {
-                const index_t Ho = arg.output_spatial_lengths_[0];
-                const index_t Wo = arg.output_spatial_lengths_[1];
-
-                auto func = [&](auto g, auto n) {
-                    for(index_t ho = 0; ho < Ho; ++ho)
-                    {
-                        for(index_t wo = 0; wo < Wo; ++wo)
-                        {
-                            index_t row    = n * Ho * Wo + ho * Wo + wo;
-                            index_t column = 0;
-
-                            for(index_t y = 0; y < arg.filter_spatial_lengths_[0]; ++y)
-                            {
-                                auto hi =
-                                    static_cast<ck::long_index_t>(ho * arg.conv_strides_[0]) +
-                                    static_cast<ck::long_index_t>(y * arg.conv_dilations_[0]) -
-                                    static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-
-                                for(index_t x = 0; x < arg.filter_spatial_lengths_[1]; ++x)
-                                {
-                                    auto wi =
-                                        static_cast<ck::long_index_t>(wo * arg.conv_strides_[1]) +
-                                        static_cast<ck::long_index_t>(x * arg.conv_dilations_[1]) -
-                                        static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-
-                                    for(index_t c = 0; c < C; ++c)
-                                    {
-
-                                        if(hi >= 0 &&
-                                           ck::type_convert<std::size_t>(hi) <
-                                               arg.output_.GetLengths()[3] &&
-                                           wi >= 0 &&
-                                           ck::type_convert<std::size_t>(wi) <
-                                               arg.output_.GetLengths()[4])
-                                        {
-                                            float v_in =
-                                                ck::type_convert<float>(arg.input_(g, row, column));
-                                            float v_out = ck::type_convert<float>(
-                                                arg.output_(g, n, c, hi, wi));
-                                            arg.output_(g, n, c, hi, wi) =
-                                                ck::type_convert<OutDataType>(v_in + v_out);
-                                        }
-                                        column++;
-                                    }
-                                }
-                            }
-                        }
-                    }
-                };
-
-                make_ParallelTensorFunctor(func, G, N)(std::thread::hardware_concurrency());
-
-                return 0;
-            }
-            else if constexpr(NDimSpatial == 3)
-            {
-                const index_t Do = arg.output_spatial_lengths_[0];
-                const index_t Ho = arg.output_spatial_lengths_[1];
-                const index_t Wo = arg.output_spatial_lengths_[2];
-
-                auto func = [&](auto g, auto n) {
-                    for(index_t d_o = 0; d_o < Do; ++d_o)
-                    {
-                        for(index_t ho = 0; ho < Ho; ++ho)
-                        {
-                            for(index_t wo = 0; wo < Wo; ++wo)
-                            {
-                                index_t row    = n * Do * Ho * Wo + d_o * Ho * Wo + ho * Wo + wo;
-                                index_t column = 0;
-
-                                for(index_t z = 0; z < arg.filter_spatial_lengths_[0]; ++z)
-                                {
-                                    auto di =
-                                        static_cast<ck::long_index_t>(d_o * arg.conv_strides_[0]) +
-                                        static_cast<ck::long_index_t>(z * arg.conv_dilations_[0]) -
-                                        static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-                                    for(index_t y = 0; y < arg.filter_spatial_lengths_[1]; ++y)
-                                    {
-                                        auto hi =
-                                            static_cast<ck::long_index_t>(ho *
-                                                                          arg.conv_strides_[1]) +
-                                            static_cast<ck::long_index_t>(y *
-                                                                          arg.conv_dilations_[1]) -
-                                            static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-                                        for(index_t x = 0; x < arg.filter_spatial_lengths_[2]; ++x)
-                                        {
-                                            auto wi =
-                                                static_cast<ck::long_index_t>(
-                                                    wo * arg.conv_strides_[2]) +
-                                                static_cast<ck::long_index_t>(
-                                                    x * arg.conv_dilations_[2]) -
-                                                static_cast<ck::long_index_t>(arg.in_left_pads_[2]);
-                                            for(index_t c = 0; c < C; ++c)
-                                            {
-                                                if(di >= 0 &&
-                                                   ck::type_convert<std::size_t>(di) <
-                                                       arg.output_.GetLengths()[3] &&
-                                                   hi >= 0 &&
-                                                   ck::type_convert<std::size_t>(hi) <
-                                                       arg.output_.GetLengths()[4] &&
-                                                   wi >= 0 &&
-                                                   ck::type_convert<std::size_t>(wi) <
-                                                       arg.output_.GetLengths()[5])
-                                                {
-                                                    float v_in = ck::type_convert<float>(
-                                                        arg.input_(g, row, column));
-                                                    float v_out = ck::type_convert<float>(
-                                                        arg.output_(g, n, c, di, hi, wi));
-                                                    arg.output_(g, n, c, di, hi, wi) =
-                                                        ck::type_convert<OutDataType>(v_in + v_out);
-                                                }
-                                                column++;
-                                            }
-                                        }
-                                    }
-                                }
-                            }
-                        }
-                    }
-                };
-
-                make_ParallelTensorFunctor(func, G, N)(std::thread::hardware_concurrency());
-
-                return 0;
-            }
-            throw std::runtime_error("Col2Img: number of dimensions should be between 1 and 3.");
-            return 1;
+            // Every task owns a tile of the outermost spatial dimension of one image and adds
+            // the runs of C channels of all filter taps that land in it, output positions and
+            // taps in order like a sequential pass. Tiles are disjoint, so overlapping windows
+            // accumulate in parallel without atomics. Runs that continue each other in both
+            // tensors are merged.
+            const detail::ImageColumnGeometry<NDimSpatial> geometry(arg.output_.mDesc,
+                                                                    arg.input_.mDesc,
+                                                                    arg.filter_spatial_lengths_,
+                                                                    arg.output_spatial_lengths_,
+                                                                    arg.conv_strides_,
+                                                                    arg.conv_dilations_,
+                                                                    arg.in_left_pads_);
+
+            const long_index_t num_thread = std::thread::hardware_concurrency();
+            const long_index_t Di         = geometry.in_lengths[0];
+            const long_index_t num_tiles  = std::clamp<long_index_t>(
+                (4 * num_thread + geometry.G * geometry.N - 1) / (geometry.G * geometry.N), 1, Di);
+            const long_index_t tile_length = (Di + num_tiles - 1) / num_tiles;
+
+            // output positions per position along the outermost dimension
+            const long_index_t inner = geometry.num_outputs / geometry.out_lengths[0];
+
+            auto accumulate = [&](long_index_t image, long_index_t column, long_index_t length) {
+                detail::accumulate_run(arg.output_.mData.data() + image,
+                                       geometry.image_strides[2],
+                                       arg.input_.mData.data() + column,
+                                       geometry.column_strides[2],
+                                       length);
+            };
+
+            auto func = [&](auto g, auto n, auto tile) {
+                const long_index_t begin = tile * tile_length;
+                const long_index_t end   = std::min(begin + tile_length, Di);
+
+                // outputs whose windows reach [begin, end) along the outermost dimension
+                const long_index_t reach =
+                    (geometry.filter_lengths[0] - 1) * geometry.dilations[0];
+                const long_index_t lowest = begin + geometry.left_pads[0] - reach;
+                const long_index_t o_begin =
+                    lowest <= 0 ? 0 : (lowest + geometry.strides[0] - 1) / geometry.strides[0];
+                const long_index_t o_end =
+                    std::min(geometry.out_lengths[0],
+                             (end - 1 + geometry.left_pads[0]) / geometry.strides[0] + 1);
+
+                detail::RunMerger runs(
+                    geometry.C, geometry.image_strides[2], geometry.column_strides[2], accumulate);
+
+                for(long_index_t out = o_begin * inner; out < o_end * inner; ++out)
+                    geometry.ForEachTap(g, n, out, [&](auto column, auto image, auto outermost) {
+                        if(image >= 0 && outermost >= begin && outermost < end)
+                            runs.Add(image, column);
+                    });
+            };
+
+            make_ParallelTensorFunctor(func, geometry.G, geometry.N, num_tiles)(num_thread);
+
+            return 0;
         }
 
         float Run(const device::BaseArgument* p_arg,
@@ -3,11 +3,19 @@
 
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <numeric>
 #include <sstream>
+#include <thread>
+#include <tuple>
+#include <vector>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_blocked_gemm.hpp"
 
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
 
@@ -15,6 +23,12 @@ namespace ck {
 namespace tensor_operation {
 namespace host {
 
+// Contraction C[ms, ns] = sum_ks A[ms, ks] * B[ns, ks] for any number of M, N and K modes with
+// arbitrary strides, lowered to transpose-transpose-GEMM-transpose: A and B are copied into packed
+// [M, K] and [K, N] panels, multiplied with the blocked host GEMM, and the packed [M, N] result is
+// copied out to C. The modes of each of the M, N and K groups are ordered by decreasing stride in
+// C (M, N) or A (K), so that the copies fuse modes that are contiguous in both layouts into long
+// runs. Every element is accumulated over the K modes in that order.
 template <ck::index_t NumDimM,
           ck::index_t NumDimN,
           ck::index_t NumDimK,
@@ -24,18 +38,17 @@ template <ck::index_t NumDimM,
           typename AccDataType,
           typename ComputeDataType,
           typename AElementwiseOperation,
-          typename BElementwiseOperation,
-          ck::enable_if_t<(NumDimM == 2 || NumDimM == 6) && (NumDimN == 2 || NumDimN == 6) &&
-                              (NumDimK == 2 || NumDimK == 6),
-                          bool> = false>
-struct ReferenceContraction_M2_N2_K2 : public ck::tensor_operation::device::BaseOperator
+          typename BElementwiseOperation>
+struct ReferenceContraction : public ck::tensor_operation::device::BaseOperator
 {
+    static_assert(NumDimM > 0 && NumDimN > 0 && NumDimK > 0);
+
     // Argument
     struct Argument : public ck::tensor_operation::device::BaseArgument
     {
-        Argument(const Tensor<ADataType>& a_ms_ks,
-                 const Tensor<BDataType>& b_ns_ks,
-                 Tensor<CDataType>& c_ms_ns,
+        Argument(TensorView<const ADataType> a_ms_ks,
+                 TensorView<const BDataType> b_ns_ks,
+                 TensorView<CDataType> c_ms_ns,
                  AElementwiseOperation a_element_op,
                  BElementwiseOperation b_element_op)
             : a_ms_ks_{a_ms_ks},
@@ -46,9 +59,9 @@ struct ReferenceContraction_M2_N2_K2 : public ck::tensor_operation::device::Base
         {
         }
 
-        const Tensor<ADataType>& a_ms_ks_;
-        const Tensor<BDataType>& b_ns_ks_;
-        Tensor<CDataType>& c_ms_ns_;
+        TensorView<const ADataType> a_ms_ks_;
+        TensorView<const BDataType> b_ns_ks_;
+        TensorView<CDataType> c_ms_ns_;
 
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
@@ -57,129 +70,164 @@ struct ReferenceContraction_M2_N2_K2 : public ck::tensor_operation::device::Base
     // Invoker
     struct Invoker : public ck::tensor_operation::device::BaseInvoker
     {
-        using Argument = ReferenceContraction_M2_N2_K2::Argument;
+        using Argument = ReferenceContraction::Argument;
 
         float Run(const Argument& arg)
         {
-            auto f_ms_ns = [&](auto m0,
-                               auto m1,
-                               auto m2,
-                               auto m3,
-                               auto m4,
-                               auto m5,
-                               auto n0,
-                               auto n1,
-                               auto n2,
-                               auto n3,
-                               auto n4,
-                               auto n5) {
-                const ck::index_t K0 = arg.a_ms_ks_.mDesc.GetLengths()[NumDimM];
-                const ck::index_t K1 = arg.a_ms_ks_.mDesc.GetLengths()[NumDimM + 1];
-                const ck::index_t K2 =
-                    NumDimK >= 3 ? arg.a_ms_ks_.mDesc.GetLengths()[NumDimM + 2] : 1;
-                const ck::index_t K3 =
-                    NumDimK >= 4 ? arg.a_ms_ks_.mDesc.GetLengths()[NumDimM + 3] : 1;
-                const ck::index_t K4 =
-                    NumDimK >= 5 ? arg.a_ms_ks_.mDesc.GetLengths()[NumDimM + 4] : 1;
-                const ck::index_t K5 =
-                    NumDimK >= 6 ? arg.a_ms_ks_.mDesc.GetLengths()[NumDimM + 5] : 1;
+            constexpr std::size_t MPerTile = 16;
+
+            const auto [m_order, n_order, k_order] = GetModeOrders(arg);
+
+            auto append = [](std::vector<std::size_t>& new2old,
+                             const std::vector<std::size_t>& order,
+                             std::size_t first) {
+                for(auto d : order)
+                    new2old.push_back(first + d);
+            };
+
+            std::vector<std::size_t> a_m_k_new2old, b_k_n_new2old, c_m_n_new2old;
+            append(a_m_k_new2old, m_order, 0);
+            append(a_m_k_new2old, k_order, NumDimM);
+            append(b_k_n_new2old, k_order, NumDimN);
+            append(b_k_n_new2old, n_order, 0);
+            append(c_m_n_new2old, m_order, 0);
+            append(c_m_n_new2old, n_order, NumDimM);
+
+            const auto a_m_k = to_packed_tensor(arg.a_ms_ks_.Permute(a_m_k_new2old));
+            const auto b_k_n = to_packed_tensor(arg.b_ns_ks_.Permute(b_k_n_new2old));
+            const auto c_m_n_view = arg.c_ms_ns_.Permute(c_m_n_new2old);
+
+            auto product = [](const std::vector<std::size_t>& lengths,
+                              std::size_t first,
+                              std::size_t num) {
+                return std::accumulate(lengths.begin() + first,
+                                       lengths.begin() + first + num,
+                                       std::size_t{1},
+                                       std::multiplies<>{});
+            };
+
+            const std::size_t M = product(arg.c_ms_ns_.GetLengths(), 0, NumDimM);
+            const std::size_t N = product(arg.c_ms_ns_.GetLengths(), NumDimM, NumDimN);
+            const std::size_t K = product(arg.a_ms_ks_.GetLengths(), NumDimM, NumDimK);
+
+            const std::size_t num_thread = std::thread::hardware_concurrency();
+
+            // A and B as the per-element reference converts them, through ComputeDataType
+            std::vector<AccDataType> a_panel(M * K);
+            std::vector<AccDataType> b_panel(K * N);
+
+            auto f_convert_a = [&](auto m) {
+                for(std::size_t k = 0; k < K; ++k)
+                {
+                    const auto v_a_compute_input =
+                        ck::type_convert<ComputeDataType>(a_m_k.mData[m * K + k]);
+                    arg.a_element_op_(a_panel[m * K + k],
+                                      ck::type_convert<AccDataType>(v_a_compute_input));
+                }
+            };
+            auto f_convert_b = [&](auto k) {
+                for(std::size_t n = 0; n < N; ++n)
+                {
+                    const auto v_b_compute_input =
+                        ck::type_convert<ComputeDataType>(b_k_n.mData[k * N + n]);
+                    arg.b_element_op_(b_panel[k * N + n],
+                                      ck::type_convert<AccDataType>(v_b_compute_input));
+                }
+            };
+
+            make_ParallelTensorFunctor(f_convert_a, M)(num_thread);
+            make_ParallelTensorFunctor(f_convert_b, K)(num_thread);
+
+            Tensor<CDataType> c_m_n(c_m_n_view.GetLengths());
+
+            auto f_tile = [&](auto m_tile) {
+                const std::size_t m_begin = m_tile * MPerTile;
+                const std::size_t m_size  = std::min(MPerTile, M - m_begin);
+
+                detail::blocked_gemm(a_panel.data() + m_begin * K,
+                                     b_panel.data(),
+                                     m_size,
+                                     N,
+                                     K,
+                                     [&](auto i, auto n, auto acc) {
+                                         c_m_n.mData[(m_begin + i) * N + n] =
+                                             ck::type_convert<CDataType>(acc);
+                                     });
+            };
+
+            make_ParallelTensorFunctor(f_tile, (M + MPerTile - 1) / MPerTile)(num_thread);
+
+            copy_tensor_view(make_tensor_view(c_m_n), c_m_n_view);
+            return 0;
+        }
+
+        // Computes only the elements of C at `output_indices`, each an [M0, M1, ..., N0, N1, ...]
+        // multi-index, as a dot product over the K modes in the order of Run(arg), and leaves the
+        // other elements untouched.
+        float Run(const Argument& arg, const std::vector<std::vector<std::size_t>>& output_indices)
+        {
+            const auto k_order = std::get<2>(GetModeOrders(arg));
+
+            // A as [ms, ks] and B as [ns, ks] with the K modes in k_order
+            std::vector<std::size_t> a_ms_k_new2old(NumDimM), b_ns_k_new2old(NumDimN);
+            std::iota(a_ms_k_new2old.begin(), a_ms_k_new2old.end(), std::size_t{0});
+            std::iota(b_ns_k_new2old.begin(), b_ns_k_new2old.end(), std::size_t{0});
+            for(auto d : k_order)
+            {
+                a_ms_k_new2old.push_back(NumDimM + d);
+                b_ns_k_new2old.push_back(NumDimN + d);
+            }
+
+            const auto a_ms_k = arg.a_ms_ks_.Permute(a_ms_k_new2old);
+            const auto b_ns_k = arg.b_ns_ks_.Permute(b_ns_k_new2old);
+
+            const std::vector<std::size_t> k_lengths(a_ms_k.GetLengths().begin() + NumDimM,
+                                                     a_ms_k.GetLengths().end());
+
+            auto f_element = [&](auto i) {
+                const auto& c_idx = output_indices[i];
+
+                std::vector<std::size_t> a_idx(c_idx.begin(), c_idx.begin() + NumDimM);
+                std::vector<std::size_t> b_idx(c_idx.begin() + NumDimM, c_idx.end());
+                a_idx.resize(NumDimM + NumDimK, 0);
+                b_idx.resize(NumDimN + NumDimK, 0);
 
                 AccDataType v_acc = 0;
 
-                for(ck::index_t k0 = 0; k0 < K0; ++k0)
+                for(bool done = false; !done;)
                 {
-                    for(ck::index_t k1 = 0; k1 < K1; ++k1)
+                    // Simulate the possible casting when ComputeDataType is different than the
+                    // A/B data types
+                    const auto v_a_compute_input = ck::type_convert<ComputeDataType>(a_ms_k(a_idx));
+                    const auto v_b_compute_input = ck::type_convert<ComputeDataType>(b_ns_k(b_idx));
+
+                    AccDataType v_a;
+                    AccDataType v_b;
+
+                    arg.a_element_op_(v_a, ck::type_convert<AccDataType>(v_a_compute_input));
+                    arg.b_element_op_(v_b, ck::type_convert<AccDataType>(v_b_compute_input));
+
+                    v_acc += v_a * v_b;
+
+                    // next K multi-index, the last mode fastest
+                    done = true;
+                    for(std::size_t d = NumDimK; d-- > 0;)
                     {
-                        for(ck::index_t k2 = 0; k2 < K2; ++k2)
+                        if(++a_idx[NumDimM + d] < k_lengths[d])
                         {
-                            for(ck::index_t k3 = 0; k3 < K3; ++k3)
-                            {
-                                for(ck::index_t k4 = 0; k4 < K4; ++k4)
-                                {
-                                    for(ck::index_t k5 = 0; k5 < K5; ++k5)
-                                    {
-                                        ComputeDataType v_a_compute_input;
-                                        ComputeDataType v_b_compute_input;
-
-                                        // Simulate the possible casting when ComputeDataType is
-                                        // different than the A/B data types
-                                        if constexpr(NumDimK == 2)
-                                        {
-                                            v_a_compute_input = ck::type_convert<ComputeDataType>(
-                                                arg.a_ms_ks_(m0, m1, k0, k1));
-                                            v_b_compute_input = ck::type_convert<ComputeDataType>(
-                                                arg.b_ns_ks_(n0, n1, k0, k1));
-                                        }
-                                        else if constexpr(NumDimK == 6)
-                                        {
-                                            v_a_compute_input = ck::type_convert<
-                                                ComputeDataType>(arg.a_ms_ks_(
-                                                m0, m1, m2, m3, m4, m5, k0, k1, k2, k3, k4, k5));
-                                            v_b_compute_input = ck::type_convert<
-                                                ComputeDataType>(arg.b_ns_ks_(
-                                                n0, n1, n2, n3, n4, n5, k0, k1, k2, k3, k4, k5));
-                                        }
-
-                                        AccDataType v_a;
-                                        AccDataType v_b;
-
-                                        arg.a_element_op_(
-                                            v_a, ck::type_convert<AccDataType>(v_a_compute_input));
-                                        arg.b_element_op_(
-                                            v_b, ck::type_convert<AccDataType>(v_b_compute_input));
-
-                                        v_acc += v_a * v_b;
-                                    }
-                                }
-                            }
+                            done = false;
+                            break;
                         }
+                        a_idx[NumDimM + d] = 0;
                     }
+                    std::copy(a_idx.begin() + NumDimM, a_idx.end(), b_idx.begin() + NumDimN);
                 }
 
-                if constexpr(NumDimK == 2)
-                {
-                    arg.c_ms_ns_(m0, m1, n0, n1) = ck::type_convert<CDataType>(v_acc);
-                }
-                else if constexpr(NumDimK == 6)
-                {
-                    arg.c_ms_ns_(m0, m1, m2, m3, m4, m5, n0, n1, n2, n3, n4, n5) =
-                        ck::type_convert<CDataType>(v_acc);
-                }
+                arg.c_ms_ns_(c_idx) = ck::type_convert<CDataType>(v_acc);
             };
 
-            if constexpr(NumDimK == 2)
-            {
-                make_ParallelTensorFunctor(f_ms_ns,
-                                           arg.c_ms_ns_.mDesc.GetLengths()[0],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[1],
-                                           1,
-                                           1,
-                                           1,
-                                           1,
-                                           arg.c_ms_ns_.mDesc.GetLengths()[2],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[3],
-                                           1,
-                                           1,
-                                           1,
-                                           1)(std::thread::hardware_concurrency());
-            }
-            else if constexpr(NumDimK == 6)
-            {
-                make_ParallelTensorFunctor(f_ms_ns,
-                                           arg.c_ms_ns_.mDesc.GetLengths()[0],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[1],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[2],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[3],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[4],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[5],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[6],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[7],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[8],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[9],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[10],
-                                           arg.c_ms_ns_.mDesc.GetLengths()[11])(
-                    std::thread::hardware_concurrency());
-            }
+            make_ParallelTensorFunctor(f_element, output_indices.size())(
+                std::thread::hardware_concurrency());
 
             return 0;
         }
@@ -189,22 +237,164 @@ struct ReferenceContraction_M2_N2_K2 : public ck::tensor_operation::device::Base
         {
             return Run(*dynamic_cast<const Argument*>(p_arg));
         }
+
+        private:
+        // The M, N and K modes, each group outermost first by the strides in C (M, N) or A (K)
+        // and then in A (M) or B (N, K)
+        static auto GetModeOrders(const Argument& arg)
+        {
+            const auto& a_strides = arg.a_ms_ks_.GetStrides();
+            const auto& b_strides = arg.b_ns_ks_.GetStrides();
+            const auto& c_strides = arg.c_ms_ns_.GetStrides();
+
+            // the `num` modes starting at x_first in x, outermost first by their strides in x and
+            // then in y
+            auto order_modes = [](std::size_t num,
+                                  const std::vector<std::size_t>& x,
+                                  std::size_t x_first,
+                                  const std::vector<std::size_t>& y,
+                                  std::size_t y_first) {
+                std::vector<std::size_t> order(num);
+                std::iota(order.begin(), order.end(), std::size_t{0});
+                std::stable_sort(order.begin(), order.end(), [&](auto i, auto j) {
+                    if(x[x_first + i] != x[x_first + j])
+                        return x[x_first + i] > x[x_first + j];
+                    return y[y_first + i] > y[y_first + j];
+                });
+                return order;
+            };
+
+            return std::make_tuple(order_modes(NumDimM, c_strides, 0, a_strides, 0),
+                                   order_modes(NumDimN, c_strides, NumDimM, b_strides, 0),
+                                   order_modes(NumDimK, a_strides, NumDimM, b_strides, NumDimN));
+        }
     };
 
-    static constexpr bool IsValidCompilationParameter()
+    static constexpr bool IsValidCompilationParameter() { return true; }
+
+    bool IsSupportedArgument(const ck::tensor_operation::device::BaseArgument*) override
     {
-        // TODO: properly implement this check
         return true;
     }
 
+    static auto MakeArgument(TensorView<const ADataType> a_ms_ks,
+                             TensorView<const BDataType> b_ns_ks,
+                             TensorView<CDataType> c_ms_ns,
+                             AElementwiseOperation a_element_op,
+                             BElementwiseOperation b_element_op)
+    {
+        return Argument{a_ms_ks, b_ns_ks, c_ms_ns, a_element_op, b_element_op};
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    virtual std::unique_ptr<ck::tensor_operation::device::BaseInvoker> MakeInvokerPointer()
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "ReferenceContraction"
+            << "<" << NumDimM << ", " << NumDimN << ", " << NumDimK << ">"
+            << std::endl;
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+template <ck::index_t NumDimM,
+          ck::index_t NumDimN,
+          ck::index_t NumDimK,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename AccDataType,
+          typename ComputeDataType,
+          typename AElementwiseOperation,
+          typename BElementwiseOperation>
+struct ReferenceContraction_M2_N2_K2 : public ck::tensor_operation::device::BaseOperator
+{
+    // Argument
+    struct Argument : public ck::tensor_operation::device::BaseArgument
+    {
+        Argument(TensorView<const ADataType> a_ms_ks,
+                 TensorView<const BDataType> b_ns_ks,
+                 TensorView<CDataType> c_ms_ns,
+                 AElementwiseOperation a_element_op,
+                 BElementwiseOperation b_element_op)
+            : a_ms_ks_{a_ms_ks},
+              b_ns_ks_{b_ns_ks},
+              c_ms_ns_{c_ms_ns},
+              a_element_op_{a_element_op},
+              b_element_op_{b_element_op}
+        {
+        }
+
+        TensorView<const ADataType> a_ms_ks_;
+        TensorView<const BDataType> b_ns_ks_;
+        TensorView<CDataType> c_ms_ns_;
+
+        AElementwiseOperation a_element_op_;
+        BElementwiseOperation b_element_op_;
+    };
+
+    // Invoker
+    struct Invoker : public ck::tensor_operation::device::BaseInvoker
+    {
+        using Argument = ReferenceContraction_M2_N2_K2::Argument;
+
+        using Reference = ReferenceContraction<NumDimM,
+                                               NumDimN,
+                                               NumDimK,
+                                               ADataType,
+                                               BDataType,
+                                               CDataType,
+                                               AccDataType,
+                                               ComputeDataType,
+                                               AElementwiseOperation,
+                                               BElementwiseOperation>;
+
+        float Run(const Argument& arg)
+        {
+            return Reference::MakeInvoker().Run(MakeReferenceArgument(arg));
+        }
+
+        // Computes only the elements of C at `output_indices`, each an [M0, M1, ..., N0, N1, ...]
+        // multi-index, and leaves the other elements untouched.
+        float Run(const Argument& arg, const std::vector<std::vector<std::size_t>>& output_indices)
+        {
+            return Reference::MakeInvoker().Run(MakeReferenceArgument(arg), output_indices);
+        }
+
+        float Run(const ck::tensor_operation::device::BaseArgument* p_arg,
+                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+
+        private:
+        static auto MakeReferenceArgument(const Argument& arg)
+        {
+            return Reference::MakeArgument(
+                arg.a_ms_ks_, arg.b_ns_ks_, arg.c_ms_ns_, arg.a_element_op_, arg.b_element_op_);
+        }
+    };
+
+    static constexpr bool IsValidCompilationParameter() { return true; }
+
     bool IsSupportedArgument(const ck::tensor_operation::device::BaseArgument*) override
     {
         return true;
     }
 
-    static auto MakeArgument(const Tensor<ADataType>& a_ms_ks,
-                             const Tensor<BDataType>& b_ns_ks,
-                             Tensor<CDataType>& c_ms_ns,
+    static auto MakeArgument(TensorView<const ADataType> a_ms_ks,
+                             TensorView<const BDataType> b_ns_ks,
+                             TensorView<CDataType> c_ms_ns,
                              AElementwiseOperation a_element_op,
                              BElementwiseOperation b_element_op)
     {
@@ -9,6 +9,7 @@
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -35,9 +36,9 @@ struct ReferenceConvBwdData : public device::BaseOperator
     struct Argument : public device::BaseArgument
     {
         Argument(
-            Tensor<InDataType>& input,
-            const Tensor<WeiDataType>& weight,
-            const Tensor<OutDataType>& output,
+            TensorView<InDataType> input,
+            TensorView<const WeiDataType> weight,
+            TensorView<const OutDataType> output,
             std::vector<ck::index_t> conv_filter_strides,
             std::vector<ck::index_t> conv_filter_dilations,
             std::vector<ck::index_t> input_left_pads,
@@ -64,9 +65,9 @@ struct ReferenceConvBwdData : public device::BaseOperator
         {
         }
 
-        Tensor<InDataType>& input_;
-        const Tensor<WeiDataType>& weight_;
-        const Tensor<OutDataType>& output_;
+        TensorView<InDataType> input_;
+        TensorView<const WeiDataType> weight_;
+        TensorView<const OutDataType> output_;
 
         const std::array<Tensor<InDataType>, NumAElementwiseTensor>& elementwise_a_tensors_;
         const std::array<Tensor<WeiDataType>, NumBElementwiseTensor>& elementwise_b_tensors_;
@@ -87,7 +88,24 @@ struct ReferenceConvBwdData : public device::BaseOperator
     {
         using Argument = ReferenceConvBwdData::Argument;
 
-        float Run(const Argument& arg)
+        float Run(const Argument& arg) { return RunImpl(arg, nullptr); }
+
+        // Computes only the input gradient elements at `output_indices`, each a
+        // [G, N, C, Di, Hi, Wi] multi-index, and leaves the other elements untouched.
+        float Run(const Argument& arg, const std::vector<std::vector<std::size_t>>& output_indices)
+        {
+            return RunImpl(arg, &output_indices);
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+
+        private:
+        float RunImpl(const Argument& arg,
+                      const std::vector<std::vector<std::size_t>>* output_indices)
         {
             if(!(arg.input_.GetNumOfDimension() == NDimSpatial + 3 &&
                  arg.weight_.GetNumOfDimension() == NDimSpatial + 3 &&
@@ -162,12 +180,16 @@ struct ReferenceConvBwdData : public device::BaseOperator
                                          wi);
                 };
 
-                make_ParallelTensorFunctor(f_ncw,
-                                           arg.input_.GetLengths()[0],
-                                           arg.input_.GetLengths()[1],
-                                           arg.input_.GetLengths()[2],
-                                           arg.input_.GetLengths()[3])(
-                    std::thread::hardware_concurrency());
+                if(output_indices)
+                    parallel_for_each_index<NDimSpatial + 3>(
+                        f_ncw, *output_indices, std::thread::hardware_concurrency());
+                else
+                    make_ParallelTensorFunctor(f_ncw,
+                                               arg.input_.GetLengths()[0],
+                                               arg.input_.GetLengths()[1],
+                                               arg.input_.GetLengths()[2],
+                                               arg.input_.GetLengths()[3])(
+                        std::thread::hardware_concurrency());
 
                 return 0;
             }
@@ -259,13 +281,17 @@ struct ReferenceConvBwdData : public device::BaseOperator
                                          wi);
                 };
 
-                make_ParallelTensorFunctor(f_nchw,
-                                           arg.input_.GetLengths()[0],
-                                           arg.input_.GetLengths()[1],
-                                           arg.input_.GetLengths()[2],
-                                           arg.input_.GetLengths()[3],
-                                           arg.input_.GetLengths()[4])(
-                    std::thread::hardware_concurrency());
+                if(output_indices)
+                    parallel_for_each_index<NDimSpatial + 3>(
+                        f_nchw, *output_indices, std::thread::hardware_concurrency());
+                else
+                    make_ParallelTensorFunctor(f_nchw,
+                                               arg.input_.GetLengths()[0],
+                                               arg.input_.GetLengths()[1],
+                                               arg.input_.GetLengths()[2],
+                                               arg.input_.GetLengths()[3],
+                                               arg.input_.GetLengths()[4])(
+                        std::thread::hardware_concurrency());
 
                 return 0;
             }
@@ -382,14 +408,18 @@ struct ReferenceConvBwdData : public device::BaseOperator
                                          wi);
                 };
 
-                make_ParallelTensorFunctor(f_ncdhw,
-                                           arg.input_.GetLengths()[0],
-                                           arg.input_.GetLengths()[1],
-                                           arg.input_.GetLengths()[2],
-                                           arg.input_.GetLengths()[3],
-                                           arg.input_.GetLengths()[4],
-                                           arg.input_.GetLengths()[5])(
-                    std::thread::hardware_concurrency());
+                if(output_indices)
+                    parallel_for_each_index<NDimSpatial + 3>(
+                        f_ncdhw, *output_indices, std::thread::hardware_concurrency());
+                else
+                    make_ParallelTensorFunctor(f_ncdhw,
+                                               arg.input_.GetLengths()[0],
+                                               arg.input_.GetLengths()[1],
+                                               arg.input_.GetLengths()[2],
+                                               arg.input_.GetLengths()[3],
+                                               arg.input_.GetLengths()[4],
+                                               arg.input_.GetLengths()[5])(
+                        std::thread::hardware_concurrency());
 
                 return 0;
             }
@@ -397,12 +427,6 @@ struct ReferenceConvBwdData : public device::BaseOperator
                 "Conv_bwd_data: number of dimensions must be between 1 and 3.");
             return 1;
         }
-
-        float Run(const device::BaseArgument* p_arg,
-                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
-        {
-            return Run(*dynamic_cast<const Argument*>(p_arg));
-        }
     };
 
     template <typename... Args,
@@ -444,9 +468,9 @@ struct ReferenceConvBwdData : public device::BaseOperator
     bool IsSupportedArgument(const device::BaseArgument*) override { return true; }
 
     static auto MakeArgument(
-        Tensor<InDataType>& input,
-        const Tensor<WeiDataType>& weight,
-        const Tensor<OutDataType>& output,
+        TensorView<InDataType> input,
+        TensorView<const WeiDataType> weight,
+        TensorView<const OutDataType> output,
         std::vector<ck::index_t> conv_filter_strides,
         std::vector<ck::index_t> conv_filter_dilations,
         std::vector<ck::index_t> input_left_pads,
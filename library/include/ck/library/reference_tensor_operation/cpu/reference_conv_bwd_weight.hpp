@@ -9,6 +9,7 @@
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -37,9 +38,9 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
     struct Argument : public device::BaseArgument
     {
         Argument(
-            const Tensor<InDataType>& in_n_c_hi_wi,
-            Tensor<WeiDataType>& wei_k_c_y_x,
-            const Tensor<OutDataType>& out_n_k_ho_wo,
+            TensorView<const InDataType> in_n_c_hi_wi,
+            TensorView<WeiDataType> wei_k_c_y_x,
+            TensorView<const OutDataType> out_n_k_ho_wo,
             std::vector<ck::index_t> conv_filter_strides,
             std::vector<ck::index_t> conv_filter_dilations,
             std::vector<ck::index_t> input_left_pads,
@@ -66,9 +67,9 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
         {
         }
 
-        const Tensor<InDataType>& input_;
-        Tensor<WeiDataType>& weight_;
-        const Tensor<OutDataType>& output_;
+        TensorView<const InDataType> input_;
+        TensorView<WeiDataType> weight_;
+        TensorView<const OutDataType> output_;
 
         const std::array<Tensor<OutDataType>, NumAElementwiseTensor>& elementwise_a_tensors_;
         const std::array<Tensor<InDataType>, NumBElementwiseTensor>& elementwise_b_tensors_;
@@ -89,7 +90,24 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
     {
         using Argument = ReferenceConvBwdWeight::Argument;
 
-        float Run(const Argument& arg)
+        float Run(const Argument& arg) { return RunImpl(arg, nullptr); }
+
+        // Computes only the weight gradient elements at `output_indices`, each a
+        // [G, K, C, Z, Y, X] multi-index, and leaves the other elements untouched.
+        float Run(const Argument& arg, const std::vector<std::vector<std::size_t>>& output_indices)
+        {
+            return RunImpl(arg, &output_indices);
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /*stream_config*/ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+
+        private:
+        float RunImpl(const Argument& arg,
+                      const std::vector<std::vector<std::size_t>>* output_indices)
         {
             if(!(arg.input_.GetNumOfDimension() == NDimSpatial + 3 &&
                  arg.weight_.GetNumOfDimension() == NDimSpatial + 3 &&
@@ -156,12 +174,16 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
                                          x);
                 };
 
-                make_ParallelTensorFunctor(f_kcx,
-                                           arg.weight_.GetLengths()[0],
-                                           arg.weight_.GetLengths()[1],
-                                           arg.weight_.GetLengths()[2],
-                                           arg.weight_.GetLengths()[3])(
-                    std::thread::hardware_concurrency());
+                if(output_indices)
+                    parallel_for_each_index<NDimSpatial + 3>(
+                        f_kcx, *output_indices, std::thread::hardware_concurrency());
+                else
+                    make_ParallelTensorFunctor(f_kcx,
+                                               arg.weight_.GetLengths()[0],
+                                               arg.weight_.GetLengths()[1],
+                                               arg.weight_.GetLengths()[2],
+                                               arg.weight_.GetLengths()[3])(
+                        std::thread::hardware_concurrency());
 
                 return 0;
             }
@@ -241,13 +263,17 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
                                          x);
                 };
 
-                make_ParallelTensorFunctor(f_kcyx,
-                                           arg.weight_.GetLengths()[0],
-                                           arg.weight_.GetLengths()[1],
-                                           arg.weight_.GetLengths()[2],
-                                           arg.weight_.GetLengths()[3],
-                                           arg.weight_.GetLengths()[4])(
-                    std::thread::hardware_concurrency());
+                if(output_indices)
+                    parallel_for_each_index<NDimSpatial + 3>(
+                        f_kcyx, *output_indices, std::thread::hardware_concurrency());
+                else
+                    make_ParallelTensorFunctor(f_kcyx,
+                                               arg.weight_.GetLengths()[0],
+                                               arg.weight_.GetLengths()[1],
+                                               arg.weight_.GetLengths()[2],
+                                               arg.weight_.GetLengths()[3],
+                                               arg.weight_.GetLengths()[4])(
+                        std::thread::hardware_concurrency());
 
                 return 0;
             }
@@ -337,26 +363,24 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
                                          x);
                 };
 
-                make_ParallelTensorFunctor(f_kczyx,
-                                           arg.weight_.GetLengths()[0],
-                                           arg.weight_.GetLengths()[1],
-                                           arg.weight_.GetLengths()[2],
-                                           arg.weight_.GetLengths()[3],
-                                           arg.weight_.GetLengths()[4],
-                                           arg.weight_.GetLengths()[5])(
-                    std::thread::hardware_concurrency());
+                if(output_indices)
+                    parallel_for_each_index<NDimSpatial + 3>(
+                        f_kczyx, *output_indices, std::thread::hardware_concurrency());
+                else
+                    make_ParallelTensorFunctor(f_kczyx,
+                                               arg.weight_.GetLengths()[0],
+                                               arg.weight_.GetLengths()[1],
+                                               arg.weight_.GetLengths()[2],
+                                               arg.weight_.GetLengths()[3],
+                                               arg.weight_.GetLengths()[4],
+                                               arg.weight_.GetLengths()[5])(
+                        std::thread::hardware_concurrency());
 
                 return 0;
             }
             throw std::runtime_error("Conv_bwd: number of dimensions must be between 1 and 3.");
             return 1;
         }
-
-        float Run(const device::BaseArgument* p_arg,
-                  const StreamConfig& /*stream_config*/ = StreamConfig{}) override
-        {
-            return Run(*dynamic_cast<const Argument*>(p_arg));
-        }
     };
 
     template <typename... Args,
@@ -399,9 +423,9 @@ struct ReferenceConvBwdWeight : public device::BaseOperator
     bool IsSupportedArgument(const device::BaseArgument*) override { return true; }
 
     static auto MakeArgument(
-        const Tensor<InDataType>& in_n_c_hi_wi,
-        Tensor<WeiDataType>& wei_k_c_y_x,
-        const Tensor<OutDataType>& out_n_k_ho_wo,
+        TensorView<const InDataType> in_n_c_hi_wi,
+        TensorView<WeiDataType> wei_k_c_y_x,
+        TensorView<const OutDataType> out_n_k_ho_wo,
         std::vector<ck::index_t> conv_filter_strides,
         std::vector<ck::index_t> conv_filter_dilations,
         std::vector<ck::index_t> input_left_pads,
@@ -18,6 +18,7 @@
 #include "ck/library/utility/check_err.hpp"
 #include "ck/library/utility/fill.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
 
@@ -66,9 +67,9 @@ struct ReferenceConvFwd : public device::BaseOperator
     struct Argument : public device::BaseArgument
     {
         Argument(
-            const Tensor<InDataType>& input,
-            const Tensor<WeiDataType>& weight,
-            Tensor<OutDataType>& output,
+            TensorView<const InDataType> input,
+            TensorView<const WeiDataType> weight,
+            TensorView<OutDataType> output,
             std::vector<ck::index_t> conv_filter_strides,
             std::vector<ck::index_t> conv_filter_dilations,
             std::vector<ck::index_t> input_left_pads,
@@ -95,9 +96,9 @@ struct ReferenceConvFwd : public device::BaseOperator
         {
         }
 
-        const Tensor<InDataType>& input_;
-        const Tensor<WeiDataType>& weight_;
-        Tensor<OutDataType>& output_;
+        TensorView<const InDataType> input_;
+        TensorView<const WeiDataType> weight_;
+        TensorView<OutDataType> output_;
 
         const std::array<Tensor<InDataType>, NumAElementwiseTensor>& elementwise_a_tensors_;
         const std::array<Tensor<WeiDataType>, NumBElementwiseTensor>& elementwise_b_tensors_;
@@ -117,7 +118,24 @@ struct ReferenceConvFwd : public device::BaseOperator
     {
         using Argument = ReferenceConvFwd::Argument;
 
-        float Run(const Argument& arg)
+        float Run(const Argument& arg) { return RunImpl(arg, nullptr); }
+
+        // Computes only the output elements at `output_indices`, each a
+        // [G, N, K, Do, Ho, Wo] multi-index, and leaves the other elements untouched.
+        float Run(const Argument& arg, const std::vector<std::vector<std::size_t>>& output_indices)
+        {
+            return RunImpl(arg, &output_indices);
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /*stream_config*/ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+
+        private:
+        float RunImpl(const Argument& arg,
+                      const std::vector<std::vector<std::size_t>>* output_indices)
         {
             if(!(arg.input_.GetNumOfDimension() == NDimSpatial + 3 &&
                  arg.weight_.GetNumOfDimension() == NDimSpatial + 3 &&
@@ -181,12 +199,16 @@ struct ReferenceConvFwd : public device::BaseOperator
                                          wo);
                 };
 
-                make_ParallelTensorFunctor(func,
-                                           arg.output_.GetLengths()[0],
-                                           arg.output_.GetLengths()[1],
-                                           arg.output_.GetLengths()[2],
-                                           arg.output_.GetLengths()[3])(
-                    std::thread::hardware_concurrency());
+                if(output_indices)
+                    parallel_for_each_index<NDimSpatial + 3>(
+                        func, *output_indices, std::thread::hardware_concurrency());
+                else
+                    make_ParallelTensorFunctor(func,
+                                               arg.output_.GetLengths()[0],
+                                               arg.output_.GetLengths()[1],
+                                               arg.output_.GetLengths()[2],
+                                               arg.output_.GetLengths()[3])(
+                        std::thread::hardware_concurrency());
 
                 return 0;
             }
@@ -258,13 +280,17 @@ struct ReferenceConvFwd : public device::BaseOperator
                                          wo);
                 };
 
-                make_ParallelTensorFunctor(func,
-                                           arg.output_.GetLengths()[0],
-                                           arg.output_.GetLengths()[1],
-                                           arg.output_.GetLengths()[2],
-                                           arg.output_.GetLengths()[3],
-                                           arg.output_.GetLengths()[4])(
-                    std::thread::hardware_concurrency());
+                if(output_indices)
+                    parallel_for_each_index<NDimSpatial + 3>(
+                        func, *output_indices, std::thread::hardware_concurrency());
+                else
+                    make_ParallelTensorFunctor(func,
+                                               arg.output_.GetLengths()[0],
+                                               arg.output_.GetLengths()[1],
+                                               arg.output_.GetLengths()[2],
+                                               arg.output_.GetLengths()[3],
+                                               arg.output_.GetLengths()[4])(
+                        std::thread::hardware_concurrency());
 
                 return 0;
             }
@@ -349,26 +375,24 @@ struct ReferenceConvFwd : public device::BaseOperator
                                          wo);
                 };
 
-                make_ParallelTensorFunctor(func,
-                                           arg.output_.GetLengths()[0],
-                                           arg.output_.GetLengths()[1],
-                                           arg.output_.GetLengths()[2],
-                                           arg.output_.GetLengths()[3],
-                                           arg.output_.GetLengths()[4],
-                                           arg.output_.GetLengths()[5])(
-                    std::thread::hardware_concurrency());
+                if(output_indices)
+                    parallel_for_each_index<NDimSpatial + 3>(
+                        func, *output_indices, std::thread::hardware_concurrency());
+                else
+                    make_ParallelTensorFunctor(func,
+                                               arg.output_.GetLengths()[0],
+                                               arg.output_.GetLengths()[1],
+                                               arg.output_.GetLengths()[2],
+                                               arg.output_.GetLengths()[3],
+                                               arg.output_.GetLengths()[4],
+                                               arg.output_.GetLengths()[5])(
+                        std::thread::hardware_concurrency());
 
                 return 0;
             }
             throw std::runtime_error("Conv_fwd: number of dimensions must be between 1 and 3.");
             return 1;
         }
-
-        float Run(const device::BaseArgument* p_arg,
-                  const StreamConfig& /*stream_config*/ = StreamConfig{}) override
-        {
-            return Run(*dynamic_cast<const Argument*>(p_arg));
-        }
     };
 
     template <typename... Args,
@@ -413,9 +437,9 @@ struct ReferenceConvFwd : public device::BaseOperator
     }
 
     static auto MakeArgument(
-        const Tensor<InDataType>& input,
-        const Tensor<WeiDataType>& weight,
-        Tensor<OutDataType>& output,
+        TensorView<const InDataType> input,
+        TensorView<const WeiDataType> weight,
+        TensorView<OutDataType> output,
         std::vector<ck::index_t> conv_filter_strides,
         std::vector<ck::index_t> conv_filter_dilations,
         std::vector<ck::index_t> input_left_pads,
@@ -3,12 +3,15 @@
 
 #pragma once
 
+#include <array>
 #include <iostream>
 #include <sstream>
+#include <tuple>
 
 #include "ck/tensor_operation/gpu/element/combined_element_wise_operation.hpp"
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -20,15 +23,28 @@ struct ReferenceElementwise : public device::BaseOperator
     // Argument
     struct Argument : public device::BaseArgument
     {
-        Argument(const std::array<Tensor<ADataType>, NumATensors>& a_tensors,
-                 Tensor<BDataType>& b_tensor,
+        Argument(const std::array<TensorView<const ADataType>, NumATensors>& a_tensors,
+                 TensorView<BDataType> b_tensor,
                  ElementOp element_op)
             : a_tensors_{a_tensors}, b_tensor_{b_tensor}, element_op_{element_op}
         {
         }
 
-        const std::array<Tensor<ADataType>, NumATensors>& a_tensors_;
-        Tensor<BDataType>& b_tensor_;
+        Argument(const std::array<Tensor<ADataType>, NumATensors>& a_tensors,
+                 TensorView<BDataType> b_tensor,
+                 ElementOp element_op)
+            : Argument(std::apply(
+                           [](const auto&... a) {
+                               return std::array<TensorView<const ADataType>, NumATensors>{a...};
+                           },
+                           a_tensors),
+                       b_tensor,
+                       element_op)
+        {
+        }
+
+        std::array<TensorView<const ADataType>, NumATensors> a_tensors_;
+        TensorView<BDataType> b_tensor_;
         ElementOp element_op_;
     };
 
@@ -79,12 +95,20 @@ struct ReferenceElementwise : public device::BaseOperator
     bool IsSupportedArgument(const device::BaseArgument*) override { return true; }
 
     static auto MakeArgument(const std::array<Tensor<ADataType>, NumATensors>& a_tensors,
-                             Tensor<BDataType>& b_tensor,
+                             TensorView<BDataType> b_tensor,
                              ElementOp element_op)
     {
         return Argument{a_tensors, b_tensor, element_op};
     }
 
+    static auto
+    MakeArgument(const std::array<TensorView<const ADataType>, NumATensors>& a_tensors,
+                 TensorView<BDataType> b_tensor,
+                 ElementOp element_op)
+    {
+        return Argument{a_tensors, b_tensor, element_op};
+    }
+
     static auto MakeInvoker() { return Invoker{}; }
 
     virtual std::unique_ptr<device::BaseInvoker> MakeInvokerPointer()
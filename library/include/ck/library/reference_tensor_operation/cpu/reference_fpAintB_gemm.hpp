@@ -3,17 +3,34 @@
 
 #pragma once
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #include "ck/tensor_operation/gpu/element/unary_element_wise_operation.hpp"
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_blocked_gemm.hpp"
 
 namespace ck {
 namespace tensor_operation {
 namespace host {
 
+// Layout of the quantized B of ReferencefpAintBGemm
+struct fpAintBQuantization
+{
+    // number of consecutive k that share the scales in row k / scale_k_group of scale_k_n: 1 for
+    // a scale per element (per-channel scales broadcast one row with stride 0), or e.g. 32, 64 or
+    // 128 for group-wise scales with ceil(K / scale_k_group) rows
+    index_t scale_k_group = 1;
+    // b_k_n is integral and holds two signed 4-bit weights per element: those of k = 2r in the low
+    // and k = 2r + 1 in the high nibble of row r
+    bool packed_int4 = false;
+};
+
 template <typename ADataType,
           typename BDataType,
           typename ScaleDataType,
@@ -24,7 +41,8 @@ template <typename ADataType,
           typename CElementwiseOperation>
 struct ReferencefpAintBGemm : public device::BaseOperator
 {
-    // Argument
+    // Argument; scale_k_n needs ceil(K / scale_k_group) rows unless it broadcasts its rows with
+    // stride 0
     struct Argument : public device::BaseArgument
     {
         Argument(const Tensor<ADataType>& a_m_k,
@@ -33,15 +51,27 @@ struct ReferencefpAintBGemm : public device::BaseOperator
                  Tensor<CDataType>& c_m_n,
                  AElementwiseOperation a_element_op,
                  BElementwiseOperation b_element_op,
-                 CElementwiseOperation c_element_op)
+                 CElementwiseOperation c_element_op,
+                 fpAintBQuantization quantization = {})
             : a_m_k_{a_m_k},
               b_k_n_{b_k_n},
               scale_k_n_{scale_k_n},
               c_m_n_{c_m_n},
               a_element_op_{a_element_op},
               b_element_op_{b_element_op},
-              c_element_op_{c_element_op}
+              c_element_op_{c_element_op},
+              quantization_{quantization}
         {
+            if(quantization.scale_k_group <= 0)
+                throw std::runtime_error("wrong! invalid scale group size in fpAintB GEMM");
+
+            if(quantization.packed_int4 && !std::is_integral_v<BDataType>)
+                throw std::runtime_error("wrong! packed int4 B must be integral in fpAintB GEMM");
+
+            const std::size_t K = a_m_k.mDesc.GetLengths()[1];
+            if(scale_k_n.mDesc.GetStrides()[0] != 0 &&
+               scale_k_n.mDesc.GetLengths()[0] * quantization.scale_k_group < K)
+                throw std::runtime_error("wrong! too few rows of scales in fpAintB GEMM");
         }
 
         const Tensor<ADataType>& a_m_k_;
@@ -52,6 +82,8 @@ struct ReferencefpAintBGemm : public device::BaseOperator
         AElementwiseOperation a_element_op_;
         BElementwiseOperation b_element_op_;
         CElementwiseOperation c_element_op_;
+
+        fpAintBQuantization quantization_;
     };
 
     // Invoker
@@ -59,19 +91,30 @@ struct ReferencefpAintBGemm : public device::BaseOperator
     {
         using Argument = ReferencefpAintBGemm::Argument;
 
+        // B is dequantized one KPerPanel x NPerPanel block at a time into a cache-resident
+        // panel, each element once, and multiplied with the blocked host GEMM. The tasks of the
+        // parallel sweep own the columns of NPerPanel wide strips of C.
         float Run(const Argument& arg)
         {
-            auto f_mk_kn_mn = [&](auto m, auto n) {
-                const int K = arg.a_m_k_.mDesc.GetLengths()[1];
+            constexpr std::size_t KPerPanel = 256;
+            constexpr std::size_t NPerPanel = 64;
+
+            const std::size_t M = arg.c_m_n_.mDesc.GetLengths()[0];
+            const std::size_t N = arg.c_m_n_.mDesc.GetLengths()[1];
+            const std::size_t K = arg.a_m_k_.mDesc.GetLengths()[1];
+
+            const auto& quantization = arg.quantization_;
 
-                AccDataType v_acc = 0;
+            const std::size_t num_thread = std::thread::hardware_concurrency();
 
-                for(int k = 0; k < K; ++k)
+            // A in AccDataType, its k panels one after another: element (m, k) of the panel at
+            // k0 is a_panels[k0 * M + m * k_size + (k - k0)]
+            std::vector<AccDataType> a_panels(M * K);
+
+            auto f_convert_a = [&](auto m) {
+                for(std::size_t k = 0; k < K; ++k)
                 {
                     ADataType v_a;
-                    BDataType v_b;
-                    ScaleDataType v_scale;
-                    ADataType v_converted_b;
 
                     // use PassThrough instead of ConvertBF16RTN for reference calculation
                     if constexpr(is_same_v<AElementwiseOperation,
@@ -84,44 +127,86 @@ struct ReferencefpAintBGemm : public device::BaseOperator
                         arg.a_element_op_(v_a, arg.a_m_k_(m, k));
                     }
 
-                    // same for B matrix
-                    if constexpr(is_same_v<BElementwiseOperation,
-                                           ck::tensor_operation::element_wise::ConvertBF16RTN>)
-                    {
-                        ck::tensor_operation::element_wise::PassThrough{}(v_b, arg.b_k_n_(k, n));
-                    }
-                    else
-                    {
-                        arg.b_element_op_(v_b, arg.b_k_n_(k, n));
-                    }
+                    const std::size_t k0     = k / KPerPanel * KPerPanel;
+                    const std::size_t k_size = std::min(KPerPanel, K - k0);
+                    a_panels[k0 * M + m * k_size + (k - k0)] = ck::type_convert<AccDataType>(v_a);
+                }
+            };
 
-                    // same for scale matrix
-                    if constexpr(is_same_v<BElementwiseOperation,
-                                           ck::tensor_operation::element_wise::ConvertBF16RTN>)
-                    {
-                        ck::tensor_operation::element_wise::PassThrough{}(v_scale,
-                                                                          arg.scale_k_n_(k, n));
-                    }
-                    else
+            make_ParallelTensorFunctor(f_convert_a, M)(num_thread);
+
+            auto dequantize = [&](std::size_t k, std::size_t n) {
+                BDataType v_b;
+                ScaleDataType v_scale;
+
+                BDataType v_b_stored = arg.b_k_n_(quantization.packed_int4 ? k / 2 : k, n);
+                if constexpr(std::is_integral_v<BDataType>)
+                {
+                    if(quantization.packed_int4)
                     {
-                        arg.b_element_op_(v_scale, arg.scale_k_n_(k, n));
+                        // sign-extended nibble of k
+                        const int nibble = (static_cast<int>(v_b_stored) >> (k % 2 * 4)) & 0xf;
+                        v_b_stored       = static_cast<BDataType>((nibble ^ 8) - 8);
                     }
+                }
+
+                const ScaleDataType v_scale_stored =
+                    arg.scale_k_n_(k / quantization.scale_k_group, n);
+
+                // same for B matrix and its scales
+                if constexpr(is_same_v<BElementwiseOperation,
+                                       ck::tensor_operation::element_wise::ConvertBF16RTN>)
+                {
+                    ck::tensor_operation::element_wise::PassThrough{}(v_b, v_b_stored);
+                    ck::tensor_operation::element_wise::PassThrough{}(v_scale, v_scale_stored);
+                }
+                else
+                {
+                    arg.b_element_op_(v_b, v_b_stored);
+                    arg.b_element_op_(v_scale, v_scale_stored);
+                }
+
+                const ADataType v_converted_b = type_convert<ADataType>(v_b) * v_scale;
+                return ck::type_convert<AccDataType>(v_converted_b);
+            };
+
+            auto f_strip = [&](auto n_panel) {
+                const std::size_t n0     = n_panel * NPerPanel;
+                const std::size_t n_size = std::min(NPerPanel, N - n0);
+
+                std::vector<AccDataType> b_panel(KPerPanel * n_size);
+                std::vector<AccDataType> c_strip(M * n_size, 0);
 
-                    v_converted_b = type_convert<ADataType>(v_b) * v_scale;
-                    v_acc += ck::type_convert<AccDataType>(v_a) *
-                             ck::type_convert<AccDataType>(v_converted_b);
+                for(std::size_t k0 = 0; k0 < K; k0 += KPerPanel)
+                {
+                    const std::size_t k_size = std::min(KPerPanel, K - k0);
+
+                    for(std::size_t k = 0; k < k_size; ++k)
+                        for(std::size_t n = 0; n < n_size; ++n)
+                            b_panel[k * n_size + n] = dequantize(k0 + k, n0 + n);
+
+                    detail::blocked_gemm(a_panels.data() + k0 * M,
+                                         b_panel.data(),
+                                         M,
+                                         n_size,
+                                         k_size,
+                                         [&](auto m, auto n, auto acc) {
+                                             c_strip[m * n_size + n] += acc;
+                                         });
                 }
 
-                AccDataType v_c;
+                for(std::size_t m = 0; m < M; ++m)
+                    for(std::size_t n = 0; n < n_size; ++n)
+                    {
+                        AccDataType v_c;
 
-                arg.c_element_op_(v_c, v_acc);
+                        arg.c_element_op_(v_c, c_strip[m * n_size + n]);
 
-                arg.c_m_n_(m, n) = ck::type_convert<CDataType>(v_c);
+                        arg.c_m_n_(m, n0 + n) = ck::type_convert<CDataType>(v_c);
+                    }
             };
 
-            make_ParallelTensorFunctor(
-                f_mk_kn_mn, arg.c_m_n_.mDesc.GetLengths()[0], arg.c_m_n_.mDesc.GetLengths()[1])(
-                std::thread::hardware_concurrency());
+            make_ParallelTensorFunctor(f_strip, (N + NPerPanel - 1) / NPerPanel)(num_thread);
 
             return 0;
         }
@@ -147,9 +232,11 @@ struct ReferencefpAintBGemm : public device::BaseOperator
                              Tensor<CDataType>& c_m_n,
                              AElementwiseOperation a_element_op,
                              BElementwiseOperation b_element_op,
-                             CElementwiseOperation c_element_op)
+                             CElementwiseOperation c_element_op,
+                             fpAintBQuantization quantization = {})
     {
-        return Argument{a_m_k, b_k_n, scale_k_n, c_m_n, a_element_op, b_element_op, c_element_op};
+        return Argument{
+            a_m_k, b_k_n, scale_k_n, c_m_n, a_element_op, b_element_op, c_element_op, quantization};
     }
 
     static auto MakeInvoker() { return Invoker{}; }
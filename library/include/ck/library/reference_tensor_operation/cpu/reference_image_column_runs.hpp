@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+namespace detail {
+
+// Geometry of the image to column and column to image references: the image [G, N, C, Di, Hi, Wi]
+// and its columns [G, N * Do * Ho * Wo, Z * Y * X * C], both addressed through their strides
+template <index_t NDimSpatial>
+struct ImageColumnGeometry
+{
+    ImageColumnGeometry(const HostTensorDescriptor& image,
+                        const HostTensorDescriptor& columns,
+                        const std::vector<index_t>& filter_spatial_lengths,
+                        const std::vector<index_t>& output_spatial_lengths,
+                        const std::vector<index_t>& conv_strides,
+                        const std::vector<index_t>& conv_dilations,
+                        const std::vector<index_t>& in_left_pads)
+        : G(image.GetLengths()[0]), N(image.GetLengths()[1]), C(image.GetLengths()[2])
+    {
+        for(index_t i = 0; i < NDimSpatial; ++i)
+        {
+            in_lengths[i]     = image.GetLengths()[3 + i];
+            out_lengths[i]    = output_spatial_lengths[i];
+            filter_lengths[i] = filter_spatial_lengths[i];
+            strides[i]        = conv_strides[i];
+            dilations[i]      = conv_dilations[i];
+            left_pads[i]      = in_left_pads[i];
+        }
+        std::copy(image.GetStrides().begin(), image.GetStrides().end(), image_strides.begin());
+        std::copy(columns.GetStrides().begin(), columns.GetStrides().end(), column_strides.begin());
+
+        num_outputs = 1;
+        num_taps    = 1;
+        for(index_t i = 0; i < NDimSpatial; ++i)
+        {
+            num_outputs *= out_lengths[i];
+            num_taps *= filter_lengths[i];
+        }
+    }
+
+    // Calls f(column offset, image offset, di) for the run of C channels of every filter tap of
+    // output position `out` (flat over Do, Ho, Wo) of image (g, n), in z, y, x order. The image
+    // offset is -1 for taps in the padding, di the position of the tap along the outermost
+    // spatial dimension.
+    template <typename F>
+    void ForEachTap(long_index_t g, long_index_t n, long_index_t out, F f) const
+    {
+        const long_index_t row = n * num_outputs + out;
+
+        std::array<long_index_t, NDimSpatial> out_idx;
+        for(index_t i = NDimSpatial; i-- > 0;)
+        {
+            out_idx[i] = out % out_lengths[i];
+            out /= out_lengths[i];
+        }
+
+        const long_index_t column_base = g * column_strides[0] + row * column_strides[1];
+        const long_index_t image_base  = g * image_strides[0] + n * image_strides[1];
+
+        for(long_index_t t = 0; t < num_taps; ++t)
+        {
+            long_index_t image_offset = image_base;
+            long_index_t outermost    = 0;
+            long_index_t tap          = t;
+            for(index_t i = NDimSpatial; i-- > 0;)
+            {
+                const long_index_t pos = out_idx[i] * strides[i] +
+                                         tap % filter_lengths[i] * dilations[i] - left_pads[i];
+                tap /= filter_lengths[i];
+
+                if(image_offset >= 0 && pos >= 0 && pos < in_lengths[i])
+                    image_offset += pos * image_strides[3 + i];
+                else
+                    image_offset = -1;
+                outermost = pos;
+            }
+
+            f(column_base + t * C * column_strides[2], image_offset, outermost);
+        }
+    }
+
+    long_index_t G, N, C;
+    std::array<long_index_t, NDimSpatial> in_lengths;
+    std::array<long_index_t, NDimSpatial> out_lengths;
+    std::array<long_index_t, NDimSpatial> filter_lengths;
+    std::array<long_index_t, NDimSpatial> strides;
+    std::array<long_index_t, NDimSpatial> dilations;
+    std::array<long_index_t, NDimSpatial> left_pads;
+    std::array<long_index_t, NDimSpatial + 3> image_strides;
+    std::array<long_index_t, 3> column_strides;
+    long_index_t num_outputs;
+    long_index_t num_taps;
+};
+
+// Collects runs of `length` elements, merging a run that continues the previous one in both the
+// destination and the source, and moves them with op(dst_offset, src_offset, length). With packed
+// channels-last images the runs of consecutive taps are contiguous in both tensors, e.g. all
+// X * C channels of a filter row. A source offset of -1 marks padding; padding runs merge too.
+template <typename Op>
+class RunMerger
+{
+    public:
+    RunMerger(long_index_t length, long_index_t dst_stride, long_index_t src_stride, Op op)
+        : length_(length), dst_stride_(dst_stride), src_stride_(src_stride), op_(op)
+    {
+    }
+
+    ~RunMerger() { Flush(); }
+
+    void Add(long_index_t dst, long_index_t src)
+    {
+        const bool continues =
+            size_ > 0 && dst == dst_ + size_ * dst_stride_ &&
+            ((src < 0 && src_ < 0) || (src >= 0 && src_ >= 0 && src == src_ + size_ * src_stride_));
+        if(!continues)
+        {
+            Flush();
+            dst_ = dst;
+            src_ = src;
+        }
+        size_ += length_;
+    }
+
+    void Flush()
+    {
+        if(size_ > 0)
+            op_(dst_, src_, size_);
+        size_ = 0;
+    }
+
+    private:
+    long_index_t length_;
+    long_index_t dst_stride_;
+    long_index_t src_stride_;
+    Op op_;
+
+    long_index_t dst_  = 0;
+    long_index_t src_  = 0;
+    long_index_t size_ = 0;
+};
+
+// dst[i * dst_stride] = src[i * src_stride] for i < length, or zero when src is null; one memcpy
+// or fill when both are contiguous and of the same type
+template <typename DstDataType, typename SrcDataType>
+void copy_run(DstDataType* dst,
+              long_index_t dst_stride,
+              const SrcDataType* src,
+              long_index_t src_stride,
+              long_index_t length)
+{
+    if(src == nullptr)
+    {
+        if(dst_stride == 1)
+            std::fill_n(dst, length, DstDataType{0});
+        else
+            for(long_index_t i = 0; i < length; ++i)
+                dst[i * dst_stride] = DstDataType{0};
+    }
+    else if(std::is_same_v<DstDataType, SrcDataType> && dst_stride == 1 && src_stride == 1)
+    {
+        std::memcpy(dst, src, length * sizeof(DstDataType));
+    }
+    else
+    {
+        for(long_index_t i = 0; i < length; ++i)
+            dst[i * dst_stride] = ck::type_convert<DstDataType>(src[i * src_stride]);
+    }
+}
+
+// dst[i * dst_stride] += src[i * src_stride] for i < length, added in float and rounded to
+// DstDataType
+template <typename DstDataType, typename SrcDataType>
+void accumulate_run(DstDataType* dst,
+                    long_index_t dst_stride,
+                    const SrcDataType* src,
+                    long_index_t src_stride,
+                    long_index_t length)
+{
+    for(long_index_t i = 0; i < length; ++i)
+        dst[i * dst_stride] = ck::type_convert<DstDataType>(
+            ck::type_convert<float>(src[i * src_stride]) +
+            ck::type_convert<float>(dst[i * dst_stride]));
+}
+
+} // namespace detail
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -11,6 +11,7 @@
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/numeric.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_image_column_runs.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -99,139 +100,37 @@ struct ReferenceImageToColumn : public device::BaseOperator
                 throw std::runtime_error("wrong! inconsistent dimension");
             }
 
-            const index_t G = arg.input_.GetLengths()[0];
-            const index_t N = arg.input_.GetLengths()[1];
-            const index_t C = arg.input_.GetLengths()[2];
-
-            if constexpr(NDimSpatial == 1)
-            {
-                const index_t Wo = arg.output_spatial_lengths_[0];
-                auto func        = [&](auto g, auto n, auto wo) {
-                    index_t row    = n * Wo + wo;
-                    index_t column = 0;
-
-                    for(index_t x = 0; x < arg.filter_spatial_lengths_[0]; ++x)
-                    {
-                        auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[0]) +
-                                  static_cast<ck::long_index_t>(x * arg.conv_dilations_[0]) -
-                                  static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-
-                        for(index_t c = 0; c < C; ++c)
-                        {
-                            if(wi >= 0 &&
-                               ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[3])
-                            {
-                                InDataType v_in             = arg.input_(g, n, c, wi);
-                                arg.output_(g, row, column) = ck::type_convert<OutDataType>(v_in);
-                            }
-                            column++;
-                        }
-                    }
-                };
-
-                make_ParallelTensorFunctor(func, G, N, Wo)(std::thread::hardware_concurrency());
-
-                return 0;
-            }
-            else if constexpr(NDimSpatial == 2)
-            {
-                const index_t Ho = arg.output_spatial_lengths_[0];
-                const index_t Wo = arg.output_spatial_lengths_[1];
-
-                auto func = [&](auto g, auto n, auto ho, auto wo) {
-                    index_t row    = n * Ho * Wo + ho * Wo + wo;
-                    index_t column = 0;
-
-                    for(index_t y = 0; y < arg.filter_spatial_lengths_[0]; ++y)
-                    {
-                        auto hi = static_cast<ck::long_index_t>(ho * arg.conv_strides_[0]) +
-                                  static_cast<ck::long_index_t>(y * arg.conv_dilations_[0]) -
-                                  static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-
-                        for(index_t x = 0; x < arg.filter_spatial_lengths_[1]; ++x)
-                        {
-                            auto wi = static_cast<ck::long_index_t>(wo * arg.conv_strides_[1]) +
-                                      static_cast<ck::long_index_t>(x * arg.conv_dilations_[1]) -
-                                      static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-
-                            for(index_t c = 0; c < C; ++c)
-                            {
-
-                                if(hi >= 0 &&
-                                   ck::type_convert<std::size_t>(hi) < arg.input_.GetLengths()[3] &&
-                                   wi >= 0 &&
-                                   ck::type_convert<std::size_t>(wi) < arg.input_.GetLengths()[4])
-                                {
-                                    InDataType v_in = arg.input_(g, n, c, hi, wi);
-                                    arg.output_(g, row, column) =
-                                        ck::type_convert<OutDataType>(v_in);
-                                }
-                                column++;
-                            }
-                        }
-                    }
-                };
-
-                make_ParallelTensorFunctor(func, G, N, Ho, Wo)(std::thread::hardware_concurrency());
-
-                return 0;
-            }
-            else if constexpr(NDimSpatial == 3)
-            {
-                const index_t Do = arg.output_spatial_lengths_[0];
-                const index_t Ho = arg.output_spatial_lengths_[1];
-                const index_t Wo = arg.output_spatial_lengths_[2];
-
-                auto func = [&](auto g, auto n, auto d_o, auto ho, auto wo) {
-                    index_t row    = n * Do * Ho * Wo + d_o * Ho * Wo + ho * Wo + wo;
-                    index_t column = 0;
-
-                    for(index_t z = 0; z < arg.filter_spatial_lengths_[0]; ++z)
-                    {
-                        auto di = static_cast<ck::long_index_t>(d_o * arg.conv_strides_[0]) +
-                                  static_cast<ck::long_index_t>(z * arg.conv_dilations_[0]) -
-                                  static_cast<ck::long_index_t>(arg.in_left_pads_[0]);
-                        for(index_t y = 0; y < arg.filter_spatial_lengths_[1]; ++y)
-                        {
-                            auto hi = static_cast<ck::long_index_t>(ho * arg.conv_strides_[1]) +
-                                      static_cast<ck::long_index_t>(y * arg.conv_dilations_[1]) -
-                                      static_cast<ck::long_index_t>(arg.in_left_pads_[1]);
-                            for(index_t x = 0; x < arg.filter_spatial_lengths_[2]; ++x)
-                            {
-                                auto wi =
-                                    static_cast<ck::long_index_t>(wo * arg.conv_strides_[2]) +
-                                    static_cast<ck::long_index_t>(x * arg.conv_dilations_[2]) -
-                                    static_cast<ck::long_index_t>(arg.in_left_pads_[2]);
-                                for(index_t c = 0; c < C; ++c)
-                                {
-                                    if(di >= 0 &&
-                                       ck::type_convert<std::size_t>(di) <
-                                           arg.input_.GetLengths()[3] &&
-                                       hi >= 0 &&
-                                       ck::type_convert<std::size_t>(hi) <
-                                           arg.input_.GetLengths()[4] &&
-                                       wi >= 0 &&
-                                       ck::type_convert<std::size_t>(wi) <
-                                           arg.input_.GetLengths()[5])
-                                    {
-                                        InDataType v_in = arg.input_(g, n, c, di, hi, wi);
-                                        arg.output_(g, row, column) =
-                                            ck::type_convert<OutDataType>(v_in);
-                                    }
-                                    column++;
-                                }
-                            }
-                        }
-                    }
-                };
-
-                make_ParallelTensorFunctor(func, G, N, Do, Ho, Wo)(
-                    std::thread::hardware_concurrency());
-
-                return 0;
-            }
-            throw std::runtime_error("Img2Col: number of dimensions should be between 1 and 3.");
-            return 1;
+            // Every filter tap of an output position copies a run of C channels, or zeros in
+            // the padding. Runs that continue each other in both tensors are merged, so that a
+            // packed channels-last image moves whole filter rows with one memcpy.
+            const detail::ImageColumnGeometry<NDimSpatial> geometry(arg.input_.mDesc,
+                                                                    arg.output_.mDesc,
+                                                                    arg.filter_spatial_lengths_,
+                                                                    arg.output_spatial_lengths_,
+                                                                    arg.conv_strides_,
+                                                                    arg.conv_dilations_,
+                                                                    arg.in_left_pads_);
+
+            auto copy = [&](long_index_t column, long_index_t image, long_index_t length) {
+                detail::copy_run(arg.output_.mData.data() + column,
+                                 geometry.column_strides[2],
+                                 image < 0 ? nullptr : arg.input_.mData.data() + image,
+                                 geometry.image_strides[2],
+                                 length);
+            };
+
+            auto func = [&](auto g, auto n, auto out) {
+                detail::RunMerger runs(
+                    geometry.C, geometry.column_strides[2], geometry.image_strides[2], copy);
+
+                geometry.ForEachTap(
+                    g, n, out, [&](auto column, auto image, auto) { runs.Add(column, image); });
+            };
+
+            make_ParallelTensorFunctor(func, geometry.G, geometry.N, geometry.num_outputs)(
+                std::thread::hardware_concurrency());
+
+            return 0;
         }
 
         float Run(const device::BaseArgument* p_arg,
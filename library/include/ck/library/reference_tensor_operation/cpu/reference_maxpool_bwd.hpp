@@ -4,7 +4,9 @@
 #pragma once
 
 #include <iostream>
+#include <numeric>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
@@ -43,30 +45,55 @@ struct ReferenceMaxPoolBwd : public device::BaseOperator
     // Invoker
     struct Invoker : public device::BaseInvoker
     {
+        // Gathers the gradient of every din element from the dout elements whose index selects
+        // it, in parallel over din. The dout elements of a din element are grouped by a counting
+        // sort and accumulated in the order of dout, like a sequential scatter would.
         float Run(const Argument& arg)
         {
             int din_length  = arg.din_.GetElementSpaceSize();
             int dout_length = arg.dout_.GetElementSpaceSize();
-            std::vector<ConputeDataType> buf(din_length, 0);
 
+            // dout elements of din element j: sources[begin[j]], ..., sources[begin[j + 1] - 1]
+            std::vector<int> begin(din_length + 1, 0);
             for(int i = 0; i < dout_length; ++i)
             {
                 int index = arg.indices_.mData[i];
                 if(index >= 0 && index < din_length)
+                    ++begin[index + 1];
+            }
+            std::partial_sum(begin.begin(), begin.end(), begin.begin());
+
+            std::vector<int> sources(begin[din_length]);
+            {
+                std::vector<int> next(begin.begin(), begin.end() - 1);
+                for(int i = 0; i < dout_length; ++i)
+                {
+                    int index = arg.indices_.mData[i];
+                    if(index >= 0 && index < din_length)
+                        sources[next[index]++] = i;
+                }
+            }
+
+            auto f_din = [&](auto j) {
+                ConputeDataType buf = 0;
+
+                for(int s = begin[j]; s < begin[j + 1]; ++s)
                 {
                     if constexpr(is_same_v<ConputeDataType, bhalf_t>)
                     {
-                        float buf_val = ck::type_convert<float>(buf[index]);
-                        buf_val += ck::type_convert<float>(arg.dout_.mData[i]);
-                        buf[index] = ck::type_convert<ConputeDataType>(buf_val);
+                        float buf_val = ck::type_convert<float>(buf);
+                        buf_val += ck::type_convert<float>(arg.dout_.mData[sources[s]]);
+                        buf = ck::type_convert<ConputeDataType>(buf_val);
                     }
                     else
-                        buf[index] += ck::type_convert<ConputeDataType>(arg.dout_.mData[i]);
+                        buf += ck::type_convert<ConputeDataType>(arg.dout_.mData[sources[s]]);
                 }
-            }
 
-            for(int i = 0; i < din_length; ++i)
-                arg.din_.mData[i] = ck::type_convert<DInDataType>(buf[i]);
+                arg.din_.mData[j] = ck::type_convert<DInDataType>(buf);
+            };
+
+            make_ParallelTensorFunctor(f_din, din_length)(std::thread::hardware_concurrency());
+
             return 0;
         }
 
@@ -7,12 +7,15 @@
 #include <sstream>
 #include <vector>
 #include <algorithm>
+#include <stdexcept>
+#include <thread>
 
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/tensor_operation/gpu/device/reduction_operator_mapping.hpp"
 #include "ck/utility/reduction_functions_accumulate.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_sliding_window.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -68,8 +71,14 @@ struct ReferencePoolingFwd : public device::BaseOperator
     // Invoker
     struct Invoker : public device::BaseInvoker
     {
-        float RunPooling3dFwd(const Argument& arg)
+        // The window reduction is separable: sums (add, avg, norm1, norm2) are taken along one
+        // spatial axis after another with prefix sums, and max, min and amax with a sliding
+        // monotonic deque, both at a cost independent of the window size. The element taken by
+        // max, min or amax is the one the per-window accumulation in z, y, x order would keep.
+        float RunPoolingFwd(const Argument& arg)
         {
+            using detail::SlidingWindow;
+            using detail::WindowCandidate;
 
             auto elementwise_ops =
                 ck::reduce_unary_operator<ReduceOpId, true, true>::GetElementwiseOperator(
@@ -78,233 +87,160 @@ struct ReferencePoolingFwd : public device::BaseOperator
             auto in_elementwise_op  = std::get<0>(elementwise_ops);
             auto acc_elementwise_op = std::get<1>(elementwise_ops);
 
-            if constexpr(!OutputIndex)
-            {
-                using Accumulation = ck::detail::
-                    AccumulateWithNanCheck<PropagateNan, ReduceOperation, ComputeDataType>;
+            const std::size_t num_thread = std::thread::hardware_concurrency();
 
-                auto f_ncdhw = [&](auto n, auto c, auto do_, auto ho, auto wo) {
-                    auto accuVal = ReduceOperation::template GetIdentityValue<ComputeDataType>();
+            std::vector<SlidingWindow> windows(WindowRank);
+            for(index_t i = 0; i < WindowRank; ++i)
+                windows[i] = SlidingWindow{arg.window_spatial_lengths_[i],
+                                           arg.window_strides_[i],
+                                           arg.window_dilations_[i],
+                                           arg.in_left_pads_[i]};
 
-                    for(ck::index_t z = 0; z < arg.window_spatial_lengths_[0]; ++z)
-                    {
-                        ck::index_t di = do_ * arg.window_strides_[0] +
-                                         z * arg.window_dilations_[0] - arg.in_left_pads_[0];
-                        for(ck::index_t y = 0; y < arg.window_spatial_lengths_[1]; ++y)
-                        {
-                            ck::index_t hi = ho * arg.window_strides_[1] +
-                                             y * arg.window_dilations_[1] - arg.in_left_pads_[1];
-                            for(ck::index_t x = 0; x < arg.window_spatial_lengths_[2]; ++x)
-                            {
-                                ck::index_t wi = wo * arg.window_strides_[2] +
-                                                 x * arg.window_dilations_[2] -
-                                                 arg.in_left_pads_[2];
-                                if(di >= 0 &&
-                                   di < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[2]) &&
-                                   hi >= 0 &&
-                                   hi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[3]) &&
-                                   wi >= 0 &&
-                                   wi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[4]))
-                                {
-                                    ComputeDataType currVal = ck::type_convert<ComputeDataType>(
-                                        arg.in_(n, c, di, hi, wi));
-
-                                    in_elementwise_op(currVal, currVal);
-
-                                    Accumulation::Calculate(accuVal, currVal);
-                                }
-                            }
-                        }
-                    }
-                    acc_elementwise_op(accuVal, accuVal);
+            // in_elementwise_op(in) in a packed [N, C, Di, Hi, Wi] buffer, reduced one spatial
+            // axis after another to the packed [N, C, Do, Ho, Wo] output
+            auto f_reduce = [&](auto f_load, auto f_line) {
+                using T = decltype(f_load(std::size_t{}));
 
-                    arg.out_(n, c, do_, ho, wo) = ck::type_convert<OutDataType>(accuVal);
-                };
+                std::vector<std::size_t> lengths = arg.in_.mDesc.GetLengths();
+                std::vector<T> buf(arg.in_.mDesc.GetElementSize());
 
-                make_ParallelTensorFunctor(f_ncdhw,
-                                           arg.out_.mDesc.GetLengths()[0],
-                                           arg.out_.mDesc.GetLengths()[1],
-                                           arg.out_.mDesc.GetLengths()[2],
-                                           arg.out_.mDesc.GetLengths()[3],
-                                           arg.out_.mDesc.GetLengths()[4])(
-                    std::thread::hardware_concurrency());
-            }
-            else
-            {
-                using Accumulation = ck::detail::AccumulateWithIndexAndNanCheck<PropagateNan,
-                                                                                ReduceOperation,
-                                                                                ComputeDataType,
-                                                                                IndexDataType>;
+                make_ParallelTensorFunctor([&](auto i) { buf[i] = f_load(i); }, buf.size())(
+                    num_thread);
 
-                auto f_ncdhw = [&](auto n, auto c, auto do_, auto ho, auto wo) {
-                    auto accuVal = ReduceOperation::template GetIdentityValue<ComputeDataType>();
-                    IndexDataType accuIndex = 0;
+                for(index_t i = 0; i < WindowRank; ++i)
+                    buf = detail::transform_axis(
+                        buf,
+                        lengths,
+                        2 + i,
+                        arg.out_.mDesc.GetLengths()[2 + i],
+                        [&](const auto& in, auto& out) { f_line(in, out, windows[i]); });
 
-                    for(ck::index_t z = 0; z < arg.window_spatial_lengths_[0]; ++z)
-                    {
-                        ck::index_t di = do_ * arg.window_strides_[0] +
-                                         z * arg.window_dilations_[0] - arg.in_left_pads_[0];
-                        for(ck::index_t y = 0; y < arg.window_spatial_lengths_[1]; ++y)
-                        {
-                            ck::index_t hi = ho * arg.window_strides_[1] +
-                                             y * arg.window_dilations_[1] - arg.in_left_pads_[1];
-                            for(ck::index_t x = 0; x < arg.window_spatial_lengths_[2]; ++x)
-                            {
-                                ck::index_t wi = wo * arg.window_strides_[2] +
-                                                 x * arg.window_dilations_[2] -
-                                                 arg.in_left_pads_[2];
-                                if(di >= 0 &&
-                                   di < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[2]) &&
-                                   hi >= 0 &&
-                                   hi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[3]) &&
-                                   wi >= 0 &&
-                                   wi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[4]))
-                                {
-                                    ComputeDataType currVal = ck::type_convert<ComputeDataType>(
-                                        arg.in_(n, c, di, hi, wi));
-                                    IndexDataType currIndex =
-                                        arg.in_.GetOffsetFromMultiIndex(n, c, di, hi, wi);
-
-                                    in_elementwise_op(currVal, currVal);
-
-                                    Accumulation::Calculate(accuVal, currVal, accuIndex, currIndex);
-                                }
-                            }
-                        }
-                    }
+                return buf;
+            };
 
-                    acc_elementwise_op(accuVal, accuVal);
+            auto f_in = [&](std::size_t i) {
+                ComputeDataType v = ck::type_convert<ComputeDataType>(
+                    arg.in_.mData[detail::packed_to_offset(i, arg.in_.mDesc)]);
 
-                    arg.out_(n, c, do_, ho, wo)         = ck::type_convert<OutDataType>(accuVal);
-                    arg.out_indices_(n, c, do_, ho, wo) = accuIndex;
-                };
-
-                make_ParallelTensorFunctor(f_ncdhw,
-                                           arg.out_.mDesc.GetLengths()[0],
-                                           arg.out_.mDesc.GetLengths()[1],
-                                           arg.out_.mDesc.GetLengths()[2],
-                                           arg.out_.mDesc.GetLengths()[3],
-                                           arg.out_.mDesc.GetLengths()[4])(
-                    std::thread::hardware_concurrency());
+                in_elementwise_op(v, v);
+                return v;
             };
 
-            return 0;
-        }
-
-        float RunPooling2dFwd(const Argument& arg)
-        {
+            auto f_store = [&](auto f_out) {
+                make_ParallelTensorFunctor(
+                    [&](auto i) {
+                        ComputeDataType v = f_out(i);
 
-            auto elementwise_ops =
-                ck::reduce_unary_operator<ReduceOpId, true, true>::GetElementwiseOperator(
-                    arg.reduceLength_);
+                        acc_elementwise_op(v, v);
+                        arg.out_.mData[detail::packed_to_offset(i, arg.out_.mDesc)] =
+                            ck::type_convert<OutDataType>(v);
+                    },
+                    arg.out_.mDesc.GetElementSize())(num_thread);
+            };
 
-            auto in_elementwise_op  = std::get<0>(elementwise_ops);
-            auto acc_elementwise_op = std::get<1>(elementwise_ops);
+            if constexpr(ReduceOpId == ReduceTensorOp::ADD || ReduceOpId == ReduceTensorOp::AVG ||
+                         ReduceOpId == ReduceTensorOp::NORM1 || ReduceOpId == ReduceTensorOp::NORM2)
+            {
+                const auto sums = f_reduce(
+                    [&](std::size_t i) { return detail::to_double(f_in(i)); },
+                    [](const auto& in, auto& out, const SlidingWindow& window) {
+                        detail::sliding_window_sum(in, out, window);
+                    });
 
-            if constexpr(!OutputIndex)
+                f_store([&](auto i) { return detail::from_double<ComputeDataType>(sums[i]); });
+            }
+            else if constexpr(ReduceOpId == ReduceTensorOp::MUL)
             {
                 using Accumulation = ck::detail::
                     AccumulateWithNanCheck<PropagateNan, ReduceOperation, ComputeDataType>;
 
-                auto f_nchw = [&](auto n, auto c, auto ho, auto wo) {
-                    auto accuVal = ReduceOperation::template GetIdentityValue<ComputeDataType>();
-
-                    for(ck::index_t y = 0; y < arg.window_spatial_lengths_[0]; ++y)
-                    {
-                        ck::index_t hi = ho * arg.window_strides_[0] +
-                                         y * arg.window_dilations_[0] - arg.in_left_pads_[0];
-                        for(ck::index_t x = 0; x < arg.window_spatial_lengths_[1]; ++x)
-                        {
-                            ck::index_t wi = wo * arg.window_strides_[1] +
-                                             x * arg.window_dilations_[1] - arg.in_left_pads_[1];
-                            if(hi >= 0 &&
-                               hi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[2]) &&
-                               wi >= 0 &&
-                               wi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[3]))
-                            {
-                                ComputeDataType currVal =
-                                    ck::type_convert<ComputeDataType>(arg.in_(n, c, hi, wi));
-
-                                in_elementwise_op(currVal, currVal);
-
-                                Accumulation::Calculate(accuVal, currVal);
-                            }
-                        }
-                    }
-
-                    acc_elementwise_op(accuVal, accuVal);
-                    arg.out_(n, c, ho, wo) = ck::type_convert<OutDataType>(accuVal);
-                };
-
-                make_ParallelTensorFunctor(f_nchw,
-                                           arg.out_.mDesc.GetLengths()[0],
-                                           arg.out_.mDesc.GetLengths()[1],
-                                           arg.out_.mDesc.GetLengths()[2],
-                                           arg.out_.mDesc.GetLengths()[3])(
-                    std::thread::hardware_concurrency());
+                const auto products = f_reduce(
+                    f_in, [](const auto& in, auto& out, const SlidingWindow& window) {
+                        detail::sliding_window_accumulate(
+                            in,
+                            out,
+                            window,
+                            ReduceOperation::template GetIdentityValue<ComputeDataType>(),
+                            [](auto& acc, auto v) { Accumulation::Calculate(acc, v); });
+                    });
+
+                f_store([&](auto i) { return products[i]; });
             }
             else
             {
-                using Accumulation = ck::detail::AccumulateWithIndexAndNanCheck<PropagateNan,
-                                                                                ReduceOperation,
-                                                                                ComputeDataType,
-                                                                                IndexDataType>;
+                using Candidate = WindowCandidate<ComputeDataType>;
 
-                auto f_nchw = [&](auto n, auto c, auto ho, auto wo) {
-                    auto accuVal = ReduceOperation::template GetIdentityValue<ComputeDataType>();
-                    IndexDataType accuIndex = 0;
+                const auto identity = ReduceOperation::template GetIdentityValue<ComputeDataType>();
 
-                    for(ck::index_t y = 0; y < arg.window_spatial_lengths_[0]; ++y)
+                // whether value a replaces value b in an accumulation starting from b
+                auto replaces = [](ComputeDataType a, ComputeDataType b) {
+                    bool changed = false;
+                    ReduceOperation{}(b, a, changed);
+                    return changed;
+                };
+
+                // The accumulation keeps the first of equal elements, and the last NaN when it
+                // propagates them, and ignores NaNs otherwise. Offsets in the packed input grow
+                // with z, y, x in every window.
+                auto ranks_higher = [&](const Candidate& x, const Candidate& y) {
+                    if constexpr(PropagateNan)
                     {
-                        ck::index_t hi = ho * arg.window_strides_[0] +
-                                         y * arg.window_dilations_[0] - arg.in_left_pads_[0];
-                        for(ck::index_t x = 0; x < arg.window_spatial_lengths_[1]; ++x)
-                        {
-                            ck::index_t wi = wo * arg.window_strides_[1] +
-                                             x * arg.window_dilations_[1] - arg.in_left_pads_[1];
-                            if(hi >= 0 &&
-                               hi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[2]) &&
-                               wi >= 0 &&
-                               wi < static_cast<ck::index_t>(arg.in_.mDesc.GetLengths()[3]))
-                            {
-                                ComputeDataType currVal =
-                                    ck::type_convert<ComputeDataType>(arg.in_(n, c, hi, wi));
-
-                                IndexDataType currIndex =
-                                    arg.in_.GetOffsetFromMultiIndex(n, c, hi, wi);
-
-                                in_elementwise_op(currVal, currVal);
-
-                                Accumulation::Calculate(accuVal, currVal, accuIndex, currIndex);
-                            }
-                        }
+                        const bool x_nan = ck::math::isnan(x.value);
+                        const bool y_nan = ck::math::isnan(y.value);
+                        if(x_nan || y_nan)
+                            return x_nan && (!y_nan || x.key > y.key);
                     }
+                    if(replaces(x.value, y.value))
+                        return true;
+                    if(replaces(y.value, x.value))
+                        return false;
+                    return x.key < y.key;
+                };
 
-                    acc_elementwise_op(accuVal, accuVal);
-                    arg.out_(n, c, ho, wo)         = ck::type_convert<OutDataType>(accuVal);
-                    arg.out_indices_(n, c, ho, wo) = accuIndex;
+                const auto selected = f_reduce(
+                    [&](std::size_t i) {
+                        const ComputeDataType v = f_in(i);
+                        const bool ignored      = !PropagateNan && ck::math::isnan(v);
+                        return Candidate{v, ignored ? -1 : static_cast<long_index_t>(i)};
+                    },
+                    [&](const auto& in, auto& out, const SlidingWindow& window) {
+                        detail::sliding_window_select(in, out, window, ranks_higher);
+                    });
+
+                // like the accumulation, keep the identity unless the selected element replaces it
+                auto is_selected = [&](const Candidate& x) {
+                    return x.key >= 0 && ((PropagateNan && ck::math::isnan(x.value)) ||
+                                          replaces(x.value, identity));
                 };
 
-                make_ParallelTensorFunctor(f_nchw,
-                                           arg.out_.mDesc.GetLengths()[0],
-                                           arg.out_.mDesc.GetLengths()[1],
-                                           arg.out_.mDesc.GetLengths()[2],
-                                           arg.out_.mDesc.GetLengths()[3])(
-                    std::thread::hardware_concurrency());
-            };
+                f_store([&](auto i) {
+                    return is_selected(selected[i]) ? selected[i].value : identity;
+                });
+
+                if constexpr(OutputIndex)
+                {
+                    make_ParallelTensorFunctor(
+                        [&](auto i) {
+                            arg.out_indices_.mData[detail::packed_to_offset(
+                                i, arg.out_indices_.mDesc)] =
+                                is_selected(selected[i])
+                                    ? static_cast<IndexDataType>(
+                                          detail::packed_to_offset(selected[i].key, arg.in_.mDesc))
+                                    : IndexDataType{0};
+                        },
+                        arg.out_indices_.mDesc.GetElementSize())(num_thread);
+                }
+            }
 
             return 0;
         }
 
         float Run(const Argument& arg)
         {
-            // TODO - support generic pooling
-            if constexpr(InOutRank == 5 && WindowRank == 3)
-                return RunPooling3dFwd(arg);
-            else if constexpr(InOutRank == 4 && WindowRank == 2)
-                return RunPooling2dFwd(arg);
+            if constexpr(InOutRank == WindowRank + 2)
+                return RunPoolingFwd(arg);
             else
-                throw std::runtime_error("Only support pooling3d or pooling2d so far");
+                throw std::runtime_error("wrong! pooling needs [N, C, spatial...] tensors");
         }
 
         float Run(const device::BaseArgument* p_arg,
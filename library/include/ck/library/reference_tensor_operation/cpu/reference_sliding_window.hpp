@@ -0,0 +1,327 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+namespace detail {
+
+// Sliding windows of the host pooling references, one spatial axis at a time: output o of an axis
+// reduces the input positions o * stride - left_pad + t * dilation, t = 0, ..., window - 1, that
+// lie in [0, length). Sums and running maxima of the separable pooling operators are taken along
+// every axis in turn, at a cost independent of the window size.
+struct SlidingWindow
+{
+    long_index_t window;
+    long_index_t stride;
+    long_index_t dilation;
+    long_index_t left_pad;
+
+    // first and last tap t of output o whose input position lies in [0, length), first > last if
+    // there is none
+    std::pair<long_index_t, long_index_t> Taps(long_index_t o, long_index_t length) const
+    {
+        const long_index_t w0 = o * stride - left_pad;
+
+        const long_index_t first = w0 >= 0 ? 0 : (dilation - 1 - w0) / dilation;
+        const long_index_t last =
+            length - 1 - w0 < 0 ? -1 : std::min(window - 1, (length - 1 - w0) / dilation);
+        return {first, last};
+    }
+
+    long_index_t Position(long_index_t o, long_index_t t) const
+    {
+        return o * stride - left_pad + t * dilation;
+    }
+};
+
+// Sums of x[a], x[a + step], ..., x[b] of a line in O(1), from prefix sums along every residue
+// class mod step. NaNs and infinities are counted instead of summed, so that they do not leak into
+// the sums of the ranges after them.
+class ProgressionSums
+{
+    public:
+    ProgressionSums(const std::vector<double>& x, std::size_t step)
+        : step_(step), sum_(x.size()), nan_(x.size()), pos_inf_(x.size()), neg_inf_(x.size())
+    {
+        for(std::size_t i = 0; i < x.size(); ++i)
+        {
+            const bool has_prev = i >= step_;
+
+            sum_[i]     = (std::isfinite(x[i]) ? x[i] : 0.0) + (has_prev ? sum_[i - step_] : 0.0);
+            nan_[i]     = std::isnan(x[i]) + (has_prev ? nan_[i - step_] : 0);
+            pos_inf_[i] = (x[i] == std::numeric_limits<double>::infinity()) +
+                          (has_prev ? pos_inf_[i - step_] : 0);
+            neg_inf_[i] = (x[i] == -std::numeric_limits<double>::infinity()) +
+                          (has_prev ? neg_inf_[i - step_] : 0);
+        }
+    }
+
+    // a <= b and a = b mod step
+    double operator()(std::size_t a, std::size_t b) const
+    {
+        auto range = [&](const auto& prefix) {
+            return a >= step_ ? prefix[b] - prefix[a - step_] : prefix[b];
+        };
+
+        const bool pos_inf = range(pos_inf_) > 0;
+        const bool neg_inf = range(neg_inf_) > 0;
+
+        if(range(nan_) > 0 || (pos_inf && neg_inf))
+            return std::numeric_limits<double>::quiet_NaN();
+        if(pos_inf)
+            return std::numeric_limits<double>::infinity();
+        if(neg_inf)
+            return -std::numeric_limits<double>::infinity();
+        return range(sum_);
+    }
+
+    private:
+    std::size_t step_;
+    std::vector<double> sum_;
+    std::vector<std::size_t> nan_;
+    std::vector<std::size_t> pos_inf_;
+    std::vector<std::size_t> neg_inf_;
+};
+
+// out[o] = sum of the inputs in the window of o, 0 for an empty window
+inline void sliding_window_sum(const std::vector<double>& in,
+                               std::vector<double>& out,
+                               const SlidingWindow& window)
+{
+    const ProgressionSums sums(in, window.dilation);
+    const long_index_t length = in.size();
+
+    for(std::size_t o = 0; o < out.size(); ++o)
+    {
+        const auto [first, last] = window.Taps(o, length);
+
+        out[o] = first <= last ? sums(window.Position(o, first), window.Position(o, last)) : 0.0;
+    }
+}
+
+// Adjoint of sliding_window_sum(): out[i] = sum of in[o] over the outputs o that have a tap at
+// position i, gathered per position. The outputs o with o * stride = i + left_pad mod dilation
+// form an arithmetic progression of step dilation / gcd(stride, dilation), of which those whose
+// window reaches i are a contiguous range.
+inline void sliding_window_sum_transposed(const std::vector<double>& in,
+                                          std::vector<double>& out,
+                                          const SlidingWindow& window)
+{
+    const long_index_t g    = std::gcd(window.stride, window.dilation);
+    const long_index_t step = window.dilation / g;
+
+    // inverse of stride / g mod step
+    long_index_t inverse = 1;
+    {
+        long_index_t r0 = window.stride / g % step, r1 = step;
+        long_index_t s0 = 1, s1 = 0;
+        while(r1 != 0)
+        {
+            const long_index_t q = r0 / r1;
+            r0 = std::exchange(r1, r0 - q * r1);
+            s0 = std::exchange(s1, s0 - q * s1);
+        }
+        inverse = (s0 % step + step) % step;
+    }
+
+    const ProgressionSums sums(in, step);
+    const long_index_t num_out = in.size();
+
+    for(std::size_t i = 0; i < out.size(); ++i)
+    {
+        out[i] = 0.0;
+
+        // o * stride = c - t * dilation for a tap t in [0, window)
+        const long_index_t c = static_cast<long_index_t>(i) + window.left_pad;
+        if(c % g != 0)
+            continue;
+
+        const long_index_t residue = c / g % step * inverse % step;
+
+        const long_index_t lowest = c - (window.window - 1) * window.dilation;
+        const long_index_t lo = lowest <= 0 ? 0 : (lowest + window.stride - 1) / window.stride;
+        const long_index_t hi = std::min(num_out - 1, c / window.stride);
+
+        const long_index_t first = lo + ((residue - lo % step) % step + step) % step;
+        const long_index_t last  = hi - ((hi % step - residue) % step + step) % step;
+
+        if(first <= last)
+            out[i] = sums(first, last);
+    }
+}
+
+// Candidate of a selecting reduction (max, min, amax): the value and the packed offset of the
+// element it was taken from, key < 0 for none
+template <typename T>
+struct WindowCandidate
+{
+    T value;
+    long_index_t key;
+};
+
+// out[o] = the candidate of the window of o that ranks highest, by ranks_higher(x, y) of a strict
+// total order, from a monotonic deque per residue class mod dilation. Windows of the same residue
+// slide forward with o, so that every input is pushed and popped at most once.
+template <typename T, typename RanksHigher>
+void sliding_window_select(const std::vector<WindowCandidate<T>>& in,
+                           std::vector<WindowCandidate<T>>& out,
+                           const SlidingWindow& window,
+                           RanksHigher ranks_higher)
+{
+    const long_index_t length = in.size();
+
+    std::vector<std::deque<long_index_t>> deques(window.dilation);
+    std::vector<long_index_t> next(window.dilation);
+    std::iota(next.begin(), next.end(), long_index_t{0});
+
+    for(std::size_t o = 0; o < out.size(); ++o)
+    {
+        out[o].key = -1;
+
+        const auto [first, last] = window.Taps(o, length);
+        if(first > last)
+            continue;
+
+        const long_index_t begin = window.Position(o, first);
+        const long_index_t end   = window.Position(o, last);
+
+        auto& deque = deques[begin % window.dilation];
+        auto& push  = next[begin % window.dilation];
+
+        for(push = std::max(push, begin); push <= end; push += window.dilation)
+        {
+            if(in[push].key < 0)
+                continue;
+            while(!deque.empty() && ranks_higher(in[push], in[deque.back()]))
+                deque.pop_back();
+            deque.push_back(push);
+        }
+        while(!deque.empty() && deque.front() < begin)
+            deque.pop_front();
+
+        if(!deque.empty())
+            out[o] = in[deque.front()];
+    }
+}
+
+// out[o] = accumulation of the window of o with accumulate(acc, x), starting from identity, for
+// reductions without a sliding formulation
+template <typename T, typename Accumulate>
+void sliding_window_accumulate(const std::vector<T>& in,
+                               std::vector<T>& out,
+                               const SlidingWindow& window,
+                               T identity,
+                               Accumulate accumulate)
+{
+    const long_index_t length = in.size();
+
+    for(std::size_t o = 0; o < out.size(); ++o)
+    {
+        const auto [first, last] = window.Taps(o, length);
+
+        out[o] = identity;
+        for(long_index_t t = first; t <= last; ++t)
+            accumulate(out[o], in[window.Position(o, t)]);
+    }
+}
+
+// Replaces the lines along `axis` of the packed row-major buffer `in` of `lengths` with lines of
+// out_length, f_line(in_line, out_line), in parallel over the dimensions before `axis`
+template <typename T, typename F>
+std::vector<T> transform_axis(const std::vector<T>& in,
+                              std::vector<std::size_t>& lengths,
+                              std::size_t axis,
+                              std::size_t out_length,
+                              F f_line)
+{
+    const std::size_t outer = std::accumulate(
+        lengths.begin(), lengths.begin() + axis, std::size_t{1}, std::multiplies<std::size_t>{});
+    const std::size_t inner = std::accumulate(
+        lengths.begin() + axis + 1, lengths.end(), std::size_t{1}, std::multiplies<std::size_t>{});
+    const std::size_t length = lengths[axis];
+
+    std::vector<T> out(outer * out_length * inner);
+
+    auto f_outer = [&](auto i) {
+        std::vector<T> line_in(length);
+        std::vector<T> line_out(out_length);
+
+        for(std::size_t j = 0; j < inner; ++j)
+        {
+            for(std::size_t l = 0; l < length; ++l)
+                line_in[l] = in[(i * length + l) * inner + j];
+
+            f_line(line_in, line_out);
+
+            for(std::size_t l = 0; l < out_length; ++l)
+                out[(i * out_length + l) * inner + j] = line_out[l];
+        }
+    };
+
+    make_ParallelTensorFunctor(f_outer, outer)(std::thread::hardware_concurrency());
+
+    lengths[axis] = out_length;
+    return out;
+}
+
+// Exact conversions between the data types of the pooling references and the double precision of
+// their window sums. bhalf_t is a uint16_t and the f8 types are _BitInts, which type_convert only
+// converts to and from float; all their values are exact in float.
+template <typename T>
+inline constexpr bool converts_through_float_v =
+    std::is_same_v<T, bhalf_t> || std::is_same_v<T, f8_t> || std::is_same_v<T, bf8_t>;
+
+template <typename T>
+double to_double(T x)
+{
+    if constexpr(converts_through_float_v<T>)
+        return ck::type_convert<float>(x);
+    else
+        return ck::type_convert<double>(x);
+}
+
+template <typename T>
+T from_double(double x)
+{
+    if constexpr(converts_through_float_v<T>)
+        return ck::type_convert<T>(static_cast<float>(x));
+    else
+        return ck::type_convert<T>(x);
+}
+
+// offset in `desc` of the i-th element of its lengths in packed row-major order
+inline std::size_t packed_to_offset(std::size_t i, const HostTensorDescriptor& desc)
+{
+    const auto& lengths = desc.GetLengths();
+    const auto& strides = desc.GetStrides();
+
+    std::size_t offset = 0;
+    for(std::size_t d = lengths.size(); d-- > 0;)
+    {
+        offset += i % lengths[d] * strides[d];
+        i /= lengths[d];
+    }
+    return offset;
+}
+
+} // namespace detail
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
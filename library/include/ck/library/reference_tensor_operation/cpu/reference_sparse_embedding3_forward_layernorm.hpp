@@ -11,6 +11,7 @@
 #include "ck/tensor_operation/gpu/device/device_base.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_sparse_embeddings_forward_layernorm.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -55,14 +56,14 @@ struct ReferenceSparseEmbedding3ForwardLayernorm : public device::BaseOperator
         {
         }
         Tensor<OutType>& output_;
-        const Tensor<EmbType> emb_a_;
-        const Tensor<EmbType> emb_b_;
-        const Tensor<EmbType> emb_c_;
-        const Tensor<IndexType> index_a_;
-        const Tensor<IndexType> index_b_;
-        const Tensor<IndexType> index_c_;
-        const Tensor<GammaDataType> gamma_;
-        const Tensor<BetaDataType> beta_;
+        const Tensor<EmbType>& emb_a_;
+        const Tensor<EmbType>& emb_b_;
+        const Tensor<EmbType>& emb_c_;
+        const Tensor<IndexType>& index_a_;
+        const Tensor<IndexType>& index_b_;
+        const Tensor<IndexType>& index_c_;
+        const Tensor<GammaDataType>& gamma_;
+        const Tensor<BetaDataType>& beta_;
         ck::index_t NumRows_;
         ck::index_t EmbeddingDim_;
         ck::index_t IndexLength_;
@@ -74,65 +75,17 @@ struct ReferenceSparseEmbedding3ForwardLayernorm : public device::BaseOperator
     {
         float Run(const Argument& arg)
         {
-            ck::index_t D = arg.EmbeddingDim_;
-            ck::index_t L = arg.IndexLength_;
-            ck::index_t E = arg.NumRows_;
-
-            Tensor<AccDataType> accumulator({L, D});
-
-            Tensor<AccDataType> mean({L});
-            Tensor<AccDataType> var({L});
-
-            accumulator.SetZero();
-
-            auto f_emb_per_row = [&](auto idx) {
-                IndexType idx_a = arg.index_a_(idx);
-                IndexType idx_b = arg.index_b_(idx);
-                IndexType idx_c = arg.index_c_(idx);
-
-                if(!((idx_a < E) && (idx_b < E) && (idx_c < E)))
-                {
-                    throw(std::runtime_error("wrong! out of range"));
-                }
-
-                for(auto d = 0; d < D; d++)
-                {
-                    auto v_a = ck::type_convert<AccDataType>(arg.emb_a_(idx_a, d));
-                    auto v_b = ck::type_convert<AccDataType>(arg.emb_b_(idx_b, d));
-                    auto v_c = ck::type_convert<AccDataType>(arg.emb_c_(idx_c, d));
-
-                    accumulator(idx, d) += v_a + v_b + v_c;
-                }
-            };
-            make_ParallelTensorFunctor(f_emb_per_row, L)(std::thread::hardware_concurrency());
-
-            // layernorm
-            for(auto idx = 0; idx < L; ++idx)
-            {
-                mean(idx) = 0;
-                var(idx)  = 0;
-
-                for(auto d = 0; d < D; ++d)
-                {
-                    auto x_val = accumulator(idx, d);
-                    mean(idx) += x_val;
-                    var(idx) += x_val * x_val;
-                }
-
-                mean(idx) = mean(idx) / D;
-                var(idx)  = (var(idx) / D) - (mean(idx) * mean(idx));
-            }
-
-            for(auto idx = 0; idx < L; ++idx)
-            {
-                for(auto d = 0; d < D; ++d)
-                {
-                    auto x_val          = accumulator(idx, d);
-                    auto y_val          = (x_val - mean(idx)) / sqrt(var(idx) + arg.epsilon_);
-                    y_val               = (y_val * arg.gamma_(d)) + arg.beta_(d);
-                    arg.output_(idx, d) = ck::type_convert<OutType>(y_val);
-                }
-            }
+            detail::sparse_embeddings_forward_layernorm<AccDataType>(
+                arg.output_,
+                std::array<const Tensor<EmbType>*, 3>{&arg.emb_a_, &arg.emb_b_, &arg.emb_c_},
+                std::array<const Tensor<IndexType>*, 3>{
+                    &arg.index_a_, &arg.index_b_, &arg.index_c_},
+                arg.gamma_,
+                arg.beta_,
+                arg.NumRows_,
+                arg.EmbeddingDim_,
+                arg.IndexLength_,
+                arg.epsilon_);
             return 0;
         }
 
@@ -0,0 +1,289 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "ck/tensor_operation/gpu/device/device_base.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace host {
+namespace detail {
+
+// Prefetches the cache lines of a contiguous row that is looked up next
+template <typename T>
+void prefetch_row(const T* p, long_index_t length)
+{
+    constexpr long_index_t line = std::max<long_index_t>(1, 64 / sizeof(T));
+
+    for(long_index_t i = 0; i < length; i += line)
+        __builtin_prefetch(p + i);
+}
+
+// output(l, d) = layernorm over d of the sum of embs[t](indexes[t](l), d) over the tables t, in
+// parallel over batches of rows. The sum of a row is gathered into a row buffer in blocks, while
+// the Welford mean and variance of the finished blocks are merged into those of the row; the row
+// is then normalized straight into the output. The rows of the next lookup are prefetched while
+// one is reduced.
+template <typename AccDataType,
+          typename EmbType,
+          typename IndexType,
+          typename GammaDataType,
+          typename BetaDataType,
+          typename OutType,
+          std::size_t NumEmbeddings>
+void sparse_embeddings_forward_layernorm(
+    Tensor<OutType>& output,
+    const std::array<const Tensor<EmbType>*, NumEmbeddings>& embs,
+    const std::array<const Tensor<IndexType>*, NumEmbeddings>& indexes,
+    const Tensor<GammaDataType>& gamma,
+    const Tensor<BetaDataType>& beta,
+    long_index_t num_rows,
+    long_index_t D,
+    long_index_t L,
+    AccDataType epsilon)
+{
+    static_assert(NumEmbeddings > 0, "wrong! no embedding table");
+
+    constexpr long_index_t rows_per_task = 16;
+    constexpr long_index_t block         = 64;
+
+    // every lookup is checked before the workers start, they can not throw
+    std::array<std::vector<long_index_t>, NumEmbeddings> row_offsets;
+    std::array<long_index_t, NumEmbeddings> emb_strides;
+    bool contiguous = true;
+    for(std::size_t t = 0; t < NumEmbeddings; ++t)
+    {
+        row_offsets[t].resize(L);
+        for(long_index_t l = 0; l < L; ++l)
+        {
+            const auto row = static_cast<long_index_t>((*indexes[t])(l));
+            if(row < 0 || row >= num_rows)
+                throw std::runtime_error("wrong! out of range");
+
+            row_offsets[t][l] = row * embs[t]->mDesc.GetStrides()[0];
+        }
+
+        emb_strides[t] = embs[t]->mDesc.GetStrides()[1];
+        contiguous     = contiguous && emb_strides[t] == 1;
+    }
+
+    std::vector<AccDataType> gamma_acc(D);
+    std::vector<AccDataType> beta_acc(D);
+    for(long_index_t d = 0; d < D; ++d)
+    {
+        gamma_acc[d] = ck::type_convert<AccDataType>(gamma(d));
+        beta_acc[d]  = ck::type_convert<AccDataType>(beta(d));
+    }
+
+    const long_index_t out_row_stride = output.mDesc.GetStrides()[0];
+    const long_index_t out_stride     = output.mDesc.GetStrides()[1];
+
+    auto f_rows = [&](auto task) {
+        std::vector<AccDataType> x(D);
+
+        const long_index_t l_begin = task * rows_per_task;
+        const long_index_t l_end   = std::min(L, l_begin + rows_per_task);
+
+        for(long_index_t l = l_begin; l < l_end; ++l)
+        {
+            if(contiguous && l + 1 < L)
+                for(std::size_t t = 0; t < NumEmbeddings; ++t)
+                    prefetch_row(embs[t]->mData.data() + row_offsets[t][l + 1], D);
+
+            std::array<const EmbType*, NumEmbeddings> p;
+            for(std::size_t t = 0; t < NumEmbeddings; ++t)
+                p[t] = embs[t]->mData.data() + row_offsets[t][l];
+
+            AccDataType mean  = 0;
+            AccDataType m2    = 0;
+            long_index_t size = 0;
+
+            for(long_index_t d_begin = 0; d_begin < D; d_begin += block)
+            {
+                const long_index_t d_end = std::min(D, d_begin + block);
+                const long_index_t n     = d_end - d_begin;
+
+                AccDataType sum = 0;
+                if(contiguous)
+                {
+                    for(long_index_t d = d_begin; d < d_end; ++d)
+                    {
+                        AccDataType v = ck::type_convert<AccDataType>(p[0][d]);
+                        for(std::size_t t = 1; t < NumEmbeddings; ++t)
+                            v += ck::type_convert<AccDataType>(p[t][d]);
+                        x[d] = v;
+                        sum += v;
+                    }
+                }
+                else
+                {
+                    for(long_index_t d = d_begin; d < d_end; ++d)
+                    {
+                        AccDataType v = ck::type_convert<AccDataType>(p[0][d * emb_strides[0]]);
+                        for(std::size_t t = 1; t < NumEmbeddings; ++t)
+                            v += ck::type_convert<AccDataType>(p[t][d * emb_strides[t]]);
+                        x[d] = v;
+                        sum += v;
+                    }
+                }
+
+                // merge the statistics of the block, whose elements are still in cache
+                const AccDataType block_mean = sum / n;
+                AccDataType block_m2         = 0;
+                for(long_index_t d = d_begin; d < d_end; ++d)
+                    block_m2 += (x[d] - block_mean) * (x[d] - block_mean);
+
+                const AccDataType delta   = block_mean - mean;
+                const long_index_t merged = size + n;
+
+                mean += delta * n / merged;
+                m2 += block_m2 + delta * delta * size * n / merged;
+                size = merged;
+            }
+
+            const AccDataType var     = m2 / D;
+            const AccDataType inv_std = AccDataType{1} / std::sqrt(var + epsilon);
+
+            for(long_index_t d = 0; d < D; ++d)
+                x[d] = (x[d] - mean) * inv_std * gamma_acc[d] + beta_acc[d];
+
+            OutType* out = output.mData.data() + l * out_row_stride;
+            for(long_index_t d = 0; d < D; ++d)
+                out[d * out_stride] = ck::type_convert<OutType>(x[d]);
+        }
+    };
+
+    make_ParallelTensorFunctor(f_rows, (L + rows_per_task - 1) / rows_per_task)(
+        std::thread::hardware_concurrency());
+}
+
+} // namespace detail
+
+// Layernorm of the sum of NumEmbeddings embedding lookups per row, the generalization of
+// ReferenceSparseEmbedding3ForwardLayernorm to any number of tables
+template <typename EmbType,
+          typename IndexType,
+          typename GammaDataType,
+          typename BetaDataType,
+          typename AccDataType,
+          typename OutType,
+          ck::index_t NumEmbeddings>
+struct ReferenceSparseEmbeddingsForwardLayernorm : public device::BaseOperator
+{
+    struct Argument : public device::BaseArgument
+    {
+        Argument(Tensor<OutType>& output,
+                 const std::array<const Tensor<EmbType>*, NumEmbeddings>& embs,
+                 const std::array<const Tensor<IndexType>*, NumEmbeddings>& indexes,
+                 const Tensor<GammaDataType>& gamma,
+                 const Tensor<BetaDataType>& beta,
+                 ck::index_t NumRows,
+                 ck::index_t EmbeddingDim,
+                 ck::index_t IndexLength,
+                 AccDataType epsilon)
+            : output_(output),
+              embs_(embs),
+              indexes_(indexes),
+              gamma_(gamma),
+              beta_(beta),
+              NumRows_(NumRows),
+              EmbeddingDim_(EmbeddingDim),
+              IndexLength_(IndexLength),
+              epsilon_(epsilon)
+        {
+        }
+        Tensor<OutType>& output_;
+        std::array<const Tensor<EmbType>*, NumEmbeddings> embs_;
+        std::array<const Tensor<IndexType>*, NumEmbeddings> indexes_;
+        const Tensor<GammaDataType>& gamma_;
+        const Tensor<BetaDataType>& beta_;
+        ck::index_t NumRows_;
+        ck::index_t EmbeddingDim_;
+        ck::index_t IndexLength_;
+        AccDataType epsilon_;
+    };
+
+    // Invoker
+    struct Invoker : public device::BaseInvoker
+    {
+        float Run(const Argument& arg)
+        {
+            detail::sparse_embeddings_forward_layernorm<AccDataType>(arg.output_,
+                                                                     arg.embs_,
+                                                                     arg.indexes_,
+                                                                     arg.gamma_,
+                                                                     arg.beta_,
+                                                                     arg.NumRows_,
+                                                                     arg.EmbeddingDim_,
+                                                                     arg.IndexLength_,
+                                                                     arg.epsilon_);
+            return 0;
+        }
+
+        float Run(const device::BaseArgument* p_arg,
+                  const StreamConfig& /* stream_config */ = StreamConfig{}) override
+        {
+            return Run(*dynamic_cast<const Argument*>(p_arg));
+        }
+    };
+
+    static constexpr bool IsValidCompilationParameter() { return true; }
+
+    bool IsSupportedArgument(const device::BaseArgument*) override { return true; }
+
+    static auto MakeArgument(Tensor<OutType>& output,
+                             const std::array<const Tensor<EmbType>*, NumEmbeddings>& embs,
+                             const std::array<const Tensor<IndexType>*, NumEmbeddings>& indexes,
+                             const Tensor<GammaDataType>& gamma,
+                             const Tensor<BetaDataType>& beta,
+                             ck::index_t NumRows,
+                             ck::index_t EmbeddingDim,
+                             ck::index_t IndexLength,
+                             AccDataType epsilon)
+    {
+        return Argument(output,
+                        embs,
+                        indexes,
+                        gamma,
+                        beta,
+                        NumRows,
+                        EmbeddingDim,
+                        IndexLength,
+                        epsilon);
+    }
+
+    static auto MakeInvoker() { return Invoker{}; }
+
+    virtual std::unique_ptr<device::BaseInvoker> MakeInvokerPointer()
+    {
+        return std::make_unique<Invoker>(Invoker{});
+    }
+
+    std::string GetTypeString() const override
+    {
+        auto str = std::stringstream();
+
+        // clang-format off
+        str << "ReferenceSparseEmbeddingsForwardLayernorm"
+            << "<" << NumEmbeddings << ">"
+            << std::endl;
+        // clang-format on
+
+        return str.str();
+    }
+};
+
+} // namespace host
+} // namespace tensor_operation
+} // namespace ck
@@ -11,6 +11,7 @@
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
 
 #include "ck/library/tensor_operation_instance/device_operation_instance_factory.hpp"
+#include "ck/library/tensor_operation_instance/instance_shard.hpp"
 
 namespace ck {
 namespace tensor_operation {
@@ -455,49 +456,73 @@ struct DeviceOperationInstanceFactory<
             if constexpr(is_same_v<ALayout, Row> && is_same_v<BLayout, Row> &&
                          is_same_v<CLayout, Row>)
             {
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_comp_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_comp_kpadding_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_comp_mnpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_comp_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_comp_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_comp_kpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_comp_mnpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_comp_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_mem_v1_default_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_mem_v1_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_mem_v1_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_mem_v1_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_mem_v1_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_mem_v1_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_mem_v2_default_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_mem_v2_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_mem_v2_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_mem_v2_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_mem_v2_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_kn_mn_mem_v2_mnkpadding_instances,
                     op_ptrs);
             }
             else if constexpr(is_same_v<ALayout, Row> && is_same_v<BLayout, Col> &&
                               is_same_v<CLayout, Row>)
             {
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_comp_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_comp_kpadding_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_comp_mnpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_comp_default_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_comp_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_comp_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_comp_mnpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_comp_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_mem_v1_default_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_mem_v1_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_mem_v1_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_mem_v1_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_mem_v1_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_mem_v1_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_mem_v2_default_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_mem_v2_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_mem_v2_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_mem_v2_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_mem_v2_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f16_f16_mk_nk_mn_mem_v2_mnkpadding_instances,
                     op_ptrs);
             }
         }
@@ -509,43 +534,73 @@ struct DeviceOperationInstanceFactory<
             if constexpr(is_same_v<ALayout, Row> && is_same_v<BLayout, Col> &&
                          is_same_v<CLayout, Row>)
             {
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_comp_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_comp_kpadding_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_comp_mnpadding_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_comp_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_comp_default_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_comp_kpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_comp_mnpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_comp_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_mem_v1_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_mem_v1_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_mem_v1_default_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_mem_v1_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_mem_v1_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_mem_v1_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_mem_v2_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_mem_v2_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_mem_v2_default_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_mem_v2_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_mem_v2_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_nk_mn_mem_v2_mnkpadding_instances,
                     op_ptrs);
             }
             else if constexpr(is_same_v<ALayout, Row> && is_same_v<BLayout, Row> &&
                               is_same_v<CLayout, Row>)
             {
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_comp_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_comp_kpadding_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_comp_mnpadding_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_comp_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_comp_default_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_comp_kpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_comp_mnpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_comp_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_mem_v1_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_mem_v1_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_mem_v1_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_mem_v1_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_mem_v1_kpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_mem_v1_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_mem_v2_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_mem_v2_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_mem_v2_default_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_mem_v2_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_mem_v2_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f16_f8_f16_mk_kn_mn_mem_v2_mnkpadding_instances,
                     op_ptrs);
             }
         }
@@ -555,43 +610,73 @@ struct DeviceOperationInstanceFactory<
             if constexpr(is_same_v<ALayout, Row> && is_same_v<BLayout, Col> &&
                          is_same_v<CLayout, Row>)
             {
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_comp_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_comp_kpadding_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_comp_mnpadding_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_comp_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_comp_default_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_comp_kpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_comp_mnpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_comp_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_mem_v1_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_mem_v1_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_mem_v1_default_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_mem_v1_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_mem_v1_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_mem_v1_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_mem_v2_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_mem_v2_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_mem_v2_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_mem_v2_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_mem_v2_kpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_nk_mn_mem_v2_mnkpadding_instances,
                     op_ptrs);
             }
             else if constexpr(is_same_v<ALayout, Row> && is_same_v<BLayout, Row> &&
                               is_same_v<CLayout, Row>)
             {
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_comp_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_comp_kpadding_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_comp_mnpadding_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_comp_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_comp_default_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_comp_kpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_comp_mnpadding_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_comp_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_mem_v1_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_mem_v1_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_mem_v1_default_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_mem_v1_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_mem_v1_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_mem_v1_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_mem_v2_default_instances(op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_mem_v2_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_mem_v2_default_instances,
+                    op_ptrs);
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_mem_v2_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_mem_v2_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_f8_f16_f16_mk_kn_mn_mem_v2_mnkpadding_instances,
                     op_ptrs);
             }
         }
@@ -603,53 +688,73 @@ struct DeviceOperationInstanceFactory<
             if constexpr(is_same_v<ALayout, Row> && is_same_v<BLayout, Row> &&
                          is_same_v<CLayout, Row>)
             {
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_comp_default_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_comp_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_comp_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_comp_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_comp_mnpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_comp_mnpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_comp_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_comp_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_mem_v1_default_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_mem_v1_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_mem_v1_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_mem_v1_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_mem_v1_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_mem_v1_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_mem_v2_default_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_mem_v2_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_mem_v2_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_mem_v2_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_mem_v2_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_kn_mn_mem_v2_mnkpadding_instances,
                     op_ptrs);
             }
             else if constexpr(is_same_v<ALayout, Row> && is_same_v<BLayout, Col> &&
                               is_same_v<CLayout, Row>)
             {
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_comp_default_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_comp_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_comp_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_comp_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_comp_mnpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_comp_mnpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_comp_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_comp_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_mem_v1_default_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_mem_v1_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_mem_v1_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_mem_v1_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_mem_v1_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_mem_v1_mnkpadding_instances,
                     op_ptrs);
 
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_mem_v2_default_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_mem_v2_default_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_mem_v2_kpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_mem_v2_kpadding_instances,
                     op_ptrs);
-                add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_mem_v2_mnkpadding_instances(
+                CK_ADD_DEVICE_INSTANCES(
+                    add_device_gemm_xdl_universal_bf16_bf16_bf16_mk_nk_mn_mem_v2_mnkpadding_instances,
                     op_ptrs);
             }
         }
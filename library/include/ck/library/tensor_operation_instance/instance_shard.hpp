@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ck/config.h"
+
+// An instance shard is a shared object holding the instances of one operation family and data
+// type. It exports a single C function, CK_INSTANCE_SHARD_SYMBOL, returning the table of the
+// add_device_*_instances functions it defines, so that the shard can be loaded with dlopen() on
+// the first request for one of them instead of linking every instance into the application.
+//
+// Shards are built when CK is configured with -DINSTANCE_SHARDS=ON. Every shard directory has
+// an index, ck_instance_shards.index, with one "<function> <shard file>" line per function.
+
+#define CK_INSTANCE_SHARD_ABI_VERSION 1
+#define CK_INSTANCE_SHARD_SYMBOL "ck_instance_shard"
+
+extern "C" {
+
+// appends instances to the std::vector<std::unique_ptr<DeviceOp>> pointed to by `instances`
+using ck_instance_shard_add_fn = void (*)(void* instances);
+
+struct ck_instance_shard_entry
+{
+    const char* name;
+    ck_instance_shard_add_fn add_instances;
+};
+
+struct ck_instance_shard_desc
+{
+    unsigned abi_version;
+    const char* name;
+    std::size_t num_entries;
+    const ck_instance_shard_entry* entries;
+};
+
+using ck_instance_shard_fn = const ck_instance_shard_desc* (*)();
+}
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+template <typename AddInstancesFn>
+struct add_instances_signature;
+
+template <typename Instances>
+struct add_instances_signature<void (*)(Instances&)>
+{
+    using instances_type = Instances;
+};
+
+// C ABI wrapper of a typed add_device_*_instances function
+template <auto AddInstances>
+void add_instances_thunk(void* instances)
+{
+    using Instances = typename add_instances_signature<decltype(AddInstances)>::instances_type;
+    AddInstances(*static_cast<Instances*>(instances));
+}
+
+// Maps add_device_*_instances functions to the shards defining them, using the indices of a
+// list of directories, and loads each shard once, on the first request for one of its
+// functions. Shards are never unloaded, since the instances they add refer to their code.
+class InstanceShardLoader
+{
+    public:
+    static constexpr const char* IndexFileName = "ck_instance_shards.index";
+
+    // `search_paths` are the directories holding shard indices; when several indices list the
+    // same function, the first directory wins
+    explicit InstanceShardLoader(std::vector<std::string> search_paths);
+
+    InstanceShardLoader(const InstanceShardLoader&) = delete;
+    InstanceShardLoader& operator=(const InstanceShardLoader&) = delete;
+
+    // process wide loader, searching the ':' separated directories of $CK_INSTANCE_SHARD_PATH
+    // followed by the build and install directories of the CK shards
+    static InstanceShardLoader& Instance();
+
+    // Calls the function `name` of the shard defining it, loading the shard first if needed.
+    // Returns false if no shard defines `name`, and throws std::runtime_error if the shard
+    // cannot be loaded.
+    bool AddInstances(const std::string& name, void* instances);
+
+    // names of the shards loaded so far, in load order
+    std::vector<std::string> LoadedShards() const;
+
+    private:
+    struct Shard
+    {
+        std::string name;
+        std::map<std::string, ck_instance_shard_add_fn> functions;
+    };
+
+    void ReadIndices();
+    const Shard& Load(const std::string& path);
+
+    std::vector<std::string> mSearchPaths;
+    bool mIndexed = false;
+    // function name -> shard path
+    std::map<std::string, std::string> mShardOf;
+    // shard path -> loaded shard
+    std::map<std::string, Shard> mShards;
+    std::vector<std::string> mLoadOrder;
+    mutable std::mutex mMutex;
+};
+
+// Appends the instances of the add_device_*_instances function `name`, of type AddInstancesFn,
+// from the shard defining it
+template <typename AddInstancesFn, typename Instances>
+void add_shard_instances(const char* name, Instances& instances)
+{
+    static_assert(
+        std::is_same_v<typename add_instances_signature<AddInstancesFn>::instances_type, Instances>,
+        "wrong! instances do not match the add function");
+
+    if(!InstanceShardLoader::Instance().AddInstances(name, &instances))
+        throw std::runtime_error(std::string("no instance shard defines ") + name);
+}
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
+
+// Adds the instances of `add_instances` to `instances` at a DeviceOperationInstanceFactory call
+// site. With instance shards, the function is looked up in its shard instead of being linked,
+// so that only the shards of the requested families and data types are ever loaded.
+#ifdef CK_ENABLE_INSTANCE_SHARDS
+#define CK_ADD_DEVICE_INSTANCES(add_instances, instances)                                    \
+    ::ck::tensor_operation::device::instance::add_shard_instances<decltype(&add_instances)>( \
+        #add_instances, instances)
+#else
+#define CK_ADD_DEVICE_INSTANCES(add_instances, instances) add_instances(instances)
+#endif
+
+// one entry of CK_INSTANCE_SHARD, for an add function visible unqualified
+#define CK_INSTANCE_SHARD_ENTRY(add_instances)                                            \
+    ck_instance_shard_entry                                                               \
+    {                                                                                     \
+        #add_instances,                                                                   \
+            ::ck::tensor_operation::device::instance::add_instances_thunk<&add_instances> \
+    }
+
+// defines the registration function of a shard named `shard_name`, given its entries
+#define CK_INSTANCE_SHARD(shard_name, ...)                                             \
+    extern "C" __attribute__((visibility("default"))) const ck_instance_shard_desc*    \
+    ck_instance_shard()                                                                \
+    {                                                                                  \
+        static const ck_instance_shard_entry entries[] = {__VA_ARGS__};                \
+        static const ck_instance_shard_desc desc{CK_INSTANCE_SHARD_ABI_VERSION,        \
+                                                 shard_name,                           \
+                                                 sizeof(entries) / sizeof(entries[0]), \
+                                                 entries};                             \
+        return &desc;                                                                  \
+    }
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "ck/library/utility/check_gemm_freivalds.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
+
+namespace ck {
+namespace utils {
+
+struct AbftConfig
+{
+    // allowed deviation of a checksum, in estimated standard deviations of the rounding error
+    double threshold = 8.0;
+    // roundings of every output element to CDataType, e.g. the number of split-K batches when
+    // their partial results are accumulated in C
+    std::size_t c_roundings = 1;
+    // granularity in which mismatching tiles are reported
+    std::size_t tile_m = 64;
+    std::size_t tile_n = 64;
+    // with more mismatching rows and more mismatching columns than this the check fails without
+    // recomputing them
+    std::size_t max_recompute = 64;
+};
+
+namespace abft {
+
+// Checksum weights of n rows (columns): a column of ones and a ramp (i + 1) / 2^e with 2^e >= n,
+// which also catches errors that cancel in a plain sum, like two swapped elements. The power of
+// two keeps the checksums of integer results exact.
+inline std::vector<double> checksum_weights(std::size_t n)
+{
+    int e = 0;
+    while((std::size_t{1} << e) < n)
+        ++e;
+
+    std::vector<double> w(2 * n);
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        w[2 * i]     = 1.0;
+        w[2 * i + 1] = std::ldexp(static_cast<double>(i + 1), -e);
+    }
+    return w;
+}
+
+} // namespace abft
+
+// Algorithm-based fault tolerance (ABFT) check of c_m_n == a_m_k * b_k_n: compares the row
+// checksums C w against A (B w) and the column checksums w^T C against (w^T A) B, in
+// O(MK + KN + MN) instead of the O(MNK) of a reference GEMM. The tolerance of a checksum follows
+// the rounding model of check_gemm_freivalds(). Mismatching rows and columns localize the wrong
+// tiles, which are reported, recomputed and compared with check_err(out, ref, check_err_args...).
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename... CheckErrArgs>
+bool check_gemm_abft(TensorView<const ADataType> a_m_k,
+                     TensorView<const BDataType> b_k_n,
+                     TensorView<const CDataType> c_m_n,
+                     const AbftConfig& config,
+                     CheckErrArgs&&... check_err_args)
+{
+    using namespace freivalds;
+
+    const std::size_t M = c_m_n.GetLengths()[0];
+    const std::size_t N = c_m_n.GetLengths()[1];
+
+    auto a_k_m = a_m_k.Transpose(0, 1);
+    auto b_n_k = b_k_n.Transpose(0, 1);
+    auto c_n_m = c_m_n.Transpose(0, 1);
+
+    // row checksums: C w against A (B w)
+    std::vector<std::size_t> rows;
+    {
+        const auto w    = abft::checksum_weights(N);
+        const auto c_w  = project(c_m_n, w, 2);
+        const auto a_bw = project(a_m_k, project(b_k_n, w, 2), 2);
+
+        const auto var = row_variance<AccDataType>(a_m_k, b_k_n, c_m_n, config.c_roundings);
+        rows           = inconsistent(c_w, a_bw, var, 2, config.threshold);
+    }
+
+    // column checksums: w^T C against (w^T A) B
+    std::vector<std::size_t> cols;
+    {
+        const auto w    = abft::checksum_weights(M);
+        const auto w_c  = project(c_n_m, w, 2);
+        const auto wa_b = project(b_n_k, project(a_k_m, w, 2), 2);
+
+        const auto var = row_variance<AccDataType>(b_n_k, a_k_m, c_n_m, config.c_roundings);
+        cols           = inconsistent(w_c, wa_b, var, 2, config.threshold);
+    }
+
+    if(rows.empty() && cols.empty())
+        return true;
+
+    // a mismatch in only one direction cancels in the other, the whole row (column) is suspect
+    if(rows.empty())
+        rows = all_indices(M);
+    if(cols.empty())
+        cols = all_indices(N);
+
+    std::set<std::pair<std::size_t, std::size_t>> tiles;
+    for(std::size_t m : rows)
+        for(std::size_t n : cols)
+            tiles.emplace(m / config.tile_m, n / config.tile_n);
+
+    std::cerr << "ABFT check: " << rows.size() << " of " << M << " rows and " << cols.size()
+              << " of " << N << " columns mismatch, in " << tiles.size() << " tiles of "
+              << config.tile_m << "x" << config.tile_n << ":";
+    std::size_t reported = 0;
+    for(const auto& [tile_m, tile_n] : tiles)
+    {
+        if(reported++ == 16)
+        {
+            std::cerr << " ...";
+            break;
+        }
+        std::cerr << " (" << tile_m << ", " << tile_n << ")";
+    }
+    std::cerr << std::endl;
+
+    if(std::min(rows.size(), cols.size()) > config.max_recompute)
+    {
+        std::cerr << "ABFT check: too many mismatching rows and columns to recompute" << std::endl;
+        return false;
+    }
+
+    return check_elements<AccDataType>(
+        a_m_k, b_k_n, c_m_n, rows, cols, std::forward<CheckErrArgs>(check_err_args)...);
+}
+
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename... CheckErrArgs>
+bool check_gemm_abft(const Tensor<ADataType>& a_m_k,
+                     const Tensor<BDataType>& b_k_n,
+                     const Tensor<CDataType>& c_m_n,
+                     const AbftConfig& config,
+                     CheckErrArgs&&... check_err_args)
+{
+    return check_gemm_abft<AccDataType, ADataType, BDataType, CDataType>(
+        make_tensor_view(a_m_k),
+        make_tensor_view(b_k_n),
+        make_tensor_view(c_m_n),
+        config,
+        std::forward<CheckErrArgs>(check_err_args)...);
+}
+
+// check_gemm_abft() of every batch, whose tiles are reported per batch
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename... CheckErrArgs>
+bool check_batched_gemm_abft(TensorView<const ADataType> a_g_m_k,
+                             TensorView<const BDataType> b_g_k_n,
+                             TensorView<const CDataType> c_g_m_n,
+                             const AbftConfig& config,
+                             const CheckErrArgs&... check_err_args)
+{
+    bool pass = true;
+    for(std::size_t g = 0; g < c_g_m_n.GetLengths()[0]; ++g)
+        pass = pass & check_gemm_abft<AccDataType>(a_g_m_k.Select(0, g),
+                                                   b_g_k_n.Select(0, g),
+                                                   c_g_m_n.Select(0, g),
+                                                   config,
+                                                   check_err_args...);
+    return pass;
+}
+
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename... CheckErrArgs>
+bool check_batched_gemm_abft(const Tensor<ADataType>& a_g_m_k,
+                             const Tensor<BDataType>& b_g_k_n,
+                             const Tensor<CDataType>& c_g_m_n,
+                             const AbftConfig& config,
+                             const CheckErrArgs&... check_err_args)
+{
+    return check_batched_gemm_abft<AccDataType, ADataType, BDataType, CDataType>(
+        make_tensor_view(a_g_m_k),
+        make_tensor_view(b_g_k_n),
+        make_tensor_view(c_g_m_n),
+        config,
+        check_err_args...);
+}
+
+// Verifies every group of a grouped GEMM, as the grouped GEMM profilers do: with `checksums`
+// (verification mode 2) by check_gemm_abft() of c_m_n[g] against a_m_k[g] and b_k_n[g], otherwise
+// by check_err() against the reference results c_m_n_ref[g]. Stops at the first failing group.
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename... CheckErrArgs>
+bool check_grouped_gemm_abft(bool checksums,
+                             const std::vector<Tensor<ADataType>>& a_m_k,
+                             const std::vector<Tensor<BDataType>>& b_k_n,
+                             const std::vector<Tensor<CDataType>>& c_m_n,
+                             const std::vector<Tensor<CDataType>>& c_m_n_ref,
+                             const AbftConfig& config,
+                             const CheckErrArgs&... check_err_args)
+{
+    for(std::size_t g = 0; g < c_m_n.size(); ++g)
+    {
+        const bool pass =
+            checksums ? check_gemm_abft<AccDataType>(
+                            a_m_k[g], b_k_n[g], c_m_n[g], config, check_err_args...)
+                      : check_err(c_m_n[g], c_m_n_ref[g], check_err_args...);
+        if(!pass)
+            return false;
+    }
+    return true;
+}
+
+} // namespace utils
+} // namespace ck
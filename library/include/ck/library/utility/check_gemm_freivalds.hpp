@@ -0,0 +1,390 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ck/utility/data_type.hpp"
+#include "ck/utility/env.hpp"
+#include "ck/utility/type_convert.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
+
+// Randomized GEMM verification (Freivalds' algorithm), selected with verification mode 2 of the
+// gemm profilers:
+//   export CK_FREIVALDS_ROUNDS=N   number of random projections (default 16)
+//   export CK_FREIVALDS_SEED=S     seed of the projections (default fixed)
+CK_DECLARE_ENV_VAR_UINT64(CK_FREIVALDS_ROUNDS)
+CK_DECLARE_ENV_VAR_UINT64(CK_FREIVALDS_SEED)
+
+namespace ck {
+namespace utils {
+
+struct FreivaldsConfig
+{
+    // random +-1 projections; each one misses a wrong result with probability at most 1/2
+    std::size_t rounds = 16;
+    // allowed deviation of a projection, in estimated standard deviations of the rounding error
+    double threshold = 8.0;
+    // roundings of every output element to CDataType, e.g. the number of split-K batches when
+    // their partial results are accumulated in C
+    std::size_t c_roundings = 1;
+    // with more inconsistent rows (or columns) than this the check fails without recomputing them
+    std::size_t max_recompute = 64;
+    uint64_t seed = 0x9e3779b97f4a7c15ULL;
+
+    static FreivaldsConfig FromEnv()
+    {
+        FreivaldsConfig config;
+        if(EnvValue(CK_ENV(CK_FREIVALDS_ROUNDS)) > 0)
+            config.rounds = EnvValue(CK_ENV(CK_FREIVALDS_ROUNDS));
+        if(!EnvIsUnset(CK_ENV(CK_FREIVALDS_SEED)))
+            config.seed = EnvValue(CK_ENV(CK_FREIVALDS_SEED));
+        return config;
+    }
+};
+
+namespace freivalds {
+
+// f8_t and bf8_t are _BitInts, which some standard libraries count as integral
+template <typename T>
+inline constexpr bool is_f8_v = std::is_same_v<T, f8_t> || std::is_same_v<T, bf8_t>;
+
+template <typename T>
+double to_double(T v)
+{
+    if constexpr(std::is_same_v<T, bhalf_t> || is_f8_v<T>)
+        return type_convert<float>(v);
+    else if constexpr(std::is_arithmetic_v<T>)
+        return static_cast<double>(v);
+    else
+        return type_convert<float>(v);
+}
+
+// unit roundoff of T, 0 for integer types whose results are exact
+template <typename T>
+constexpr double unit_roundoff()
+{
+    if constexpr(std::is_same_v<T, bhalf_t>)
+        return 0x1p-8;
+    else if constexpr(is_f8_v<T>)
+        return 1.0 / static_cast<double>(uint64_t{1} << (NumericUtils<T>::mant + 1));
+    else if constexpr(std::is_integral_v<T>)
+        return 0;
+    else if constexpr(std::is_same_v<T, double>)
+        return 0x1p-53;
+    else
+        return 1.0 / static_cast<double>(uint64_t{1} << (NumericUtils<T>::mant + 1));
+}
+
+// out[p * R + j] = sum_q f(x(p, q)) * r[q * R + j] for the P x Q view x and R columns of r
+template <typename T, typename F>
+std::vector<double>
+project(const TensorView<const T>& x, const std::vector<double>& r, std::size_t R, F f)
+{
+    const std::size_t P = x.GetLengths()[0];
+    const std::size_t Q = x.GetLengths()[1];
+    std::vector<double> out(P * R, 0);
+
+    // a block of rows walks every layout of x with at most `rows` streams
+    constexpr std::size_t rows = 16;
+
+    auto f_block = [&](auto block) {
+        const std::size_t p_end = std::min(P, (block + 1) * rows);
+        for(std::size_t q = 0; q < Q; ++q)
+            for(std::size_t p = block * rows; p < p_end; ++p)
+            {
+                const double v = f(to_double(x(p, q)));
+                for(std::size_t j = 0; j < R; ++j)
+                    out[p * R + j] += v * r[q * R + j];
+            }
+    };
+    make_ParallelTensorFunctor(f_block, (P + rows - 1) / rows)(std::thread::hardware_concurrency());
+    return out;
+}
+
+template <typename T>
+std::vector<double>
+project(const TensorView<const T>& x, const std::vector<double>& r, std::size_t R)
+{
+    return project(x, r, R, [](double v) { return v; });
+}
+
+// f(x(p, q)) summed over q
+template <typename T, typename F>
+std::vector<double> reduce(const TensorView<const T>& x, F f)
+{
+    return project(x, std::vector<double>(x.GetLengths()[1], 1.0), 1, f);
+}
+
+inline std::vector<double> random_signs(std::size_t n, std::size_t R, std::mt19937_64& gen)
+{
+    std::vector<double> r(n * R);
+    for(auto& v : r)
+        v = (gen() & 1) ? 1.0 : -1.0;
+    return r;
+}
+
+// Variance of the rounding error in every row of c_m_n = a_m_k * b_k_n, as seen by a projection
+// with weights of magnitude at most 1: u_C^2 sum_n c^2 from `c_roundings` roundings of every
+// output element, plus u_acc^2 K sum_n (sum_k (a b)^2 + c^2) from the accumulation. The latter
+// models the K rounding errors of a sum as independent, each of the size of its partial sum:
+// partial sums grow like sqrt(k) for terms of random sign and like k c / K for terms that drift
+// towards c, and their squares summed over k stay below K sum_k (a b)^2 and K c^2 respectively.
+template <typename AccDataType, typename ADataType, typename BDataType, typename CDataType>
+std::vector<double> row_variance(const TensorView<const ADataType>& a_m_k,
+                                 const TensorView<const BDataType>& b_k_n,
+                                 const TensorView<const CDataType>& c_m_n,
+                                 std::size_t c_roundings = 1)
+{
+    constexpr double u_c   = unit_roundoff<CDataType>();
+    constexpr double u_acc = unit_roundoff<AccDataType>();
+    const double K         = static_cast<double>(a_m_k.GetLengths()[1]);
+
+    auto square = [](double v) { return v * v; };
+
+    const auto c_sq    = reduce(c_m_n, square);
+    const auto a_sq_b2 = project(a_m_k, reduce(b_k_n, square), 1, square);
+
+    std::vector<double> var(c_sq.size());
+    for(std::size_t m = 0; m < var.size(); ++m)
+        var[m] = u_c * u_c * c_roundings * c_sq[m] + u_acc * u_acc * K * (a_sq_b2[m] + c_sq[m]);
+    return var;
+}
+
+// Indices i whose projections lhs[i * R + j] and rhs[i * R + j] differ by more than
+// threshold * sqrt(var[i]), or are not finite
+inline std::vector<std::size_t> inconsistent(const std::vector<double>& lhs,
+                                             const std::vector<double>& rhs,
+                                             const std::vector<double>& var,
+                                             std::size_t R,
+                                             double threshold)
+{
+    std::vector<std::size_t> flagged;
+    for(std::size_t i = 0; i < var.size(); ++i)
+    {
+        const double tol = threshold * std::sqrt(var[i]);
+        for(std::size_t j = 0; j < R; ++j)
+        {
+            const double diff = std::abs(lhs[i * R + j] - rhs[i * R + j]);
+            if(!(diff <= tol))
+            {
+                flagged.push_back(i);
+                break;
+            }
+        }
+    }
+    return flagged;
+}
+
+inline std::vector<std::size_t> all_indices(std::size_t n)
+{
+    std::vector<std::size_t> v(n);
+    std::iota(v.begin(), v.end(), std::size_t{0});
+    return v;
+}
+
+// Recomputes the elements rows x cols of c_m_n with AccDataType accumulation and compares them
+// with check_err(out, ref, check_err_args...)
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename... CheckErrArgs>
+bool check_elements(const TensorView<const ADataType>& a_m_k,
+                    const TensorView<const BDataType>& b_k_n,
+                    const TensorView<const CDataType>& c_m_n,
+                    const std::vector<std::size_t>& rows,
+                    const std::vector<std::size_t>& cols,
+                    CheckErrArgs&&... check_err_args)
+{
+    const std::size_t K = a_m_k.GetLengths()[1];
+
+    std::vector<CDataType> out(rows.size() * cols.size());
+    std::vector<CDataType> ref(rows.size() * cols.size());
+    auto f_element = [&](auto i, auto j) {
+        const std::size_t m = rows[i];
+        const std::size_t n = cols[j];
+
+        AccDataType v_acc = 0;
+        for(std::size_t k = 0; k < K; ++k)
+            v_acc +=
+                type_convert<AccDataType>(a_m_k(m, k)) * type_convert<AccDataType>(b_k_n(k, n));
+
+        out[i * cols.size() + j] = c_m_n(m, n);
+        ref[i * cols.size() + j] = type_convert<CDataType>(v_acc);
+    };
+    make_ParallelTensorFunctor(f_element, rows.size(), cols.size())(
+        std::thread::hardware_concurrency());
+
+    return check_err(out, ref, std::forward<CheckErrArgs>(check_err_args)...);
+}
+
+} // namespace freivalds
+
+// Checks c_m_n == a_m_k * b_k_n, as computed with AccDataType accumulation and rounded to
+// CDataType, in O(rounds * (MK + KN + MN)) instead of the O(MNK) of a reference GEMM.
+//
+// Every round compares C r against A (B r) for a random +-1 vector r, which localizes the
+// inconsistent rows, and s^T C against (s^T A) B, which localizes the columns. A projection may
+// deviate by `threshold` times the standard deviation expected from rounding (row_variance()).
+// The flagged elements are then recomputed exactly and compared with check_err(out, ref,
+// check_err_args...), so a correct result does not fail on rounding noise unless too many rows
+// or columns are inconsistent to recompute. Results rounded to C more than once, e.g. split-K
+// batches accumulated in C, need config.c_roundings.
+//
+// A wrong element is only caught when its error exceeds that tolerance, which grows with the
+// square root of the projected length: about threshold * sqrt(N) * u_C |c| for the rows of a
+// result rounded to CDataType, so even a single f16 column only resolves errors of 0.4% where
+// check_err rejects 0.1%, and a 4096-wide one a quarter of |c|. With a float C the accumulation
+// sets the floor instead, about 0.05% of a typical |c| for N = 64 and K = 8192. The check finds
+// wrong tiles, indexing and synchronization bugs, not small numerical deviations in low
+// precision outputs, which need the reference GEMM.
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename... CheckErrArgs>
+bool check_gemm_freivalds(TensorView<const ADataType> a_m_k,
+                          TensorView<const BDataType> b_k_n,
+                          TensorView<const CDataType> c_m_n,
+                          const FreivaldsConfig& config = FreivaldsConfig::FromEnv(),
+                          CheckErrArgs&&... check_err_args)
+{
+    using namespace freivalds;
+
+    const std::size_t M = c_m_n.GetLengths()[0];
+    const std::size_t N = c_m_n.GetLengths()[1];
+    const std::size_t R = config.rounds;
+
+    auto a_k_m = a_m_k.Transpose(0, 1);
+    auto b_n_k = b_k_n.Transpose(0, 1);
+    auto c_n_m = c_m_n.Transpose(0, 1);
+
+    std::mt19937_64 gen(config.seed);
+
+    // rows: C r against A (B r)
+    std::vector<std::size_t> rows;
+    {
+        const auto r    = random_signs(N, R, gen);
+        const auto c_r  = project(c_m_n, r, R);
+        const auto a_br = project(a_m_k, project(b_k_n, r, R), R);
+
+        const auto var = row_variance<AccDataType>(a_m_k, b_k_n, c_m_n, config.c_roundings);
+        rows           = inconsistent(c_r, a_br, var, R, config.threshold);
+    }
+
+    // columns: s^T C against (s^T A) B
+    std::vector<std::size_t> cols;
+    {
+        const auto s    = random_signs(M, R, gen);
+        const auto s_c  = project(c_n_m, s, R);
+        const auto sa_b = project(b_n_k, project(a_k_m, s, R), R);
+
+        const auto var = row_variance<AccDataType>(b_n_k, a_k_m, c_n_m, config.c_roundings);
+        cols           = inconsistent(s_c, sa_b, var, R, config.threshold);
+    }
+
+    if(rows.empty() && cols.empty())
+        return true;
+
+    std::cerr << "Freivalds check: " << rows.size() << " of " << M << " rows and " << cols.size()
+              << " of " << N << " columns inconsistent after " << R << " rounds" << std::endl;
+
+    if(rows.size() > config.max_recompute || cols.size() > config.max_recompute)
+    {
+        std::cerr << "Freivalds check: too many inconsistent rows or columns to recompute"
+                  << std::endl;
+        return false;
+    }
+
+    // a row (column) flagged alone is recomputed in full
+    if(rows.empty())
+        rows = all_indices(M);
+    if(cols.empty())
+        cols = all_indices(N);
+
+    std::cerr << "Freivalds check: recomputed " << rows.size() * cols.size() << " elements"
+              << std::endl;
+    return check_elements<AccDataType>(
+        a_m_k, b_k_n, c_m_n, rows, cols, std::forward<CheckErrArgs>(check_err_args)...);
+}
+
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename... CheckErrArgs>
+bool check_gemm_freivalds(const Tensor<ADataType>& a_m_k,
+                          const Tensor<BDataType>& b_k_n,
+                          const Tensor<CDataType>& c_m_n,
+                          const FreivaldsConfig& config = FreivaldsConfig::FromEnv(),
+                          CheckErrArgs&&... check_err_args)
+{
+    return check_gemm_freivalds<AccDataType, ADataType, BDataType, CDataType>(
+        make_tensor_view(a_m_k),
+        make_tensor_view(b_k_n),
+        make_tensor_view(c_m_n),
+        config,
+        std::forward<CheckErrArgs>(check_err_args)...);
+}
+
+// check_gemm_freivalds() of every batch
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename... CheckErrArgs>
+bool check_batched_gemm_freivalds(TensorView<const ADataType> a_g_m_k,
+                                  TensorView<const BDataType> b_g_k_n,
+                                  TensorView<const CDataType> c_g_m_n,
+                                  const FreivaldsConfig& config = FreivaldsConfig::FromEnv(),
+                                  const CheckErrArgs&... check_err_args)
+{
+    bool pass = true;
+    for(std::size_t g = 0; g < c_g_m_n.GetLengths()[0]; ++g)
+    {
+        FreivaldsConfig batch_config = config;
+        batch_config.seed += g;
+        pass = pass & check_gemm_freivalds<AccDataType>(a_g_m_k.Select(0, g),
+                                                        b_g_k_n.Select(0, g),
+                                                        c_g_m_n.Select(0, g),
+                                                        batch_config,
+                                                        check_err_args...);
+    }
+    return pass;
+}
+
+template <typename AccDataType,
+          typename ADataType,
+          typename BDataType,
+          typename CDataType,
+          typename... CheckErrArgs>
+bool check_batched_gemm_freivalds(const Tensor<ADataType>& a_g_m_k,
+                                  const Tensor<BDataType>& b_g_k_n,
+                                  const Tensor<CDataType>& c_g_m_n,
+                                  const FreivaldsConfig& config = FreivaldsConfig::FromEnv(),
+                                  const CheckErrArgs&... check_err_args)
+{
+    return check_batched_gemm_freivalds<AccDataType, ADataType, BDataType, CDataType>(
+        make_tensor_view(a_g_m_k),
+        make_tensor_view(b_g_k_n),
+        make_tensor_view(c_g_m_n),
+        config,
+        check_err_args...);
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,129 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ck/utility/magic_division.hpp"
+
+namespace ck {
+namespace utils {
+
+// Host division by a runtime divisor with the multiply-shift scheme of ck::MagicDivision.
+// Dividends below 2^31 use the 32-bit magic numbers of MagicDivision::CalculateMagicNumbers,
+// larger ones (up to 2^63) the 64-bit ones of MagicDivision::CalculateMagicNumbers64.
+struct HostMagicDivider
+{
+    HostMagicDivider() = default;
+
+    explicit HostMagicDivider(std::size_t divisor) : mDivisor(divisor)
+    {
+        if(divisor <= INT32_MAX)
+        {
+            auto tmp    = MagicDivision::CalculateMagicNumbers(static_cast<uint32_t>(divisor));
+            mMultiplier = tmp[Number<0>{}];
+            mShift      = tmp[Number<1>{}];
+        }
+        auto tmp64    = MagicDivision::CalculateMagicNumbers64(divisor);
+        mMultiplier64 = tmp64[Number<0>{}];
+        mShift64      = tmp64[Number<1>{}];
+    }
+
+    std::size_t GetDivisor() const { return mDivisor; }
+    uint32_t GetMultiplier() const { return mMultiplier; }
+    uint32_t GetShift() const { return mShift; }
+
+    // whether Divide32() is exact for every dividend below 2^31
+    bool Has32BitMagic() const { return mDivisor >= 1 && mDivisor <= INT32_MAX; }
+
+    uint32_t Divide32(uint32_t dividend) const
+    {
+        return MagicDivision::DoMagicDivision(dividend, mMultiplier, mShift);
+    }
+
+    std::size_t Divide(std::size_t dividend) const
+    {
+        if(dividend <= INT32_MAX && Has32BitMagic())
+            return Divide32(static_cast<uint32_t>(dividend));
+        return MagicDivision::DoMagicDivision64(dividend, mMultiplier64, mShift64);
+    }
+
+    private:
+    std::size_t mDivisor   = 0;
+    uint32_t mMultiplier   = 0;
+    uint32_t mShift        = 0;
+    uint64_t mMultiplier64 = 0;
+    uint32_t mShift64      = 0;
+};
+
+// Instruction set used by the batched index decomposition
+enum struct HostSimd
+{
+    Scalar,
+    Avx2,
+    Avx512,
+    // best one supported by the CPU
+    Native,
+};
+
+// best HostSimd supported by this CPU and build
+HostSimd GetNativeHostSimd();
+
+// Decomposes flat indices of a packed row-major iteration space into N-d coordinates, replacing
+// the "/" and "%" by every length of host traversal code with magic division. Batches of indices
+// are decomposed with AVX2 or AVX-512 when the CPU has them and the space has fewer than 2^31
+// elements, and with scalar magic division otherwise.
+class HostIndexDecomposer
+{
+    public:
+    HostIndexDecomposer() = default;
+
+    explicit HostIndexDecomposer(std::vector<std::size_t> lengths);
+
+    std::size_t GetNumOfDimension() const { return mLengths.size(); }
+    std::size_t GetElementSize() const { return mElementSize; }
+    const std::vector<std::size_t>& GetLengths() const { return mLengths; }
+    const std::vector<HostMagicDivider>& GetDividers() const { return mDividers; }
+
+    // coordinates of flat index `i` into idx[0, GetNumOfDimension())
+    template <typename Index>
+    void Decompose(std::size_t i, Index* idx) const
+    {
+        for(std::size_t d = mLengths.size(); d-- > 1;)
+        {
+            const std::size_t q = mDividers[d].Divide(i);
+            idx[d]              = static_cast<Index>(i - q * mLengths[d]);
+            i                   = q;
+        }
+        if(!mLengths.empty())
+            idx[0] = static_cast<Index>(i);
+    }
+
+    // Coordinates of the flat indices [begin, begin + count), in structure-of-arrays form:
+    // idx[d * count + j] is coordinate d of flat index begin + j
+    void DecomposeRange(std::size_t begin,
+                        std::size_t count,
+                        std::size_t* idx,
+                        HostSimd simd = HostSimd::Native) const;
+
+    // coordinates of the flat indices flat[0, count), which must all be below GetElementSize(),
+    // in the same form as DecomposeRange()
+    void Decompose(const std::size_t* flat,
+                   std::size_t count,
+                   std::size_t* idx,
+                   HostSimd simd = HostSimd::Native) const;
+
+    private:
+    // whether every flat index fits the 32-bit magic division of the vector kernels
+    bool Use32Bit() const { return mElementSize <= INT32_MAX; }
+
+    std::vector<std::size_t> mLengths;
+    std::vector<HostMagicDivider> mDividers;
+    std::size_t mElementSize = 0;
+};
+
+} // namespace utils
+} // namespace ck
@@ -4,9 +4,11 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <iostream>
 #include <numeric>
+#include <stdexcept>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -16,6 +18,7 @@
 #include "ck/utility/type_convert.hpp"
 
 #include "ck/library/utility/algorithm.hpp"
+#include "ck/library/utility/host_magic_division.hpp"
 #include "ck/library/utility/ranges.hpp"
 
 template <typename Range>
@@ -184,8 +187,12 @@ struct ParallelTensorFunctor
     std::array<std::size_t, NDIM> mLens;
     std::array<std::size_t, NDIM> mStrides;
     std::size_t mN1d;
+    ck::utils::HostIndexDecomposer mDecomposer;
 
-    ParallelTensorFunctor(F f, Xs... xs) : mF(f), mLens({static_cast<std::size_t>(xs)...})
+    ParallelTensorFunctor(F f, Xs... xs)
+        : mF(f),
+          mLens({static_cast<std::size_t>(xs)...}),
+          mDecomposer(std::vector<std::size_t>{static_cast<std::size_t>(xs)...})
     {
         mStrides.back() = 1;
         std::partial_sum(mLens.rbegin(),
@@ -198,13 +205,7 @@ struct ParallelTensorFunctor
     std::array<std::size_t, NDIM> GetNdIndices(std::size_t i) const
     {
         std::array<std::size_t, NDIM> indices;
-
-        for(std::size_t idim = 0; idim < NDIM; ++idim)
-        {
-            indices[idim] = i / mStrides[idim];
-            i -= indices[idim] * mStrides[idim];
-        }
-
+        mDecomposer.Decompose(i, indices.data());
         return indices;
     }
 
@@ -220,9 +221,20 @@ struct ParallelTensorFunctor
             std::size_t iw_end   = std::min((it + 1) * work_per_thread, mN1d);
 
             auto f = [=] {
-                for(std::size_t iw = iw_begin; iw < iw_end; ++iw)
+                // decompose the flat indices in batches, with vectorized magic division
+                constexpr std::size_t batch = 512;
+                std::vector<std::size_t> nd_indices(NDIM * batch);
+                for(std::size_t iw = iw_begin; iw < iw_end; iw += batch)
                 {
-                    call_f_unpack_args(mF, GetNdIndices(iw));
+                    const std::size_t n = std::min(batch, iw_end - iw);
+                    mDecomposer.DecomposeRange(iw, n, nd_indices.data());
+                    for(std::size_t j = 0; j < n; ++j)
+                    {
+                        std::array<std::size_t, NDIM> indices;
+                        for(std::size_t idim = 0; idim < NDIM; ++idim)
+                            indices[idim] = nd_indices[idim * n + j];
+                        call_f_unpack_args(mF, indices);
+                    }
                 }
             };
             threads[it] = joinable_thread(f);
@@ -236,6 +248,39 @@ auto make_ParallelTensorFunctor(F f, Xs... xs)
     return ParallelTensorFunctor<F, Xs...>(f, xs...);
 }
 
+// Calls f(i0, i1, ...) for every multi-index of `indices`, each of NDIM coordinates, spread over
+// `num_thread` threads. References use it to compute a subset of their output with the functor
+// they otherwise run over the whole tensor.
+template <std::size_t NDIM, typename F>
+void parallel_for_each_index(F f,
+                             const std::vector<std::vector<std::size_t>>& indices,
+                             std::size_t num_thread = 1)
+{
+    for(const auto& idx : indices)
+        if(idx.size() != NDIM)
+            throw std::runtime_error("parallel_for_each_index: wrong number of coordinates");
+
+    num_thread                        = std::max<std::size_t>(1, num_thread);
+    const std::size_t work_per_thread = (indices.size() + num_thread - 1) / num_thread;
+
+    std::vector<joinable_thread> threads(num_thread);
+
+    for(std::size_t it = 0; it < num_thread; ++it)
+    {
+        const std::size_t iw_begin = std::min(it * work_per_thread, indices.size());
+        const std::size_t iw_end   = std::min((it + 1) * work_per_thread, indices.size());
+
+        threads[it] = joinable_thread([=, &indices] {
+            for(std::size_t iw = iw_begin; iw < iw_end; ++iw)
+            {
+                std::array<std::size_t, NDIM> idx;
+                std::copy(indices[iw].begin(), indices[iw].end(), idx.begin());
+                call_f_unpack_args(f, idx);
+            }
+        });
+    }
+}
+
 template <typename T>
 struct Tensor
 {
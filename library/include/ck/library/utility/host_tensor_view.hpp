@@ -0,0 +1,253 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ck/library/utility/host_tensor.hpp"
+
+// Non-owning view of host tensor data with arbitrary lengths and strides. Slicing, permuting and
+// broadcasting a view only changes its descriptor and data pointer, so a reference can read a
+// permuted or broadcast operand in place instead of from a packed copy. Views are shallow: a
+// const TensorView<T> still gives mutable access to T, use TensorView<const T> for inputs.
+template <typename T>
+struct TensorView
+{
+    using Descriptor = HostTensorDescriptor;
+    using Element    = T;
+
+    TensorView(T* data, const Descriptor& desc) : mDesc(desc), mData(data) {}
+
+    template <typename U, typename = std::enable_if_t<std::is_same_v<std::remove_const_t<T>, U>>>
+    TensorView(Tensor<U>& tensor) : TensorView(tensor.mData.data(), tensor.mDesc)
+    {
+    }
+
+    template <typename U, typename = std::enable_if_t<std::is_same_v<T, const U>>>
+    TensorView(const Tensor<U>& tensor) : TensorView(tensor.mData.data(), tensor.mDesc)
+    {
+    }
+
+    // view of const data from a view of mutable data
+    template <typename U, typename = std::enable_if_t<std::is_same_v<T, const U>>>
+    TensorView(const TensorView<U>& view) : TensorView(view.data(), view.mDesc)
+    {
+    }
+
+    decltype(auto) GetLengths() const { return mDesc.GetLengths(); }
+
+    decltype(auto) GetStrides() const { return mDesc.GetStrides(); }
+
+    std::size_t GetNumOfDimension() const { return mDesc.GetNumOfDimension(); }
+
+    std::size_t GetElementSize() const { return mDesc.GetElementSize(); }
+
+    std::size_t GetElementSpaceSize() const { return mDesc.GetElementSpaceSize(); }
+
+    T* data() const { return mData; }
+
+    template <typename... Is>
+    std::size_t GetOffsetFromMultiIndex(Is... is) const
+    {
+        return mDesc.GetOffsetFromMultiIndex(is...);
+    }
+
+    template <typename... Is>
+    T& operator()(Is... is) const
+    {
+        return mData[mDesc.GetOffsetFromMultiIndex(is...)];
+    }
+
+    T& operator()(const std::vector<std::size_t>& idx) const
+    {
+        return mData[mDesc.GetOffsetFromMultiIndex(idx)];
+    }
+
+    // calls f(*this, idx) for every multi-index, in row-major order
+    template <typename F>
+    void ForEach(F&& f) const
+    {
+        const auto& lens = GetLengths();
+        if(GetElementSize() == 0)
+            return;
+
+        std::vector<std::size_t> idx(lens.size(), 0);
+        while(true)
+        {
+            f(*this, idx);
+
+            std::size_t d = lens.size();
+            for(; d > 0; --d)
+            {
+                if(++idx[d - 1] < lens[d - 1])
+                    break;
+                idx[d - 1] = 0;
+            }
+            if(d == 0)
+                return;
+        }
+    }
+
+    // every `step`-th element in [begin, end) of dimension `dim`
+    TensorView
+    Slice(std::size_t dim, std::size_t begin, std::size_t end, std::size_t step = 1) const
+    {
+        CheckDimension(dim, "Slice");
+        if(begin > end || end > GetLengths()[dim] || step == 0)
+            throw std::runtime_error("TensorView::Slice: invalid range of dimension " +
+                                     std::to_string(dim));
+
+        auto lens    = GetLengths();
+        auto strides = GetStrides();
+        lens[dim]    = (end - begin + step - 1) / step;
+        strides[dim] = strides[dim] * step;
+        return TensorView(mData + begin * GetStrides()[dim], Descriptor(lens, strides));
+    }
+
+    // slice `index` of dimension `dim`, without that dimension
+    TensorView Select(std::size_t dim, std::size_t index) const
+    {
+        CheckDimension(dim, "Select");
+        if(index >= GetLengths()[dim])
+            throw std::runtime_error("TensorView::Select: index out of range of dimension " +
+                                     std::to_string(dim));
+
+        auto lens    = GetLengths();
+        auto strides = GetStrides();
+        lens.erase(lens.begin() + dim);
+        strides.erase(strides.begin() + dim);
+        return TensorView(mData + index * GetStrides()[dim], Descriptor(lens, strides));
+    }
+
+    // dimension i of the result is dimension new2old[i] of this view
+    template <typename New2Old>
+    TensorView Permute(const New2Old& new2old) const
+    {
+        std::vector<bool> seen(GetNumOfDimension(), false);
+        for(std::size_t i = 0; i < GetNumOfDimension(); ++i)
+        {
+            const std::size_t old = static_cast<std::size_t>(new2old[i]);
+            if(old >= GetNumOfDimension() || seen[old])
+                throw std::runtime_error("TensorView::Permute: not a permutation");
+            seen[old] = true;
+        }
+        return TensorView(mData, transpose_host_tensor_descriptor_given_new2old(mDesc, new2old));
+    }
+
+    TensorView Transpose(std::size_t dim0, std::size_t dim1) const
+    {
+        CheckDimension(dim0, "Transpose");
+        CheckDimension(dim1, "Transpose");
+
+        std::vector<std::size_t> new2old(GetNumOfDimension());
+        std::iota(new2old.begin(), new2old.end(), std::size_t{0});
+        std::swap(new2old[dim0], new2old[dim1]);
+        return Permute(new2old);
+    }
+
+    // a new dimension of length 1 before dimension `dim`
+    TensorView Unsqueeze(std::size_t dim) const
+    {
+        if(dim > GetNumOfDimension())
+            throw std::runtime_error("TensorView::Unsqueeze: invalid dimension " +
+                                     std::to_string(dim));
+
+        auto lens    = GetLengths();
+        auto strides = GetStrides();
+        lens.insert(lens.begin() + dim, 1);
+        strides.insert(strides.begin() + dim, 0);
+        return TensorView(mData, Descriptor(lens, strides));
+    }
+
+    // dimension `dim`, of length 1, repeated `length` times with stride 0
+    TensorView Broadcast(std::size_t dim, std::size_t length) const
+    {
+        CheckDimension(dim, "Broadcast");
+        if(GetLengths()[dim] != 1)
+            throw std::runtime_error("TensorView::Broadcast: dimension " + std::to_string(dim) +
+                                     " has length " + std::to_string(GetLengths()[dim]));
+
+        auto lens    = GetLengths();
+        auto strides = GetStrides();
+        lens[dim]    = length;
+        strides[dim] = 0;
+        return TensorView(mData, Descriptor(lens, strides));
+    }
+
+    Descriptor mDesc;
+    T* mData; // not owned
+
+    private:
+    void CheckDimension(std::size_t dim, const char* op) const
+    {
+        if(dim >= GetNumOfDimension())
+            throw std::runtime_error(std::string("TensorView::") + op + ": invalid dimension " +
+                                     std::to_string(dim));
+    }
+};
+
+template <typename T>
+TensorView<T> make_tensor_view(Tensor<T>& tensor)
+{
+    return TensorView<T>(tensor);
+}
+
+template <typename T>
+TensorView<const T> make_tensor_view(const Tensor<T>& tensor)
+{
+    return TensorView<const T>(tensor);
+}
+
+namespace ck {
+namespace utils {
+
+// Copies the elements of a `lengths` shaped space between two strided layouts (strides in
+// elements of `element_size` bytes). The space is split recursively along its dimension of
+// largest extent until a block fits any cache level, so neither layout is walked with a
+// cache-hostile stride whatever the permutation between them; runs that are contiguous in both
+// layouts are copied with memcpy.
+void copy_strided(const void* src,
+                  const std::vector<std::size_t>& src_strides,
+                  void* dst,
+                  const std::vector<std::size_t>& dst_strides,
+                  const std::vector<std::size_t>& lengths,
+                  std::size_t element_size);
+
+} // namespace utils
+} // namespace ck
+
+// Copies `src` into `dst`, which must have the same lengths, with the blocked copy of
+// ck::utils::copy_strided. Use it when a strided view has to be materialized.
+template <typename SrcT, typename DstT>
+void copy_tensor_view(const TensorView<SrcT>& src, const TensorView<DstT>& dst)
+{
+    static_assert(std::is_same_v<std::remove_const_t<SrcT>, DstT>,
+                  "copy_tensor_view does not convert between data types");
+    static_assert(std::is_trivially_copyable_v<DstT>);
+
+    if(src.GetLengths() != dst.GetLengths())
+        throw std::runtime_error("copy_tensor_view: lengths of source and destination differ");
+
+    ck::utils::copy_strided(src.data(),
+                            src.GetStrides(),
+                            dst.data(),
+                            dst.GetStrides(),
+                            src.GetLengths(),
+                            sizeof(DstT));
+}
+
+// packed copy of the elements of `view`
+template <typename T>
+Tensor<std::remove_const_t<T>> to_packed_tensor(const TensorView<T>& view)
+{
+    Tensor<std::remove_const_t<T>> packed(view.GetLengths());
+    copy_tensor_view(view, make_tensor_view(packed));
+    return packed;
+}
@@ -0,0 +1,872 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_description/tensor_descriptor.hpp"
+#include "ck/tensor_description/tensor_adaptor.hpp"
+
+namespace ck {
+namespace utils {
+
+// Host-side interpreter for TensorDescriptor/TensorAdaptor transform chains.
+//
+// The constexpr descriptors are built for device code: every (transform chain, index) pair is
+// a separate template instantiation and the index is a MultiIndex. RuntimeTensorAdaptor keeps
+// the same hidden-dimension graph in plain vectors so host code (verification, layout debugging,
+// argument builders) can evaluate it for arbitrary chains without instantiating the chain, and
+// can evaluate many indices at once in structure-of-arrays form.
+//
+// A runtime adaptor is either built directly (make_runtime_naive_tensor_descriptor +
+// transform_runtime_tensor_descriptor, mirroring the constexpr helpers) or converted from an
+// existing constexpr TensorDescriptor/TensorAdaptor with make_runtime_tensor_descriptor /
+// make_runtime_tensor_adaptor, which is how it is cross-checked against the device path.
+struct RuntimeTransform
+{
+    enum struct Kind
+    {
+        PassThrough,
+        Pad,
+        LeftPad,
+        RightPad,
+        Embed,
+        Merge,
+        UnMerge,
+        Freeze,
+        Insert,
+        Vectorize,
+        Slice,
+        Modulo,
+        Xor,
+    };
+
+    Kind kind = Kind::PassThrough;
+
+    std::vector<long_index_t> low_lengths;
+    std::vector<long_index_t> up_lengths;
+    // Embed: coefficients; Merge: reverse exclusive scan of low_lengths; UnMerge: reverse
+    // exclusive scan of up_lengths
+    std::vector<long_index_t> coefficients;
+
+    // Pad/LeftPad: left pad; Slice: begin; Freeze: frozen lower index; Vectorize: vector size;
+    // Modulo: modulus; Xor: 1 if the modulo is applied
+    long_index_t param0 = 0;
+    // Pad/RightPad: right pad
+    long_index_t param1 = 0;
+
+    // Pad variants skip the validity check when instantiated with SkipIsValidCheck
+    bool skip_is_valid_check = false;
+
+    std::size_t GetNumOfLowerDimension() const
+    {
+        switch(kind)
+        {
+        case Kind::Insert: return 0;
+        case Kind::Merge: return low_lengths.size();
+        case Kind::Xor: return 2;
+        default: return 1;
+        }
+    }
+
+    std::size_t GetNumOfUpperDimension() const { return up_lengths.size(); }
+
+    bool IsValidUpperIndexAlwaysMappedToValidLowerIndex() const
+    {
+        switch(kind)
+        {
+        case Kind::Pad:
+        case Kind::LeftPad:
+        case Kind::RightPad: return skip_is_valid_check;
+        default: return true;
+        }
+    }
+
+    std::string GetTypeString() const
+    {
+        switch(kind)
+        {
+        case Kind::PassThrough: return "PassThrough";
+        case Kind::Pad: return "Pad";
+        case Kind::LeftPad: return "LeftPad";
+        case Kind::RightPad: return "RightPad";
+        case Kind::Embed: return "Embed";
+        case Kind::Merge: return "Merge";
+        case Kind::UnMerge: return "UnMerge";
+        case Kind::Freeze: return "Freeze";
+        case Kind::Insert: return "Insert";
+        case Kind::Vectorize: return "Vectorize";
+        case Kind::Slice: return "Slice";
+        case Kind::Modulo: return "Modulo";
+        case Kind::Xor: return "Xor";
+        }
+        return "";
+    }
+
+    static std::vector<long_index_t> ReverseExclusiveScan(const std::vector<long_index_t>& lengths)
+    {
+        std::vector<long_index_t> scan(lengths.size(), 1);
+        for(std::size_t i = lengths.size(); i > 1; --i)
+            scan[i - 2] = scan[i - 1] * lengths[i - 1];
+        return scan;
+    }
+
+    static RuntimeTransform MakePassThrough(long_index_t length)
+    {
+        RuntimeTransform t;
+        t.kind        = Kind::PassThrough;
+        t.low_lengths = {length};
+        t.up_lengths  = {length};
+        return t;
+    }
+
+    static RuntimeTransform MakePad(long_index_t low_length,
+                                    long_index_t left_pad,
+                                    long_index_t right_pad,
+                                    bool skip_is_valid_check = false)
+    {
+        RuntimeTransform t;
+        t.kind                = Kind::Pad;
+        t.low_lengths         = {low_length};
+        t.up_lengths          = {low_length + left_pad + right_pad};
+        t.param0              = left_pad;
+        t.param1              = right_pad;
+        t.skip_is_valid_check = skip_is_valid_check;
+        return t;
+    }
+
+    static RuntimeTransform
+    MakeLeftPad(long_index_t low_length, long_index_t left_pad, bool skip_is_valid_check = false)
+    {
+        auto t = MakePad(low_length, left_pad, 0, skip_is_valid_check);
+        t.kind = Kind::LeftPad;
+        return t;
+    }
+
+    static RuntimeTransform
+    MakeRightPad(long_index_t low_length, long_index_t right_pad, bool skip_is_valid_check = false)
+    {
+        auto t = MakePad(low_length, 0, right_pad, skip_is_valid_check);
+        t.kind = Kind::RightPad;
+        return t;
+    }
+
+    static RuntimeTransform MakeEmbed(const std::vector<long_index_t>& up_lengths,
+                                      const std::vector<long_index_t>& coefficients)
+    {
+        if(up_lengths.size() != coefficients.size())
+            throw std::runtime_error("wrong! inconsistent # of dimension for Embed");
+
+        RuntimeTransform t;
+        t.kind         = Kind::Embed;
+        t.up_lengths   = up_lengths;
+        t.coefficients = coefficients;
+        t.low_lengths  = {1};
+        for(std::size_t i = 0; i < up_lengths.size(); ++i)
+            t.low_lengths[0] += (up_lengths[i] - 1) * coefficients[i];
+        return t;
+    }
+
+    static RuntimeTransform MakeMerge(const std::vector<long_index_t>& low_lengths)
+    {
+        RuntimeTransform t;
+        t.kind         = Kind::Merge;
+        t.low_lengths  = low_lengths;
+        t.coefficients = ReverseExclusiveScan(low_lengths);
+        t.up_lengths   = {std::accumulate(
+            low_lengths.begin(), low_lengths.end(), long_index_t{1}, std::multiplies<>{})};
+        return t;
+    }
+
+    static RuntimeTransform MakeUnMerge(const std::vector<long_index_t>& up_lengths)
+    {
+        RuntimeTransform t;
+        t.kind         = Kind::UnMerge;
+        t.up_lengths   = up_lengths;
+        t.coefficients = ReverseExclusiveScan(up_lengths);
+        t.low_lengths  = {std::accumulate(
+            up_lengths.begin(), up_lengths.end(), long_index_t{1}, std::multiplies<>{})};
+        return t;
+    }
+
+    static RuntimeTransform MakeFreeze(long_index_t low_idx)
+    {
+        RuntimeTransform t;
+        t.kind        = Kind::Freeze;
+        t.low_lengths = {low_idx + 1};
+        t.param0      = low_idx;
+        return t;
+    }
+
+    static RuntimeTransform MakeInsert(long_index_t up_length)
+    {
+        RuntimeTransform t;
+        t.kind       = Kind::Insert;
+        t.up_lengths = {up_length};
+        return t;
+    }
+
+    static RuntimeTransform MakeVectorize(long_index_t vector_size, long_index_t up_length)
+    {
+        RuntimeTransform t;
+        t.kind        = Kind::Vectorize;
+        t.low_lengths = {vector_size * up_length};
+        t.up_lengths  = {up_length};
+        t.param0      = vector_size;
+        return t;
+    }
+
+    static RuntimeTransform
+    MakeSlice(long_index_t low_length, long_index_t slice_begin, long_index_t slice_end)
+    {
+        RuntimeTransform t;
+        t.kind        = Kind::Slice;
+        t.low_lengths = {low_length};
+        t.up_lengths  = {slice_end - slice_begin};
+        t.param0      = slice_begin;
+        return t;
+    }
+
+    static RuntimeTransform MakeModulo(long_index_t modulus, long_index_t up_length)
+    {
+        RuntimeTransform t;
+        t.kind        = Kind::Modulo;
+        t.low_lengths = {modulus};
+        t.up_lengths  = {up_length};
+        t.param0      = modulus;
+        return t;
+    }
+
+    static RuntimeTransform MakeXor(const std::vector<long_index_t>& low_lengths,
+                                    bool apply_modulo = true)
+    {
+        RuntimeTransform t;
+        t.kind        = Kind::Xor;
+        t.low_lengths = low_lengths;
+        t.up_lengths  = low_lengths;
+        t.param0      = apply_modulo ? 1 : 0;
+        return t;
+    }
+
+    // Evaluate n upper indices at once. up[i] / low[i] point to the i-th upper / lower dimension,
+    // each holding n values. Returns false in valid[] for indices mapped out of the lower range.
+    void CalculateLowerIndices(std::size_t n,
+                               const long_index_t* const* up,
+                               long_index_t* const* low,
+                               uint8_t* valid) const
+    {
+        switch(kind)
+        {
+        case Kind::PassThrough:
+            std::copy_n(up[0], n, low[0]);
+            break;
+        case Kind::Pad:
+        case Kind::LeftPad:
+        case Kind::RightPad: {
+            const long_index_t left = param0;
+            const long_index_t len  = low_lengths[0];
+            for(std::size_t j = 0; j < n; ++j)
+                low[0][j] = up[0][j] - left;
+            if(!skip_is_valid_check)
+            {
+                for(std::size_t j = 0; j < n; ++j)
+                    valid[j] &= static_cast<uint8_t>(low[0][j] >= 0 && low[0][j] < len);
+            }
+            break;
+        }
+        case Kind::Embed:
+            std::fill_n(low[0], n, long_index_t{0});
+            for(std::size_t i = 0; i < up_lengths.size(); ++i)
+            {
+                const long_index_t c = coefficients[i];
+                for(std::size_t j = 0; j < n; ++j)
+                    low[0][j] += up[i][j] * c;
+            }
+            break;
+        case Kind::Merge: {
+            const std::size_t ndim_low = low_lengths.size();
+            std::copy_n(up[0], n, low[ndim_low - 1]);
+            // peel the leading dimensions off the remainder kept in the last lower dimension
+            for(std::size_t i = 0; i + 1 < ndim_low; ++i)
+            {
+                const long_index_t s = coefficients[i];
+                for(std::size_t j = 0; j < n; ++j)
+                {
+                    low[i][j] = low[ndim_low - 1][j] / s;
+                    low[ndim_low - 1][j] -= low[i][j] * s;
+                }
+            }
+            break;
+        }
+        case Kind::UnMerge:
+            std::fill_n(low[0], n, long_index_t{0});
+            for(std::size_t i = 0; i < up_lengths.size(); ++i)
+            {
+                const long_index_t s = coefficients[i];
+                for(std::size_t j = 0; j < n; ++j)
+                    low[0][j] += up[i][j] * s;
+            }
+            break;
+        case Kind::Freeze: std::fill_n(low[0], n, param0); break;
+        case Kind::Insert: break;
+        case Kind::Vectorize:
+            for(std::size_t j = 0; j < n; ++j)
+                low[0][j] = up[0][j] * param0;
+            break;
+        case Kind::Slice:
+            for(std::size_t j = 0; j < n; ++j)
+                low[0][j] = up[0][j] + param0;
+            break;
+        case Kind::Modulo:
+            for(std::size_t j = 0; j < n; ++j)
+                low[0][j] = up[0][j] % param0;
+            break;
+        case Kind::Xor: {
+            const long_index_t m = up_lengths[1];
+            std::copy_n(up[0], n, low[0]);
+            if(param0 != 0)
+            {
+                for(std::size_t j = 0; j < n; ++j)
+                    low[1][j] = up[1][j] ^ (up[0][j] % m);
+            }
+            else
+            {
+                for(std::size_t j = 0; j < n; ++j)
+                    low[1][j] = up[1][j] ^ up[0][j];
+            }
+            break;
+        }
+        }
+    }
+};
+
+// Runtime counterpart of TensorAdaptor. Dimension ids refer to hidden dimensions, exactly as in
+// the constexpr types, so a converted adaptor can be printed and compared id-for-id.
+struct RuntimeTensorAdaptor
+{
+    // number of indices evaluated per inner pass; keeps the hidden index block cache resident
+    static constexpr std::size_t BatchSize = 256;
+
+    std::vector<RuntimeTransform> transforms;
+    std::vector<std::vector<index_t>> lower_dimension_hidden_idss;
+    std::vector<std::vector<index_t>> upper_dimension_hidden_idss;
+    std::vector<index_t> bottom_dimension_hidden_ids;
+    std::vector<index_t> top_dimension_hidden_ids;
+
+    std::size_t GetNumOfTransform() const { return transforms.size(); }
+
+    std::size_t GetNumOfBottomDimension() const { return bottom_dimension_hidden_ids.size(); }
+
+    std::size_t GetNumOfTopDimension() const { return top_dimension_hidden_ids.size(); }
+
+    std::size_t GetNumOfHiddenDimension() const
+    {
+        index_t max_id = -1;
+        for(const auto& ids : lower_dimension_hidden_idss)
+            for(auto id : ids)
+                max_id = std::max(max_id, id);
+        for(const auto& ids : upper_dimension_hidden_idss)
+            for(auto id : ids)
+                max_id = std::max(max_id, id);
+        for(auto id : bottom_dimension_hidden_ids)
+            max_id = std::max(max_id, id);
+        for(auto id : top_dimension_hidden_ids)
+            max_id = std::max(max_id, id);
+        return static_cast<std::size_t>(max_id + 1);
+    }
+
+    long_index_t GetTopLength(std::size_t idim_top) const
+    {
+        const index_t id = top_dimension_hidden_ids.at(idim_top);
+        for(std::size_t itran = 0; itran < transforms.size(); ++itran)
+        {
+            const auto& up_ids = upper_dimension_hidden_idss[itran];
+            for(std::size_t i = 0; i < up_ids.size(); ++i)
+                if(up_ids[i] == id)
+                    return transforms[itran].up_lengths[i];
+        }
+        throw std::runtime_error("wrong! not found matching transformation and upper-dimension");
+    }
+
+    std::vector<long_index_t> GetTopLengths() const
+    {
+        std::vector<long_index_t> lengths(GetNumOfTopDimension());
+        for(std::size_t i = 0; i < lengths.size(); ++i)
+            lengths[i] = GetTopLength(i);
+        return lengths;
+    }
+
+    long_index_t GetElementSize() const
+    {
+        const auto lengths = GetTopLengths();
+        return std::accumulate(
+            lengths.begin(), lengths.end(), long_index_t{1}, std::multiplies<>{});
+    }
+
+    // Batched top-to-bottom evaluation. top[i] points to n values of the i-th top dimension,
+    // bottom[i] receives n values of the i-th bottom dimension. If valid is not null it receives
+    // the same answer as coordinate_has_valid_offset for each index.
+    void CalculateBottomIndices(std::size_t n,
+                                const long_index_t* const* top,
+                                long_index_t* const* bottom,
+                                uint8_t* valid = nullptr) const
+    {
+        const std::size_t ndim_hidden = GetNumOfHiddenDimension();
+        const auto top_lengths        = GetTopLengths();
+
+        std::vector<long_index_t> hidden(ndim_hidden * BatchSize);
+        std::vector<uint8_t> valid_block(BatchSize);
+        std::vector<const long_index_t*> up_ptrs;
+        std::vector<long_index_t*> low_ptrs;
+
+        for(std::size_t j0 = 0; j0 < n; j0 += BatchSize)
+        {
+            const std::size_t nb = std::min(BatchSize, n - j0);
+            auto h               = [&](index_t id) { return hidden.data() + id * BatchSize; };
+
+            std::fill_n(valid_block.begin(), nb, uint8_t{1});
+
+            for(std::size_t i = 0; i < top_dimension_hidden_ids.size(); ++i)
+            {
+                long_index_t* dst = h(top_dimension_hidden_ids[i]);
+                std::copy_n(top[i] + j0, nb, dst);
+                for(std::size_t j = 0; j < nb; ++j)
+                    valid_block[j] &= static_cast<uint8_t>(dst[j] >= 0 && dst[j] < top_lengths[i]);
+            }
+
+            for(std::size_t itran = transforms.size(); itran > 0; --itran)
+            {
+                const auto& tran    = transforms[itran - 1];
+                const auto& low_ids = lower_dimension_hidden_idss[itran - 1];
+                const auto& up_ids  = upper_dimension_hidden_idss[itran - 1];
+
+                up_ptrs.resize(up_ids.size());
+                low_ptrs.resize(low_ids.size());
+                for(std::size_t i = 0; i < up_ids.size(); ++i)
+                    up_ptrs[i] = h(up_ids[i]);
+                for(std::size_t i = 0; i < low_ids.size(); ++i)
+                    low_ptrs[i] = h(low_ids[i]);
+
+                tran.CalculateLowerIndices(nb, up_ptrs.data(), low_ptrs.data(), valid_block.data());
+            }
+
+            for(std::size_t i = 0; i < bottom_dimension_hidden_ids.size(); ++i)
+                std::copy_n(h(bottom_dimension_hidden_ids[i]), nb, bottom[i] + j0);
+
+            if(valid != nullptr)
+                std::copy_n(valid_block.begin(), nb, valid + j0);
+        }
+    }
+
+    std::vector<long_index_t> CalculateBottomIndex(const std::vector<long_index_t>& idx_top) const
+    {
+        if(idx_top.size() != GetNumOfTopDimension())
+            throw std::runtime_error("wrong! # of dimension inconsistent");
+
+        std::vector<const long_index_t*> top(idx_top.size());
+        for(std::size_t i = 0; i < idx_top.size(); ++i)
+            top[i] = &idx_top[i];
+
+        std::vector<long_index_t> idx_bottom(GetNumOfBottomDimension());
+        std::vector<long_index_t*> bottom(idx_bottom.size());
+        for(std::size_t i = 0; i < idx_bottom.size(); ++i)
+            bottom[i] = &idx_bottom[i];
+
+        CalculateBottomIndices(1, top.data(), bottom.data());
+        return idx_bottom;
+    }
+
+    std::string GetTypeString() const
+    {
+        std::string str = "RuntimeTensorAdaptor{";
+        for(std::size_t itran = 0; itran < transforms.size(); ++itran)
+        {
+            str += transforms[itran].GetTypeString() + "(";
+            for(auto id : lower_dimension_hidden_idss[itran])
+                str += std::to_string(id) + " ";
+            str += "<-";
+            for(auto id : upper_dimension_hidden_idss[itran])
+                str += " " + std::to_string(id);
+            str += ") ";
+        }
+        return str + "}";
+    }
+};
+
+// Runtime counterpart of TensorDescriptor: an adaptor whose single bottom dimension (hidden id 0)
+// is the offset.
+struct RuntimeTensorDescriptor : RuntimeTensorAdaptor
+{
+    long_index_t element_space_size = 0;
+
+    std::size_t GetNumOfDimension() const { return GetNumOfTopDimension(); }
+
+    std::vector<long_index_t> GetLengths() const { return GetTopLengths(); }
+
+    long_index_t GetElementSpaceSize() const { return element_space_size; }
+
+    // Batched offset evaluation over structure-of-arrays indices, idx[i] holding n values of
+    // visible dimension i
+    void CalculateOffsets(std::size_t n,
+                          const long_index_t* const* idx,
+                          long_index_t* offsets,
+                          uint8_t* valid = nullptr) const
+    {
+        CalculateBottomIndices(n, idx, &offsets, valid);
+    }
+
+    long_index_t CalculateOffset(const std::vector<long_index_t>& idx) const
+    {
+        return CalculateBottomIndex(idx)[0];
+    }
+
+    bool HasValidOffset(const std::vector<long_index_t>& idx) const
+    {
+        std::vector<const long_index_t*> ptrs(idx.size());
+        for(std::size_t i = 0; i < idx.size(); ++i)
+            ptrs[i] = &idx[i];
+
+        long_index_t offset;
+        uint8_t valid;
+        CalculateOffsets(1, ptrs.data(), &offset, &valid);
+        return valid != 0;
+    }
+
+    // offsets of every visible index in row-major (last dimension fastest) order; invalid
+    // (padded) positions get -1
+    std::vector<long_index_t> CalculateAllOffsets() const
+    {
+        const auto lengths         = GetLengths();
+        const std::size_t ndim     = lengths.size();
+        const long_index_t n_total = GetElementSize();
+
+        std::vector<long_index_t> offsets(n_total);
+        std::vector<std::vector<long_index_t>> idx(ndim,
+                                                   std::vector<long_index_t>(BatchSize));
+        std::vector<const long_index_t*> idx_ptrs(ndim);
+        std::vector<uint8_t> valid(BatchSize);
+        std::vector<long_index_t> counter(ndim, 0);
+
+        for(std::size_t i = 0; i < ndim; ++i)
+            idx_ptrs[i] = idx[i].data();
+
+        for(long_index_t j0 = 0; j0 < n_total; j0 += BatchSize)
+        {
+            const std::size_t nb = std::min<long_index_t>(BatchSize, n_total - j0);
+
+            for(std::size_t j = 0; j < nb; ++j)
+            {
+                for(std::size_t i = 0; i < ndim; ++i)
+                    idx[i][j] = counter[i];
+
+                for(std::size_t i = ndim; i > 0; --i)
+                {
+                    if(++counter[i - 1] < lengths[i - 1])
+                        break;
+                    counter[i - 1] = 0;
+                }
+            }
+
+            CalculateOffsets(nb, idx_ptrs.data(), offsets.data() + j0, valid.data());
+
+            for(std::size_t j = 0; j < nb; ++j)
+                if(valid[j] == 0)
+                    offsets[j0 + j] = -1;
+        }
+
+        return offsets;
+    }
+};
+
+inline RuntimeTensorDescriptor
+make_runtime_naive_tensor_descriptor(const std::vector<long_index_t>& lengths,
+                                     const std::vector<long_index_t>& strides)
+{
+    RuntimeTensorDescriptor desc;
+
+    const index_t ndim = static_cast<index_t>(lengths.size());
+
+    desc.transforms                  = {RuntimeTransform::MakeEmbed(lengths, strides)};
+    desc.lower_dimension_hidden_idss = {{0}};
+    desc.upper_dimension_hidden_idss = {std::vector<index_t>(ndim)};
+    std::iota(desc.upper_dimension_hidden_idss[0].begin(),
+              desc.upper_dimension_hidden_idss[0].end(),
+              1);
+    desc.bottom_dimension_hidden_ids = {0};
+    desc.top_dimension_hidden_ids    = desc.upper_dimension_hidden_idss[0];
+    desc.element_space_size          = desc.transforms[0].low_lengths[0];
+
+    return desc;
+}
+
+inline RuntimeTensorDescriptor
+make_runtime_naive_tensor_descriptor_packed(const std::vector<long_index_t>& lengths)
+{
+    return make_runtime_naive_tensor_descriptor(
+        lengths, RuntimeTransform::ReverseExclusiveScan(lengths));
+}
+
+// Same contract as transform_tensor_descriptor: new_lower_dimension_old_visible_idss[i] are the
+// old visible dimensions consumed by new_transforms[i], new_upper_dimension_new_visible_idss[i]
+// the new visible dimensions it produces.
+inline RuntimeTensorDescriptor transform_runtime_tensor_descriptor(
+    const RuntimeTensorDescriptor& old_desc,
+    const std::vector<RuntimeTransform>& new_transforms,
+    const std::vector<std::vector<index_t>>& new_lower_dimension_old_visible_idss,
+    const std::vector<std::vector<index_t>>& new_upper_dimension_new_visible_idss)
+{
+    if(new_transforms.size() != new_lower_dimension_old_visible_idss.size() ||
+       new_transforms.size() != new_upper_dimension_new_visible_idss.size())
+        throw std::runtime_error("wrong! inconsistent # of transformations");
+
+    RuntimeTensorDescriptor desc = old_desc;
+
+    index_t next_hidden_id = static_cast<index_t>(old_desc.GetNumOfHiddenDimension());
+
+    std::size_t ndim_new_visible = 0;
+    for(const auto& ids : new_upper_dimension_new_visible_idss)
+        ndim_new_visible += ids.size();
+
+    std::vector<index_t> new_visible_ids(ndim_new_visible, -1);
+
+    for(std::size_t itran = 0; itran < new_transforms.size(); ++itran)
+    {
+        const auto& tran    = new_transforms[itran];
+        const auto& old_ids = new_lower_dimension_old_visible_idss[itran];
+        const auto& new_ids = new_upper_dimension_new_visible_idss[itran];
+
+        if(old_ids.size() != tran.GetNumOfLowerDimension() ||
+           new_ids.size() != tran.GetNumOfUpperDimension())
+            throw std::runtime_error("wrong! inconsistent # of dimension for " +
+                                     tran.GetTypeString());
+
+        std::vector<index_t> low_hidden_ids(old_ids.size());
+        for(std::size_t i = 0; i < old_ids.size(); ++i)
+            low_hidden_ids[i] = old_desc.top_dimension_hidden_ids.at(old_ids[i]);
+
+        std::vector<index_t> up_hidden_ids(new_ids.size());
+        for(std::size_t i = 0; i < new_ids.size(); ++i)
+        {
+            up_hidden_ids[i]               = next_hidden_id++;
+            new_visible_ids.at(new_ids[i]) = up_hidden_ids[i];
+        }
+
+        desc.transforms.push_back(tran);
+        desc.lower_dimension_hidden_idss.push_back(std::move(low_hidden_ids));
+        desc.upper_dimension_hidden_idss.push_back(std::move(up_hidden_ids));
+    }
+
+    if(std::find(new_visible_ids.begin(), new_visible_ids.end(), -1) != new_visible_ids.end())
+        throw std::runtime_error("wrong! new visible dimension ids are not a valid map");
+
+    desc.top_dimension_hidden_ids = std::move(new_visible_ids);
+
+    return desc;
+}
+
+namespace detail {
+
+template <typename X>
+long_index_t to_long_index(const X& x)
+{
+    return static_cast<long_index_t>(x);
+}
+
+template <typename Container>
+std::vector<long_index_t> container_to_long_index_vector(const Container& c)
+{
+    std::vector<long_index_t> v(Container::Size());
+    static_for<0, Container::Size(), 1>{}([&](auto i) { v[i] = to_long_index(c[i]); });
+    return v;
+}
+
+template <typename Seq>
+std::vector<index_t> sequence_to_vector(Seq)
+{
+    std::vector<index_t> v(Seq::Size());
+    static_for<0, Seq::Size(), 1>{}([&](auto i) { v[i] = Seq::At(i); });
+    return v;
+}
+
+template <typename LowLength>
+RuntimeTransform make_runtime_transform(const PassThrough<LowLength>& t)
+{
+    return RuntimeTransform::MakePassThrough(to_long_index(t.GetUpperLengths()[Number<0>{}]));
+}
+
+template <typename LowLength, typename LeftPad, typename RightPad, bool SkipIsValidCheck>
+RuntimeTransform
+make_runtime_transform(const ck::Pad<LowLength, LeftPad, RightPad, SkipIsValidCheck>& t)
+{
+    const long_index_t left  = to_long_index(t.left_pad_length_);
+    const long_index_t right = to_long_index(t.right_pad_length_);
+    const long_index_t up    = to_long_index(t.up_lengths_[Number<0>{}]);
+    return RuntimeTransform::MakePad(up - left - right, left, right, SkipIsValidCheck);
+}
+
+template <typename LowLength, typename LeftPadLength, bool SkipIsValidCheck>
+RuntimeTransform
+make_runtime_transform(const ck::LeftPad<LowLength, LeftPadLength, SkipIsValidCheck>& t)
+{
+    const long_index_t left = to_long_index(t.left_pad_length_);
+    const long_index_t up   = to_long_index(t.up_lengths_[Number<0>{}]);
+    return RuntimeTransform::MakeLeftPad(up - left, left, SkipIsValidCheck);
+}
+
+template <typename LowLength, typename RightPadLength, bool SkipIsValidCheck>
+RuntimeTransform
+make_runtime_transform(const ck::RightPad<LowLength, RightPadLength, SkipIsValidCheck>& t)
+{
+    const long_index_t low = to_long_index(t.low_length_);
+    const long_index_t up  = to_long_index(t.up_lengths_[Number<0>{}]);
+    return RuntimeTransform::MakeRightPad(low, up - low, SkipIsValidCheck);
+}
+
+template <typename UpLengths, typename Coefficients>
+RuntimeTransform make_runtime_transform(const Embed<UpLengths, Coefficients>& t)
+{
+    return RuntimeTransform::MakeEmbed(container_to_long_index_vector(t.up_lengths_),
+                                       container_to_long_index_vector(t.coefficients_));
+}
+
+template <typename LowLengths>
+RuntimeTransform make_runtime_transform(const Merge_v1_carry_check<LowLengths>& t)
+{
+    return RuntimeTransform::MakeMerge(container_to_long_index_vector(t.low_lengths_));
+}
+
+template <typename LowLengths>
+RuntimeTransform make_runtime_transform(const Merge_v2_magic_division<LowLengths>& t)
+{
+    return RuntimeTransform::MakeMerge(container_to_long_index_vector(t.low_lengths_));
+}
+
+template <typename LowLengths>
+RuntimeTransform make_runtime_transform(const Merge_v2r2_magic_division<LowLengths>& t)
+{
+    return RuntimeTransform::MakeMerge(container_to_long_index_vector(t.low_lengths_));
+}
+
+template <typename LowLengths>
+RuntimeTransform make_runtime_transform(const Merge_v3_division_mod<LowLengths>& t)
+{
+    return RuntimeTransform::MakeMerge(container_to_long_index_vector(t.low_lengths_));
+}
+
+template <typename UpLengths, bool Use24BitIntegerCalculation>
+RuntimeTransform make_runtime_transform(const UnMerge<UpLengths, Use24BitIntegerCalculation>& t)
+{
+    return RuntimeTransform::MakeUnMerge(container_to_long_index_vector(t.up_lengths_));
+}
+
+template <typename LowerIndex>
+RuntimeTransform make_runtime_transform(const Freeze<LowerIndex>& t)
+{
+    return RuntimeTransform::MakeFreeze(to_long_index(t.low_idx_));
+}
+
+template <typename UpperLength>
+RuntimeTransform make_runtime_transform(const Insert<UpperLength>& t)
+{
+    return RuntimeTransform::MakeInsert(to_long_index(t.up_lengths_[Number<0>{}]));
+}
+
+template <typename VectorSize, typename UpLength>
+RuntimeTransform make_runtime_transform(const Vectorize<VectorSize, UpLength>& t)
+{
+    return RuntimeTransform::MakeVectorize(to_long_index(t.vector_size_),
+                                           to_long_index(t.up_lengths_[Number<0>{}]));
+}
+
+template <typename LowLength, typename SliceBegin, typename SliceEnd>
+RuntimeTransform make_runtime_transform(const Slice<LowLength, SliceBegin, SliceEnd>& t)
+{
+    // Slice does not store its lower length; the slice end is the smallest consistent one
+    return RuntimeTransform::MakeSlice(
+        to_long_index(t.slice_end_), to_long_index(t.slice_begin_), to_long_index(t.slice_end_));
+}
+
+template <typename Modulus, typename UpLength>
+RuntimeTransform make_runtime_transform(const Modulo<Modulus, UpLength>& t)
+{
+    return RuntimeTransform::MakeModulo(to_long_index(t.modulus_),
+                                        to_long_index(t.up_lengths_[Number<0>{}]));
+}
+
+template <typename LowLengths, bool ApplyModulo>
+RuntimeTransform make_runtime_transform(const Xor<LowLengths, ApplyModulo>& t)
+{
+    return RuntimeTransform::MakeXor(container_to_long_index_vector(t.up_lengths_), ApplyModulo);
+}
+
+template <typename Transforms, typename LowerIdss, typename UpperIdss>
+void convert_transforms(RuntimeTensorAdaptor& adaptor,
+                        const Transforms& transforms,
+                        LowerIdss,
+                        UpperIdss)
+{
+    static_for<0, Transforms::Size(), 1>{}([&](auto itran) {
+        adaptor.transforms.push_back(make_runtime_transform(transforms[itran]));
+        adaptor.lower_dimension_hidden_idss.push_back(sequence_to_vector(LowerIdss{}[itran]));
+        adaptor.upper_dimension_hidden_idss.push_back(sequence_to_vector(UpperIdss{}[itran]));
+    });
+}
+
+} // namespace detail
+
+template <typename Transforms,
+          typename LowerDimensionIdss,
+          typename UpperDimensionIdss,
+          typename VisibleDimensionIds,
+          typename ElementSpaceSize>
+RuntimeTensorDescriptor
+make_runtime_tensor_descriptor(const TensorDescriptor<Transforms,
+                                                      LowerDimensionIdss,
+                                                      UpperDimensionIdss,
+                                                      VisibleDimensionIds,
+                                                      ElementSpaceSize>& desc)
+{
+    RuntimeTensorDescriptor rt_desc;
+
+    detail::convert_transforms(
+        rt_desc, desc.GetTransforms(), LowerDimensionIdss{}, UpperDimensionIdss{});
+
+    rt_desc.bottom_dimension_hidden_ids = {0};
+    rt_desc.top_dimension_hidden_ids    = detail::sequence_to_vector(VisibleDimensionIds{});
+    rt_desc.element_space_size          = detail::to_long_index(desc.GetElementSpaceSize());
+
+    return rt_desc;
+}
+
+template <typename Transforms,
+          typename LowerDimensionHiddenIdss,
+          typename UpperDimensionHiddenIdss,
+          typename BottomDimensionHiddenIds,
+          typename TopDimensionHiddenIds>
+RuntimeTensorAdaptor make_runtime_tensor_adaptor(const TensorAdaptor<Transforms,
+                                                                     LowerDimensionHiddenIdss,
+                                                                     UpperDimensionHiddenIdss,
+                                                                     BottomDimensionHiddenIds,
+                                                                     TopDimensionHiddenIds>& a)
+{
+    RuntimeTensorAdaptor rt_adaptor;
+
+    detail::convert_transforms(
+        rt_adaptor, a.GetTransforms(), LowerDimensionHiddenIdss{}, UpperDimensionHiddenIdss{});
+
+    rt_adaptor.bottom_dimension_hidden_ids = detail::sequence_to_vector(BottomDimensionHiddenIds{});
+    rt_adaptor.top_dimension_hidden_ids    = detail::sequence_to_vector(TopDimensionHiddenIds{});
+
+    return rt_adaptor;
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ck/utility/env.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+// Sampled verification, selected with verification mode 2 of the convolution and contraction
+// profilers: the reference computes only a stratified random subset of the output elements and
+// only those are compared.
+//   export CK_VERIFY_SAMPLES=N   number of randomly drawn output elements (default 4096)
+//   export CK_VERIFY_SEED=S      seed of the sampling (default fixed)
+CK_DECLARE_ENV_VAR_UINT64(CK_VERIFY_SAMPLES)
+CK_DECLARE_ENV_VAR_UINT64(CK_VERIFY_SEED)
+
+namespace ck {
+namespace utils {
+
+// multi-indices of tensor elements, as passed to the references' Run(argument, indices)
+using TensorIndices = std::vector<std::vector<std::size_t>>;
+
+struct SampledVerificationConfig
+{
+    // elements drawn at random, on top of the ones covering the required coordinates
+    std::size_t samples = 4096;
+    // coordinates on both sides of every multiple of `tile` are required, to cover tile edges
+    std::size_t tile = 32;
+    uint64_t seed    = 0x2545f4914f6cdd1dULL;
+
+    static SampledVerificationConfig FromEnv()
+    {
+        SampledVerificationConfig config;
+        if(EnvValue(CK_ENV(CK_VERIFY_SAMPLES)) > 0)
+            config.samples = EnvValue(CK_ENV(CK_VERIFY_SAMPLES));
+        if(!EnvIsUnset(CK_ENV(CK_VERIFY_SEED)))
+            config.seed = EnvValue(CK_ENV(CK_VERIFY_SEED));
+        return config;
+    }
+};
+
+// Picks the elements of a tensor of `lengths` to verify. Every coordinate of required[d], both
+// borders and the tile edges of every dimension d are covered by at least one element; the
+// required coordinates of all dimensions are combined in shuffled order so that they also meet
+// each other. `config.samples` more elements are drawn one from each of as many equal strata of
+// the row-major index space, so that no region of the tensor goes unsampled. Returns unique
+// indices in row-major order, all of them when the tensor is not larger than the sample.
+TensorIndices sample_indices(const std::vector<std::size_t>& lengths,
+                             const std::vector<std::vector<std::size_t>>& required,
+                             const SampledVerificationConfig& config);
+
+// check_err of the elements of `out` and `ref` at `indices`; an error reports the position in
+// `indices`
+template <typename T, typename... Args>
+bool check_err_at(const Tensor<T>& out,
+                  const Tensor<T>& ref,
+                  const TensorIndices& indices,
+                  Args&&... args)
+{
+    std::vector<T> out_values;
+    std::vector<T> ref_values;
+    out_values.reserve(indices.size());
+    ref_values.reserve(indices.size());
+    for(const auto& idx : indices)
+    {
+        out_values.push_back(out(idx));
+        ref_values.push_back(ref(idx));
+    }
+    return check_err(out_values, ref_values, std::forward<Args>(args)...);
+}
+
+// The elements of a tensor of `lengths` that verification mode `do_verification` compares: with
+// mode 2 the sample_indices covering `required`, logged as "verifying X of Y <elements>", and
+// otherwise none, which stands for all of them in run_reference and check_err_sampled
+TensorIndices make_verify_indices(int do_verification,
+                                  const std::vector<std::size_t>& lengths,
+                                  const std::vector<std::vector<std::size_t>>& required,
+                                  const std::string& elements);
+
+// Runs a host reference on the elements at `indices` only, or on all of them when there are none
+template <typename Invoker, typename Argument>
+float run_reference(Invoker& invoker, const Argument& argument, const TensorIndices& indices)
+{
+    return indices.empty() ? invoker.Run(argument) : invoker.Run(argument, indices);
+}
+
+// check_err_at of the elements at `indices`, or check_err of all of them when there are none
+template <typename T, typename... Args>
+bool check_err_sampled(const Tensor<T>& out,
+                       const Tensor<T>& ref,
+                       const TensorIndices& indices,
+                       Args&&... args)
+{
+    return indices.empty() ? check_err(out, ref, std::forward<Args>(args)...)
+                           : check_err_at(out, ref, indices, std::forward<Args>(args)...);
+}
+
+namespace conv {
+
+// Coordinates the sampled verification of a convolution has to cover in each dimension of
+//  - the [G, N, K, Do, Ho, Wo] output: every group, and the positions whose filter window
+//    reaches into the padding;
+std::vector<std::vector<std::size_t>> get_fwd_required_coordinates(const ConvParam& param);
+//  - the [G, N, C, Di, Hi, Wi] input gradient: every group, and the positions reached by a filter
+//    tap from outside the output, or by no tap at all;
+std::vector<std::vector<std::size_t>> get_bwd_data_required_coordinates(const ConvParam& param);
+//  - the [G, K, C, Z, Y, X] weight gradient: every group and every filter tap.
+std::vector<std::vector<std::size_t>> get_bwd_weight_required_coordinates(const ConvParam& param);
+
+} // namespace conv
+} // namespace utils
+} // namespace ck
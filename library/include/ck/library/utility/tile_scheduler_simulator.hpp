@@ -0,0 +1,532 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <list>
+#include <ostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "ck/ck.hpp"
+#include "ck/utility/common_header.hpp"
+#include "ck/tensor_operation/gpu/grid/block_to_ctile_map.hpp"
+
+namespace ck {
+namespace utils {
+
+// Host-side discrete-event model of how a GEMM grid is executed by the workgroup dispatcher.
+//
+// The work of a grid is described per workgroup as the C tile segments it visits, in the order
+// the kernel visits them. make_data_parallel_work and make_stream_k_work derive that list from
+// the real BlockToCTileMap classes, so a mapping is evaluated exactly the way the kernel applies
+// it. simulate_tile_schedule then dispatches the workgroups in block order onto num_cu CUs with
+// `occupancy` resident slots each and reports per-CU busy time, wave efficiency and how well the
+// order in which tiles are visited reuses A/B panels.
+//
+// The cost model is deliberately coarse: one K iteration of one C tile costs k_iter_cost at full
+// CU throughput. The workgroups resident on a CU share its throughput equally, and a single
+// resident workgroup only reaches single_wg_throughput of it. Only comparisons between mappings
+// of the same problem (stream-K vs data-parallel, different swizzle factors) are meaningful.
+struct TileSchedulerModel
+{
+    uint32_t num_cu    = 1;
+    uint32_t occupancy = 1; // workgroups resident per CU
+
+    // fraction of the CU throughput reached by one resident workgroup; n resident workgroups
+    // reach min(1, n * single_wg_throughput)
+    double single_wg_throughput = 1.0;
+
+    double k_iter_cost = 1.0; // one KPerBlock step of one C tile
+    double tile_cost   = 0.0; // prologue/epilogue paid by every visited tile segment
+    // paid on top of tile_cost by segments not covering the whole K range of their tile
+    // (partial accumulator store, atomic add or reduction read)
+    double partial_tile_cost = 0.0;
+
+    // LRU capacity, in A row panels + B column panels, of the L2 model; 0 disables it
+    uint32_t l2_panel_capacity = 0;
+};
+
+struct TileSegment
+{
+    uint32_t m_tile       = 0;
+    uint32_t n_tile       = 0;
+    uint32_t k_iter_begin = 0; // in KPerBlock steps, relative to the tile
+    uint32_t k_iter_end   = 0;
+    bool partial          = false;
+};
+
+struct WorkgroupWork
+{
+    std::vector<TileSegment> segments;
+    // workgroups that have to finish before this one makes progress (stream-K reduction)
+    std::vector<uint32_t> depends_on;
+};
+
+struct TileScheduleReport
+{
+    double makespan   = 0;
+    double total_work = 0;
+    // total_work / (num_cu * makespan); 1 means every CU ran at full throughput until the end
+    double efficiency = 0;
+    double waves      = 0; // workgroups / (num_cu * occupancy)
+    // fraction of the makespan after the first CU ran out of work for good
+    double tail_fraction = 0;
+    double cu_imbalance  = 0; // max / mean of cu_work
+
+    std::vector<double> cu_busy_time; // time with at least one workgroup making progress
+    std::vector<double> cu_work;
+
+    std::vector<uint32_t> workgroup_cu;
+    std::vector<double> workgroup_start;
+    std::vector<double> workgroup_finish;
+
+    // C tiles (m, n) in the order their first segment started
+    std::vector<std::pair<uint32_t, uint32_t>> tile_order;
+    // mean number of distinct A row + B column panels touched by num_cu * occupancy consecutive
+    // segments; lower means concurrently running workgroups share more of their inputs
+    double panels_per_wave = 0;
+    double l2_hit_rate     = 0; // only computed with l2_panel_capacity > 0
+
+    void Print(std::ostream& os) const
+    {
+        const auto minmax_busy = std::minmax_element(cu_busy_time.begin(), cu_busy_time.end());
+
+        os << std::fixed << std::setprecision(3) << "makespan: " << makespan
+           << ", work: " << total_work << ", efficiency: " << efficiency << ", waves: " << waves
+           << ", tail: " << tail_fraction << std::endl;
+        if(!cu_busy_time.empty())
+        {
+            os << "cu busy min/max: " << *minmax_busy.first << "/" << *minmax_busy.second
+               << ", cu work imbalance: " << cu_imbalance << std::endl;
+        }
+        os << "tiles: " << tile_order.size() << ", panels per wave: " << panels_per_wave
+           << ", l2 hit rate: " << l2_hit_rate << std::endl;
+        os << std::defaultfloat;
+    }
+};
+
+// One workgroup per block id of a data-parallel BlockToCTileMap_* (anything with
+// CalculateBottomIndex). The last two entries of the bottom index are the M and N tile; the
+// KSplit maps put the K batch in front, which selects one of k_batch equal K ranges. Blocks
+// mapped outside the m_tiles x n_tiles grid do no work, as in the kernels.
+template <typename Block2CTileMap>
+std::vector<WorkgroupWork> make_data_parallel_work(const Block2CTileMap& block_2_ctile_map,
+                                                   index_t grid_size,
+                                                   index_t m_tiles,
+                                                   index_t n_tiles,
+                                                   uint32_t k_iters_per_tile,
+                                                   index_t k_batch = 1)
+{
+    const uint32_t k_iters_per_batch = math::integer_divide_ceil(k_iters_per_tile, k_batch);
+
+    std::vector<WorkgroupWork> workgroups(grid_size);
+
+    for(index_t block_id = 0; block_id < grid_size; ++block_id)
+    {
+        const auto idx = block_2_ctile_map.CalculateBottomIndex(make_multi_index(block_id));
+
+        constexpr index_t NDim = remove_cvref_t<decltype(idx)>::Size();
+        static_assert(NDim == 2 || NDim == 3, "expect (m, n) or (k, m, n) bottom index");
+
+        const index_t m = idx[Number<NDim - 2>{}];
+        const index_t n = idx[Number<NDim - 1>{}];
+        index_t k       = 0;
+        if constexpr(NDim == 3)
+        {
+            k = idx[Number<0>{}];
+        }
+
+        if(m < 0 || m >= m_tiles || n < 0 || n >= n_tiles || k < 0 || k >= k_batch)
+        {
+            continue;
+        }
+
+        TileSegment segment;
+        segment.m_tile       = m;
+        segment.n_tile       = n;
+        segment.k_iter_begin = math::min(k * k_iters_per_batch, k_iters_per_tile);
+        segment.k_iter_end   = math::min((k + 1) * k_iters_per_batch, k_iters_per_tile);
+        segment.partial      = k_batch > 1;
+
+        workgroups[block_id].segments.push_back(segment);
+    }
+
+    return workgroups;
+}
+
+// Workgroups of BlockToCTileMap_GemmStreamK, replaying the iteration loop of
+// GridwiseGemm_bk0mk1_bk0nk1_mn_xdlops_streamk: stream-K blocks walk their iteration range
+// backwards one tile segment at a time, padding blocks exit, data-parallel blocks own one tile
+// and, with StreamKReductionStrategy::Reduction, one trailing block per stream-K tile waits for
+// the stream-K blocks contributing to it.
+template <typename Block2CTileMap>
+std::vector<WorkgroupWork>
+make_stream_k_work(const Block2CTileMap& block_2_ctile_map, uint32_t m, uint32_t n)
+{
+    const uint32_t grid_size        = block_2_ctile_map.get_grid_dims().x;
+    const uint32_t k_iters_per_tile = block_2_ctile_map.k_iters_per_tile.get();
+
+    std::vector<WorkgroupWork> workgroups(grid_size);
+
+    const auto to_segment = [&](uint32_t tile_idx, uint32_t k_begin, uint32_t k_end) {
+        const auto spatial_idx = block_2_ctile_map.tile_to_spatial(tile_idx, m, n);
+
+        TileSegment segment;
+        segment.m_tile       = spatial_idx[Number<0>{}];
+        segment.n_tile       = spatial_idx[Number<1>{}];
+        segment.k_iter_begin = k_begin;
+        segment.k_iter_end   = k_end;
+        segment.partial      = k_end - k_begin != k_iters_per_tile;
+        return segment;
+    };
+
+    for(uint32_t block_idx = 0; block_idx < block_2_ctile_map.reduction_start_block_idx;
+        ++block_idx)
+    {
+        const bool is_padding_block = block_idx >= block_2_ctile_map.sk_num_blocks &&
+                                      block_idx < block_2_ctile_map.dp_start_block_idx;
+        if(is_padding_block)
+        {
+            continue;
+        }
+
+        uint32_t iter_start, iter_end;
+        block_2_ctile_map.get_block_itr(block_idx, iter_start, iter_end);
+        const uint32_t total_iter_length = iter_end - iter_start;
+
+        while(iter_end > iter_start)
+        {
+            const uint32_t current_iter_length =
+                block_2_ctile_map.get_current_iter_length(iter_start, iter_end, total_iter_length);
+
+            uint32_t tile_idx, iter_offset;
+            block_2_ctile_map.get_tile_idx_with_offset(iter_end - 1, tile_idx, iter_offset);
+            iter_offset = iter_offset - current_iter_length + 1;
+
+            workgroups[block_idx].segments.push_back(
+                to_segment(tile_idx, iter_offset, iter_offset + current_iter_length));
+
+            iter_end -= current_iter_length;
+        }
+    }
+
+    // reduction blocks: block reduction_start_block_idx + i finalizes stream-K tile i
+    for(uint32_t block_idx = block_2_ctile_map.reduction_start_block_idx; block_idx < grid_size;
+        ++block_idx)
+    {
+        const uint32_t tile_idx        = block_idx - block_2_ctile_map.reduction_start_block_idx;
+        const uint32_t tile_iter_begin = tile_idx * k_iters_per_tile;
+        const uint32_t tile_iter_end   = tile_iter_begin + k_iters_per_tile;
+
+        auto& workgroup = workgroups[block_idx];
+        workgroup.segments.push_back(to_segment(tile_idx, 0, 0));
+
+        for(uint32_t sk_block = 0; sk_block < block_2_ctile_map.sk_num_blocks; ++sk_block)
+        {
+            uint32_t iter_start, iter_end;
+            block_2_ctile_map.get_block_itr(sk_block, iter_start, iter_end);
+            if(iter_start < tile_iter_end && tile_iter_begin < iter_end)
+            {
+                workgroup.depends_on.push_back(sk_block);
+            }
+        }
+    }
+
+    return workgroups;
+}
+
+namespace detail {
+
+inline double tile_segment_cost(const TileSegment& segment, const TileSchedulerModel& model)
+{
+    return model.tile_cost + (segment.partial ? model.partial_tile_cost : 0.0) +
+           (segment.k_iter_end - segment.k_iter_begin) * model.k_iter_cost;
+}
+
+// LRU over A row panels and B column panels, fed in visitation order
+inline double tile_order_l2_hit_rate(const std::vector<TileSegment>& segments, uint32_t capacity)
+{
+    std::list<uint64_t> lru;
+    std::unordered_map<uint64_t, std::list<uint64_t>::iterator> where;
+    std::size_t hits = 0, accesses = 0;
+
+    const auto access = [&](uint64_t key) {
+        ++accesses;
+        auto it = where.find(key);
+        if(it != where.end())
+        {
+            ++hits;
+            lru.splice(lru.begin(), lru, it->second);
+            return;
+        }
+        lru.push_front(key);
+        where[key] = lru.begin();
+        if(lru.size() > capacity)
+        {
+            where.erase(lru.back());
+            lru.pop_back();
+        }
+    };
+
+    for(const auto& segment : segments)
+    {
+        access(uint64_t{segment.m_tile} << 1);
+        access((uint64_t{segment.n_tile} << 1) | 1);
+    }
+
+    return accesses == 0 ? 0.0 : static_cast<double>(hits) / accesses;
+}
+
+} // namespace detail
+
+inline TileScheduleReport simulate_tile_schedule(const std::vector<WorkgroupWork>& workgroups,
+                                                 const TileSchedulerModel& model)
+{
+    if(model.num_cu == 0 || model.occupancy == 0 || model.single_wg_throughput <= 0)
+    {
+        throw std::runtime_error("tile scheduler model needs CUs, occupancy and throughput");
+    }
+
+    const std::size_t num_wg = workgroups.size();
+    const uint32_t num_cu    = model.num_cu;
+
+    TileScheduleReport report;
+    report.cu_busy_time.assign(num_cu, 0.0);
+    report.cu_work.assign(num_cu, 0.0);
+    report.workgroup_cu.assign(num_wg, 0);
+    report.workgroup_start.assign(num_wg, 0.0);
+    report.workgroup_finish.assign(num_wg, 0.0);
+
+    std::vector<double> cost(num_wg, 0.0);
+    std::vector<uint32_t> num_pending_deps(num_wg, 0);
+    std::vector<std::vector<uint32_t>> dependents(num_wg);
+
+    for(std::size_t i = 0; i < num_wg; ++i)
+    {
+        for(const auto& segment : workgroups[i].segments)
+        {
+            cost[i] += detail::tile_segment_cost(segment, model);
+        }
+        for(uint32_t dep : workgroups[i].depends_on)
+        {
+            // workgroups are dispatched in order, a later one could never be resident in time
+            if(dep >= i)
+            {
+                throw std::runtime_error("workgroup depends on a later workgroup");
+            }
+            ++num_pending_deps[i];
+            dependents[dep].push_back(i);
+        }
+        report.total_work += cost[i];
+    }
+
+    std::vector<double> remaining = cost;
+    std::vector<std::vector<uint32_t>> resident(num_cu);
+
+    // the dispatcher hands out workgroups in block order, walking the CUs round-robin and
+    // skipping CUs without a free slot
+    std::size_t next_wg = 0;
+    uint32_t next_cu    = 0;
+
+    const auto dispatch = [&](double now) {
+        for(uint32_t num_full = 0; next_wg < num_wg && num_full < num_cu;)
+        {
+            if(resident[next_cu].size() < model.occupancy)
+            {
+                resident[next_cu].push_back(next_wg);
+                report.workgroup_cu[next_wg]    = next_cu;
+                report.workgroup_start[next_wg] = now;
+                ++next_wg;
+                num_full = 0;
+            }
+            else
+            {
+                ++num_full;
+            }
+            next_cu = (next_cu + 1) % num_cu;
+        }
+    };
+
+    const auto cu_throughput = [&](std::size_t num_active) {
+        return std::min(1.0, model.single_wg_throughput * num_active);
+    };
+
+    const auto num_runnable = [&](uint32_t cu) {
+        return std::count_if(resident[cu].begin(), resident[cu].end(), [&](uint32_t wg) {
+            return num_pending_deps[wg] == 0;
+        });
+    };
+
+    double now           = 0;
+    std::size_t num_done = 0;
+
+    dispatch(now);
+
+    while(num_done < num_wg)
+    {
+        // finish every runnable workgroup without work left, then refill its slot
+        bool retired = false;
+        for(uint32_t cu = 0; cu < num_cu; ++cu)
+        {
+            auto& wgs = resident[cu];
+            for(auto it = wgs.begin(); it != wgs.end();)
+            {
+                const uint32_t wg = *it;
+                if(num_pending_deps[wg] == 0 && remaining[wg] <= 1e-9 * std::max(1.0, cost[wg]))
+                {
+                    report.workgroup_finish[wg] = now;
+                    for(uint32_t dependent : dependents[wg])
+                    {
+                        --num_pending_deps[dependent];
+                    }
+                    it      = wgs.erase(it);
+                    retired = true;
+                    ++num_done;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+        if(retired)
+        {
+            dispatch(now);
+            continue;
+        }
+
+        // advance to the next workgroup completion
+        double dt = std::numeric_limits<double>::infinity();
+        for(uint32_t cu = 0; cu < num_cu; ++cu)
+        {
+            const auto num_active = num_runnable(cu);
+            if(num_active == 0)
+            {
+                continue;
+            }
+            const double rate = cu_throughput(num_active) / num_active;
+            for(uint32_t wg : resident[cu])
+            {
+                if(num_pending_deps[wg] == 0)
+                {
+                    dt = std::min(dt, remaining[wg] / rate);
+                }
+            }
+        }
+
+        if(dt == std::numeric_limits<double>::infinity())
+        {
+            throw std::runtime_error("no resident workgroup can make progress");
+        }
+
+        for(uint32_t cu = 0; cu < num_cu; ++cu)
+        {
+            const auto num_active = num_runnable(cu);
+            if(num_active == 0)
+            {
+                continue;
+            }
+            const double rate = cu_throughput(num_active) / num_active;
+            for(uint32_t wg : resident[cu])
+            {
+                if(num_pending_deps[wg] == 0)
+                {
+                    remaining[wg] -= dt * rate;
+                }
+            }
+            report.cu_busy_time[cu] += dt;
+            report.cu_work[cu] += dt * cu_throughput(num_active);
+        }
+
+        now += dt;
+    }
+
+    report.makespan = now;
+    report.waves    = static_cast<double>(num_wg) / (num_cu * model.occupancy);
+
+    if(report.makespan > 0)
+    {
+        report.efficiency = report.total_work / (num_cu * report.makespan);
+
+        std::vector<double> cu_last_finish(num_cu, 0.0);
+        for(std::size_t i = 0; i < num_wg; ++i)
+        {
+            auto& last_finish = cu_last_finish[report.workgroup_cu[i]];
+            last_finish       = std::max(last_finish, report.workgroup_finish[i]);
+        }
+        const double first_idle = *std::min_element(cu_last_finish.begin(), cu_last_finish.end());
+        report.tail_fraction    = (report.makespan - first_idle) / report.makespan;
+
+        const double mean_work = report.total_work / num_cu;
+        report.cu_imbalance =
+            *std::max_element(report.cu_work.begin(), report.cu_work.end()) / mean_work;
+    }
+
+    // visitation order: segments are assumed to progress linearly within their workgroup
+    std::vector<std::pair<double, TileSegment>> timed_segments;
+    for(std::size_t i = 0; i < num_wg; ++i)
+    {
+        const double duration = report.workgroup_finish[i] - report.workgroup_start[i];
+        double done           = 0;
+        for(const auto& segment : workgroups[i].segments)
+        {
+            const double start =
+                report.workgroup_start[i] + (cost[i] > 0 ? duration * done / cost[i] : 0.0);
+            timed_segments.emplace_back(start, segment);
+            done += detail::tile_segment_cost(segment, model);
+        }
+    }
+    std::stable_sort(timed_segments.begin(),
+                     timed_segments.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<TileSegment> ordered_segments;
+    std::unordered_set<uint64_t> seen_tiles;
+    for(const auto& timed_segment : timed_segments)
+    {
+        const auto& segment = timed_segment.second;
+        ordered_segments.push_back(segment);
+        if(seen_tiles.insert((uint64_t{segment.m_tile} << 32) | segment.n_tile).second)
+        {
+            report.tile_order.emplace_back(segment.m_tile, segment.n_tile);
+        }
+    }
+
+    const std::size_t window = std::size_t{num_cu} * model.occupancy;
+    std::size_t num_windows  = 0;
+    for(std::size_t begin = 0; begin < ordered_segments.size(); begin += window)
+    {
+        std::unordered_set<uint32_t> m_panels, n_panels;
+        const std::size_t end = std::min(begin + window, ordered_segments.size());
+        for(std::size_t i = begin; i < end; ++i)
+        {
+            m_panels.insert(ordered_segments[i].m_tile);
+            n_panels.insert(ordered_segments[i].n_tile);
+        }
+        report.panels_per_wave += m_panels.size() + n_panels.size();
+        ++num_windows;
+    }
+    if(num_windows > 0)
+    {
+        report.panels_per_wave /= num_windows;
+    }
+
+    if(model.l2_panel_capacity > 0)
+    {
+        report.l2_hit_rate =
+            detail::tile_order_l2_hit_rate(ordered_segments, model.l2_panel_capacity);
+    }
+
+    return report;
+}
+
+} // namespace utils
+} // namespace ck
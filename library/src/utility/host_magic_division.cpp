@@ -0,0 +1,239 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <utility>
+
+// the vector kernels are host code; the device pass of a HIP compilation does not see them
+#if defined(__x86_64__) && !defined(__HIP_DEVICE_COMPILE__)
+#define CK_HOST_MAGIC_DIVISION_X86 1
+#include <immintrin.h>
+#endif
+
+#include "ck/library/utility/host_magic_division.hpp"
+
+namespace ck {
+namespace utils {
+
+namespace {
+
+// The vector kernels decompose `count` flat indices, either the range [begin, begin + count) or
+// flat[0, count), which all fit the 32-bit magic division. Dimensions are peeled from the
+// innermost one: q = n / length, coordinate = n - q * length, n = q.
+struct FlatIndices
+{
+    std::size_t begin;
+    const std::size_t* flat;
+
+    std::size_t operator[](std::size_t j) const { return flat != nullptr ? flat[j] : begin + j; }
+};
+
+void decompose_scalar(const HostIndexDecomposer& decomposer,
+                      FlatIndices in,
+                      std::size_t first,
+                      std::size_t count,
+                      std::size_t* idx)
+{
+    const std::size_t ndim = decomposer.GetNumOfDimension();
+    std::vector<std::size_t> coord(ndim);
+    for(std::size_t j = first; j < count; ++j)
+    {
+        decomposer.Decompose(in[j], coord.data());
+        for(std::size_t d = 0; d < ndim; ++d)
+            idx[d * count + j] = coord[d];
+    }
+}
+
+#ifdef CK_HOST_MAGIC_DIVISION_X86
+
+__attribute__((target("avx2"))) inline __m256i mulhi_epu32_avx2(__m256i a, __m256i m)
+{
+    const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(a, m), 32);
+    const __m256i odd  = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+__attribute__((target("avx2"))) inline void store_epu32_avx2(std::size_t* p, __m256i v)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p),
+                        _mm256_cvtepu32_epi64(_mm256_castsi256_si128(v)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + 4),
+                        _mm256_cvtepu32_epi64(_mm256_extracti128_si256(v, 1)));
+}
+
+__attribute__((target("avx2"))) inline __m256i load_epu64_avx2(const std::size_t* p)
+{
+    // low halves of the 8 64-bit indices
+    const __m256i low = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    const __m256i a =
+        _mm256_permutevar8x32_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)), low);
+    const __m256i b = _mm256_permutevar8x32_epi32(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 4)), low);
+    return _mm256_permute2x128_si256(a, b, 0x20);
+}
+
+// returns the number of indices decomposed, a multiple of the vector width
+__attribute__((target("avx2"))) std::size_t
+decompose_avx2(const std::vector<HostMagicDivider>& dividers,
+               FlatIndices in,
+               std::size_t count,
+               std::size_t* idx)
+{
+    constexpr std::size_t lanes = 8;
+    const std::size_t ndim      = dividers.size();
+    const __m256i lane          = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+    std::size_t j = 0;
+    for(; j + lanes <= count; j += lanes)
+    {
+        __m256i n;
+        if(in.flat != nullptr)
+            n = load_epu64_avx2(in.flat + j);
+        else
+            n = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(in.begin + j)), lane);
+        for(std::size_t d = ndim; d-- > 1;)
+        {
+            const auto& div  = dividers[d];
+            const __m256i hi = mulhi_epu32_avx2(n, _mm256_set1_epi32(div.GetMultiplier()));
+            const __m256i q =
+                _mm256_srl_epi32(_mm256_add_epi32(hi, n), _mm_cvtsi32_si128(div.GetShift()));
+            const __m256i len = _mm256_set1_epi32(static_cast<int>(div.GetDivisor()));
+            store_epu32_avx2(idx + d * count + j,
+                             _mm256_sub_epi32(n, _mm256_mullo_epi32(q, len)));
+            n = q;
+        }
+        store_epu32_avx2(idx + j, n);
+    }
+    return j;
+}
+
+__attribute__((target("avx512f"))) inline __m512i mulhi_epu32_avx512(__m512i a, __m512i m)
+{
+    const __m512i even = _mm512_srli_epi64(_mm512_mul_epu32(a, m), 32);
+    const __m512i odd  = _mm512_mul_epu32(_mm512_srli_epi64(a, 32), m);
+    return _mm512_mask_blend_epi32(0xaaaa, even, odd);
+}
+
+__attribute__((target("avx512f"))) inline void store_epu32_avx512(std::size_t* p, __m512i v)
+{
+    _mm512_storeu_si512(p, _mm512_cvtepu32_epi64(_mm512_castsi512_si256(v)));
+    _mm512_storeu_si512(p + 8, _mm512_cvtepu32_epi64(_mm512_extracti64x4_epi64(v, 1)));
+}
+
+__attribute__((target("avx512f"))) inline __m512i load_epu64_avx512(const std::size_t* p)
+{
+    const __m256i a = _mm512_cvtepi64_epi32(_mm512_loadu_si512(p));
+    const __m256i b = _mm512_cvtepi64_epi32(_mm512_loadu_si512(p + 8));
+    return _mm512_inserti64x4(_mm512_castsi256_si512(a), b, 1);
+}
+
+__attribute__((target("avx512f"))) std::size_t
+decompose_avx512(const std::vector<HostMagicDivider>& dividers,
+                 FlatIndices in,
+                 std::size_t count,
+                 std::size_t* idx)
+{
+    constexpr std::size_t lanes = 16;
+    const std::size_t ndim      = dividers.size();
+    const __m512i lane = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+
+    std::size_t j = 0;
+    for(; j + lanes <= count; j += lanes)
+    {
+        __m512i n;
+        if(in.flat != nullptr)
+            n = load_epu64_avx512(in.flat + j);
+        else
+            n = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(in.begin + j)), lane);
+        for(std::size_t d = ndim; d-- > 1;)
+        {
+            const auto& div  = dividers[d];
+            const __m512i hi = mulhi_epu32_avx512(n, _mm512_set1_epi32(div.GetMultiplier()));
+            const __m512i q =
+                _mm512_srl_epi32(_mm512_add_epi32(hi, n), _mm_cvtsi32_si128(div.GetShift()));
+            const __m512i len = _mm512_set1_epi32(static_cast<int>(div.GetDivisor()));
+            store_epu32_avx512(idx + d * count + j,
+                               _mm512_sub_epi32(n, _mm512_mullo_epi32(q, len)));
+            n = q;
+        }
+        store_epu32_avx512(idx + j, n);
+    }
+    return j;
+}
+
+#endif
+
+void decompose(const HostIndexDecomposer& decomposer,
+               FlatIndices in,
+               std::size_t count,
+               std::size_t* idx,
+               HostSimd simd)
+{
+    if(decomposer.GetNumOfDimension() == 0)
+        return;
+
+    const HostSimd native = GetNativeHostSimd();
+    if(simd == HostSimd::Native || static_cast<int>(simd) > static_cast<int>(native))
+        simd = native;
+
+    std::size_t vectorized = 0;
+#ifdef CK_HOST_MAGIC_DIVISION_X86
+    if(simd == HostSimd::Avx512)
+        vectorized = decompose_avx512(decomposer.GetDividers(), in, count, idx);
+    else if(simd == HostSimd::Avx2)
+        vectorized = decompose_avx2(decomposer.GetDividers(), in, count, idx);
+#endif
+    decompose_scalar(decomposer, in, vectorized, count, idx);
+}
+
+} // namespace
+
+HostSimd GetNativeHostSimd()
+{
+#ifdef CK_HOST_MAGIC_DIVISION_X86
+    static const HostSimd simd = [] {
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f"))
+            return HostSimd::Avx512;
+        if(__builtin_cpu_supports("avx2"))
+            return HostSimd::Avx2;
+        return HostSimd::Scalar;
+    }();
+    return simd;
+#else
+    return HostSimd::Scalar;
+#endif
+}
+
+HostIndexDecomposer::HostIndexDecomposer(std::vector<std::size_t> lengths)
+    : mLengths(std::move(lengths)),
+      mElementSize(std::accumulate(
+          mLengths.begin(), mLengths.end(), std::size_t{1}, std::multiplies<std::size_t>()))
+{
+    mDividers.reserve(mLengths.size());
+    for(std::size_t length : mLengths)
+        mDividers.emplace_back(length);
+}
+
+void HostIndexDecomposer::DecomposeRange(std::size_t begin,
+                                         std::size_t count,
+                                         std::size_t* idx,
+                                         HostSimd simd) const
+{
+    // the vector kernels add the lane to the 32-bit flat index
+    const bool fits_32bit = Use32Bit() && begin + count <= INT32_MAX;
+    decompose(*this, FlatIndices{begin, nullptr}, count, idx, fits_32bit ? simd : HostSimd::Scalar);
+}
+
+void HostIndexDecomposer::Decompose(const std::size_t* flat,
+                                    std::size_t count,
+                                    std::size_t* idx,
+                                    HostSimd simd) const
+{
+    decompose(*this, FlatIndices{0, flat}, count, idx, Use32Bit() ? simd : HostSimd::Scalar);
+}
+
+} // namespace utils
+} // namespace ck
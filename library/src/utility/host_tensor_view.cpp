@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cstring>
+
+#include "ck/library/utility/host_tensor_view.hpp"
+
+namespace ck {
+namespace utils {
+
+namespace {
+
+// Blocks of at most this many bytes are copied with plain loops. It only has to amortize the
+// recursion, the recursion itself adapts the blocks to every cache level.
+constexpr std::size_t base_block_bytes = 4096;
+
+// Recursive copy of a space whose innermost dimension has the smallest destination stride.
+// Strides are in bytes; `run` bytes starting at every element are copied, more than one element
+// when the innermost dimension has been folded into contiguous runs.
+template <std::size_t ElementSize>
+struct BlockedCopy
+{
+    const std::vector<std::size_t>& src_strides;
+    const std::vector<std::size_t>& dst_strides;
+    std::size_t run;
+
+    void copy_run(const char* src, char* dst) const
+    {
+        if constexpr(ElementSize != 0)
+            std::memcpy(dst, src, ElementSize);
+        else
+            std::memcpy(dst, src, run);
+    }
+
+    void copy_block(const char* src, char* dst, const std::vector<std::size_t>& lengths) const
+    {
+        const std::size_t ndim       = lengths.size();
+        const std::size_t inner      = ndim - 1;
+        const std::size_t inner_len  = lengths[inner];
+        const std::size_t src_stride = src_strides[inner];
+        const std::size_t dst_stride = dst_strides[inner];
+
+        std::vector<std::size_t> idx(ndim, 0);
+        while(true)
+        {
+            for(std::size_t i = 0; i < inner_len; ++i)
+                copy_run(src + i * src_stride, dst + i * dst_stride);
+
+            std::size_t d = inner;
+            for(; d > 0; --d)
+            {
+                src += src_strides[d - 1];
+                dst += dst_strides[d - 1];
+                if(++idx[d - 1] < lengths[d - 1])
+                    break;
+                src -= lengths[d - 1] * src_strides[d - 1];
+                dst -= lengths[d - 1] * dst_strides[d - 1];
+                idx[d - 1] = 0;
+            }
+            if(d == 0)
+                return;
+        }
+    }
+
+    void operator()(const char* src, char* dst, std::vector<std::size_t>& lengths) const
+    {
+        // split the dimension spanning the most memory in either layout
+        std::size_t bytes = run;
+        std::size_t split = 0;
+        std::size_t span  = 0;
+        for(std::size_t d = 0; d < lengths.size(); ++d)
+        {
+            bytes *= lengths[d];
+            const std::size_t d_span = lengths[d] * std::max(src_strides[d], dst_strides[d]);
+            if(lengths[d] > 1 && d_span > span)
+            {
+                split = d;
+                span  = d_span;
+            }
+        }
+
+        if(bytes <= base_block_bytes || span == 0)
+        {
+            copy_block(src, dst, lengths);
+            return;
+        }
+
+        const std::size_t length = lengths[split];
+        const std::size_t half   = length / 2;
+
+        lengths[split] = half;
+        (*this)(src, dst, lengths);
+        lengths[split] = length - half;
+        (*this)(src + half * src_strides[split], dst + half * dst_strides[split], lengths);
+        lengths[split] = length;
+    }
+};
+
+template <std::size_t ElementSize>
+void blocked_copy(const char* src,
+                  const std::vector<std::size_t>& src_strides,
+                  char* dst,
+                  const std::vector<std::size_t>& dst_strides,
+                  std::vector<std::size_t>& lengths,
+                  std::size_t run)
+{
+    BlockedCopy<ElementSize>{src_strides, dst_strides, run}(src, dst, lengths);
+}
+
+} // namespace
+
+void copy_strided(const void* src,
+                  const std::vector<std::size_t>& src_strides,
+                  void* dst,
+                  const std::vector<std::size_t>& dst_strides,
+                  const std::vector<std::size_t>& lengths,
+                  std::size_t element_size)
+{
+    if(std::find(lengths.begin(), lengths.end(), std::size_t{0}) != lengths.end())
+        return;
+
+    // dimensions of length > 1, outermost first in the destination
+    std::vector<std::size_t> order;
+    for(std::size_t d = 0; d < lengths.size(); ++d)
+        if(lengths[d] > 1)
+            order.push_back(d);
+    std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) {
+        return dst_strides[a] != dst_strides[b] ? dst_strides[a] > dst_strides[b]
+                                                : src_strides[a] > src_strides[b];
+    });
+
+    // merge dimensions that are contiguous with the next one in both layouts, in bytes
+    std::vector<std::size_t> lens, src_bytes, dst_bytes;
+    for(std::size_t d : order)
+    {
+        const std::size_t s = src_strides[d] * element_size;
+        const std::size_t t = dst_strides[d] * element_size;
+        if(!lens.empty() && src_bytes.back() == s * lengths[d] &&
+           dst_bytes.back() == t * lengths[d])
+        {
+            lens.back() *= lengths[d];
+            src_bytes.back() = s;
+            dst_bytes.back() = t;
+            continue;
+        }
+        lens.push_back(lengths[d]);
+        src_bytes.push_back(s);
+        dst_bytes.push_back(t);
+    }
+
+    // the innermost dimension becomes a memcpy run when it is packed in both layouts
+    std::size_t run = element_size;
+    if(!lens.empty() && src_bytes.back() == element_size && dst_bytes.back() == element_size)
+    {
+        run *= lens.back();
+        lens.pop_back();
+        src_bytes.pop_back();
+        dst_bytes.pop_back();
+    }
+
+    if(lens.empty())
+    {
+        std::memcpy(dst, src, run);
+        return;
+    }
+
+    const auto* s = static_cast<const char*>(src);
+    auto* t       = static_cast<char*>(dst);
+    if(run != element_size)
+        return blocked_copy<0>(s, src_bytes, t, dst_bytes, lens, run);
+
+    switch(element_size)
+    {
+    case 1: return blocked_copy<1>(s, src_bytes, t, dst_bytes, lens, run);
+    case 2: return blocked_copy<2>(s, src_bytes, t, dst_bytes, lens, run);
+    case 4: return blocked_copy<4>(s, src_bytes, t, dst_bytes, lens, run);
+    case 8: return blocked_copy<8>(s, src_bytes, t, dst_bytes, lens, run);
+    case 16: return blocked_copy<16>(s, src_bytes, t, dst_bytes, lens, run);
+    default: return blocked_copy<0>(s, src_bytes, t, dst_bytes, lens, run);
+    }
+}
+
+} // namespace utils
+} // namespace ck
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <dlfcn.h>
+
+#include "ck/library/tensor_operation_instance/instance_shard.hpp"
+
+namespace ck {
+namespace tensor_operation {
+namespace device {
+namespace instance {
+
+namespace {
+
+void append_search_paths(std::vector<std::string>& paths, const std::string& list)
+{
+    std::stringstream ss(list);
+    std::string path;
+    while(std::getline(ss, path, ':'))
+    {
+        if(!path.empty())
+            paths.push_back(path);
+    }
+}
+
+std::vector<std::string> default_search_paths()
+{
+    std::vector<std::string> paths;
+    if(const char* env = std::getenv("CK_INSTANCE_SHARD_PATH"))
+        append_search_paths(paths, env);
+#ifdef CK_INSTANCE_SHARD_DIRS
+    append_search_paths(paths, CK_INSTANCE_SHARD_DIRS);
+#endif
+    return paths;
+}
+
+} // namespace
+
+InstanceShardLoader::InstanceShardLoader(std::vector<std::string> search_paths)
+    : mSearchPaths(std::move(search_paths))
+{
+}
+
+InstanceShardLoader& InstanceShardLoader::Instance()
+{
+    static InstanceShardLoader loader(default_search_paths());
+    return loader;
+}
+
+void InstanceShardLoader::ReadIndices()
+{
+    for(const auto& dir : mSearchPaths)
+    {
+        std::ifstream index(dir + "/" + IndexFileName);
+        std::string line;
+        while(std::getline(index, line))
+        {
+            std::istringstream fields(line);
+            std::string function, file;
+            if(!(fields >> function >> file) || function[0] == '#')
+                continue;
+            // emplace keeps the shard of the first directory listing the function
+            mShardOf.emplace(function, file[0] == '/' ? file : dir + "/" + file);
+        }
+    }
+    mIndexed = true;
+}
+
+const InstanceShardLoader::Shard& InstanceShardLoader::Load(const std::string& path)
+{
+    auto it = mShards.find(path);
+    if(it != mShards.end())
+        return it->second;
+
+    // RTLD_LOCAL: all shards define the same inline functions and template instantiations
+    void* handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if(handle == nullptr)
+        throw std::runtime_error("failed to load instance shard " + path + ": " + dlerror());
+
+    const auto get_desc =
+        reinterpret_cast<ck_instance_shard_fn>(dlsym(handle, CK_INSTANCE_SHARD_SYMBOL));
+    const ck_instance_shard_desc* desc = get_desc != nullptr ? get_desc() : nullptr;
+    if(desc == nullptr || desc->abi_version != CK_INSTANCE_SHARD_ABI_VERSION)
+    {
+        dlclose(handle);
+        throw std::runtime_error(path + " is not an instance shard of ABI version " +
+                                 std::to_string(CK_INSTANCE_SHARD_ABI_VERSION));
+    }
+
+    Shard shard;
+    shard.name = desc->name;
+    for(std::size_t i = 0; i < desc->num_entries; ++i)
+        shard.functions.emplace(desc->entries[i].name, desc->entries[i].add_instances);
+
+    mLoadOrder.push_back(shard.name);
+    return mShards.emplace(path, std::move(shard)).first->second;
+}
+
+bool InstanceShardLoader::AddInstances(const std::string& name, void* instances)
+{
+    ck_instance_shard_add_fn add_instances = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if(!mIndexed)
+            ReadIndices();
+
+        auto it = mShardOf.find(name);
+        if(it == mShardOf.end())
+            return false;
+
+        const auto& shard = Load(it->second);
+        auto fn           = shard.functions.find(name);
+        if(fn == shard.functions.end())
+            throw std::runtime_error("instance shard " + shard.name + " does not define " + name);
+        add_instances = fn->second;
+    }
+    // instances are created outside of the lock, only the lookup needs it
+    add_instances(instances);
+    return true;
+}
+
+std::vector<std::string> InstanceShardLoader::LoadedShards() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mLoadOrder;
+}
+
+} // namespace instance
+} // namespace device
+} // namespace tensor_operation
+} // namespace ck
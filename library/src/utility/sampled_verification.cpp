@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include "ck/library/utility/sampled_verification.hpp"
+
+namespace ck {
+namespace utils {
+
+namespace {
+
+std::vector<std::size_t> all_coordinates(std::size_t length)
+{
+    std::vector<std::size_t> coords(length);
+    std::iota(coords.begin(), coords.end(), std::size_t{0});
+    return coords;
+}
+
+} // namespace
+
+TensorIndices sample_indices(const std::vector<std::size_t>& lengths,
+                             const std::vector<std::vector<std::size_t>>& required,
+                             const SampledVerificationConfig& config)
+{
+    const std::size_t ndim = lengths.size();
+    if(required.size() != ndim)
+        throw std::runtime_error("sample_indices: required coordinates of the wrong rank");
+
+    std::vector<std::size_t> strides(ndim, 1);
+    for(std::size_t d = ndim; d-- > 1;)
+        strides[d - 1] = strides[d] * lengths[d];
+    const std::size_t size = ndim == 0 ? 1 : strides[0] * lengths[0];
+
+    TensorIndices indices;
+    if(size == 0)
+        return indices;
+
+    std::mt19937_64 gen(config.seed);
+
+    // required coordinates of every dimension: the given ones, the borders and the tile edges
+    std::vector<std::vector<std::size_t>> coords(ndim);
+    std::size_t num_required = 0;
+    for(std::size_t d = 0; d < ndim; ++d)
+    {
+        auto& c = coords[d];
+        for(std::size_t x : required[d])
+            if(x < lengths[d])
+                c.push_back(x);
+        c.push_back(0);
+        c.push_back(lengths[d] - 1);
+        for(std::size_t t = config.tile; config.tile > 0 && t < lengths[d]; t += config.tile)
+        {
+            c.push_back(t - 1);
+            c.push_back(t);
+        }
+        std::sort(c.begin(), c.end());
+        c.erase(std::unique(c.begin(), c.end()), c.end());
+        std::shuffle(c.begin(), c.end(), gen);
+        num_required = std::max(num_required, c.size());
+    }
+
+    if(size <= num_required + config.samples)
+    {
+        indices.reserve(size);
+        std::vector<std::size_t> idx(ndim, 0);
+        for(std::size_t i = 0; i < size; ++i)
+        {
+            indices.push_back(idx);
+            for(std::size_t d = ndim; d-- > 0;)
+            {
+                if(++idx[d] < lengths[d])
+                    break;
+                idx[d] = 0;
+            }
+        }
+        return indices;
+    }
+
+    // the j-th required element combines the j-th coordinate of every dimension, cycling through
+    // the shorter lists
+    std::vector<std::size_t> flat;
+    flat.reserve(num_required + config.samples);
+    for(std::size_t j = 0; j < num_required; ++j)
+    {
+        std::size_t offset = 0;
+        for(std::size_t d = 0; d < ndim; ++d)
+            offset += coords[d][j % coords[d].size()] * strides[d];
+        flat.push_back(offset);
+    }
+
+    // one element from each stratum [size * j / n, size * (j + 1) / n)
+    const std::size_t n = config.samples;
+    for(std::size_t j = 0; j < n; ++j)
+    {
+        const std::size_t begin = static_cast<std::size_t>(static_cast<double>(size) * j / n);
+        const std::size_t end =
+            std::max(begin + 1, static_cast<std::size_t>(static_cast<double>(size) * (j + 1) / n));
+        flat.push_back(std::uniform_int_distribution<std::size_t>(begin, end - 1)(gen));
+    }
+
+    std::sort(flat.begin(), flat.end());
+    flat.erase(std::unique(flat.begin(), flat.end()), flat.end());
+
+    indices.reserve(flat.size());
+    for(std::size_t offset : flat)
+    {
+        std::vector<std::size_t> idx(ndim);
+        for(std::size_t d = 0; d < ndim; ++d)
+        {
+            idx[d] = offset / strides[d];
+            offset -= idx[d] * strides[d];
+        }
+        indices.push_back(std::move(idx));
+    }
+    return indices;
+}
+
+TensorIndices make_verify_indices(int do_verification,
+                                  const std::vector<std::size_t>& lengths,
+                                  const std::vector<std::vector<std::size_t>>& required,
+                                  const std::string& elements)
+{
+    if(do_verification != 2)
+        return {};
+
+    auto indices = sample_indices(lengths, required, SampledVerificationConfig::FromEnv());
+
+    const std::size_t size = std::accumulate(
+        lengths.begin(), lengths.end(), std::size_t{1}, std::multiplies<std::size_t>{});
+    std::cout << "verifying " << indices.size() << " of " << size << " " << elements << std::endl;
+    return indices;
+}
+
+namespace conv {
+
+std::vector<std::vector<std::size_t>> get_fwd_required_coordinates(const ConvParam& param)
+{
+    std::vector<std::vector<std::size_t>> coords(param.num_dim_spatial_ + 3);
+    coords[0] = all_coordinates(param.G_);
+
+    for(ck::index_t s = 0; s < param.num_dim_spatial_; ++s)
+    {
+        const ck::long_index_t Wi = param.input_spatial_lengths_[s];
+        const ck::long_index_t Wo = param.output_spatial_lengths_[s];
+        const ck::long_index_t X  = param.filter_spatial_lengths_[s];
+
+        for(ck::long_index_t wo = 0; wo < Wo; ++wo)
+            for(ck::long_index_t x = 0; x < X; ++x)
+            {
+                const ck::long_index_t wi = wo * param.conv_filter_strides_[s] +
+                                            x * param.conv_filter_dilations_[s] -
+                                            param.input_left_pads_[s];
+                if(wi < 0 || wi >= Wi)
+                {
+                    coords[3 + s].push_back(wo);
+                    break;
+                }
+            }
+    }
+    return coords;
+}
+
+std::vector<std::vector<std::size_t>> get_bwd_data_required_coordinates(const ConvParam& param)
+{
+    std::vector<std::vector<std::size_t>> coords(param.num_dim_spatial_ + 3);
+    coords[0] = all_coordinates(param.G_);
+
+    for(ck::index_t s = 0; s < param.num_dim_spatial_; ++s)
+    {
+        const ck::long_index_t Wi = param.input_spatial_lengths_[s];
+        const ck::long_index_t Wo = param.output_spatial_lengths_[s];
+        const ck::long_index_t X  = param.filter_spatial_lengths_[s];
+
+        for(ck::long_index_t wi = 0; wi < Wi; ++wi)
+        {
+            bool outside = false;
+            bool reached = false;
+            for(ck::long_index_t x = 0; x < X; ++x)
+            {
+                const ck::long_index_t w_tmp =
+                    wi + param.input_left_pads_[s] - x * param.conv_filter_dilations_[s];
+                if(w_tmp % param.conv_filter_strides_[s] != 0)
+                    continue;
+
+                const ck::long_index_t wo = w_tmp / param.conv_filter_strides_[s];
+                if(wo < 0 || wo >= Wo)
+                    outside = true;
+                else
+                    reached = true;
+            }
+            if(outside || !reached)
+                coords[3 + s].push_back(wi);
+        }
+    }
+    return coords;
+}
+
+std::vector<std::vector<std::size_t>> get_bwd_weight_required_coordinates(const ConvParam& param)
+{
+    std::vector<std::vector<std::size_t>> coords(param.num_dim_spatial_ + 3);
+    coords[0] = all_coordinates(param.G_);
+
+    for(ck::index_t s = 0; s < param.num_dim_spatial_; ++s)
+        coords[3 + s] = all_coordinates(param.filter_spatial_lengths_[s]);
+    return coords;
+}
+
+} // namespace conv
+} // namespace utils
+} // namespace ck
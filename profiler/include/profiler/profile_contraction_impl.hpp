@@ -23,6 +23,7 @@
 #include "ck/library/utility/literals.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_contraction.hpp"
 #include "ck/library/utility/numeric.hpp"
+#include "ck/library/utility/sampled_verification.hpp"
 
 #include "ck/host_utility/io.hpp"
 
@@ -142,6 +143,13 @@ int profile_contraction_impl(ck::index_t do_verification,
     using AccDataType =
         typename std::conditional<std::is_same<ComputeDataType, F64>::value, F64, F32>::type;
 
+    // verification mode 2 computes and compares a sample of the output elements only
+    const auto verify_indices = ck::utils::make_verify_indices(
+        do_verification,
+        e_m_n_host_result.GetLengths(),
+        std::vector<std::vector<std::size_t>>(e_m_n_host_result.GetNumOfDimension()),
+        "output elements");
+
     // Run reference op
     if(do_verification)
     {
@@ -165,9 +173,7 @@ int profile_contraction_impl(ck::index_t do_verification,
         auto ref_argument =
             ref_op.MakeArgument(a_m_k, b_n_k, c_m_n_host_result, a_element_op, b_element_op);
 
-        ref_invoker.Run(ref_argument);
-
-        e_m_n_host_result.ForEach([&](auto& self, auto idx) {
+        auto f_cde = [&](auto& self, auto idx) {
             if constexpr(is_same<CDElementOp, Bilinear>::value)
             {
                 cde_element_op(self(idx), c_m_n_host_result(idx), d_m_n(idx));
@@ -180,7 +186,14 @@ int profile_contraction_impl(ck::index_t do_verification,
             {
                 static_assert("Unsupported CDElementOp in contraction profiler.");
             }
-        });
+        };
+
+        ck::utils::run_reference(ref_invoker, ref_argument, verify_indices);
+        if(verify_indices.empty())
+            e_m_n_host_result.ForEach(f_cde);
+        else
+            for(const auto& idx : verify_indices)
+                f_cde(e_m_n_host_result, idx);
     }
 
     std::string best_op_name;
@@ -302,11 +315,12 @@ int profile_contraction_impl(ck::index_t do_verification,
                     threshold += epsilon * 2;
                 }
 
-                pass = pass & ck::utils::check_err(e_m_n_device_result,
-                                                   e_m_n_host_result,
-                                                   "Error: incorrect results!",
-                                                   threshold,
-                                                   threshold);
+                pass = pass & ck::utils::check_err_sampled(e_m_n_device_result,
+                                                           e_m_n_host_result,
+                                                           verify_indices,
+                                                           "Error: incorrect results!",
+                                                           threshold,
+                                                           threshold);
 
                 if(do_log)
                 {
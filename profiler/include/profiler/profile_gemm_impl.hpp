@@ -9,6 +9,7 @@
 #include <unistd.h>
 
 #include "ck/ck.hpp"
+#include "ck/host_utility/host_trace.hpp"
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/tensor_operation/gpu/device/device_gemm.hpp"
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
@@ -16,6 +17,7 @@
 #include "ck/library/tensor_operation_instance/gpu/gemm.hpp"
 
 #include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/check_gemm_freivalds.hpp"
 #include "ck/library/utility/device_memory.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
@@ -112,13 +114,15 @@ int profile_gemm_impl(int do_verification,
                                                               CElementOp>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto op_ptrs = CK_TRACE_CALL(
+        "GetInstances",
+        ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
+            DeviceOp>::GetInstances());
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
-    // Run reference op
-    if(do_verification)
+    // Run reference op, unless the results are checked with randomized projections instead
+    if(do_verification == 1)
     {
         using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
                                                                                 BDataType,
@@ -144,7 +148,8 @@ int profile_gemm_impl(int do_verification,
     // profile device op instances
     for(auto& op_ptr : op_ptrs)
     {
-        auto argument_ptr =
+        auto argument_ptr = CK_TRACE_CALL(
+            "MakeArgumentPointer",
             op_ptr->MakeArgumentPointer(static_cast<ADataType*>(a_device_buf.GetDeviceBuffer()),
                                         static_cast<BDataType*>(b_device_buf.GetDeviceBuffer()),
                                         static_cast<CDataType*>(c_device_buf.GetDeviceBuffer()),
@@ -156,16 +161,16 @@ int profile_gemm_impl(int do_verification,
                                         StrideC,
                                         a_element_op,
                                         b_element_op,
-                                        c_element_op);
+                                        c_element_op));
 
-        auto invoker_ptr = op_ptr->MakeInvokerPointer();
+        auto invoker_ptr = CK_TRACE_CALL("MakeInvokerPointer", op_ptr->MakeInvokerPointer());
 
-        if(op_ptr->IsSupportedArgument(argument_ptr.get()))
+        if(CK_TRACE_CALL("IsSupportedArgument", op_ptr->IsSupportedArgument(argument_ptr.get())))
         {
             // re-init C to zero before profiling next kernel
             c_device_buf.SetZero();
 
-            std::string op_name = op_ptr->GetTypeString();
+            std::string op_name = CK_TRACE_CALL("GetTypeString", op_ptr->GetTypeString());
 
             float avg_time = invoker_ptr->Run(
                 argument_ptr.get(), StreamConfig{nullptr, time_kernel, 0, n_warmup, n_iter});
@@ -192,7 +197,11 @@ int profile_gemm_impl(int do_verification,
             {
                 c_device_buf.FromDevice(c_m_n_device_result.mData.data());
 
-                pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
+                if(do_verification == 2)
+                    pass = pass & ck::utils::check_gemm_freivalds<AccDataType>(
+                                      a_m_k, b_k_n, c_m_n_device_result);
+                else
+                    pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
 
                 if(do_log)
                 {
@@ -151,6 +151,11 @@ bool profile_gemm_splitk_impl(int do_verification,
         {
             kbatch_list = {KBatch};
         }
+        else if(KBatch < 0)
+        {
+            // split factor picked by the instance's split-K model
+            kbatch_list = {op_ptr->GetOptimalKBatch(M, N, K)};
+        }
 
         for(std::size_t i = 0; i < kbatch_list.size(); i++)
         {
@@ -8,6 +8,7 @@
 #include <typeinfo>
 
 #include "ck/ck.hpp"
+#include "ck/host_utility/host_trace.hpp"
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/tensor_operation/gpu/device/impl/device_gemm_xdl_cshuffle_v3.hpp"
 #include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
@@ -15,6 +16,7 @@
 #include "ck/library/tensor_operation_instance/gpu/gemm_universal.hpp"
 
 #include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/check_gemm_freivalds.hpp"
 #include "ck/library/utility/device_memory.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/host_tensor_generator.hpp"
@@ -116,13 +118,15 @@ bool profile_gemm_universal_impl(int do_verification,
                                                                 CElementOp>;
 
     // get device op instances
-    const auto op_ptrs = ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
-        DeviceOp>::GetInstances();
+    const auto op_ptrs = CK_TRACE_CALL(
+        "GetInstances",
+        ck::tensor_operation::device::instance::DeviceOperationInstanceFactory<
+            DeviceOp>::GetInstances());
 
     std::cout << "found " << op_ptrs.size() << " instances" << std::endl;
 
-    // Run reference GEMM
-    if(do_verification)
+    // Run reference GEMM, unless the results are checked with randomized projections instead
+    if(do_verification == 1)
     {
         using ReferenceGemmInstance = ck::tensor_operation::host::ReferenceGemm<ADataType,
                                                                                 BDataType,
@@ -161,7 +165,8 @@ bool profile_gemm_universal_impl(int do_verification,
         {
             auto kbatch_curr = kbatch_list[i];
 
-            auto argument_ptr =
+            auto argument_ptr = CK_TRACE_CALL(
+                "MakeArgumentPointer",
                 op_ptr->MakeArgumentPointer(static_cast<ADataType*>(a_device_buf.GetDeviceBuffer()),
                                             static_cast<BDataType*>(b_device_buf.GetDeviceBuffer()),
                                             static_cast<CDataType*>(c_device_buf.GetDeviceBuffer()),
@@ -174,11 +179,12 @@ bool profile_gemm_universal_impl(int do_verification,
                                             kbatch_curr,
                                             a_element_op,
                                             b_element_op,
-                                            c_element_op);
+                                            c_element_op));
 
-            auto invoker_ptr = op_ptr->MakeInvokerPointer();
+            auto invoker_ptr = CK_TRACE_CALL("MakeInvokerPointer", op_ptr->MakeInvokerPointer());
 
-            if(op_ptr->IsSupportedArgument(argument_ptr.get()))
+            if(CK_TRACE_CALL("IsSupportedArgument",
+                             op_ptr->IsSupportedArgument(argument_ptr.get())))
             {
 
                 // re-init C to zero before profiling next kernel
@@ -191,7 +197,30 @@ bool profile_gemm_universal_impl(int do_verification,
                 {
                     c_device_buf.FromDevice(c_m_n_device_result.mData.data());
 
-                    pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
+                    if(do_verification == 2)
+                    {
+                        // every split-K batch adds its rounded partial result to C
+                        auto config        = ck::utils::FreivaldsConfig::FromEnv();
+                        config.c_roundings = kbatch_curr;
+#if defined CK_ENABLE_FP8
+                        // set softer tolerances for fp8
+                        if constexpr(is_same_v<ADataType, f8_t> || is_same_v<BDataType, f8_t> ||
+                                     is_same_v<CDataType, f8_t>)
+                            pass = pass & ck::utils::check_gemm_freivalds<AccDataType>(
+                                              a_m_k,
+                                              b_k_n,
+                                              c_m_n_device_result,
+                                              config,
+                                              "Error: Incorrect results!",
+                                              1e-1,
+                                              1e-1);
+                        else
+#endif
+                            pass = pass & ck::utils::check_gemm_freivalds<AccDataType>(
+                                              a_m_k, b_k_n, c_m_n_device_result, config);
+                    }
+                    else
+                        pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
 
                     if(do_log)
                     {
@@ -206,7 +235,7 @@ bool profile_gemm_universal_impl(int do_verification,
                     }
                 }
 
-                std::string op_name = op_ptr->GetTypeString();
+                std::string op_name = CK_TRACE_CALL("GetTypeString", op_ptr->GetTypeString());
 
                 float ave_time = invoker_ptr->Run(argument_ptr.get(),
                                                   StreamConfig{nullptr,
@@ -230,24 +259,28 @@ bool profile_gemm_universal_impl(int do_verification,
                           << " TFlops, " << gb_per_sec << " GB/s, " << op_name << ", KBatch "
                           << kbatch_curr << std::endl;
 
-#if defined CK_ENABLE_FP8
-                // set softer tolerances for fp8
-                if constexpr(is_same_v<ADataType, f8_t> || is_same_v<BDataType, f8_t> ||
-                             is_same_v<CDataType, f8_t>)
-                {
-                    std::string msg = "Error: Incorrect results!";
-                    double rtol     = 1e-1;
-                    double atol     = 1e-1;
-                    pass            = pass & ck::utils::check_err(
-                                      c_m_n_device_result, c_m_n_host_result, msg, rtol, atol);
-                }
-                else
+                // the randomized check has no host result to compare with
+                if(do_verification != 2)
                 {
+#if defined CK_ENABLE_FP8
+                    // set softer tolerances for fp8
+                    if constexpr(is_same_v<ADataType, f8_t> || is_same_v<BDataType, f8_t> ||
+                                 is_same_v<CDataType, f8_t>)
+                    {
+                        std::string msg = "Error: Incorrect results!";
+                        double rtol     = 1e-1;
+                        double atol     = 1e-1;
+                        pass            = pass & ck::utils::check_err(
+                                          c_m_n_device_result, c_m_n_host_result, msg, rtol, atol);
+                    }
+                    else
+                    {
 #endif
-                    pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
+                        pass = pass & ck::utils::check_err(c_m_n_device_result, c_m_n_host_result);
 #if defined CK_ENABLE_FP8
-                }
+                    }
 #endif
+                }
 
                 if(tflops > best_tflops)
                 {
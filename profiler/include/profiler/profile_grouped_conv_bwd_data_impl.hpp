@@ -17,6 +17,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/utility/sampled_verification.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_data.hpp"
 #include "ck/library/tensor_operation_instance/gpu/grouped_convolution_backward_data.hpp"
 
@@ -88,6 +89,13 @@ bool profile_grouped_conv_bwd_data_impl(int do_verification,
     // reset input to zero
     in_device_buf.SetZero();
 
+    // verification mode 2 computes and compares a sample of the input gradient elements only
+    const auto verify_indices = ck::utils::make_verify_indices(
+        do_verification,
+        in_host.GetLengths(),
+        ck::utils::conv::get_bwd_data_required_coordinates(conv_param),
+        "input elements");
+
     if(do_verification)
     {
         auto ref_conv = ck::tensor_operation::host::ReferenceConvBwdData<NDimSpatial,
@@ -113,7 +121,7 @@ bool profile_grouped_conv_bwd_data_impl(int do_verification,
                                                   wei_element_op,
                                                   in_element_op);
 
-        ref_invoker.Run(ref_argument);
+        ck::utils::run_reference(ref_invoker, ref_argument, verify_indices);
     }
 
     std::string best_op_name;
@@ -159,7 +167,7 @@ bool profile_grouped_conv_bwd_data_impl(int do_verification,
             {
                 in_device_buf.FromDevice(in_device.mData.data());
 
-                pass = pass & ck::utils::check_err(in_device, in_host);
+                pass = pass & ck::utils::check_err_sampled(in_device, in_host, verify_indices);
 
                 if(do_log)
                 {
@@ -22,6 +22,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/utility/sampled_verification.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_weight.hpp"
 
 namespace ck {
@@ -89,6 +90,13 @@ bool profile_grouped_conv_bwd_weight_impl(int do_verification,
     in_device_buf.ToDevice(input.mData.data());
     out_device_buf.ToDevice(output.mData.data());
 
+    // verification mode 2 computes and compares a sample of the weight gradient elements only
+    const auto verify_indices = ck::utils::make_verify_indices(
+        do_verification,
+        weight_host_result.GetLengths(),
+        ck::utils::conv::get_bwd_weight_required_coordinates(conv_param),
+        "weight elements");
+
     if(do_verification)
     {
         auto ref_conv     = ck::tensor_operation::host::ReferenceConvBwdWeight<NDimSpatial,
@@ -113,7 +121,7 @@ bool profile_grouped_conv_bwd_weight_impl(int do_verification,
                                                   {},
                                                   {});
 
-        ref_invoker.Run(ref_argument);
+        ck::utils::run_reference(ref_invoker, ref_argument, verify_indices);
     }
 
     using DeviceOp = ck::tensor_operation::device::DeviceGroupedConvBwdWeight<NDimSpatial,
@@ -225,7 +233,8 @@ bool profile_grouped_conv_bwd_weight_impl(int do_verification,
             {
                 wei_device_buf.FromDevice(weight_device_result.mData.data());
 
-                bool pass = ck::utils::check_err(weight_device_result, weight_host_result);
+                bool pass = ck::utils::check_err_sampled(
+                    weight_device_result, weight_host_result, verify_indices);
 
                 if(!pass)
                 {
@@ -20,6 +20,7 @@
 #include "ck/library/utility/host_tensor_generator.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/utility/sampled_verification.hpp"
 #include "ck/library/reference_tensor_operation/cpu/reference_conv_fwd.hpp"
 
 namespace ck {
@@ -109,6 +110,13 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
     in_device_buf.ToDevice(input.mData.data());
     wei_device_buf.ToDevice(weight.mData.data());
 
+    // verification mode 2 computes and compares a sample of the output elements only
+    const auto verify_indices = ck::utils::make_verify_indices(
+        do_verification,
+        host_output.GetLengths(),
+        ck::utils::conv::get_fwd_required_coordinates(conv_param),
+        "output elements");
+
     // run reference op
     if(do_verification)
     {
@@ -135,7 +143,7 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
         // init host output to zero
         host_output.SetZero();
 
-        ref_invoker.Run(ref_argument);
+        ck::utils::run_reference(ref_invoker, ref_argument, verify_indices);
     }
 
     std::string best_op_name;
@@ -181,7 +189,8 @@ bool profile_grouped_conv_fwd_impl(int do_verification,
             {
                 out_device_buf.FromDevice(device_output.mData.data());
 
-                pass = pass & ck::utils::check_err(device_output, host_output);
+                pass = pass &
+                       ck::utils::check_err_sampled(device_output, host_output, verify_indices);
 
                 if(do_log)
                 {
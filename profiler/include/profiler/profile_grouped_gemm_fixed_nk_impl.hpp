@@ -13,6 +13,7 @@
 #include "ck/library/tensor_operation_instance/gpu/grouped_gemm_fixed_nk.hpp"
 
 #include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/check_gemm_abft.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/device_memory.hpp"
 #include "ck/library/utility/host_tensor.hpp"
@@ -196,7 +197,7 @@ bool profile_grouped_gemm_fixed_nk_impl(int do_verification,
 
     auto p_ds = std::vector<std::array<const void*, 0>>{};
 
-    if(do_verification)
+    if(do_verification == 1)
     {
         for(std::size_t i = 0; i < gemm_descs.size(); i++)
         {
@@ -279,26 +280,14 @@ bool profile_grouped_gemm_fixed_nk_impl(int do_verification,
                 if(do_verification)
                 {
                     bool instance_pass = true;
+
+                    ck::utils::AbftConfig abft_config;
+                    abft_config.c_roundings = kbatch_curr;
+
                     for(std::size_t i = 0; i < gemm_descs.size(); i++)
                     {
-
                         c_device_buf[i]->FromDevice(c_m_n_device_results[i].mData.data());
 
-                        if(std::is_same_v<CDataType, ck::half_t> && kbatch_curr > 1)
-                        {
-                            instance_pass =
-                                instance_pass && ck::utils::check_err(c_m_n_device_results[i],
-                                                                      c_m_n_host_results[i],
-                                                                      "Error: Incorrect results!",
-                                                                      0.06);
-                        }
-                        else
-                        {
-                            instance_pass =
-                                instance_pass && ck::utils::check_err(c_m_n_device_results[i],
-                                                                      c_m_n_host_results[i]);
-                        }
-
                         if(do_log)
                         {
                             LogRangeAsType<float>(std::cout << "a : ", a_m_k[i].mData, ",")
@@ -314,6 +303,26 @@ bool profile_grouped_gemm_fixed_nk_impl(int do_verification,
                         }
                     }
 
+                    // mode 2 checks the checksums of every group instead of its reference result
+                    if(std::is_same_v<CDataType, ck::half_t> && kbatch_curr > 1)
+                        instance_pass = ck::utils::check_grouped_gemm_abft<AccDataType>(
+                            do_verification == 2,
+                            a_m_k,
+                            b_k_n,
+                            c_m_n_device_results,
+                            c_m_n_host_results,
+                            abft_config,
+                            "Error: Incorrect results!",
+                            0.06);
+                    else
+                        instance_pass =
+                            ck::utils::check_grouped_gemm_abft<AccDataType>(do_verification == 2,
+                                                                            a_m_k,
+                                                                            b_k_n,
+                                                                            c_m_n_device_results,
+                                                                            c_m_n_host_results,
+                                                                            abft_config);
+
                     std::cout << "Instance: " << gemm_name << " verification "
                               << (instance_pass ? "SUCCEED" : "FAILED") << std::endl;
 
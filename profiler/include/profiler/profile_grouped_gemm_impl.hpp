@@ -6,6 +6,7 @@
 #include <iomanip>
 
 #include "ck/ck.hpp"
+#include "ck/host_utility/host_trace.hpp"
 #include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
 #include "ck/tensor_operation/gpu/device/device_grouped_gemm.hpp"
 #include "ck/tensor_operation/gpu/device/device_grouped_gemm_splitk.hpp"
@@ -14,6 +15,7 @@
 #include "ck/library/tensor_operation_instance/gpu/grouped_gemm.hpp"
 
 #include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/check_gemm_abft.hpp"
 #include "ck/library/utility/convolution_parameter.hpp"
 #include "ck/library/utility/device_memory.hpp"
 #include "ck/library/utility/host_tensor.hpp"
@@ -180,7 +182,7 @@ bool profile_grouped_gemm_impl(int do_verification,
 
     auto p_ds = std::vector<std::array<const void*, 0>>{};
 
-    if(do_verification)
+    if(do_verification == 1)
     {
         for(std::size_t i = 0; i < gemm_descs.size(); i++)
         {
@@ -209,7 +211,8 @@ bool profile_grouped_gemm_impl(int do_verification,
     // profile device GEMM instances
     for(auto& gemm_ptr : op_ptrs)
     {
-        auto argument_ptr =
+        auto argument_ptr = CK_TRACE_CALL(
+            "MakeArgumentPointer",
             gemm_ptr->MakeArgumentPointer(p_a,
                                           p_b,
                                           p_ds,
@@ -217,14 +220,16 @@ bool profile_grouped_gemm_impl(int do_verification,
                                           gemm_descs,
                                           ck::tensor_operation::element_wise::PassThrough{},
                                           ck::tensor_operation::element_wise::PassThrough{},
-                                          ck::tensor_operation::element_wise::PassThrough{});
+                                          ck::tensor_operation::element_wise::PassThrough{}));
 
-        auto invoker_ptr = gemm_ptr->MakeInvokerPointer();
+        auto invoker_ptr = CK_TRACE_CALL("MakeInvokerPointer", gemm_ptr->MakeInvokerPointer());
 
-        DeviceMem gemm_desc_workspace(gemm_ptr->GetWorkSpaceSize(argument_ptr.get()));
+        DeviceMem gemm_desc_workspace(
+            CK_TRACE_CALL("GetWorkSpaceSize", gemm_ptr->GetWorkSpaceSize(argument_ptr.get())));
+        CK_TRACE_COUNTER("GroupedGemmWorkSpaceBytes", gemm_desc_workspace.GetBufferSize());
 
         gemm_ptr->SetWorkSpacePointer(argument_ptr.get(), gemm_desc_workspace.GetDeviceBuffer());
-        std::string gemm_name = gemm_ptr->GetTypeString();
+        std::string gemm_name = CK_TRACE_CALL("GetTypeString", gemm_ptr->GetTypeString());
 
         using DeviceOpSplitK = ck::tensor_operation::device::DeviceGroupedGemmSplitK<ALayout,
                                                                                      BLayout,
@@ -259,7 +264,8 @@ bool profile_grouped_gemm_impl(int do_verification,
             dynamic_cast<DeviceOpSplitK*>(gemm_ptr.get())
                 ->SetKBatchSize(argument_ptr.get(), kbatch_curr);
 
-            if(gemm_ptr->IsSupportedArgument(argument_ptr.get()))
+            if(CK_TRACE_CALL("IsSupportedArgument",
+                             gemm_ptr->IsSupportedArgument(argument_ptr.get())))
             {
                 for(std::size_t i = 0; i < gemm_descs.size(); i++)
                     c_device_buf[i]->SetZero();
@@ -270,26 +276,14 @@ bool profile_grouped_gemm_impl(int do_verification,
                 if(do_verification)
                 {
                     bool instance_pass = true;
+
+                    ck::utils::AbftConfig abft_config;
+                    abft_config.c_roundings = kbatch_curr;
+
                     for(std::size_t i = 0; i < gemm_descs.size(); i++)
                     {
-
                         c_device_buf[i]->FromDevice(c_m_n_device_results[i].mData.data());
 
-                        if(std::is_same_v<CDataType, ck::half_t> && kbatch_curr > 1)
-                        {
-                            instance_pass =
-                                instance_pass && ck::utils::check_err(c_m_n_device_results[i],
-                                                                      c_m_n_host_results[i],
-                                                                      "Error: Incorrect results!",
-                                                                      0.06);
-                        }
-                        else
-                        {
-                            instance_pass =
-                                instance_pass && ck::utils::check_err(c_m_n_device_results[i],
-                                                                      c_m_n_host_results[i]);
-                        }
-
                         if(do_log)
                         {
                             LogRangeAsType<float>(std::cout << "a : ", a_m_k[i].mData, ",")
@@ -305,6 +299,26 @@ bool profile_grouped_gemm_impl(int do_verification,
                         }
                     }
 
+                    // mode 2 checks the checksums of every group instead of its reference result
+                    if(std::is_same_v<CDataType, ck::half_t> && kbatch_curr > 1)
+                        instance_pass = ck::utils::check_grouped_gemm_abft<AccDataType>(
+                            do_verification == 2,
+                            a_m_k,
+                            b_k_n,
+                            c_m_n_device_results,
+                            c_m_n_host_results,
+                            abft_config,
+                            "Error: Incorrect results!",
+                            0.06);
+                    else
+                        instance_pass =
+                            ck::utils::check_grouped_gemm_abft<AccDataType>(do_verification == 2,
+                                                                            a_m_k,
+                                                                            b_k_n,
+                                                                            c_m_n_device_results,
+                                                                            c_m_n_host_results,
+                                                                            abft_config);
+
                     std::cout << "Instance: " << gemm_name << " verification "
                               << (instance_pass ? "SUCCEED" : "FAILED") << std::endl;
 
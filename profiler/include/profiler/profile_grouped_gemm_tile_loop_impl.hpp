@@ -14,6 +14,7 @@
 #include "ck/library/tensor_operation_instance/gpu/grouped_gemm_tile_loop.hpp"
 
 #include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/check_gemm_abft.hpp"
 #include "ck/library/utility/device_memory.hpp"
 #include "ck/library/utility/host_tensor.hpp"
 #include "ck/library/utility/literals.hpp"
@@ -193,7 +194,7 @@ bool profile_grouped_gemm_tile_loop_impl(int do_verification,
 
     auto p_ds = std::vector<std::array<const void*, 0>>{};
 
-    if(do_verification)
+    if(do_verification == 1)
     {
         for(std::size_t i = 0; i < gemm_descs.size(); i++)
         {
@@ -245,11 +246,12 @@ bool profile_grouped_gemm_tile_loop_impl(int do_verification,
             if(do_verification)
             {
                 bool instance_pass = true;
+
+                const ck::utils::AbftConfig abft_config;
+
                 for(std::size_t i = 0; i < gemm_descs.size(); i++)
                 {
                     c_device_buf[i]->FromDevice(c_m_n_device_results[i].mData.data());
-                    instance_pass = instance_pass && ck::utils::check_err(c_m_n_device_results[i],
-                                                                          c_m_n_host_results[i]);
 
                     if(do_log)
                     {
@@ -265,6 +267,15 @@ bool profile_grouped_gemm_tile_loop_impl(int do_verification,
                     }
                 }
 
+                // mode 2 checks the checksums of every group instead of its reference result
+                instance_pass =
+                    ck::utils::check_grouped_gemm_abft<AccDataType>(do_verification == 2,
+                                                                    a_m_k,
+                                                                    b_k_n,
+                                                                    c_m_n_device_results,
+                                                                    c_m_n_host_results,
+                                                                    abft_config);
+
                 std::cout << "Instance: " << gemm_name << " verification "
                           << (instance_pass ? "SUCCEED" : "FAILED") << std::endl;
 
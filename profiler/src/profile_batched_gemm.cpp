@@ -42,7 +42,7 @@ int profile_batched_gemm(int argc, char* argv[])
         printf("                     1: A[g, m, k] * B[g, n, k] = C[g, m, n];\n");
         printf("                     2: A[g, k, m] * B[g, k, n] = C[g, m, n];\n");
         printf("                     3: A[g, k, m] * B[g, n, k] = C[g, m, n])\n");
-        printf("arg4: verification (0: no; 1: yes)\n");
+        printf("arg4: verification (0: no; 1: yes; 2: randomized)\n");
         printf("arg5: initialization (0: no init; 1: integer value; 2: decimal value)\n");
         printf("arg6: print tensor value (0: no; 1: yes)\n");
         printf("arg7: time kernel (0=n0, 1=yes)\n");
@@ -53,7 +53,7 @@ int profile_batched_gemm(int argc, char* argv[])
 
     const auto data_type       = static_cast<GemmDataType>(std::stoi(argv[2]));
     const auto layout          = static_cast<GemmMatrixLayout>(std::stoi(argv[3]));
-    const bool do_verification = std::stoi(argv[4]);
+    const int do_verification  = std::stoi(argv[4]);
     const int init_method      = std::stoi(argv[5]);
     const bool do_log          = std::stoi(argv[6]);
     const bool time_kernel     = std::stoi(argv[7]);
@@ -28,7 +28,7 @@ static void print_helper_msg()
                  "D[m0, m1, n0, n1] = E[m0, m1, n0, n1];\n"
               << "                     3: A[k0, k1, m0, m1] * B[n0, n1, k0, k1] + "
                  "D[m0, m1, n0, n1] = E[m0, m1, n0, n1])\n"
-              << "arg6: verification (0: no; 1: yes)\n"
+              << "arg6: verification (0: no; 1: yes; 2: sampled)\n"
               << "arg7: initialization (0: no init; 1: integer value; 2: decimal "
               << "value)\n"
               << "arg8: print tensor value (0: no; 1: yes)\n"
@@ -54,7 +54,7 @@ int profile_contraction_bilinear(int argc, char* argv[])
     const auto compute_data_type  = static_cast<ContractionComputeDataType>(std::stoi(argv[3]));
     const ck::index_t NumDimMNK   = std::stoi(argv[4]);
     const auto layout             = static_cast<ContractionMatrixLayout>(std::stoi(argv[5]));
-    const bool do_verification    = std::stoi(argv[6]);
+    const int do_verification     = std::stoi(argv[6]);
     const ck::index_t init_method = std::stoi(argv[7]);
     const bool do_log             = std::stoi(argv[8]);
     const bool time_kernel        = std::stoi(argv[9]);
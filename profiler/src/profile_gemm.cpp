@@ -37,7 +37,7 @@ static void print_helper_msg()
               << "                     1: A[m, k] * B[n, k] = C[m, n];\n"
               << "                     2: A[k, m] * B[k, n] = C[m, n];\n"
               << "                     3: A[k, m] * B[n, k] = C[m, n])\n"
-              << "arg4: verification (0: no; 1: yes)\n"
+              << "arg4: verification (0: no; 1: yes; 2: randomized)\n"
               << "arg5: initialization (0: no init; 1: integer value; 2: decimal value)\n"
               << "arg6: print tensor value (0: no; 1: yes)\n"
               << "arg7: time kernel (0: no, 1: yes)\n"
@@ -58,7 +58,7 @@ int profile_gemm(int argc, char* argv[])
 
     const auto data_type       = static_cast<GemmDataType>(std::stoi(argv[2]));
     const auto layout          = static_cast<GemmMatrixLayout>(std::stoi(argv[3]));
-    const bool do_verification = std::stoi(argv[4]);
+    const int do_verification  = std::stoi(argv[4]);
     const int init_method      = std::stoi(argv[5]);
     const bool do_log          = std::stoi(argv[6]);
     const bool time_kernel     = std::stoi(argv[7]);
@@ -54,7 +54,7 @@ int profile_grouped_gemm_fixed_nk(int argc, char* argv[])
             << "arg2: data type (0: bf16@int8; 1: fp16; 2: fp16@fp8; 3: fp16@int8)\n"
             << "arg3: matrix layout (0: A[m, k] * B[k, n] = C[m, n];\n"
             << "                     1: A[m, k] * B[n, k] = C[m, n];\n"
-            << "arg4: verification (0: no; 1: yes)\n"
+            << "arg4: verification (0: no; 1: yes; 2: checksum)\n"
             << "arg5: initialization (0: no init; 1: integer value; 2: decimal value)\n"
             << "arg6: print tensor value (0: no; 1: yes)\n"
             << "arg7: time kernel (0=n0, 1=yes)\n"
@@ -71,7 +71,7 @@ int profile_grouped_gemm_fixed_nk(int argc, char* argv[])
 
     const auto data_type       = static_cast<GemmDataType>(std::stoi(argv[2]));
     const auto layout          = static_cast<GemmMatrixLayout>(std::stoi(argv[3]));
-    const bool do_verification = std::stoi(argv[4]);
+    const int do_verification  = std::stoi(argv[4]);
     const int init_method      = std::stoi(argv[5]);
     const bool do_log          = std::stoi(argv[6]);
     const bool time_kernel     = std::stoi(argv[7]);
@@ -1,21 +1,20 @@
 import logging
 import os
-import subprocess
-from dataclasses import fields, replace
+from collections import defaultdict
+from dataclasses import replace
 from functools import lru_cache, partial
-from typing import List
+from typing import Dict, List, Optional, Tuple
 
 from ..util import library_path
 
+from . import manifest
 from .op import CKGemmOperation
 
 log = logging.getLogger(__name__)
 
 
 def _ck_library_dir():
-    gemm_instances_path = os.path.join(
-        library_path(), "src", "tensor_operation_instance", "gpu", "gemm_universal"
-    )
+    gemm_instances_path = os.path.join(library_path(), manifest.INSTANCE_DIR)
     if not os.path.exists(gemm_instances_path):
         log.error("CK library path %s does not exist", gemm_instances_path)
         return None
@@ -62,17 +61,7 @@ def parse_instances(str_instances: List[str]) -> List[CKGemmOperation]:
                     i_current = i_next + 1
             if i_next == -1:
                 break
-        # pad with `None`s for the fields which are not defined in the instance
-        new_instance = CKGemmOperation(
-            *template_args,  # type: ignore[arg-type]
-            *((None,) * (len(fields(CKGemmOperation)) - len(template_args))),
-        )
-        # the last 2 template parameters are optional
-        # if they are absent, substitute them with default values from Universal Gemm C++ template declaration
-        if new_instance.a_compute_dtype is None:
-            new_instance.a_compute_dtype = new_instance.c_element_dtype
-        if new_instance.b_compute_dtype is None:
-            new_instance.b_compute_dtype = new_instance.c_element_dtype
+        new_instance = manifest.to_operation(template_args)
 
         op_instances.append(new_instance)
     return op_instances
@@ -137,27 +126,61 @@ def default_instances() -> List[CKGemmOperation]:
     ]
 
 
+def _cache_dir():
+    return os.path.join(
+        os.environ.get("XDG_CACHE_HOME", os.path.join(os.path.expanduser("~"), ".cache")),
+        "ck4inductor",
+    )
+
+
+def _load_library_instances(ck_library_dir: str) -> List[CKGemmOperation]:
+    """
+    Load the instance manifest, in order of preference
+    - from the path in CK_INDUCTOR_MANIFEST
+    - from the manifest shipped next to the instance sources, which setup.py writes into the
+      package
+    - from the per-user cache, keyed by the fingerprint of the instance sources;
+      on a miss the sources are scanned once and the result is cached
+    """
+    candidates = [
+        os.environ.get("CK_INDUCTOR_MANIFEST"),
+        os.path.join(ck_library_dir, manifest.MANIFEST_NAME),
+    ]
+    for path in candidates:
+        if path and os.path.exists(path):
+            ops = manifest.load_manifest(path)
+            if ops is not None:
+                log.debug("ck instance manifest: %s", path)
+                return ops
+
+    cached = os.path.join(
+        _cache_dir(), f"gemm_universal_{manifest.fingerprint(ck_library_dir)}.json"
+    )
+    ops = manifest.load_manifest(cached)
+    if ops is not None:
+        log.debug("ck instance manifest: %s", cached)
+        return ops
+
+    log.debug("scanning ck instances in %s", ck_library_dir)
+    data = manifest.build_manifest(ck_library_dir)
+    try:
+        os.makedirs(os.path.dirname(cached), exist_ok=True)
+        manifest.write_manifest(data, cached)
+    except OSError as e:
+        log.info("could not cache ck instance manifest %s: %s", cached, e)
+    return manifest.operations(data)
+
+
 @lru_cache(None)
 def gen_ops_library() -> List[CKGemmOperation]:
     """
-    Parse the Universal Gemm instances defined in the composable kernel library folder.
+    Universal Gemm instances defined in the composable kernel library folder.
     """
     ck_library_dir = _ck_library_dir()
     if not ck_library_dir:
         return []
 
-    grep_result = subprocess.run(
-        [
-            "grep",
-            "-inR",
-            "DeviceGemm_Xdl_CShuffleV3",
-            _ck_library_dir(),
-        ],
-        capture_output=True,
-        text=True,
-    )
-
-    op_instances = parse_instances(grep_result.stdout.strip().split("\n"))
+    op_instances = _load_library_instances(ck_library_dir)
 
     log.debug("ck instances from library: %d", len(op_instances))
 
@@ -198,6 +221,70 @@ def gen_ops_library() -> List[CKGemmOperation]:
     return substitute_instances
 
 
+@lru_cache(None)
+def _library_index() -> Dict[Tuple[str, ...], List[CKGemmOperation]]:
+    index: Dict[Tuple[str, ...], List[CKGemmOperation]] = defaultdict(list)
+    for op in gen_ops_library():
+        index[_layouts_and_dtypes(op)].append(op)
+    return index
+
+
+def _layouts_and_dtypes(op: CKGemmOperation) -> Tuple[str, ...]:
+    return (
+        op.a_layout,
+        op.b_layout,
+        op.c_layout,
+        op.a_element_dtype,
+        op.b_element_dtype,
+        op.c_element_dtype,
+    )
+
+
+def _supports_shape(op: CKGemmOperation, m, n, k) -> bool:
+    """
+    Shape checks of DeviceGemm_Xdl_CShuffleV3::IsSupportedArgument that do not depend on the
+    device; `None` stands for a dimension which is not known yet
+    """
+    spec = op.gemm_specialization.split("::")[-1]
+    for dim, size, per_block in (("M", m, op.m_per_block), ("N", n, op.n_per_block)):
+        if size is not None and size % per_block != 0 and dim not in spec:
+            return False
+    if k is not None and k % op.k_per_block != 0 and "K" not in spec:
+        return False
+
+    # padding does not relax the vector access widths
+    vector_dims = (
+        (m if op.a_layout == "Col" else k, op.a_block_transfer_src_scalar_per_vector),
+        (k if op.b_layout == "Col" else n, op.b_block_transfer_src_scalar_per_vector),
+        (
+            m if op.c_layout == "Col" else n,
+            op.c_shuffle_block_transfer_scalar_per_vector_n_per_block,
+        ),
+    )
+    return all(size is None or size % width == 0 for size, width in vector_dims)
+
+
+def gen_ops_for_problem(
+    a_layout: str,
+    b_layout: str,
+    c_layout: str,
+    a_dtype: str,
+    b_dtype: str,
+    c_dtype: str,
+    m: Optional[int] = None,
+    n: Optional[int] = None,
+    k: Optional[int] = None,
+) -> List[CKGemmOperation]:
+    """
+    Library instances matching the layouts and data types of a problem (C++ aliases, e.g. "Row"
+    and "F16"), with the instances which cannot run its shape filtered out
+    """
+    candidates = _library_index().get(
+        (a_layout, b_layout, c_layout, a_dtype, b_dtype, c_dtype), []
+    )
+    return [op for op in candidates if _supports_shape(op, m, n, k)]
+
+
 @lru_cache(None)
 def gen_ops_preselected() -> List[CKGemmOperation]:
     """
@@ -0,0 +1,216 @@
+"""
+Structured metadata manifest of the Universal Gemm instances defined in the CK instance library.
+
+The manifest is a JSON document listing the template parameters of every
+`DeviceGemm_Xdl_CShuffleV3` instance, as written in the instance headers (`GemmSpec` and
+`BlkGemmPipeSched` stay symbolic). It is produced by the CMake build (see
+library/src/tensor_operation_instance/gpu/gemm_universal/CMakeLists.txt), written into the
+python package by setup.py, and can be regenerated with
+
+    python -m ck4inductor.universal_gemm.manifest --library-dir <gemm_universal dir> -o <file>
+"""
+
+import argparse
+import hashlib
+import json
+import logging
+import os
+import re
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import astuple, fields
+from typing import Any, Dict, Iterable, List, Optional
+
+from .op import CKGemmOperation
+
+log = logging.getLogger(__name__)
+
+# bump whenever the layout of the manifest or the fields of CKGemmOperation change
+MANIFEST_VERSION = 1
+MANIFEST_NAME = "gemm_universal_instances.json"
+# the instance sources, and the manifest shipped with them, relative to the CK library dir
+INSTANCE_DIR = os.path.join("src", "tensor_operation_instance", "gpu", "gemm_universal")
+TEMPLATE_NAME = "DeviceGemm_Xdl_CShuffleV3"
+
+_COMMENT = re.compile(r"//[^\n]*|/\*.*?\*/", re.DOTALL)
+_TEMPLATE = re.compile(r"\b" + TEMPLATE_NAME + r"\s*<")
+
+
+def _split_template_args(text: str, begin: int):
+    """
+    Split the template argument list starting right after the `<` at text[begin - 1].
+    Returns the top level arguments and the position following the closing `>`.
+    """
+    args = []
+    depth = 0
+    current = begin
+    for i in range(begin, len(text)):
+        c = text[i]
+        if c == "<":
+            depth += 1
+        elif c == ">":
+            if depth == 0:
+                args.append(text[current:i])
+                return [a.strip() for a in args], i + 1
+            depth -= 1
+        elif c == "," and depth == 0:
+            args.append(text[current:i])
+            current = i + 1
+    raise ValueError("unterminated template argument list")
+
+
+def _parse_arg(arg: str):
+    if arg.startswith("S<"):
+        return tuple(int(i) for i in arg[2:-1].split(","))
+    try:
+        return int(arg)
+    except ValueError:
+        # all string attributes must be either type aliases or global constants in C++
+        return arg
+
+
+def scan_source(text: str) -> List[List[Any]]:
+    """
+    Template arguments of every instance in a C++ source, ignoring commented out instances
+    and independent of how the instance table is formatted
+    """
+    text = _COMMENT.sub("", text)
+    instances = []
+    pos = 0
+    while True:
+        match = _TEMPLATE.search(text, pos)
+        if match is None:
+            break
+        args, pos = _split_template_args(text, match.end())
+        instances.append([_parse_arg(a) for a in args])
+    return instances
+
+
+def to_operation(template_args: List[Any]) -> CKGemmOperation:
+    # pad with `None`s for the fields which are not defined in the instance
+    op = CKGemmOperation(
+        *template_args,  # type: ignore[arg-type]
+        *((None,) * (len(fields(CKGemmOperation)) - len(template_args))),
+    )
+    # the last 2 template parameters are optional
+    # if they are absent, substitute them with default values from Universal Gemm C++ template declaration
+    if op.a_compute_dtype is None:
+        op.a_compute_dtype = op.c_element_dtype
+    if op.b_compute_dtype is None:
+        op.b_compute_dtype = op.c_element_dtype
+    return op
+
+
+def _source_files(library_dir: str) -> List[str]:
+    paths = []
+    for root, _, files in os.walk(library_dir):
+        paths.extend(
+            os.path.join(root, f) for f in files if f.endswith((".hpp", ".cpp", ".inc"))
+        )
+    return sorted(paths)
+
+
+def fingerprint(library_dir: str) -> str:
+    """
+    Cheap identity of the instance sources (names, sizes and modification times), used to key
+    manifests cached outside of the build
+    """
+    h = hashlib.sha1(os.path.abspath(library_dir).encode())
+    for path in _source_files(library_dir):
+        st = os.stat(path)
+        h.update(f"{os.path.relpath(path, library_dir)}:{st.st_size}:{st.st_mtime_ns};".encode())
+    return h.hexdigest()
+
+
+def build_manifest(library_dir: str, jobs: Optional[int] = None) -> Dict[str, Any]:
+    def scan(path):
+        with open(path) as f:
+            return scan_source(f.read())
+
+    paths = _source_files(library_dir)
+    with ThreadPoolExecutor(max_workers=jobs) as pool:
+        per_file = list(pool.map(scan, paths))
+
+    names = [f.name for f in fields(CKGemmOperation)]
+    instances = []
+    seen = set()
+    for template_args in (args for file_args in per_file for args in file_args):
+        op = to_operation(template_args)
+        key = astuple(op)
+        if key in seen:
+            continue
+        seen.add(key)
+        instances.append(dict(zip(names, key)))
+
+    return {
+        "version": MANIFEST_VERSION,
+        "template": TEMPLATE_NAME,
+        "fingerprint": fingerprint(library_dir),
+        "instances": instances,
+    }
+
+
+def write_manifest(manifest: Dict[str, Any], path: str):
+    # publish atomically so that concurrent readers never see a partial manifest
+    tmp = f"{path}.{os.getpid()}.tmp"
+    with open(tmp, "w") as f:
+        json.dump(manifest, f, indent=1)
+    os.replace(tmp, path)
+
+
+def write_package_manifest(library_dir: str, package_dir: str) -> str:
+    """
+    Write the manifest of the instances under the CK library dir `library_dir` next to their
+    sources in the ck4inductor.library package at `package_dir`, where gen_instances looks first
+    """
+    path = os.path.join(package_dir, INSTANCE_DIR, MANIFEST_NAME)
+    os.makedirs(os.path.dirname(path), exist_ok=True)
+    write_manifest(build_manifest(os.path.join(library_dir, INSTANCE_DIR)), path)
+    return path
+
+
+def operations(manifest: Dict[str, Any]) -> Optional[List[CKGemmOperation]]:
+    """
+    The instances of a manifest, or None when it was written by an incompatible version
+    """
+    if manifest.get("version") != MANIFEST_VERSION or manifest.get("template") != TEMPLATE_NAME:
+        return None
+    names = {f.name for f in fields(CKGemmOperation)}
+    ops = []
+    for instance in manifest["instances"]:
+        if set(instance) != names:
+            return None
+        ops.append(
+            CKGemmOperation(
+                **{k: tuple(v) if isinstance(v, list) else v for k, v in instance.items()}
+            )
+        )
+    return ops
+
+
+def load_manifest(path: str) -> Optional[List[CKGemmOperation]]:
+    try:
+        with open(path) as f:
+            manifest = json.load(f)
+    except (OSError, ValueError):
+        return None
+    ops = operations(manifest)
+    if ops is None:
+        log.info("ignoring manifest %s with unsupported version", path)
+    return ops
+
+
+def main(argv: Optional[Iterable[str]] = None):
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("--library-dir", required=True, help="gemm_universal instance sources")
+    parser.add_argument("-o", "--output", required=True, help="manifest to write")
+    parser.add_argument("-j", "--jobs", type=int, default=None)
+    args = parser.parse_args(argv)
+
+    manifest = build_manifest(args.library_dir, args.jobs)
+    if not manifest["instances"]:
+        raise SystemExit(f"no {TEMPLATE_NAME} instances found in {args.library_dir}")
+    write_manifest(manifest, args.output)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,50 @@
+"""
+Tests of the ck4inductor instance manifest, run with
+
+    PYTHONPATH=python python -m unittest discover -s python/test
+"""
+
+import os
+import tempfile
+import unittest
+from unittest import mock
+
+from ck4inductor.universal_gemm import gen_instances, manifest
+
+LIBRARY_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..", "library")
+
+
+class TestPackagedManifest(unittest.TestCase):
+    def setUp(self):
+        gen_instances.gen_ops_library.cache_clear()
+        self.addCleanup(gen_instances.gen_ops_library.cache_clear)
+
+    def test_load_from_package(self):
+        with tempfile.TemporaryDirectory() as package_dir:
+            # the manifest as setup.py writes it into the wheel, without a build tree
+            path = manifest.write_package_manifest(LIBRARY_DIR, package_dir)
+            expected = manifest.load_manifest(path)
+            self.assertTrue(expected)
+
+            with mock.patch.object(
+                gen_instances, "library_path", return_value=package_dir
+            ), mock.patch.object(
+                manifest, "build_manifest", side_effect=AssertionError("scanned the sources")
+            ), mock.patch.dict(
+                os.environ, {"CK_INDUCTOR_MANIFEST": ""}
+            ):
+                ops = gen_instances._load_library_instances(gen_instances._ck_library_dir())
+                self.assertEqual(ops, expected)
+                self.assertGreaterEqual(len(gen_instances.gen_ops_library()), len(expected))
+
+    def test_package_path_matches_lookup(self):
+        with tempfile.TemporaryDirectory() as package_dir:
+            path = manifest.write_package_manifest(LIBRARY_DIR, package_dir)
+            with mock.patch.object(gen_instances, "library_path", return_value=package_dir):
+                self.assertEqual(
+                    path, os.path.join(gen_instances._ck_library_dir(), manifest.MANIFEST_NAME)
+                )
+
+
+if __name__ == "__main__":
+    unittest.main()
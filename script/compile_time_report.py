@@ -0,0 +1,99 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: MIT
+# Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+"""Summarize clang -ftime-trace output of a build tree.
+
+The test_compile_time target (test/compile_time) always writes traces; any other target can be
+traced by configuring with -DCMAKE_CXX_FLAGS=-ftime-trace. Typical use:
+
+    python3 script/compile_time_report.py build/test/compile_time --save before.json
+    # rebuild with the change
+    python3 script/compile_time_report.py build/test/compile_time --baseline before.json
+"""
+import argparse
+import json
+import os
+
+# clang emits one "Total <category>" event per category at the end of each trace
+CATEGORIES = ['Frontend', 'Backend', 'InstantiateClass', 'InstantiateFunction', 'ParseClass']
+
+
+def load_trace(path):
+    with open(path) as f:
+        try:
+            trace = json.load(f)
+        except ValueError:
+            return None
+    if not isinstance(trace, dict) or 'traceEvents' not in trace:
+        return None
+    totals = dict.fromkeys(CATEGORIES, 0.0)
+    for event in trace['traceEvents']:
+        name = event.get('name', '')
+        if name.startswith('Total ') and name[6:] in totals:
+            totals[name[6:]] += event.get('dur', 0) / 1000.0
+    return totals
+
+
+def collect(root):
+    results = {}
+    for dirpath, _, filenames in os.walk(root):
+        for name in filenames:
+            if not name.endswith('.json'):
+                continue
+            totals = load_trace(os.path.join(dirpath, name))
+            if totals is not None:
+                tu = os.path.relpath(os.path.join(dirpath, name), root)
+                results[tu] = totals
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Summarize clang -ftime-trace files (ms)')
+    parser.add_argument('build_dir', help='directory searched recursively for trace files')
+    parser.add_argument('--save', help='write the summary to this json file')
+    parser.add_argument('--baseline', help='summary written by --save to compare against')
+    parser.add_argument('--top', type=int, default=20, help='number of slowest TUs to list')
+    args = parser.parse_args()
+
+    results = collect(args.build_dir)
+    if not results:
+        print('no -ftime-trace files found under', args.build_dir)
+        return 1
+
+    baseline = {}
+    if args.baseline:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+
+    header = '{:>12} {:>12} {:>12} {:>10}  {}'.format(
+        'frontend', 'inst class', 'inst func', 'delta', 'translation unit')
+    print(header)
+    ordered = sorted(results.items(), key=lambda kv: -kv[1]['Frontend'])
+    for tu, totals in ordered[:args.top]:
+        delta = ''
+        if tu in baseline and baseline[tu]['Frontend'] > 0:
+            delta = '{:+.1f}%'.format(
+                100.0 * (totals['Frontend'] / baseline[tu]['Frontend'] - 1.0))
+        print('{:12.1f} {:12.1f} {:12.1f} {:>10}  {}'.format(
+            totals['Frontend'], totals['InstantiateClass'], totals['InstantiateFunction'],
+            delta, tu))
+
+    total = sum(t['Frontend'] for t in results.values())
+    line = 'total frontend {:.1f} ms over {} translation units'.format(total, len(results))
+    common = [tu for tu in results if tu in baseline]
+    if common:
+        before = sum(baseline[tu]['Frontend'] for tu in common)
+        after = sum(results[tu]['Frontend'] for tu in common)
+        if before > 0:
+            line += ', {:+.1f}% vs baseline on {} common units'.format(
+                100.0 * (after / before - 1.0), len(common))
+    print(line)
+
+    if args.save:
+        with open(args.save, 'w') as f:
+            json.dump(results, f, indent=1, sort_keys=True)
+    return 0
+
+
+if __name__ == '__main__':
+    raise SystemExit(main())
@@ -0,0 +1,27 @@
+import os
+import sys
+
+from setuptools import setup
+from setuptools.command.build_py import build_py
+
+ROOT = os.path.dirname(os.path.abspath(__file__))
+
+
+class build_py_with_manifest(build_py):
+    """
+    Also ship the manifest of the gemm_universal instances with the ck4inductor.library package,
+    so that ck4inductor does not scan the instance sources on first use
+    """
+
+    def run(self):
+        super().run()
+        sys.path.insert(0, os.path.join(ROOT, "python"))
+        from ck4inductor.universal_gemm import manifest
+
+        manifest.write_package_manifest(
+            os.path.join(ROOT, "library"),
+            os.path.join(self.build_lib, "ck4inductor", "library"),
+        )
+
+
+setup(cmdclass={"build_py": build_py_with_manifest})
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/check_gemm_abft.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "test/check_gemm_common/check_gemm_util.hpp"
+
+using ck::check_gemm_util::gemm;
+using ck::check_gemm_util::Problem;
+using ck::check_gemm_util::random_tensor;
+using ck::check_gemm_util::split_k_gemm;
+using ck::check_gemm_util::test_accepts_correct_results;
+using ck::utils::AbftConfig;
+using ck::utils::check_batched_gemm_abft;
+using ck::utils::check_gemm_abft;
+using ck::utils::check_grouped_gemm_abft;
+
+TEST(CheckGemmAbft, AcceptsCorrectResults)
+{
+    test_accepts_correct_results(
+        [](auto& a, auto& b, auto& c) { return check_gemm_abft<float>(a, b, c, AbftConfig{}); });
+}
+
+TEST(CheckGemmAbft, SplitK)
+{
+    std::mt19937 gen(2);
+    Problem<ck::half_t> p(96, 80, 2048, gen);
+    split_k_gemm<float>(p.a, p.b, p.c, 4);
+
+    AbftConfig config;
+    config.c_roundings = 4;
+    EXPECT_TRUE(
+        check_gemm_abft<float>(p.a, p.b, p.c, config, "Error: Incorrect results!", 0.06, 0.06));
+}
+
+TEST(CheckGemmAbft, IntegerResultsAreExact)
+{
+    std::mt19937 gen(3);
+    std::uniform_int_distribution<int> dist(-5, 5);
+    Tensor<int8_t> a({96, 80});
+    Tensor<int8_t> b({80, 112});
+    Tensor<int32_t> c({96, 112});
+    for(auto& v : a.mData)
+        v = static_cast<int8_t>(dist(gen));
+    for(auto& v : b.mData)
+        v = static_cast<int8_t>(dist(gen));
+    gemm<int32_t>(a, b, c);
+    EXPECT_TRUE(check_gemm_abft<int32_t>(a, b, c, AbftConfig{}));
+
+    // swapped elements of a row cancel in the plain row sum, but not in the ramp-weighted one
+    std::swap(c(17, 33), c(17, 90));
+    EXPECT_FALSE(check_gemm_abft<int32_t>(a, b, c, AbftConfig{}));
+}
+
+TEST(CheckGemmAbft, RejectsWrongElements)
+{
+    std::mt19937 gen(4);
+    Problem<ck::half_t> p(200, 150, 384, gen);
+
+    // a wrong element, a NaN, and a result with one tile missing
+    auto wrong = p.c;
+    wrong(123, 45) += ck::type_convert<ck::half_t>(0.5f);
+    EXPECT_FALSE(check_gemm_abft<float>(p.a, p.b, wrong, AbftConfig{}));
+
+    auto nan = p.c;
+    nan(7, 149) = ck::type_convert<ck::half_t>(std::numeric_limits<float>::quiet_NaN());
+    EXPECT_FALSE(check_gemm_abft<float>(p.a, p.b, nan, AbftConfig{}));
+
+    auto tile = p.c;
+    for(std::size_t m = 128; m < 160; ++m)
+        for(std::size_t n = 64; n < 96; ++n)
+            tile(m, n) = 0;
+    EXPECT_FALSE(check_gemm_abft<float>(p.a, p.b, tile, AbftConfig{}));
+
+    // too many mismatching rows and columns to recompute
+    auto zero = p.c;
+    zero.SetZero();
+    EXPECT_FALSE(check_gemm_abft<float>(p.a, p.b, zero, AbftConfig{}));
+}
+
+TEST(CheckGemmAbft, RecomputationClearsFalseAlarms)
+{
+    std::mt19937 gen(5);
+    Problem<float> p(64, 64, 256, gen);
+
+    // perturbed far below check_err's tolerance, but above a zero-width threshold
+    auto perturbed = p.c;
+    perturbed(10, 20) *= 1.f + 1e-6f;
+
+    AbftConfig strict;
+    strict.threshold = 0;
+    EXPECT_TRUE(check_gemm_abft<float>(p.a, p.b, perturbed, strict));
+}
+
+TEST(CheckGemmAbft, Batched)
+{
+    std::mt19937 gen(6);
+    const std::size_t G = 3, M = 40, N = 50, K = 60;
+    auto a = random_tensor<float>({G, M, K}, {M * K, K, 1}, gen);
+    auto b = random_tensor<float>({G, K, N}, {K * N, N, 1}, gen);
+    Tensor<float> c({G, M, N});
+    c.ForEach([&](auto& self, auto idx) {
+        float acc = 0;
+        for(std::size_t k = 0; k < K; ++k)
+            acc += a(idx[0], idx[1], k) * b(idx[0], k, idx[2]);
+        self(idx) = acc;
+    });
+    EXPECT_TRUE(check_batched_gemm_abft<float>(a, b, c, AbftConfig{}));
+
+    c(2, 39, 0) = -c(2, 39, 0) + 1.f;
+    EXPECT_FALSE(check_batched_gemm_abft<float>(a, b, c, AbftConfig{}));
+}
+
+TEST(CheckGemmAbft, Grouped)
+{
+    std::mt19937 gen(7);
+    std::vector<Tensor<float>> a, b, c;
+    for(auto [M, N, K] : {std::array<std::size_t, 3>{40, 50, 60},
+                          std::array<std::size_t, 3>{1, 33, 7},
+                          std::array<std::size_t, 3>{64, 16, 128}})
+    {
+        Problem<float> p(M, N, K, gen);
+        a.push_back(p.a);
+        b.push_back(p.b);
+        c.push_back(p.c);
+    }
+    const auto c_ref = c;
+
+    // checksums, and the comparison with the reference results
+    EXPECT_TRUE(check_grouped_gemm_abft<float>(true, a, b, c, c_ref, AbftConfig{}));
+    EXPECT_TRUE(check_grouped_gemm_abft<float>(false, a, b, c, c_ref, AbftConfig{}));
+
+    c[2](5, 9) += 1.f;
+    EXPECT_FALSE(check_grouped_gemm_abft<float>(true, a, b, c, c_ref, AbftConfig{}));
+    EXPECT_FALSE(check_grouped_gemm_abft<float>(false, a, b, c, c_ref, AbftConfig{}));
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <array>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_tensor.hpp"
+
+// Fixtures shared by the check_gemm_freivalds and check_gemm_abft tests
+
+namespace ck {
+namespace check_gemm_util {
+
+template <typename T>
+Tensor<T> random_tensor(const std::vector<std::size_t>& lengths,
+                        const std::vector<std::size_t>& strides,
+                        std::mt19937& gen)
+{
+    Tensor<T> t(lengths, strides);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    for(auto& v : t.mData)
+        v = ck::type_convert<T>(dist(gen));
+    return t;
+}
+
+// c = a * b with AccDataType accumulation, as a device GEMM computes it
+template <typename AccDataType, typename ADataType, typename BDataType, typename CDataType>
+void gemm(const Tensor<ADataType>& a, const Tensor<BDataType>& b, Tensor<CDataType>& c)
+{
+    const std::size_t K = a.GetLengths()[1];
+    c.ForEach([&](auto& self, auto idx) {
+        AccDataType acc = 0;
+        for(std::size_t k = 0; k < K; ++k)
+            acc += ck::type_convert<AccDataType>(a(idx[0], k)) *
+                   ck::type_convert<AccDataType>(b(k, idx[1]));
+        self(idx) = ck::type_convert<CDataType>(acc);
+    });
+}
+
+// c = a * b split into k_batch partial results, which are rounded to CDataType and accumulated in
+// c, as a split-K device GEMM computes it
+template <typename AccDataType, typename ADataType, typename BDataType, typename CDataType>
+void split_k_gemm(const Tensor<ADataType>& a,
+                  const Tensor<BDataType>& b,
+                  Tensor<CDataType>& c,
+                  std::size_t k_batch)
+{
+    const std::size_t K = a.GetLengths()[1];
+    c.ForEach([&](auto& self, auto idx) {
+        CDataType result = 0;
+        for(std::size_t kb = 0; kb < k_batch; ++kb)
+        {
+            AccDataType acc = 0;
+            for(std::size_t k = K * kb / k_batch; k < K * (kb + 1) / k_batch; ++k)
+                acc += ck::type_convert<AccDataType>(a(idx[0], k)) *
+                       ck::type_convert<AccDataType>(b(k, idx[1]));
+            result = ck::type_convert<CDataType>(ck::type_convert<AccDataType>(result) + acc);
+        }
+        self(idx) = result;
+    });
+}
+
+template <typename T>
+struct Problem
+{
+    // A row-major, B and C column-major
+    Problem(std::size_t M, std::size_t N, std::size_t K, std::mt19937& gen)
+        : a(random_tensor<T>({M, K}, {K, 1}, gen)),
+          b(random_tensor<T>({K, N}, {1, K}, gen)),
+          c(std::vector<std::size_t>{M, N}, std::vector<std::size_t>{1, M})
+    {
+        gemm<float>(a, b, c);
+    }
+
+    Tensor<T> a;
+    Tensor<T> b;
+    Tensor<T> c;
+};
+
+// check(a, b, c) accepts correct f32, f16 and bf16 results of a few shapes
+template <typename Check>
+void test_accepts_correct_results(Check check)
+{
+    std::mt19937 gen(1);
+    for(auto [M, N, K] : {std::array<std::size_t, 3>{1, 1, 1},
+                          std::array<std::size_t, 3>{64, 48, 512},
+                          std::array<std::size_t, 3>{127, 255, 1023}})
+    {
+        Problem<float> f32(M, N, K, gen);
+        EXPECT_TRUE(check(f32.a, f32.b, f32.c));
+
+        Problem<ck::half_t> f16(M, N, K, gen);
+        EXPECT_TRUE(check(f16.a, f16.b, f16.c));
+
+        Problem<ck::bhalf_t> bf16(M, N, K, gen);
+        EXPECT_TRUE(check(bf16.a, bf16.b, bf16.c));
+    }
+}
+
+} // namespace check_gemm_util
+} // namespace ck
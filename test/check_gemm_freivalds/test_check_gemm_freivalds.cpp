@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/check_gemm_freivalds.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "test/check_gemm_common/check_gemm_util.hpp"
+
+using ck::check_gemm_util::gemm;
+using ck::check_gemm_util::Problem;
+using ck::check_gemm_util::random_tensor;
+using ck::check_gemm_util::split_k_gemm;
+using ck::check_gemm_util::test_accepts_correct_results;
+using ck::utils::check_batched_gemm_freivalds;
+using ck::utils::check_gemm_freivalds;
+using ck::utils::FreivaldsConfig;
+
+TEST(CheckGemmFreivalds, AcceptsCorrectResults)
+{
+    test_accepts_correct_results(
+        [](auto& a, auto& b, auto& c) { return check_gemm_freivalds<float>(a, b, c); });
+}
+
+TEST(CheckGemmFreivalds, SplitK)
+{
+    std::mt19937 gen(8);
+    Problem<ck::half_t> p(96, 80, 2048, gen);
+    split_k_gemm<float>(p.a, p.b, p.c, 32);
+
+    // the rounding of every batch is within the model, without recomputing; the default
+    // threshold would also hide a few roundings of C that the model misses
+    FreivaldsConfig config;
+    config.threshold     = 4;
+    config.max_recompute = 0;
+    EXPECT_FALSE(check_gemm_freivalds<float>(p.a, p.b, p.c, config));
+
+    config.c_roundings = 32;
+    EXPECT_TRUE(check_gemm_freivalds<float>(p.a, p.b, p.c, config));
+}
+
+TEST(CheckGemmFreivalds, ForwardsCheckErrArgs)
+{
+    std::mt19937 gen(9);
+    Problem<float> p(64, 64, 256, gen);
+
+    // 1% off, which the recomputation only accepts with the tolerance passed on to check_err
+    auto perturbed = p.c;
+    perturbed(10, 20) *= 1.01f;
+    EXPECT_FALSE(check_gemm_freivalds<float>(p.a, p.b, perturbed, FreivaldsConfig{}));
+    EXPECT_TRUE(check_gemm_freivalds<float>(
+        p.a, p.b, perturbed, FreivaldsConfig{}, "Error: Incorrect results!", 1e-1, 1e-1));
+}
+
+TEST(CheckGemmFreivalds, IntegerResultsAreExact)
+{
+    std::mt19937 gen(2);
+    std::uniform_int_distribution<int> dist(-5, 5);
+    Tensor<int8_t> a({96, 80});
+    Tensor<int8_t> b({80, 112});
+    Tensor<int32_t> c({96, 112});
+    for(auto& v : a.mData)
+        v = static_cast<int8_t>(dist(gen));
+    for(auto& v : b.mData)
+        v = static_cast<int8_t>(dist(gen));
+    gemm<int32_t>(a, b, c);
+    EXPECT_TRUE(check_gemm_freivalds<int32_t>(a, b, c));
+
+    c(17, 33) += 1;
+    EXPECT_FALSE(check_gemm_freivalds<int32_t>(a, b, c));
+}
+
+TEST(CheckGemmFreivalds, RejectsWrongElements)
+{
+    std::mt19937 gen(3);
+    Problem<ck::half_t> p(200, 150, 384, gen);
+
+    // a wrong element, a NaN, and a result with one tile missing
+    auto wrong = p.c;
+    wrong(123, 45) += ck::type_convert<ck::half_t>(0.5f);
+    EXPECT_FALSE(check_gemm_freivalds<float>(p.a, p.b, wrong));
+
+    auto nan = p.c;
+    nan(7, 149) = ck::type_convert<ck::half_t>(std::numeric_limits<float>::quiet_NaN());
+    EXPECT_FALSE(check_gemm_freivalds<float>(p.a, p.b, nan));
+
+    auto tile = p.c;
+    for(std::size_t m = 128; m < 160; ++m)
+        for(std::size_t n = 64; n < 96; ++n)
+            tile(m, n) = 0;
+    EXPECT_FALSE(check_gemm_freivalds<float>(p.a, p.b, tile));
+
+    // too many inconsistent rows to recompute
+    auto zero = p.c;
+    zero.SetZero();
+    EXPECT_FALSE(check_gemm_freivalds<float>(p.a, p.b, zero));
+}
+
+TEST(CheckGemmFreivalds, RecomputationClearsFalseAlarms)
+{
+    std::mt19937 gen(4);
+    Problem<float> p(64, 64, 256, gen);
+
+    // perturbed far below check_err's tolerance, but above a zero-width threshold
+    auto perturbed = p.c;
+    perturbed(10, 20) *= 1.f + 1e-6f;
+
+    FreivaldsConfig strict;
+    strict.max_recompute = 64;
+    strict.threshold = 0;
+    EXPECT_TRUE(check_gemm_freivalds<float>(p.a, p.b, perturbed, strict));
+}
+
+TEST(CheckGemmFreivalds, CatchesSmallErrorsAtLargeK)
+{
+    std::mt19937 gen(6);
+    const std::size_t K = 8192;
+    Problem<float> p(64, 64, K, gen);
+    EXPECT_TRUE(check_gemm_freivalds<float>(p.a, p.b, p.c));
+
+    // 0.1% of a typical |c|, the relative tolerance of check_err for f16
+    auto wrong = p.c;
+    wrong(40, 21) += 1e-3f * std::sqrt(K / 9.f);
+    EXPECT_FALSE(check_gemm_freivalds<float>(p.a, p.b, wrong));
+}
+
+TEST(CheckGemmFreivalds, AcceptsDriftingSumsWithoutRecomputing)
+{
+    // positive terms, whose partial sums grow linearly in k
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<float> dist(0.f, 1.f);
+    Tensor<float> a({64, 8192});
+    Tensor<float> b({8192, 64});
+    Tensor<float> c({64, 64});
+    for(auto& v : a.mData)
+        v = dist(gen);
+    for(auto& v : b.mData)
+        v = dist(gen);
+    gemm<float>(a, b, c);
+
+    FreivaldsConfig no_recompute;
+    no_recompute.max_recompute = 0;
+    EXPECT_TRUE(check_gemm_freivalds<float>(a, b, c, no_recompute));
+}
+
+TEST(CheckGemmFreivalds, Batched)
+{
+    std::mt19937 gen(5);
+    const std::size_t G = 3, M = 40, N = 50, K = 60;
+    auto a = random_tensor<float>({G, M, K}, {M * K, K, 1}, gen);
+    auto b = random_tensor<float>({G, K, N}, {K * N, N, 1}, gen);
+    Tensor<float> c({G, M, N});
+    c.ForEach([&](auto& self, auto idx) {
+        float acc = 0;
+        for(std::size_t k = 0; k < K; ++k)
+            acc += a(idx[0], idx[1], k) * b(idx[0], k, idx[2]);
+        self(idx) = acc;
+    });
+    EXPECT_TRUE(check_batched_gemm_freivalds<float>(a, b, c));
+
+    c(2, 39, 0) = -c(2, 39, 0) + 1.f;
+    EXPECT_FALSE(check_batched_gemm_freivalds<float>(a, b, c));
+}
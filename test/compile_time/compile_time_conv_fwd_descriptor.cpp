@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+// Compile-time benchmark: implicit-GEMM input descriptor for grouped convolution forward
+// (N, Di/Hi/Wi, G, C) -> (GemmM, GemmK), for 1, 2 and 3 spatial dimensions. These are the
+// deepest transform chains in the instance library.
+
+#include <array>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_description/tensor_descriptor.hpp"
+#include "ck/tensor_description/tensor_descriptor_helper.hpp"
+#include "ck/tensor_description/multi_index_transform_helper.hpp"
+
+namespace ck {
+namespace compile_time {
+
+template <index_t NDimSpatial>
+struct ConvProblem
+{
+    index_t N;
+    index_t C;
+    std::array<index_t, NDimSpatial> input_lengths;
+    std::array<index_t, NDimSpatial> filter_lengths;
+    std::array<index_t, NDimSpatial> output_lengths;
+    std::array<index_t, NDimSpatial> strides;
+    std::array<index_t, NDimSpatial> dilations;
+    std::array<index_t, NDimSpatial> left_pads;
+    std::array<index_t, NDimSpatial> right_pads;
+};
+
+// N, spatial..., C packed (NHWC-like, group folded into C)
+template <index_t NDimSpatial>
+auto make_in_desc(const ConvProblem<NDimSpatial>& p)
+{
+    const auto lengths = generate_tuple(
+        [&](auto i) {
+            if constexpr(i == 0)
+                return p.N;
+            else if constexpr(i == NDimSpatial + 1)
+                return p.C;
+            else
+                return p.input_lengths[i - 1];
+        },
+        Number<NDimSpatial + 2>{});
+
+    return make_naive_tensor_descriptor_packed(lengths);
+}
+
+template <index_t NDimSpatial, index_t KPerBlock>
+auto make_in_gemmm_gemmk_desc(const ConvProblem<NDimSpatial>& p)
+{
+    constexpr index_t NDim = NDimSpatial + 2;
+
+    const auto in_desc = make_in_desc(p);
+
+    using spatial_ids = typename arithmetic_sequence_gen<1, NDimSpatial + 1, 1>::type;
+
+    // pad every spatial dimension, pass N and C through
+    const auto in_pad_desc = transform_tensor_descriptor(
+        in_desc,
+        generate_tuple(
+            [&](auto i) {
+                if constexpr(i == 0)
+                    return make_pass_through_transform(p.N);
+                else if constexpr(i == NDim - 1)
+                    return make_pass_through_transform(p.C);
+                else
+                    return make_pad_transform(p.input_lengths[i - 1],
+                                              p.left_pads[i - 1],
+                                              p.right_pads[i - 1]);
+            },
+            Number<NDim>{}),
+        generate_tuple([&](auto i) { return Sequence<i.value>{}; }, Number<NDim>{}),
+        generate_tuple([&](auto i) { return Sequence<i.value>{}; }, Number<NDim>{}));
+
+    // embed every padded spatial dimension into (filter, output); the upper dimensions are
+    // N, (Y0, O0), (Y1, O1), ..., C
+    const auto in_embed_desc = transform_tensor_descriptor(
+        in_pad_desc,
+        generate_tuple(
+            [&](auto i) {
+                if constexpr(i == 0)
+                    return make_pass_through_transform(p.N);
+                else if constexpr(i == NDim - 1)
+                    return make_pass_through_transform(p.C);
+                else
+                    return make_embed_transform(
+                        make_tuple(p.filter_lengths[i - 1], p.output_lengths[i - 1]),
+                        make_tuple(p.dilations[i - 1], p.strides[i - 1]));
+            },
+            Number<NDim>{}),
+        generate_tuple([&](auto i) { return Sequence<i.value>{}; }, Number<NDim>{}),
+        generate_tuple(
+            [&](auto i) {
+                if constexpr(i == 0)
+                    return Sequence<0>{};
+                else if constexpr(i == NDim - 1)
+                    return Sequence<2 * NDimSpatial + 1>{};
+                else
+                    return Sequence<2 * i.value - 1, 2 * i.value>{};
+            },
+            Number<NDim>{}));
+
+    // GemmM = N * O0 * O1 ..., GemmK = Y0 * Y1 * ... * C
+    using filter_ids = decltype(spatial_ids{} * Number<2>{} - Number<1>{});
+    using output_ids = decltype(spatial_ids{} * Number<2>{});
+    using m_ids      = decltype(Sequence<0>::PushBack(output_ids{}));
+    using k_ids      = decltype(filter_ids::PushBack(Number<2 * NDimSpatial + 1>{}));
+
+    const auto m_lengths = generate_tuple(
+        [&](auto i) { return in_embed_desc.GetLength(Number<m_ids::At(i)>{}); },
+        Number<m_ids::Size()>{});
+    const auto k_lengths = generate_tuple(
+        [&](auto i) { return in_embed_desc.GetLength(Number<k_ids::At(i)>{}); },
+        Number<k_ids::Size()>{});
+
+    const auto in_gemmm_gemmk_desc =
+        transform_tensor_descriptor(in_embed_desc,
+                                    make_tuple(make_merge_transform(m_lengths),
+                                               make_merge_transform(k_lengths)),
+                                    make_tuple(m_ids{}, k_ids{}),
+                                    make_tuple(Sequence<0>{}, Sequence<1>{}));
+
+    // pad GemmK to the block size and split it as a blockwise copy sees it
+    const index_t gemm_k      = in_gemmm_gemmk_desc.GetLength(Number<1>{});
+    const index_t gemm_k_pad  = math::integer_divide_ceil(gemm_k, KPerBlock) * KPerBlock;
+    const index_t gemm_m      = in_gemmm_gemmk_desc.GetLength(Number<0>{});
+    const auto in_gemmm_gemmkpad_desc = transform_tensor_descriptor(
+        in_gemmm_gemmk_desc,
+        make_tuple(make_pass_through_transform(gemm_m),
+                   make_right_pad_transform(gemm_k, gemm_k_pad - gemm_k)),
+        make_tuple(Sequence<0>{}, Sequence<1>{}),
+        make_tuple(Sequence<0>{}, Sequence<1>{}));
+
+    return transform_tensor_descriptor(
+        in_gemmm_gemmkpad_desc,
+        make_tuple(make_unmerge_transform(make_tuple(gemm_k_pad / 8, Number<8>{})),
+                   make_pass_through_transform(gemm_m)),
+        make_tuple(Sequence<1>{}, Sequence<0>{}),
+        make_tuple(Sequence<0, 2>{}, Sequence<1>{}));
+}
+
+template <typename Desc>
+long_index_t sum_offsets(const Desc& desc)
+{
+    constexpr index_t NDim = Desc::GetNumOfDimension();
+
+    auto coord = make_tensor_coordinate(desc, make_zero_multi_index<NDim>());
+
+    long_index_t sum = 0;
+
+    static_for<0, NDim, 1>{}([&](auto i) {
+        auto step = make_zero_multi_index<NDim>();
+        step(i)   = 1;
+
+        move_tensor_coordinate(desc, coord, make_tensor_coordinate_step(desc, step));
+
+        if(coordinate_has_valid_offset_assuming_visible_index_is_valid(desc, coord))
+        {
+            sum += coord.GetOffset();
+        }
+    });
+
+    return sum;
+}
+
+long_index_t instantiate_all()
+{
+    long_index_t sum = 0;
+
+    const ConvProblem<1> p1{2, 64, {32}, {3}, {32}, {1}, {1}, {1}, {1}};
+    const ConvProblem<2> p2{
+        2, 64, {28, 28}, {3, 3}, {28, 28}, {1, 1}, {1, 1}, {1, 1}, {1, 1}};
+    const ConvProblem<3> p3{2,
+                            64,
+                            {8, 28, 28},
+                            {3, 3, 3},
+                            {8, 28, 28},
+                            {1, 1, 1},
+                            {1, 1, 1},
+                            {1, 1, 1},
+                            {1, 1, 1}};
+
+    sum += sum_offsets(make_in_gemmm_gemmk_desc<1, 32>(p1));
+    sum += sum_offsets(make_in_gemmm_gemmk_desc<2, 32>(p2));
+    sum += sum_offsets(make_in_gemmm_gemmk_desc<3, 32>(p3));
+    sum += sum_offsets(make_in_gemmm_gemmk_desc<2, 64>(p2));
+    sum += sum_offsets(make_in_gemmm_gemmk_desc<3, 64>(p3));
+
+    return sum;
+}
+
+} // namespace compile_time
+} // namespace ck
@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+// Compile-time benchmark: the descriptor chains a GEMM instance builds on the host and in the
+// kernel prologue, for every padding specialization and both A layouts.
+
+#include "ck/ck.hpp"
+#include "ck/tensor_description/tensor_descriptor.hpp"
+#include "ck/tensor_description/tensor_descriptor_helper.hpp"
+#include "ck/tensor_description/multi_index_transform_helper.hpp"
+
+namespace ck {
+namespace compile_time {
+
+enum struct Padding
+{
+    None,
+    M,
+    K,
+    MK
+};
+
+template <bool RowMajor, Padding Pad, index_t AK1>
+__host__ __device__ auto
+make_a_grid_desc_ak0_m_ak1(index_t M, index_t MPad, index_t K, index_t KPad, index_t StrideA)
+{
+    constexpr auto I1 = Number<1>{};
+
+    const auto desc_mraw_kraw = [&]() {
+        if constexpr(RowMajor)
+        {
+            return make_naive_tensor_descriptor(make_tuple(M, K), make_tuple(StrideA, I1));
+        }
+        else
+        {
+            return make_naive_tensor_descriptor(make_tuple(M, K), make_tuple(I1, StrideA));
+        }
+    }();
+
+    const auto desc_m_k = [&]() {
+        if constexpr(Pad == Padding::None)
+        {
+            return desc_mraw_kraw;
+        }
+        else
+        {
+            const auto m_transform = [&]() {
+                if constexpr(Pad == Padding::M || Pad == Padding::MK)
+                    return make_right_pad_transform(M, MPad - M);
+                else
+                    return make_pass_through_transform(M);
+            }();
+
+            const auto k_transform = [&]() {
+                if constexpr(Pad == Padding::K || Pad == Padding::MK)
+                    return make_right_pad_transform(K, KPad - K);
+                else
+                    return make_pass_through_transform(K);
+            }();
+
+            return transform_tensor_descriptor(desc_mraw_kraw,
+                                               make_tuple(m_transform, k_transform),
+                                               make_tuple(Sequence<0>{}, Sequence<1>{}),
+                                               make_tuple(Sequence<0>{}, Sequence<1>{}));
+        }
+    }();
+
+    const index_t AK0 = desc_m_k.GetLength(Number<1>{}) / AK1;
+
+    return transform_tensor_descriptor(
+        desc_m_k,
+        make_tuple(make_unmerge_transform(make_tuple(AK0, Number<AK1>{})),
+                   make_pass_through_transform(desc_m_k.GetLength(Number<0>{}))),
+        make_tuple(Sequence<1>{}, Sequence<0>{}),
+        make_tuple(Sequence<0, 2>{}, Sequence<1>{}));
+}
+
+// C grid descriptor split into (MBlock, MPerBlock, NBlock, NPerBlock) for the epilogue
+template <index_t MPerBlock, index_t NPerBlock>
+__host__ __device__ auto make_c_grid_desc_mblock_mperblock_nblock_nperblock(index_t M,
+                                                                          index_t N,
+                                                                          index_t StrideC)
+{
+    const auto desc_m_n =
+        make_naive_tensor_descriptor(make_tuple(M, N), make_tuple(StrideC, Number<1>{}));
+
+    const index_t MBlock = M / MPerBlock;
+    const index_t NBlock = N / NPerBlock;
+
+    return transform_tensor_descriptor(
+        desc_m_n,
+        make_tuple(make_unmerge_transform(make_tuple(MBlock, Number<MPerBlock>{})),
+                   make_unmerge_transform(make_tuple(NBlock, Number<NPerBlock>{}))),
+        make_tuple(Sequence<0>{}, Sequence<1>{}),
+        make_tuple(Sequence<0, 1>{}, Sequence<2, 3>{}));
+}
+
+// LDS descriptor with the XOR swizzle used to avoid bank conflicts; fully static
+template <index_t AK0, index_t MPerBlock, index_t AK1>
+__host__ __device__ constexpr auto make_a_lds_desc_ak0_m_ak1()
+{
+    constexpr auto desc = make_naive_tensor_descriptor(
+        make_tuple(Number<AK0 * MPerBlock / 2>{}, Number<2>{}, Number<AK1>{}),
+        make_tuple(Number<2 * AK1>{}, Number<AK1>{}, Number<1>{}));
+
+    constexpr auto permuted = transform_tensor_descriptor(
+        desc,
+        make_tuple(make_xor_with_modulo_transform(
+                       make_tuple(Number<AK0 * MPerBlock / 2>{}, Number<2>{})),
+                   make_pass_through_transform(Number<AK1>{})),
+        make_tuple(Sequence<0, 1>{}, Sequence<2>{}),
+        make_tuple(Sequence<0, 1>{}, Sequence<2>{}));
+
+    return transform_tensor_descriptor(
+        permuted,
+        make_tuple(make_unmerge_transform(make_tuple(Number<AK0>{}, Number<MPerBlock / 2>{})),
+                   make_pass_through_transform(Number<2>{}),
+                   make_pass_through_transform(Number<AK1>{})),
+        make_tuple(Sequence<0>{}, Sequence<1>{}, Sequence<2>{}),
+        make_tuple(Sequence<0, 2>{}, Sequence<1>{}, Sequence<3>{}));
+}
+
+// walk a descriptor with coordinates the way a threadwise copy does, so that coordinate
+// construction, movement and offset calculation are all instantiated
+template <typename Desc>
+__host__ __device__ long_index_t sum_offsets(const Desc& desc)
+{
+    constexpr index_t NDim = Desc::GetNumOfDimension();
+
+    auto coord = make_tensor_coordinate(desc, make_zero_multi_index<NDim>());
+
+    long_index_t sum = 0;
+
+    static_for<0, NDim, 1>{}([&](auto i) {
+        auto step = make_zero_multi_index<NDim>();
+        step(i)   = 1;
+
+        const auto step_hack = make_tensor_coordinate_step(desc, step);
+
+        move_tensor_coordinate(desc, coord, step_hack);
+
+        if(coordinate_has_valid_offset_assuming_visible_index_is_valid(desc, coord))
+        {
+            sum += coord.GetOffset();
+        }
+    });
+
+    return sum;
+}
+
+template <bool RowMajor, Padding Pad>
+long_index_t instantiate_a_grid()
+{
+    const auto desc = make_a_grid_desc_ak0_m_ak1<RowMajor, Pad, 8>(1000, 1024, 1000, 1024, 1000);
+
+    return sum_offsets(desc);
+}
+
+long_index_t instantiate_all()
+{
+    long_index_t sum = 0;
+
+    sum += instantiate_a_grid<true, Padding::None>();
+    sum += instantiate_a_grid<true, Padding::M>();
+    sum += instantiate_a_grid<true, Padding::K>();
+    sum += instantiate_a_grid<true, Padding::MK>();
+    sum += instantiate_a_grid<false, Padding::None>();
+    sum += instantiate_a_grid<false, Padding::M>();
+    sum += instantiate_a_grid<false, Padding::K>();
+    sum += instantiate_a_grid<false, Padding::MK>();
+
+    sum += sum_offsets(
+        make_c_grid_desc_mblock_mperblock_nblock_nperblock<256, 128>(1024, 1024, 1024));
+    sum += sum_offsets(
+        make_c_grid_desc_mblock_mperblock_nblock_nperblock<128, 64>(1024, 1024, 1024));
+
+    constexpr auto a_lds_desc = make_a_lds_desc_ak0_m_ak1<4, 256, 8>();
+
+    static_assert(a_lds_desc.GetElementSpaceSize() == 4 * 256 * 8, "wrong! lds size");
+
+    // static slice walk as done by a threadwise copy from LDS
+    static_ford<Sequence<2, 4, 2, 8>>{}([&](auto idx) {
+        constexpr index_t offset = a_lds_desc.CalculateOffset(
+            make_tuple(Number<idx[Number<0>{}]>{},
+                       Number<idx[Number<1>{}]>{},
+                       Number<idx[Number<2>{}]>{},
+                       Number<idx[Number<3>{}]>{}));
+
+        sum += offset;
+    });
+
+    return sum;
+}
+
+} // namespace compile_time
+} // namespace ck
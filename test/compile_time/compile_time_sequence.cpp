@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+// Compile-time benchmark: Sequence algorithms at the sizes seen in descriptor and thread-slice
+// code, plus a few larger ones so that any per-element recursion shows up in the time trace.
+
+#include "ck/ck.hpp"
+#include "ck/utility/common_header.hpp"
+
+namespace ck {
+namespace compile_time {
+
+// deterministic pseudo-random values in [0, Range)
+template <index_t Seed, index_t Range>
+struct lcg_value
+{
+    __host__ __device__ constexpr index_t operator()(index_t i) const
+    {
+        return ((i + Seed) * 7919 + 13) % 251 % Range;
+    }
+};
+
+template <index_t N, index_t Seed>
+using random_sequence_t = typename sequence_gen<N, lcg_value<Seed, N>>::type;
+
+template <typename Seq>
+__host__ __device__ constexpr bool is_non_decreasing(Seq)
+{
+    for(index_t i = 1; i < Seq::Size(); ++i)
+    {
+        if(Seq::At(i - 1) > Seq::At(i))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <index_t N, index_t Seed>
+__host__ __device__ constexpr bool check_sort()
+{
+    using values = random_sequence_t<N, Seed>;
+    using sort   = sequence_sort<values, math::less<index_t>>;
+
+    using sorted = typename sort::type;
+    using ids    = typename sort::sorted2unsorted_map;
+
+    static_assert(is_non_decreasing(sorted{}), "wrong! not sorted");
+    static_assert(is_valid_sequence_map<ids>::value, "wrong! ids are not a permutation");
+    static_assert(is_same<decltype(values::ReorderGivenNew2Old(ids{})), sorted>::value,
+                  "wrong! ids do not map back to the input");
+
+    using unique = sequence_unique_sort<values, math::less<index_t>, math::equal<index_t>>;
+
+    static_assert(is_non_decreasing(typename unique::type{}), "wrong! not sorted");
+    static_assert(is_same<decltype(values::Extract(typename unique::sorted2unsorted_map{})),
+                          typename unique::type>::value,
+                  "wrong! ids do not map back to the input");
+
+    return true;
+}
+
+template <index_t N>
+__host__ __device__ constexpr bool check_map()
+{
+    using order = typename sequence_sort<random_sequence_t<N, 7>, math::less<index_t>>::
+        sorted2unsorted_map;
+    using inverse = typename sequence_map_inverse<order>::type;
+
+    static_assert(is_same<decltype(order::ReorderGivenNew2Old(inverse{})),
+                          typename arithmetic_sequence_gen<0, N, 1>::type>::value,
+                  "wrong! inverse map");
+
+    using values = random_sequence_t<N, 3>;
+
+    using reordered = decltype(values::ReorderGivenOld2New(order{}));
+
+    static_assert(is_same<decltype(reordered::ReorderGivenNew2Old(order{})), values>::value,
+                  "wrong! reorder round trip");
+
+    static_assert(is_same<decltype(values::Reverse().Reverse()), values>::value,
+                  "wrong! reverse");
+
+    return true;
+}
+
+template <index_t N>
+__host__ __device__ constexpr bool check_scan()
+{
+    using ones = typename uniform_sequence_gen<N, 1>::type;
+
+    static_assert(is_same<decltype(reverse_exclusive_scan_sequence(
+                              ones{}, math::plus<index_t>{}, Number<0>{})),
+                          typename arithmetic_sequence_gen<N - 1, -1, -1>::type>::value,
+                  "wrong! reverse exclusive scan");
+
+    static_assert(is_same<decltype(inclusive_scan_sequence(
+                              ones{}, math::plus<index_t>{}, Number<0>{})),
+                          typename arithmetic_sequence_gen<1, N + 1, 1>::type>::value,
+                  "wrong! inclusive scan");
+
+    return true;
+}
+
+template <index_t... Ns>
+__host__ __device__ constexpr bool check_all(Sequence<Ns...>)
+{
+    return ((check_sort<Ns, Ns>() && check_map<Ns>() && check_scan<Ns>()) && ...);
+}
+
+static_assert(check_all(Sequence<1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 16, 24, 32, 48, 64>{}), "");
+
+// merging many small sequences is what Tuple-of-Sequence descriptor code does for hidden ids
+using many_merged = typename sequence_merge<Sequence<0>,
+                                            Sequence<1, 2>,
+                                            Sequence<3>,
+                                            Sequence<>,
+                                            Sequence<4, 5, 6>,
+                                            Sequence<7>,
+                                            Sequence<8>,
+                                            Sequence<9, 10>,
+                                            Sequence<11>>::type;
+
+static_assert(is_same<many_merged, typename arithmetic_sequence_gen<0, 12, 1>::type>::value, "");
+
+static_assert(is_same<decltype(pick_sequence_elements_by_mask(Sequence<4, 5, 6, 7>{},
+                                                              Sequence<1, 0, 0, 1>{})),
+                      Sequence<4, 7>>::value,
+              "");
+
+static_assert(is_same<decltype(modify_sequence_elements_by_ids(
+                          Sequence<4, 5, 6, 7>{}, Sequence<9, 8>{}, Sequence<3, 0>{})),
+                      Sequence<8, 5, 6, 9>>::value,
+              "");
+
+} // namespace compile_time
+} // namespace ck
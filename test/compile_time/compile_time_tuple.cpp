@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+// Compile-time benchmark: Tuple construction, element lookup and the container helpers that
+// descriptor code applies to Tuples of Numbers and of index_t.
+
+#include "ck/ck.hpp"
+#include "ck/utility/common_header.hpp"
+
+namespace ck {
+namespace compile_time {
+
+template <index_t... Is>
+__host__ __device__ constexpr auto make_number_tuple(Sequence<Is...>)
+{
+    return make_tuple(Number<Is>{}...);
+}
+
+template <index_t N>
+__host__ __device__ constexpr bool check_tuple()
+{
+    using ids = typename arithmetic_sequence_gen<0, N, 1>::type;
+
+    constexpr auto numbers = make_number_tuple(ids{});
+
+    static_assert(decltype(numbers)::Size() == N, "wrong! size");
+    static_assert(is_same<tuple_element_t<N - 1, remove_cvref_t<decltype(numbers)>>,
+                          Number<N - 1>>::value,
+                  "wrong! tuple_element");
+
+    // reverse through a map and back
+    using reversed_ids = typename arithmetic_sequence_gen<N - 1, -1, -1>::type;
+
+    constexpr auto reversed = container_reorder_given_new2old(numbers, reversed_ids{});
+    constexpr auto restored = container_reorder_given_old2new(reversed, reversed_ids{});
+
+    static_assert(is_same<remove_cvref_t<decltype(restored)>,
+                          remove_cvref_t<decltype(numbers)>>::value,
+                  "wrong! reorder round trip");
+
+    // element space size style reductions
+    constexpr auto sum = container_reduce(numbers, math::plus<index_t>{}, Number<0>{});
+
+    static_assert(sum == N * (N - 1) / 2, "wrong! reduce");
+
+    // packed strides of lengths {1, 2, 1, 2, ...}
+    constexpr auto strides = container_reverse_exclusive_scan(
+        generate_tuple([](auto i) { return Number<i.value % 2 + 1>{}; }, Number<N>{}),
+        math::multiplies{},
+        Number<1>{});
+
+    static_assert(strides[Number<0>{}] == (index_t{1} << (N / 2)), "wrong! exclusive scan");
+
+    constexpr auto doubled = container_concat(numbers, numbers, numbers);
+
+    static_assert(decltype(doubled)::Size() == 3 * N, "wrong! concat");
+
+    return true;
+}
+
+template <index_t... Ns>
+__host__ __device__ constexpr bool check_all(Sequence<Ns...>)
+{
+    return (check_tuple<Ns>() && ...);
+}
+
+static_assert(check_all(Sequence<1, 2, 3, 4, 6, 8, 12, 16, 24, 32>{}), "");
+
+// runtime lengths: the same helpers instantiated over index_t elements
+index_t runtime_element_space_size(index_t n, index_t h, index_t w, index_t c)
+{
+    const auto lengths = make_tuple(n, h, w, c);
+    const auto strides =
+        container_reverse_exclusive_scan(lengths, math::multiplies{}, index_t{1});
+
+    index_t size = 1;
+
+    static_for<0, 4, 1>{}([&](auto i) { size += (lengths[i] - 1) * strides[i]; });
+
+    return size;
+}
+
+} // namespace compile_time
+} // namespace ck
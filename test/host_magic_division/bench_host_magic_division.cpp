@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+// Time to decompose every flat index of a few tensor shapes into N-d coordinates, with the
+// div/mod loop ParallelTensorFunctor used to run per element and with HostIndexDecomposer.
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ck/library/utility/host_magic_division.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+using ck::utils::HostIndexDecomposer;
+using ck::utils::HostSimd;
+
+namespace {
+
+constexpr std::size_t batch = 512;
+
+template <typename F>
+double ns_per_index(std::size_t size, F&& f)
+{
+    // keep the coordinates observable so that the decomposition is not optimized away
+    std::size_t checksum = 0;
+    const auto start     = std::chrono::steady_clock::now();
+    for(std::size_t begin = 0; begin < size; begin += batch)
+        checksum += f(begin, std::min(batch, size - begin));
+    const auto stop = std::chrono::steady_clock::now();
+
+    static volatile std::size_t sink;
+    sink = checksum;
+    return std::chrono::duration<double, std::nano>(stop - start).count() / size;
+}
+
+} // namespace
+
+int main()
+{
+    const std::vector<std::vector<std::size_t>> shapes{
+        {4096, 4096}, {64, 56, 56, 64}, {2, 16, 3, 3, 3, 64, 32}, {8, 12, 1024, 128}};
+
+    const std::vector<std::pair<std::string, HostSimd>> variants{
+        {"magic", HostSimd::Scalar}, {"magic avx2", HostSimd::Avx2}, {"magic avx512", HostSimd::Avx512}};
+
+    std::cout << std::fixed << std::setprecision(2);
+    for(const auto& lengths : shapes)
+    {
+        HostIndexDecomposer decomposer(lengths);
+        const std::size_t size = decomposer.GetElementSize();
+        const std::size_t ndim = lengths.size();
+        std::vector<std::size_t> idx(ndim * batch);
+
+        std::vector<std::size_t> strides(ndim, 1);
+        for(std::size_t d = ndim - 1; d > 0; --d)
+            strides[d - 1] = strides[d] * lengths[d];
+
+        std::cout << "lengths";
+        for(auto l : lengths)
+            std::cout << " " << l;
+        std::cout << " (" << size << " indices)" << std::endl;
+
+        const double baseline = ns_per_index(size, [&](std::size_t begin, std::size_t count) {
+            for(std::size_t j = 0; j < count; ++j)
+            {
+                std::size_t i = begin + j;
+                for(std::size_t d = 0; d < ndim; ++d)
+                {
+                    idx[d * count + j] = i / strides[d];
+                    i -= idx[d * count + j] * strides[d];
+                }
+            }
+            return idx[count - 1];
+        });
+        std::cout << "  " << std::setw(14) << std::left << "div/mod" << std::right
+                  << std::setw(8) << baseline << " ns/index" << std::endl;
+
+        for(const auto& [name, simd] : variants)
+        {
+            if(static_cast<int>(simd) > static_cast<int>(ck::utils::GetNativeHostSimd()))
+                continue;
+            const double t = ns_per_index(size, [&](std::size_t begin, std::size_t count) {
+                decomposer.DecomposeRange(begin, count, idx.data(), simd);
+                return idx[count - 1];
+            });
+            std::cout << "  " << std::setw(14) << std::left << name << std::right << std::setw(8)
+                      << t << " ns/index, " << baseline / t << "x" << std::endl;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_magic_division.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+
+using ck::utils::HostIndexDecomposer;
+using ck::utils::HostMagicDivider;
+using ck::utils::HostSimd;
+
+namespace {
+
+std::vector<HostSimd> supported_simd()
+{
+    std::vector<HostSimd> simd{HostSimd::Scalar};
+    if(static_cast<int>(ck::utils::GetNativeHostSimd()) >= static_cast<int>(HostSimd::Avx2))
+        simd.push_back(HostSimd::Avx2);
+    if(ck::utils::GetNativeHostSimd() == HostSimd::Avx512)
+        simd.push_back(HostSimd::Avx512);
+    return simd;
+}
+
+// flat index of the coordinates j of structure-of-arrays `idx`, checking their range
+std::size_t flatten(const std::vector<std::size_t>& lengths,
+                    const std::vector<std::size_t>& idx,
+                    std::size_t count,
+                    std::size_t j)
+{
+    std::size_t flat = 0;
+    for(std::size_t d = 0; d < lengths.size(); ++d)
+    {
+        EXPECT_LT(idx[d * count + j], lengths[d]);
+        flat = flat * lengths[d] + idx[d * count + j];
+    }
+    return flat;
+}
+
+} // namespace
+
+TEST(HostMagicDivision, MatchesIntegerDivision)
+{
+    const std::vector<std::size_t> divisors{
+        1, 2, 3, 7, 64, 1000, INT32_MAX, std::size_t{INT32_MAX} + 1, 1ull << 40, 1ull << 63};
+    const std::vector<std::size_t> dividends{
+        0, 1, 6, 1023, INT32_MAX, std::size_t{INT32_MAX} + 1, 1ull << 40, INT64_MAX};
+    for(auto divisor : divisors)
+        for(auto dividend : dividends)
+            EXPECT_EQ(HostMagicDivider(divisor).Divide(dividend), dividend / divisor)
+                << dividend << " / " << divisor;
+
+    std::mt19937_64 gen(42);
+    for(int i = 0; i < 100000; ++i)
+    {
+        const std::size_t divisor  = (gen() >> (1 + gen() % 63)) + 1;
+        const std::size_t dividend = gen() >> (1 + gen() % 63);
+        ASSERT_EQ(HostMagicDivider(divisor).Divide(dividend), dividend / divisor)
+            << dividend << " / " << divisor;
+    }
+}
+
+TEST(HostMagicDivision, DecomposeRange)
+{
+    const std::vector<std::vector<std::size_t>> shapes{
+        {13}, {3, 5}, {2, 3, 4, 5}, {1, 1, 17, 1}, {16, 3, 3, 64}, {1000, 999}, {65537, 3, 11}};
+    for(const auto& lengths : shapes)
+    {
+        HostIndexDecomposer decomposer(lengths);
+        const std::size_t size = decomposer.GetElementSize();
+        for(auto simd : supported_simd())
+        {
+            // odd begin and count exercise the scalar head and tail of the vector kernels
+            const std::size_t begin = size / 7;
+            const std::size_t count = std::min<std::size_t>(size - begin, 1000 + size % 13);
+            std::vector<std::size_t> idx(lengths.size() * count);
+            decomposer.DecomposeRange(begin, count, idx.data(), simd);
+            for(std::size_t j = 0; j < count; ++j)
+                ASSERT_EQ(flatten(lengths, idx, count, j), begin + j);
+        }
+    }
+}
+
+TEST(HostMagicDivision, DecomposeIndices)
+{
+    const std::vector<std::size_t> lengths{7, 129, 3, 31};
+    HostIndexDecomposer decomposer(lengths);
+
+    std::mt19937_64 gen(7);
+    std::vector<std::size_t> flat(1001);
+    for(auto& i : flat)
+        i = gen() % decomposer.GetElementSize();
+
+    for(auto simd : supported_simd())
+    {
+        std::vector<std::size_t> idx(lengths.size() * flat.size());
+        decomposer.Decompose(flat.data(), flat.size(), idx.data(), simd);
+        for(std::size_t j = 0; j < flat.size(); ++j)
+            ASSERT_EQ(flatten(lengths, idx, flat.size(), j), flat[j]);
+    }
+}
+
+TEST(HostMagicDivision, LargeSpaceUses64BitDivision)
+{
+    const std::vector<std::size_t> lengths{5, 1u << 20, 3, 1u << 12};
+    HostIndexDecomposer decomposer(lengths);
+    ASSERT_GT(decomposer.GetElementSize(), std::size_t{INT32_MAX});
+
+    const std::size_t begin = decomposer.GetElementSize() - 100;
+    std::vector<std::size_t> idx(lengths.size() * 100);
+    decomposer.DecomposeRange(begin, 100, idx.data());
+    for(std::size_t j = 0; j < 100; ++j)
+        ASSERT_EQ(flatten(lengths, idx, 100, j), begin + j);
+}
+
+TEST(HostMagicDivision, ParallelTensorFunctorVisitsEveryIndexOnce)
+{
+    const std::size_t M = 37, N = 5, K = 129;
+    for(std::size_t num_thread : {1, 3})
+    {
+        std::vector<std::atomic<int>> visits(M * N * K);
+        auto f = [&](auto m, auto n, auto k) { visits[(m * N + n) * K + k]++; };
+        make_ParallelTensorFunctor(f, M, N, K)(num_thread);
+        for(const auto& v : visits)
+            ASSERT_EQ(v.load(), 1);
+    }
+}
@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
+
+namespace {
+
+template <typename T>
+Tensor<T> iota_tensor(const std::vector<std::size_t>& lengths)
+{
+    Tensor<T> t(lengths);
+    std::iota(t.mData.begin(), t.mData.end(), T{0});
+    return t;
+}
+
+// element-by-element copy, the reference for copy_tensor_view
+template <typename SrcT, typename DstT>
+void naive_copy(const TensorView<SrcT>& src, const TensorView<DstT>& dst)
+{
+    src.ForEach([&](auto& self, auto idx) { dst(idx) = self(idx); });
+}
+
+} // namespace
+
+TEST(HostTensorView, ViewsTensorInPlace)
+{
+    auto t = iota_tensor<float>({2, 3, 4});
+    auto v = make_tensor_view(t);
+    EXPECT_EQ(v.data(), t.mData.data());
+    EXPECT_EQ(v.GetLengths(), t.GetLengths());
+    EXPECT_EQ(v.GetStrides(), t.GetStrides());
+
+    v(1, 2, 3) = -1.f;
+    EXPECT_EQ(t(1, 2, 3), -1.f);
+
+    TensorView<const float> c = v;
+    EXPECT_EQ(c(std::vector<std::size_t>{1, 2, 3}), -1.f);
+}
+
+TEST(HostTensorView, SliceSelect)
+{
+    auto t = iota_tensor<int>({4, 6});
+
+    auto s = make_tensor_view(t).Slice(1, 1, 6, 2);
+    EXPECT_EQ(s.GetLengths(), (std::vector<std::size_t>{4, 3}));
+    for(std::size_t i = 0; i < 4; ++i)
+        for(std::size_t j = 0; j < 3; ++j)
+            EXPECT_EQ(s(i, j), t(i, 1 + 2 * j));
+
+    auto row = make_tensor_view(t).Select(0, 2);
+    EXPECT_EQ(row.GetLengths(), std::vector<std::size_t>{6});
+    for(std::size_t j = 0; j < 6; ++j)
+        EXPECT_EQ(row(j), t(2, j));
+
+    auto empty = make_tensor_view(t).Slice(0, 3, 3);
+    EXPECT_EQ(empty.GetElementSize(), 0u);
+
+    EXPECT_THROW(make_tensor_view(t).Slice(1, 2, 7), std::runtime_error);
+    EXPECT_THROW(make_tensor_view(t).Select(2, 0), std::runtime_error);
+}
+
+TEST(HostTensorView, PermuteTranspose)
+{
+    auto t = iota_tensor<int>({2, 3, 4});
+
+    auto p = make_tensor_view(t).Permute(std::vector<int>{2, 0, 1});
+    EXPECT_EQ(p.GetLengths(), (std::vector<std::size_t>{4, 2, 3}));
+    p.ForEach([&](auto& self, auto idx) { EXPECT_EQ(self(idx), t(idx[1], idx[2], idx[0])); });
+
+    auto tr = make_tensor_view(t).Transpose(0, 2);
+    EXPECT_EQ(tr.GetLengths(), (std::vector<std::size_t>{4, 3, 2}));
+    EXPECT_EQ(tr(3, 1, 0), t(0, 1, 3));
+
+    EXPECT_THROW(make_tensor_view(t).Permute(std::vector<int>{0, 0, 1}), std::runtime_error);
+}
+
+TEST(HostTensorView, Broadcast)
+{
+    // a [G, K] operand shared by the H heads of every group
+    auto t = iota_tensor<float>({2, 5});
+    auto b = make_tensor_view(t).Unsqueeze(1).Broadcast(1, 3);
+    EXPECT_EQ(b.GetLengths(), (std::vector<std::size_t>{2, 3, 5}));
+    EXPECT_EQ(b.GetStrides()[1], 0u);
+    b.ForEach([&](auto& self, auto idx) { EXPECT_EQ(self(idx), t(idx[0], idx[2])); });
+
+    EXPECT_THROW(make_tensor_view(t).Broadcast(0, 4), std::runtime_error);
+}
+
+TEST(HostTensorView, CopyMatchesElementwiseCopy)
+{
+    std::mt19937 gen(7);
+    const std::vector<std::vector<std::size_t>> shapes{
+        {17}, {64, 64}, {3, 1, 130, 7}, {8, 33, 2, 65}, {2, 3, 4, 5, 6, 7}};
+    for(const auto& lengths : shapes)
+    {
+        auto src = iota_tensor<int32_t>(lengths);
+
+        std::vector<std::size_t> new2old(lengths.size());
+        std::iota(new2old.begin(), new2old.end(), std::size_t{0});
+        for(int trial = 0; trial < 6; ++trial)
+        {
+            auto view = make_tensor_view(src).Permute(new2old);
+
+            Tensor<int32_t> expected(view.GetLengths());
+            naive_copy(view, make_tensor_view(expected));
+
+            const auto packed = to_packed_tensor(view);
+            EXPECT_EQ(packed.GetLengths(), view.GetLengths());
+            EXPECT_EQ(packed.mData, expected.mData);
+
+            // into a padded, permuted destination
+            std::vector<std::size_t> strides(view.GetNumOfDimension());
+            std::size_t stride = 1;
+            for(std::size_t d = strides.size(); d-- > 0;)
+            {
+                strides[d] = stride;
+                stride *= view.GetLengths()[d] + d % 2;
+            }
+            Tensor<int32_t> padded(view.GetLengths(), strides);
+            std::fill(padded.mData.begin(), padded.mData.end(), -1);
+            copy_tensor_view(view, make_tensor_view(padded));
+            padded.ForEach([&](auto& self, auto idx) { EXPECT_EQ(self(idx), expected(idx)); });
+
+            std::shuffle(new2old.begin(), new2old.end(), gen);
+        }
+    }
+}
+
+TEST(HostTensorView, CopyElementSizes)
+{
+    const std::vector<std::size_t> lengths{37, 45, 3};
+    const std::vector<int> new2old{2, 0, 1};
+
+    auto check = [&](auto type) {
+        using T  = decltype(type);
+        auto src = iota_tensor<T>(lengths);
+        auto v   = make_tensor_view(src).Permute(new2old).Slice(2, 1, 45, 3);
+
+        Tensor<T> expected(v.GetLengths());
+        naive_copy(v, make_tensor_view(expected));
+        EXPECT_EQ(to_packed_tensor(v).mData, expected.mData);
+    };
+    check(int8_t{});
+    check(int16_t{});
+    check(float{});
+    check(double{});
+
+    // broadcast source
+    auto row = iota_tensor<double>({1, 9});
+    auto b   = make_tensor_view(row).Broadcast(0, 300);
+    auto out = to_packed_tensor(b);
+    for(std::size_t i = 0; i < 300; ++i)
+        for(std::size_t j = 0; j < 9; ++j)
+            EXPECT_EQ(out(i, j), row(0, j));
+
+    Tensor<float> other({3, 4});
+    EXPECT_THROW(copy_tensor_view(make_tensor_view(other).Transpose(0, 1),
+                                  make_tensor_view(other)),
+                 std::runtime_error);
+}
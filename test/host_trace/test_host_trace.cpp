@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/host_utility/host_trace.hpp"
+
+using ck::trace::SpanHistogram;
+using ck::trace::TraceRecorder;
+
+class TestHostTrace : public ::testing::Test
+{
+    protected:
+    void SetUp() override
+    {
+        TraceRecorder::Instance().Clear();
+        TraceRecorder::Instance().SetActive(true);
+    }
+
+    void TearDown() override
+    {
+        TraceRecorder::Instance().SetActive(false);
+        TraceRecorder::Instance().Clear();
+    }
+};
+
+TEST_F(TestHostTrace, SpanAndCallAreRecorded)
+{
+    {
+        CK_TRACE_SPAN("outer");
+        const int v = CK_TRACE_CALL("inner", 40 + 2);
+        EXPECT_EQ(v, 42);
+    }
+
+    const auto histograms = TraceRecorder::Instance().GetHistograms();
+    ASSERT_EQ(histograms.count("outer"), 1);
+    ASSERT_EQ(histograms.count("inner"), 1);
+    EXPECT_EQ(histograms.at("outer").count, 1);
+    EXPECT_LE(histograms.at("inner").total_ns, histograms.at("outer").total_ns);
+    EXPECT_EQ(TraceRecorder::Instance().GetNumEvents(), 2);
+}
+
+TEST_F(TestHostTrace, InactiveRecorderSkipsDetail)
+{
+    TraceRecorder::Instance().SetActive(false);
+
+    bool detail_built = false;
+    {
+        CK_TRACE_SPAN_DETAIL("span", (detail_built = true, "detail"));
+        CK_TRACE_COUNTER("counter", 1);
+    }
+
+    EXPECT_FALSE(detail_built);
+    EXPECT_EQ(TraceRecorder::Instance().GetNumEvents(), 0);
+}
+
+TEST_F(TestHostTrace, ChromeTraceJson)
+{
+    {
+        CK_TRACE_SPAN_DETAIL("MakeArgumentPointer", "Device\"Gemm\"<128, 128>");
+    }
+    CK_TRACE_COUNTER("WorkSpaceBytes", 4096);
+
+    std::ostringstream oss;
+    TraceRecorder::Instance().WriteChromeTrace(oss);
+    const auto json = oss.str();
+
+    EXPECT_NE(json.find("\"traceEvents\":["), std::string::npos);
+    EXPECT_NE(json.find("\"name\":\"MakeArgumentPointer\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("Device\\\"Gemm\\\"<128, 128>"), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"C\",\"args\":{\"value\":4096}"), std::string::npos);
+}
+
+TEST_F(TestHostTrace, HistogramQuantiles)
+{
+    SpanHistogram h;
+    for(int i = 0; i < 99; ++i)
+        h.Add(100);
+    h.Add(1000000);
+
+    EXPECT_EQ(h.count, 100);
+    EXPECT_EQ(h.min_ns, 100);
+    EXPECT_EQ(h.max_ns, 1000000);
+    // 100ns falls in [64, 128)
+    EXPECT_EQ(h.GetQuantileNs(0.5), 127);
+    EXPECT_EQ(h.GetQuantileNs(1.0), 1000000);
+
+    {
+        CK_TRACE_SPAN("IsSupportedArgument");
+    }
+    std::ostringstream oss;
+    TraceRecorder::Instance().WriteHistogram(oss);
+    EXPECT_NE(oss.str().find("IsSupportedArgument"), std::string::npos);
+}
+
+TEST_F(TestHostTrace, ConcurrentSpans)
+{
+    constexpr int num_threads = 4;
+    constexpr int num_spans   = 1000;
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < num_threads; ++t)
+        threads.emplace_back([] {
+            for(int i = 0; i < num_spans; ++i)
+            {
+                CK_TRACE_SPAN("GetWorkSpaceSize");
+            }
+        });
+    for(auto& t : threads)
+        t.join();
+
+    EXPECT_EQ(TraceRecorder::Instance().GetHistograms().at("GetWorkSpaceSize").count,
+              num_threads * num_spans);
+}
@@ -0,0 +1,12 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "ck/library/tensor_operation_instance/instance_shard.hpp"
+#include "stub_ops.hpp"
+
+void add_stub_bf16_nn_instances(StubOps& instances)
+{
+    instances.push_back(std::make_unique<StubOpInstance>("bf16_nn_0"));
+}
+
+CK_INSTANCE_SHARD("stub_bf16", CK_INSTANCE_SHARD_ENTRY(add_stub_bf16_nn_instances))
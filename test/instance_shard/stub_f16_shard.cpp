@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "ck/library/tensor_operation_instance/instance_shard.hpp"
+#include "stub_ops.hpp"
+
+void add_stub_f16_nn_instances(StubOps& instances)
+{
+    instances.push_back(std::make_unique<StubOpInstance>("f16_nn_0"));
+    instances.push_back(std::make_unique<StubOpInstance>("f16_nn_1"));
+}
+
+void add_stub_f16_nt_instances(StubOps& instances)
+{
+    instances.push_back(std::make_unique<StubOpInstance>("f16_nt_0"));
+}
+
+CK_INSTANCE_SHARD("stub_f16",
+                  CK_INSTANCE_SHARD_ENTRY(add_stub_f16_nn_instances),
+                  CK_INSTANCE_SHARD_ENTRY(add_stub_f16_nt_instances))
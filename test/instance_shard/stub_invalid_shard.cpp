@@ -0,0 +1,10 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include "stub_ops.hpp"
+
+// a shared object without a shard table
+void add_stub_f32_nn_instances(StubOps& instances)
+{
+    instances.push_back(std::make_unique<StubOpInstance>("f32_nn_0"));
+}
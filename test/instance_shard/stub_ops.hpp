@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// Host-only stand-ins for device operations, so that the stub shards load without a GPU
+
+struct StubOp
+{
+    virtual ~StubOp() = default;
+    virtual std::string GetTypeString() const = 0;
+};
+
+struct StubOpInstance : StubOp
+{
+    explicit StubOpInstance(std::string name) : name_(std::move(name)) {}
+    std::string GetTypeString() const override { return name_; }
+
+    private:
+    std::string name_;
+};
+
+using StubOps = std::vector<std::unique_ptr<StubOp>>;
+
+void add_stub_f16_nn_instances(StubOps& instances);
+void add_stub_f16_nt_instances(StubOps& instances);
+void add_stub_bf16_nn_instances(StubOps& instances);
+// listed in the index of the tests, but defined by no shard
+void add_stub_f32_nn_instances(StubOps& instances);
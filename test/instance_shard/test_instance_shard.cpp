@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <gtest/gtest.h>
+
+#include "ck/library/tensor_operation_instance/instance_shard.hpp"
+#include "stub_ops.hpp"
+
+using ck::tensor_operation::device::instance::add_shard_instances;
+using ck::tensor_operation::device::instance::InstanceShardLoader;
+
+namespace fs = std::filesystem;
+
+namespace {
+
+// whether the shared object at `path` is mapped into this process
+bool is_mapped(const std::string& path)
+{
+    const std::string canonical = fs::canonical(path).string();
+    std::ifstream maps("/proc/self/maps");
+    std::string line;
+    while(std::getline(maps, line))
+    {
+        if(line.size() >= canonical.size() &&
+           line.compare(line.size() - canonical.size(), canonical.size(), canonical) == 0)
+            return true;
+    }
+    return false;
+}
+
+// a shard directory with an index of `lines`
+struct ShardDir
+{
+    explicit ShardDir(const std::vector<std::string>& lines)
+        : path((fs::temp_directory_path() /
+                ("ck_instance_shard_" + std::to_string(getpid()) + "_" + std::to_string(count++)))
+                   .string())
+    {
+        fs::create_directories(path);
+        std::ofstream index(path + "/" + InstanceShardLoader::IndexFileName);
+        for(const auto& line : lines)
+            index << line << "\n";
+    }
+
+    ~ShardDir() { fs::remove_all(path); }
+
+    static inline int count = 0;
+    std::string path;
+};
+
+std::vector<std::string> stub_index()
+{
+    return {"# function shard",
+            std::string("add_stub_f16_nn_instances ") + STUB_F16_SHARD,
+            std::string("add_stub_f16_nt_instances ") + STUB_F16_SHARD,
+            std::string("add_stub_bf16_nn_instances ") + STUB_BF16_SHARD,
+            std::string("add_stub_bf16_nt_instances ") + STUB_BF16_SHARD,
+            std::string("add_stub_f32_nn_instances ") + STUB_INVALID_SHARD,
+            "add_stub_f8_nn_instances /nonexistent/libck_shard_f8.so"};
+}
+
+std::vector<std::string> type_strings(const StubOps& ops)
+{
+    std::vector<std::string> names;
+    for(const auto& op : ops)
+        names.push_back(op->GetTypeString());
+    return names;
+}
+
+} // namespace
+
+// keep first: the shards stay loaded for the rest of the process
+TEST(InstanceShard, ColdStartLoadsOnlyRequestedShard)
+{
+    ShardDir dir(stub_index());
+    InstanceShardLoader loader({dir.path});
+    EXPECT_TRUE(loader.LoadedShards().empty());
+    EXPECT_FALSE(is_mapped(STUB_F16_SHARD));
+    EXPECT_FALSE(is_mapped(STUB_BF16_SHARD));
+
+    StubOps ops;
+    EXPECT_TRUE(loader.AddInstances("add_stub_f16_nn_instances", &ops));
+    EXPECT_EQ(type_strings(ops), (std::vector<std::string>{"f16_nn_0", "f16_nn_1"}));
+    EXPECT_EQ(loader.LoadedShards(), std::vector<std::string>{"stub_f16"});
+    EXPECT_TRUE(is_mapped(STUB_F16_SHARD));
+    EXPECT_FALSE(is_mapped(STUB_BF16_SHARD));
+    EXPECT_FALSE(is_mapped(STUB_INVALID_SHARD));
+}
+
+TEST(InstanceShard, ShardIsLoadedOnce)
+{
+    ShardDir dir(stub_index());
+    InstanceShardLoader loader({dir.path});
+
+    StubOps ops;
+    EXPECT_TRUE(loader.AddInstances("add_stub_f16_nn_instances", &ops));
+    EXPECT_TRUE(loader.AddInstances("add_stub_f16_nt_instances", &ops));
+    EXPECT_TRUE(loader.AddInstances("add_stub_f16_nn_instances", &ops));
+    EXPECT_EQ(ops.size(), 5u);
+    EXPECT_EQ(loader.LoadedShards(), std::vector<std::string>{"stub_f16"});
+
+    EXPECT_TRUE(loader.AddInstances("add_stub_bf16_nn_instances", &ops));
+    EXPECT_EQ(ops.back()->GetTypeString(), "bf16_nn_0");
+    EXPECT_EQ(loader.LoadedShards(), (std::vector<std::string>{"stub_f16", "stub_bf16"}));
+}
+
+TEST(InstanceShard, UnknownFunctionLoadsNothing)
+{
+    ShardDir dir(stub_index());
+    InstanceShardLoader loader({dir.path, "/nonexistent"});
+
+    StubOps ops;
+    EXPECT_FALSE(loader.AddInstances("add_stub_i8_nn_instances", &ops));
+    EXPECT_TRUE(ops.empty());
+    EXPECT_TRUE(loader.LoadedShards().empty());
+}
+
+TEST(InstanceShard, BrokenShardsThrow)
+{
+    ShardDir dir(stub_index());
+    InstanceShardLoader loader({dir.path});
+
+    StubOps ops;
+    // not a shard
+    EXPECT_THROW(loader.AddInstances("add_stub_f32_nn_instances", &ops), std::runtime_error);
+    // missing shard
+    EXPECT_THROW(loader.AddInstances("add_stub_f8_nn_instances", &ops), std::runtime_error);
+    // the shard does not define the function of the index
+    EXPECT_THROW(loader.AddInstances("add_stub_bf16_nt_instances", &ops), std::runtime_error);
+    EXPECT_EQ(ops.size(), 0u);
+    EXPECT_EQ(loader.LoadedShards(), std::vector<std::string>{"stub_bf16"});
+}
+
+TEST(InstanceShard, FirstSearchPathWins)
+{
+    // shard files are relative to the directory of their index
+    ShardDir first({"add_stub_f16_nn_instances libstub_f16.so"});
+    fs::create_symlink(STUB_F16_SHARD, first.path + "/libstub_f16.so");
+    ShardDir second({"add_stub_f16_nn_instances /nonexistent/libstub_f16.so",
+                     std::string("add_stub_bf16_nn_instances ") + STUB_BF16_SHARD});
+    InstanceShardLoader loader({first.path, second.path});
+
+    StubOps ops;
+    EXPECT_TRUE(loader.AddInstances("add_stub_f16_nn_instances", &ops));
+    EXPECT_TRUE(loader.AddInstances("add_stub_bf16_nn_instances", &ops));
+    EXPECT_EQ(ops.size(), 3u);
+}
+
+TEST(InstanceShard, FactoryCallSite)
+{
+    // the process wide loader searches CK_INSTANCE_SHARD_PATH first
+    ShardDir dir(stub_index());
+    setenv("CK_INSTANCE_SHARD_PATH", dir.path.c_str(), 1);
+
+    // add_stub_f16_nn_instances is only declared in this test, as it would be by a factory
+    StubOps ops;
+    add_shard_instances<decltype(&add_stub_f16_nn_instances)>("add_stub_f16_nn_instances", ops);
+    EXPECT_EQ(ops.size(), 2u);
+    EXPECT_THROW(
+        add_shard_instances<decltype(&add_stub_f16_nn_instances)>("add_stub_i8_nn_instances", ops),
+        std::runtime_error);
+}
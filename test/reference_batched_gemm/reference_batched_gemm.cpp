@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstddef>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_batched_gemm.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+
+// C[g0, g1] = A[g0, g1] * B[g0, g1 * KvHeads / G1], one element at a time
+template <typename DataType>
+Tensor<DataType> naive_shared_kv_gemm(const Tensor<DataType>& a_g0_g1_m_k,
+                                      const Tensor<DataType>& b_g0_gkv_k_n)
+{
+    const std::size_t G0       = a_g0_g1_m_k.GetLengths()[0];
+    const std::size_t G1       = a_g0_g1_m_k.GetLengths()[1];
+    const std::size_t M        = a_g0_g1_m_k.GetLengths()[2];
+    const std::size_t K        = a_g0_g1_m_k.GetLengths()[3];
+    const std::size_t kv_heads = b_g0_gkv_k_n.GetLengths()[1];
+    const std::size_t N        = b_g0_gkv_k_n.GetLengths()[3];
+
+    Tensor<DataType> c({G0, G1, M, N});
+    c.ForEach([&](auto& self, auto idx) {
+        float acc = 0;
+        for(std::size_t k = 0; k < K; ++k)
+            acc += ck::type_convert<float>(a_g0_g1_m_k(idx[0], idx[1], idx[2], k)) *
+                   ck::type_convert<float>(
+                       b_g0_gkv_k_n(idx[0], idx[1] * kv_heads / G1, k, idx[3]));
+        self(idx) = ck::type_convert<DataType>(acc);
+    });
+    return c;
+}
+
+template <typename DataType, ck::index_t QueryGroupNumber>
+void test_gqa(std::size_t G0, std::size_t G1, std::size_t M, std::size_t N, std::size_t K)
+{
+    Tensor<DataType> a({G0, G1, M, K});
+    Tensor<DataType> b(std::vector<std::size_t>{G0, QueryGroupNumber, K, N});
+    a.GenerateTensorValue(GeneratorTensor_2<DataType>{-5, 5});
+    b.GenerateTensorValue(GeneratorTensor_2<DataType>{-5, 5});
+    Tensor<DataType> c({G0, G1, M, N});
+
+    using ReferenceGemm = ck::tensor_operation::host::ReferenceBatchedGemm_GQA<DataType,
+                                                                               DataType,
+                                                                               DataType,
+                                                                               float,
+                                                                               PassThrough,
+                                                                               PassThrough,
+                                                                               PassThrough,
+                                                                               QueryGroupNumber>;
+    auto ref_gemm     = ReferenceGemm{};
+    auto ref_invoker  = ref_gemm.MakeInvoker();
+    auto ref_argument = ref_gemm.MakeArgument(a, b, c, PassThrough{}, PassThrough{}, PassThrough{});
+    ref_invoker.Run(ref_argument);
+
+    EXPECT_TRUE(ck::utils::check_err(c.mData, naive_shared_kv_gemm(a, b).mData));
+}
+
+} // namespace
+
+TEST(ReferenceBatchedGemm, MQA)
+{
+    const std::size_t G0 = 2, G1 = 5, M = 37, N = 70, K = 19;
+    Tensor<ck::half_t> a({G0, G1, M, K});
+    Tensor<ck::half_t> b(std::vector<std::size_t>{G0, 1, K, N});
+    a.GenerateTensorValue(GeneratorTensor_2<ck::half_t>{-5, 5});
+    b.GenerateTensorValue(GeneratorTensor_2<ck::half_t>{-5, 5});
+    Tensor<ck::half_t> c({G0, G1, M, N});
+
+    using ReferenceGemm = ck::tensor_operation::host::ReferenceBatchedGemm_MQA<ck::half_t,
+                                                                               ck::half_t,
+                                                                               ck::half_t,
+                                                                               float,
+                                                                               PassThrough,
+                                                                               PassThrough,
+                                                                               PassThrough>;
+    auto ref_gemm     = ReferenceGemm{};
+    auto ref_invoker  = ref_gemm.MakeInvoker();
+    auto ref_argument = ref_gemm.MakeArgument(a, b, c, PassThrough{}, PassThrough{}, PassThrough{});
+    ref_invoker.Run(ref_argument);
+
+    EXPECT_TRUE(ck::utils::check_err(c.mData, naive_shared_kv_gemm(a, b).mData));
+}
+
+TEST(ReferenceBatchedGemm, GQA)
+{
+    test_gqa<ck::half_t, 2>(2, 8, 64, 64, 32);
+    test_gqa<float, 4>(1, 6, 33, 129, 17);
+    test_gqa<float, 3>(3, 3, 1, 1, 1);
+    test_gqa<ck::half_t, 1>(1, 4, 20, 40, 8);
+}
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <complex>
+#include <cstddef>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_cgemm.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using ck::tensor_operation::host::CGemmAlgorithm;
+
+// c = a * b in complex double precision
+template <typename T>
+void naive_cgemm(const Tensor<T>& a_real,
+                 const Tensor<T>& a_imag,
+                 const Tensor<T>& b_real,
+                 const Tensor<T>& b_imag,
+                 Tensor<float>& c_real,
+                 Tensor<float>& c_imag)
+{
+    const std::size_t K = a_real.GetLengths()[1];
+    c_real.ForEach([&](auto&, auto idx) {
+        std::complex<double> acc = 0;
+        for(std::size_t k = 0; k < K; ++k)
+            acc += std::complex<double>(ck::type_convert<float>(a_real(idx[0], k)),
+                                        ck::type_convert<float>(a_imag(idx[0], k))) *
+                   std::complex<double>(ck::type_convert<float>(b_real(k, idx[1])),
+                                        ck::type_convert<float>(b_imag(k, idx[1])));
+        c_real(idx) = static_cast<float>(acc.real());
+        c_imag(idx) = static_cast<float>(acc.imag());
+    });
+}
+
+template <typename T>
+void run_cgemm(const Tensor<T>& a_real,
+               const Tensor<T>& a_imag,
+               const Tensor<T>& b_real,
+               const Tensor<T>& b_imag,
+               Tensor<float>& c_real,
+               Tensor<float>& c_imag,
+               CGemmAlgorithm algorithm)
+{
+    using ReferenceCGemm = ck::tensor_operation::host::
+        ReferenceCGemm<T, T, float, PassThrough, PassThrough, PassThrough>;
+
+    auto ref_cgemm    = ReferenceCGemm{};
+    auto ref_invoker  = ref_cgemm.MakeInvoker();
+    auto ref_argument = ref_cgemm.MakeArgument(a_real,
+                                               a_imag,
+                                               b_real,
+                                               b_imag,
+                                               c_real,
+                                               c_imag,
+                                               PassThrough{},
+                                               PassThrough{},
+                                               PassThrough{},
+                                               algorithm);
+    ref_invoker.Run(ref_argument);
+}
+
+} // namespace
+
+TEST(ReferenceCGemm, ExactOnIntegers)
+{
+    const std::size_t M = 37, N = 70, K = 45;
+    Tensor<ck::half_t> a_real({M, K}), a_imag({M, K}), b_real({K, N}), b_imag({K, N});
+    for(auto* t : {&a_real, &a_imag, &b_real, &b_imag})
+        t->GenerateTensorValue(GeneratorTensor_2<ck::half_t>{-8, 9});
+
+    Tensor<float> c_real({M, N}), c_imag({M, N}), c_real_ref({M, N}), c_imag_ref({M, N});
+    naive_cgemm(a_real, a_imag, b_real, b_imag, c_real_ref, c_imag_ref);
+
+    for(auto algorithm : {CGemmAlgorithm::Gauss3M, CGemmAlgorithm::Exact4M})
+    {
+        run_cgemm(a_real, a_imag, b_real, b_imag, c_real, c_imag, algorithm);
+        EXPECT_TRUE(ck::utils::check_err(c_real.mData, c_real_ref.mData, "real", 0, 0));
+        EXPECT_TRUE(ck::utils::check_err(c_imag.mData, c_imag_ref.mData, "imag", 0, 0));
+    }
+}
+
+TEST(ReferenceCGemm, Algorithms)
+{
+    const std::size_t M = 64, N = 48, K = 256;
+    Tensor<float> a_real({M, K}), a_imag({M, K}), b_real({K, N}), b_imag({K, N});
+    for(auto* t : {&a_real, &a_imag, &b_real, &b_imag})
+        t->GenerateTensorValue(GeneratorTensor_3<float>{-1.f, 1.f});
+
+    Tensor<float> c_real({M, N}), c_imag({M, N}), c_real_ref({M, N}), c_imag_ref({M, N});
+    naive_cgemm(a_real, a_imag, b_real, b_imag, c_real_ref, c_imag_ref);
+
+    run_cgemm(a_real, a_imag, b_real, b_imag, c_real, c_imag, CGemmAlgorithm::Exact4M);
+    EXPECT_TRUE(ck::utils::check_err(c_real.mData, c_real_ref.mData, "real", 1e-5, 1e-5));
+    EXPECT_TRUE(ck::utils::check_err(c_imag.mData, c_imag_ref.mData, "imag", 1e-5, 1e-5));
+
+    run_cgemm(a_real, a_imag, b_real, b_imag, c_real, c_imag, CGemmAlgorithm::Gauss3M);
+    EXPECT_TRUE(ck::utils::check_err(c_real.mData, c_real_ref.mData, "real", 1e-4, 1e-4));
+    EXPECT_TRUE(ck::utils::check_err(c_imag.mData, c_imag_ref.mData, "imag", 1e-4, 1e-4));
+}
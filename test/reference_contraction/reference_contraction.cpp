@@ -0,0 +1,158 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_contraction.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using Scale       = ck::tensor_operation::element_wise::Scale;
+
+// C[ms, ns] = sum_ks A[ms, ks] * B[ns, ks], one element at a time
+template <typename T>
+Tensor<float> naive_contraction(const TensorView<const T>& a_ms_ks,
+                                const TensorView<const T>& b_ns_ks,
+                                std::size_t num_dim_m,
+                                std::size_t num_dim_n,
+                                float scale_a = 1.f)
+{
+    const auto& a_lengths = a_ms_ks.GetLengths();
+    const auto& b_lengths = b_ns_ks.GetLengths();
+
+    std::vector<std::size_t> c_lengths(a_lengths.begin(), a_lengths.begin() + num_dim_m);
+    c_lengths.insert(c_lengths.end(), b_lengths.begin(), b_lengths.begin() + num_dim_n);
+    const std::vector<std::size_t> k_lengths(a_lengths.begin() + num_dim_m, a_lengths.end());
+
+    Tensor<float> c(c_lengths);
+    c.ForEach([&](auto& self, auto idx) {
+        std::vector<std::size_t> a_idx(idx.begin(), idx.begin() + num_dim_m);
+        std::vector<std::size_t> b_idx(idx.begin() + num_dim_m, idx.end());
+        a_idx.resize(a_lengths.size(), 0);
+        b_idx.resize(b_lengths.size(), 0);
+
+        float acc = 0;
+        Tensor<char>(k_lengths).ForEach([&](auto&, auto k_idx) {
+            for(std::size_t d = 0; d < k_idx.size(); ++d)
+            {
+                a_idx[num_dim_m + d] = k_idx[d];
+                b_idx[num_dim_n + d] = k_idx[d];
+            }
+            acc += scale_a * ck::type_convert<float>(a_ms_ks(a_idx)) *
+                   ck::type_convert<float>(b_ns_ks(b_idx));
+        });
+        self(idx) = acc;
+    });
+    return c;
+}
+
+template <ck::index_t NumDimM, ck::index_t NumDimN, ck::index_t NumDimK, typename T = float>
+void test_contraction(const std::vector<std::size_t>& a_lengths,
+                      const std::vector<std::size_t>& a_new2old,
+                      const std::vector<std::size_t>& b_lengths,
+                      const std::vector<std::size_t>& b_new2old,
+                      const std::vector<std::size_t>& c_new2old)
+{
+    // A, B and C are views of packed tensors, whose dimension i is dimension new2old[i]
+    Tensor<T> a_packed(a_lengths);
+    Tensor<T> b_packed(b_lengths);
+    // GenerateTensorValue stops at 6 dimensions
+    std::generate(a_packed.mData.begin(), a_packed.mData.end(), GeneratorTensor_2<T>{-3, 4});
+    std::generate(b_packed.mData.begin(), b_packed.mData.end(), GeneratorTensor_2<T>{-3, 4});
+    const auto a_ms_ks = make_tensor_view(std::as_const(a_packed)).Permute(a_new2old);
+    const auto b_ns_ks = make_tensor_view(std::as_const(b_packed)).Permute(b_new2old);
+
+    const auto c_ref = naive_contraction(a_ms_ks, b_ns_ks, NumDimM, NumDimN);
+
+    std::vector<std::size_t> c_lengths(c_ref.GetNumOfDimension());
+    for(std::size_t i = 0; i < c_new2old.size(); ++i)
+        c_lengths[c_new2old[i]] = c_ref.GetLengths()[i];
+    Tensor<float> c_packed(c_lengths);
+    const auto c_ms_ns = make_tensor_view(c_packed).Permute(c_new2old);
+
+    using ReferenceContraction = ck::tensor_operation::host::ReferenceContraction<NumDimM,
+                                                                                  NumDimN,
+                                                                                  NumDimK,
+                                                                                  T,
+                                                                                  T,
+                                                                                  float,
+                                                                                  float,
+                                                                                  float,
+                                                                                  PassThrough,
+                                                                                  PassThrough>;
+    auto ref_op       = ReferenceContraction{};
+    auto ref_invoker  = ref_op.MakeInvoker();
+    auto ref_argument =
+        ref_op.MakeArgument(a_ms_ks, b_ns_ks, c_ms_ns, PassThrough{}, PassThrough{});
+    ref_invoker.Run(ref_argument);
+
+    EXPECT_TRUE(ck::utils::check_err(to_packed_tensor(c_ms_ns).mData, c_ref.mData));
+}
+
+} // namespace
+
+TEST(ReferenceContraction, SingleModes)
+{
+    // a plain GEMM, with A and B in either layout
+    test_contraction<1, 1, 1>({37, 53}, {0, 1}, {45, 53}, {0, 1}, {0, 1});
+    test_contraction<1, 1, 1>({53, 37}, {1, 0}, {53, 45}, {1, 0}, {1, 0});
+}
+
+TEST(ReferenceContraction, HighRank)
+{
+    // [M0, M1, M2, K0, K1, K2, K3] x [N0, N1, K0, K1, K2, K3] with permuted layouts
+    test_contraction<3, 2, 4>({3, 5, 2, 4, 2, 3, 2},
+                              {0, 1, 2, 3, 4, 5, 6},
+                              {7, 3, 4, 2, 3, 2},
+                              {0, 1, 2, 3, 4, 5},
+                              {0, 1, 2, 3, 4});
+    test_contraction<3, 2, 4, ck::half_t>({2, 3, 4, 2, 5, 3, 2},
+                                          {6, 0, 3, 1, 5, 2, 4},
+                                          {3, 5, 7, 3, 4, 2},
+                                          {2, 5, 0, 3, 4, 1},
+                                          {4, 2, 0, 3, 1});
+    // with a mode of length 1
+    test_contraction<1, 4, 2>(
+        {5, 6, 7}, {2, 0, 1}, {5, 2, 3, 6, 1, 4}, {1, 2, 4, 5, 0, 3}, {4, 3, 2, 1, 0});
+}
+
+TEST(ReferenceContraction, M2N2K2)
+{
+    Tensor<float> a({4, 5, 6, 7});
+    Tensor<float> b({3, 8, 6, 7});
+    Tensor<float> c({4, 5, 3, 8});
+    a.GenerateTensorValue(GeneratorTensor_2<float>{-3, 4});
+    b.GenerateTensorValue(GeneratorTensor_2<float>{-3, 4});
+
+    using ReferenceContraction =
+        ck::tensor_operation::host::ReferenceContraction_M2_N2_K2<2,
+                                                                  2,
+                                                                  2,
+                                                                  float,
+                                                                  float,
+                                                                  float,
+                                                                  float,
+                                                                  float,
+                                                                  Scale,
+                                                                  PassThrough>;
+    auto ref_op       = ReferenceContraction{};
+    auto ref_invoker  = ref_op.MakeInvoker();
+    auto ref_argument = ref_op.MakeArgument(a, b, c, Scale{2.f}, PassThrough{});
+    ref_invoker.Run(ref_argument);
+
+    const auto c_ref = naive_contraction(
+        make_tensor_view(std::as_const(a)), make_tensor_view(std::as_const(b)), 2, 2, 2.f);
+    EXPECT_TRUE(ck::utils::check_err(c.mData, c_ref.mData));
+}
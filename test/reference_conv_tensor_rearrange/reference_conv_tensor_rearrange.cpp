@@ -0,0 +1,235 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstddef>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/device/tensor_layout.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_column_to_image.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_image_to_column.hpp"
+
+namespace {
+
+using ck::index_t;
+using ck::long_index_t;
+
+struct RearrangeParam
+{
+    std::size_t G;
+    std::size_t N;
+    std::size_t C;
+    std::vector<std::size_t> in_lengths;
+    std::vector<index_t> filter;
+    std::vector<index_t> strides;
+    std::vector<index_t> dilations;
+    std::vector<index_t> left_pads;
+    std::vector<index_t> right_pads;
+    // image in NDHWGC and columns in [NDoHoWo, G, CZYX], like the profilers do for G > 1
+    bool groups_inner;
+
+    std::vector<std::size_t> OutLengths() const
+    {
+        std::vector<std::size_t> out;
+        for(std::size_t i = 0; i < in_lengths.size(); ++i)
+            out.push_back((in_lengths[i] + left_pads[i] + right_pads[i] -
+                           (filter[i] - 1) * dilations[i] - 1) /
+                              strides[i] +
+                          1);
+        return out;
+    }
+
+    template <typename T>
+    Tensor<T> MakeImage() const
+    {
+        std::vector<std::size_t> lengths{G, N, C};
+        lengths.insert(lengths.end(), in_lengths.begin(), in_lengths.end());
+
+        // channels last, then the groups when inner, then the spatial dimensions, then N
+        std::vector<std::size_t> strides(lengths.size());
+        std::size_t stride = C;
+        strides[2]         = 1;
+        if(groups_inner)
+        {
+            strides[0] = stride;
+            stride *= G;
+        }
+        for(std::size_t i = lengths.size(); i-- > 3;)
+        {
+            strides[i] = stride;
+            stride *= lengths[i];
+        }
+        strides[1] = stride;
+        stride *= N;
+        if(!groups_inner)
+            strides[0] = stride;
+
+        return Tensor<T>(lengths, strides);
+    }
+
+    template <typename T>
+    Tensor<T> MakeColumns() const
+    {
+        std::size_t M = N, K = C;
+        for(auto l : OutLengths())
+            M *= l;
+        for(auto x : filter)
+            K *= x;
+
+        if(groups_inner)
+            return Tensor<T>(std::vector<std::size_t>{G, M, K},
+                             std::vector<std::size_t>{K, K * G, 1});
+        return Tensor<T>(std::vector<std::size_t>{G, M, K});
+    }
+};
+
+// Calls f(g, n, c, image multi-index, row, column) for every element of the columns that is not
+// in the padding, in the order of the former sequential references
+template <typename F>
+void for_each_pair(const RearrangeParam& p, F f)
+{
+    const auto out_lengths = p.OutLengths();
+    const std::size_t ndim = p.in_lengths.size();
+
+    std::size_t num_out = 1, num_taps = 1;
+    for(std::size_t i = 0; i < ndim; ++i)
+    {
+        num_out *= out_lengths[i];
+        num_taps *= p.filter[i];
+    }
+
+    for(std::size_t g = 0; g < p.G; ++g)
+        for(std::size_t n = 0; n < p.N; ++n)
+            for(std::size_t o = 0; o < num_out; ++o)
+                for(std::size_t t = 0; t < num_taps; ++t)
+                    for(std::size_t c = 0; c < p.C; ++c)
+                    {
+                        std::vector<std::size_t> idx{g, n, c};
+                        std::size_t rest_o = o, rest_t = t;
+                        std::vector<long_index_t> pos(ndim);
+                        for(std::size_t i = ndim; i-- > 0;)
+                        {
+                            pos[i] = static_cast<long_index_t>(rest_o % out_lengths[i]) *
+                                         p.strides[i] +
+                                     static_cast<long_index_t>(rest_t % p.filter[i]) *
+                                         p.dilations[i] -
+                                     p.left_pads[i];
+                            rest_o /= out_lengths[i];
+                            rest_t /= p.filter[i];
+                        }
+
+                        bool inside = true;
+                        for(std::size_t i = 0; i < ndim; ++i)
+                        {
+                            inside = inside && pos[i] >= 0 &&
+                                     pos[i] < static_cast<long_index_t>(p.in_lengths[i]);
+                            idx.push_back(pos[i]);
+                        }
+                        if(inside)
+                            f(idx, n * num_out + o, t * p.C + c);
+                    }
+}
+
+const std::vector<RearrangeParam> params = {
+    {1, 3, 5, {17}, {3}, {2}, {1}, {1}, {1}, false},
+    {1, 2, 4, {9, 11}, {3, 5}, {1, 2}, {1, 2}, {1, 3}, {2, 3}, false},
+    {2, 2, 3, {10, 7}, {4, 2}, {3, 1}, {1, 1}, {2, 0}, {0, 1}, true},
+    {1, 2, 4, {5, 6, 7}, {2, 3, 3}, {1, 2, 1}, {2, 1, 1}, {1, 1, 1}, {0, 1, 1}, false},
+    {3, 1, 2, {6, 5, 8}, {3, 3, 2}, {2, 1, 3}, {1, 1, 1}, {1, 0, 2}, {1, 1, 0}, true}};
+
+template <index_t NDimSpatial, typename T>
+void run_image_to_column(const RearrangeParam& p, std::mt19937& gen)
+{
+    using ImageToColumn = ck::tensor_operation::host::
+        ReferenceImageToColumn<NDimSpatial, ck::tensor_layout::convolution::GNDHWC, T, T>;
+
+    auto image       = p.MakeImage<T>();
+    auto columns     = p.MakeColumns<T>();
+    auto columns_ref = p.MakeColumns<T>();
+
+    std::uniform_int_distribution<int> dist(-9, 9);
+    for(auto& v : image.mData)
+        v = ck::type_convert<T>(static_cast<float>(dist(gen)));
+    // the padding is written with zeros
+    for(auto& v : columns.mData)
+        v = ck::type_convert<T>(1.f);
+
+    auto ref         = ImageToColumn{};
+    auto ref_invoker = ref.MakeInvoker();
+    auto ref_argument = ref.MakeArgument(
+        image, columns, p.filter, p.strides, p.dilations, p.left_pads, p.right_pads);
+    ref_invoker.Run(ref_argument);
+
+    for_each_pair(p, [&](const auto& idx, auto row, auto column) {
+        columns_ref(idx[0], row, column) = image(idx);
+    });
+
+    EXPECT_TRUE(ck::utils::check_err(columns.mData, columns_ref.mData));
+}
+
+template <index_t NDimSpatial, typename T>
+void run_column_to_image(const RearrangeParam& p, std::mt19937& gen)
+{
+    using ColumnToImage = ck::tensor_operation::host::
+        ReferenceColumnToImage<NDimSpatial, ck::tensor_layout::convolution::GNDHWC, T, T>;
+
+    auto columns   = p.MakeColumns<T>();
+    auto image     = p.MakeImage<T>();
+    auto image_ref = p.MakeImage<T>();
+
+    // values whose sums round in half, so that the order of the accumulation matters
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    for(auto& v : columns.mData)
+        v = ck::type_convert<T>(dist(gen));
+    for(std::size_t i = 0; i < image.mData.size(); ++i)
+        image.mData[i] = image_ref.mData[i] = ck::type_convert<T>(dist(gen));
+
+    auto ref         = ColumnToImage{};
+    auto ref_invoker = ref.MakeInvoker();
+    auto ref_argument = ref.MakeArgument(
+        columns, image, p.filter, p.strides, p.dilations, p.left_pads, p.right_pads);
+    ref_invoker.Run(ref_argument);
+
+    for_each_pair(p, [&](const auto& idx, auto row, auto column) {
+        image_ref(idx) = ck::type_convert<T>(ck::type_convert<float>(columns(idx[0], row, column)) +
+                                             ck::type_convert<float>(image_ref(idx)));
+    });
+
+    EXPECT_TRUE(ck::utils::check_err(image.mData, image_ref.mData, "Error", 0, 0));
+}
+
+template <typename T>
+void run_all(bool column_to_image)
+{
+    std::mt19937 gen(21);
+    for(const auto& p : params)
+    {
+        switch(p.in_lengths.size())
+        {
+        case 1:
+            column_to_image ? run_column_to_image<1, T>(p, gen) : run_image_to_column<1, T>(p, gen);
+            break;
+        case 2:
+            column_to_image ? run_column_to_image<2, T>(p, gen) : run_image_to_column<2, T>(p, gen);
+            break;
+        case 3:
+            column_to_image ? run_column_to_image<3, T>(p, gen) : run_image_to_column<3, T>(p, gen);
+            break;
+        }
+    }
+}
+
+} // namespace
+
+TEST(ReferenceImageToColumn, F32) { run_all<float>(false); }
+
+TEST(ReferenceImageToColumn, F16) { run_all<ck::half_t>(false); }
+
+TEST(ReferenceColumnToImage, F32) { run_all<float>(true); }
+
+TEST(ReferenceColumnToImage, F16) { run_all<ck::half_t>(true); }
@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_fpAintB_gemm.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using ck::tensor_operation::host::fpAintBQuantization;
+
+using ReferenceGemm = ck::tensor_operation::host::ReferencefpAintBGemm<ck::half_t,
+                                                                        int8_t,
+                                                                        ck::half_t,
+                                                                        ck::half_t,
+                                                                        float,
+                                                                        PassThrough,
+                                                                        PassThrough,
+                                                                        PassThrough>;
+
+// c = a * (b * scale), one dequantization per multiply-add with the scales of row
+// k / scale_k_group
+Tensor<ck::half_t> naive_fpAintB_gemm(const Tensor<ck::half_t>& a,
+                                      const Tensor<int8_t>& b,
+                                      const Tensor<ck::half_t>& scale,
+                                      std::size_t scale_k_group)
+{
+    const std::size_t K = a.GetLengths()[1];
+    Tensor<ck::half_t> c({a.GetLengths()[0], b.GetLengths()[1]});
+    c.ForEach([&](auto& self, auto idx) {
+        float acc = 0;
+        for(std::size_t k = 0; k < K; ++k)
+            acc += ck::type_convert<float>(a(idx[0], k)) *
+                   ck::type_convert<float>(ck::type_convert<ck::half_t>(b(k, idx[1])) *
+                                           scale(k / scale_k_group, idx[1]));
+        self(idx) = ck::type_convert<ck::half_t>(acc);
+    });
+    return c;
+}
+
+void fill(Tensor<ck::half_t>& a, Tensor<int8_t>& b, Tensor<ck::half_t>& scale)
+{
+    ck::utils::FillUniformDistributionIntegerValue<ck::half_t>{-4.f, 4.f}(a.mData);
+    ck::utils::FillUniformDistributionIntegerValue<int8_t>{-8.f, 7.f}(b.mData);
+    ck::utils::FillUniformDistributionIntegerValue<ck::half_t>{1.f, 3.f}(scale.mData);
+}
+
+Tensor<ck::half_t> run_fpAintB_gemm(const Tensor<ck::half_t>& a,
+                                    const Tensor<int8_t>& b,
+                                    const Tensor<ck::half_t>& scale,
+                                    std::size_t N,
+                                    fpAintBQuantization quantization)
+{
+    Tensor<ck::half_t> c({a.GetLengths()[0], N});
+
+    auto ref_gemm     = ReferenceGemm{};
+    auto ref_invoker  = ref_gemm.MakeInvoker();
+    auto ref_argument = ref_gemm.MakeArgument(
+        a, b, scale, c, PassThrough{}, PassThrough{}, PassThrough{}, quantization);
+    ref_invoker.Run(ref_argument);
+    return c;
+}
+
+} // namespace
+
+TEST(ReferencefpAintBGemm, PerChannelScales)
+{
+    const std::size_t M = 37, N = 150, K = 300;
+    Tensor<ck::half_t> a({M, K});
+    Tensor<int8_t> b({K, N});
+    Tensor<ck::half_t> scale(std::vector<std::size_t>{1, N});
+    fill(a, b, scale);
+
+    // one row of scales broadcast over k, as example 64_fpAintB_gemm passes it
+    Tensor<ck::half_t> scale_k_n(std::vector<std::size_t>{K, N}, std::vector<std::size_t>{0, 1});
+    scale_k_n.mData = scale.mData;
+    Tensor<ck::half_t> c({M, N});
+
+    auto ref_gemm     = ReferenceGemm{};
+    auto ref_invoker  = ref_gemm.MakeInvoker();
+    auto ref_argument = ref_gemm.MakeArgument(
+        a, b, scale_k_n, c, PassThrough{}, PassThrough{}, PassThrough{});
+    ref_invoker.Run(ref_argument);
+
+    EXPECT_TRUE(ck::utils::check_err(c.mData, naive_fpAintB_gemm(a, b, scale, K).mData));
+}
+
+TEST(ReferencefpAintBGemm, GroupScales)
+{
+    for(std::size_t group : {32, 64, 128})
+    {
+        const std::size_t M = 20, N = 70, K = 640;
+        Tensor<ck::half_t> a({M, K});
+        Tensor<int8_t> b({K, N});
+        Tensor<ck::half_t> scale({K / group, N});
+        fill(a, b, scale);
+
+        fpAintBQuantization quantization;
+        quantization.scale_k_group = group;
+        const auto c = run_fpAintB_gemm(a, b, scale, N, quantization);
+
+        EXPECT_TRUE(ck::utils::check_err(c.mData, naive_fpAintB_gemm(a, b, scale, group).mData));
+    }
+}
+
+TEST(ReferencefpAintBGemm, PackedInt4)
+{
+    const std::size_t M = 9, N = 65, K = 257;
+    Tensor<ck::half_t> a({M, K});
+    Tensor<int8_t> b({K, N});
+    Tensor<ck::half_t> scale({(K + 31) / 32, N});
+    fill(a, b, scale);
+
+    // the weights of k = 2r and 2r + 1 in the low and high nibble of row r
+    Tensor<int8_t> b_packed({(K + 1) / 2, N});
+    b_packed.ForEach([&](auto& self, auto idx) {
+        const int lo = b(2 * idx[0], idx[1]);
+        const int hi = 2 * idx[0] + 1 < K ? b(2 * idx[0] + 1, idx[1]) : 0;
+        self(idx)    = static_cast<int8_t>((lo & 0xf) | (hi << 4));
+    });
+
+    fpAintBQuantization quantization;
+    quantization.scale_k_group = 32;
+    quantization.packed_int4   = true;
+    const auto c = run_fpAintB_gemm(a, b_packed, scale, N, quantization);
+
+    EXPECT_TRUE(ck::utils::check_err(c.mData, naive_fpAintB_gemm(a, b, scale, 32).mData));
+}
+
+TEST(ReferencefpAintBGemm, ScaleRows)
+{
+    const std::size_t M = 4, N = 8, K = 100;
+    Tensor<ck::half_t> a({M, K});
+    Tensor<int8_t> b({K, N});
+    Tensor<ck::half_t> c({M, N});
+
+    fpAintBQuantization quantization;
+    quantization.scale_k_group = 32;
+
+    auto make_argument = [&](const Tensor<ck::half_t>& scale) {
+        return ReferenceGemm::MakeArgument(
+            a, b, scale, c, PassThrough{}, PassThrough{}, PassThrough{}, quantization);
+    };
+
+    // ceil(100 / 32) = 4 groups of k
+    EXPECT_THROW(make_argument(Tensor<ck::half_t>({K / 32, N})), std::runtime_error);
+    EXPECT_NO_THROW(make_argument(Tensor<ck::half_t>({(K + 31) / 32, N})));
+    // one row broadcast with stride 0
+    EXPECT_NO_THROW(make_argument(
+        Tensor<ck::half_t>(std::vector<std::size_t>{1, N}, std::vector<std::size_t>{0, 1})));
+}
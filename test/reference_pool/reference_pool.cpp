@@ -0,0 +1,289 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/element/element_wise_operation.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/fill.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_avgpool_bwd.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_maxpool_bwd.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_pool_fwd.hpp"
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using ck::index_t;
+
+struct PoolParam
+{
+    std::vector<index_t> window;
+    std::vector<index_t> strides;
+    std::vector<index_t> dilations;
+    std::vector<index_t> left_pads;
+    std::vector<index_t> right_pads;
+
+    std::size_t OutLength(std::size_t i, std::size_t in_length) const
+    {
+        const index_t eff_window = (window[i] - 1) * dilations[i] + 1;
+        return (in_length + left_pads[i] + right_pads[i] - eff_window) / strides[i] + 1;
+    }
+};
+
+template <ck::ReduceTensorOp ReduceOpId, bool PropagateNan, bool OutputIndex>
+using ReferencePool3d = ck::tensor_operation::host::
+    ReferencePoolingFwd<5, 3, float, float, float, int32_t, ReduceOpId, PropagateNan, OutputIndex>;
+
+// [N, C, Di, Hi, Wi] lengths in NDHWC layout, as the pooling profilers create them
+template <typename T>
+Tensor<T> make_ndhwc(std::size_t N, std::size_t C, std::size_t D, std::size_t H, std::size_t W)
+{
+    return Tensor<T>(std::vector<std::size_t>{N, C, D, H, W},
+                     std::vector<std::size_t>{D * H * W * C, 1, H * W * C, W * C, C});
+}
+
+// [N, C, Do, Ho, Wo] output of pooling an input of `in_lengths` in NDHWC layout
+template <typename T>
+Tensor<T> make_pooled(const std::vector<std::size_t>& in_lengths, const PoolParam& p)
+{
+    return make_ndhwc<T>(in_lengths[0],
+                         in_lengths[1],
+                         p.OutLength(0, in_lengths[2]),
+                         p.OutLength(1, in_lengths[3]),
+                         p.OutLength(2, in_lengths[4]));
+}
+
+// input position of tap t of output o along axis i, outside [0, length) when in the padding
+long naive_position(const PoolParam& p, std::size_t i, std::size_t o, index_t t)
+{
+    return static_cast<long>(o) * p.strides[i] + t * p.dilations[i] - p.left_pads[i];
+}
+
+bool inside(long x, std::size_t length) { return x >= 0 && x < static_cast<long>(length); }
+
+// the per-window accumulation in z, y, x order of max pooling with indices, or of avg pooling
+template <bool Max>
+void naive_pool3d_fwd(const Tensor<float>& in,
+                      Tensor<float>& out,
+                      Tensor<int32_t>& out_indices,
+                      const PoolParam& p,
+                      bool propagate_nan)
+{
+    const auto& in_lengths = in.GetLengths();
+
+    out.ForEach([&](auto& self, auto idx) {
+        float acc     = Max ? std::numeric_limits<float>::lowest() : 0.f;
+        int32_t index = 0;
+
+        for(index_t z = 0; z < p.window[0]; ++z)
+            for(index_t y = 0; y < p.window[1]; ++y)
+                for(index_t x = 0; x < p.window[2]; ++x)
+                {
+                    const long di = naive_position(p, 0, idx[2], z);
+                    const long hi = naive_position(p, 1, idx[3], y);
+                    const long wi = naive_position(p, 2, idx[4], x);
+                    if(!inside(di, in_lengths[2]) || !inside(hi, in_lengths[3]) ||
+                       !inside(wi, in_lengths[4]))
+                        continue;
+
+                    const float v = in(idx[0], idx[1], di, hi, wi);
+                    const auto i = static_cast<int32_t>(
+                        in.GetOffsetFromMultiIndex(idx[0], idx[1], di, hi, wi));
+                    if(!Max)
+                        acc += v;
+                    else if(propagate_nan && std::isnan(v))
+                        acc = v, index = i;
+                    else if(acc < v)
+                        acc = v, index = i;
+                }
+
+        self(idx) = Max ? acc : acc / (p.window[0] * p.window[1] * p.window[2]);
+        if(Max)
+            out_indices(idx) = index;
+    });
+}
+
+const std::vector<PoolParam> params = {
+    // the window of a 3D max pooling with padding
+    {{3, 3, 3}, {2, 2, 2}, {1, 1, 1}, {1, 1, 1}, {1, 1, 1}},
+    // windows much larger than the stride, dilated, with asymmetric padding
+    {{7, 5, 9}, {1, 2, 3}, {2, 1, 2}, {3, 0, 4}, {2, 3, 4}},
+    // stride larger than the window
+    {{2, 1, 3}, {3, 4, 5}, {1, 1, 1}, {0, 0, 1}, {0, 0, 1}}};
+
+} // namespace
+
+TEST(ReferencePoolingFwd, MaxWithIndices3d)
+{
+    using ReferencePool = ReferencePool3d<ck::ReduceTensorOp::MAX, false, true>;
+
+    for(const auto& p : params)
+    {
+        // few distinct values, so that most windows hold ties
+        auto in = make_ndhwc<float>(2, 3, 13, 11, 17);
+        ck::utils::FillUniformDistributionIntegerValue<float>{-3.f, 3.f}(in.mData);
+
+        auto out     = make_pooled<float>(in.GetLengths(), p);
+        auto out_ref = out;
+        Tensor<int32_t> indices(out.GetLengths());
+        Tensor<int32_t> indices_ref(out.GetLengths());
+
+        auto ref_pool     = ReferencePool{};
+        auto ref_invoker  = ref_pool.MakeInvoker();
+        auto ref_argument = ref_pool.MakeArgument(
+            in, out, indices, p.window, p.strides, p.dilations, p.left_pads, p.right_pads);
+        ref_invoker.Run(ref_argument);
+
+        naive_pool3d_fwd<true>(in, out_ref, indices_ref, p, false);
+
+        EXPECT_TRUE(ck::utils::check_err(out.mData, out_ref.mData));
+        EXPECT_TRUE(ck::utils::check_err(indices.mData, indices_ref.mData));
+    }
+}
+
+TEST(ReferencePoolingFwd, MaxPropagateNan3d)
+{
+    using ReferencePool = ReferencePool3d<ck::ReduceTensorOp::MAX, true, true>;
+
+    const auto& p = params[1];
+
+    auto in = make_ndhwc<float>(1, 2, 15, 9, 20);
+    ck::utils::FillUniformDistributionIntegerValue<float>{-3.f, 3.f}(in.mData);
+    for(std::size_t i = 0; i < in.mData.size(); i += 37)
+        in.mData[i] = std::numeric_limits<float>::quiet_NaN();
+
+    auto out     = make_pooled<float>(in.GetLengths(), p);
+    auto out_ref = out;
+    Tensor<int32_t> indices(out.GetLengths());
+    Tensor<int32_t> indices_ref(out.GetLengths());
+
+    auto ref_pool     = ReferencePool{};
+    auto ref_invoker  = ref_pool.MakeInvoker();
+    auto ref_argument = ref_pool.MakeArgument(
+        in, out, indices, p.window, p.strides, p.dilations, p.left_pads, p.right_pads);
+    ref_invoker.Run(ref_argument);
+
+    naive_pool3d_fwd<true>(in, out_ref, indices_ref, p, true);
+
+    for(std::size_t i = 0; i < out.mData.size(); ++i)
+    {
+        ASSERT_EQ(std::isnan(out.mData[i]), std::isnan(out_ref.mData[i]));
+        if(!std::isnan(out_ref.mData[i]))
+            EXPECT_EQ(out.mData[i], out_ref.mData[i]);
+    }
+    EXPECT_TRUE(ck::utils::check_err(indices.mData, indices_ref.mData));
+}
+
+TEST(ReferencePoolingFwd, Avg3d)
+{
+    using ReferencePool = ReferencePool3d<ck::ReduceTensorOp::AVG, false, false>;
+
+    for(const auto& p : params)
+    {
+        auto in = make_ndhwc<float>(2, 3, 13, 11, 17);
+        ck::utils::FillUniformDistributionIntegerValue<float>{-8.f, 8.f}(in.mData);
+
+        auto out     = make_pooled<float>(in.GetLengths(), p);
+        auto out_ref = out;
+        Tensor<int32_t> indices(out.GetLengths());
+
+        auto ref_pool     = ReferencePool{};
+        auto ref_invoker  = ref_pool.MakeInvoker();
+        auto ref_argument = ref_pool.MakeArgument(
+            in, out, indices, p.window, p.strides, p.dilations, p.left_pads, p.right_pads);
+        ref_invoker.Run(ref_argument);
+
+        naive_pool3d_fwd<false>(in, out_ref, indices, p, false);
+
+        EXPECT_TRUE(ck::utils::check_err(out.mData, out_ref.mData));
+    }
+}
+
+TEST(ReferenceAvgPoolBwd, Avg3d)
+{
+    using ReferencePoolBwd = ck::tensor_operation::host::ReferenceAvgPoolBwd<3, float, float>;
+
+    for(const auto& p : params)
+    {
+        auto din     = make_ndhwc<float>(2, 3, 13, 11, 17);
+        auto din_ref = din;
+
+        const auto& l = din.GetLengths();
+        auto dout = make_pooled<float>(l, p);
+        ck::utils::FillUniformDistributionIntegerValue<float>{-8.f, 8.f}(dout.mData);
+
+        auto ref_pool     = ReferencePoolBwd{};
+        auto ref_invoker  = ref_pool.MakeInvoker();
+        auto ref_argument = ref_pool.MakeArgument(
+            din, dout, p.window, p.strides, p.dilations, p.left_pads, p.right_pads);
+        ref_invoker.Run(ref_argument);
+
+        // scatter of every output gradient to the inputs of its window
+        const auto& o = dout.GetLengths();
+        Tensor<float> sums(l);
+        for(std::size_t n = 0; n < o[0]; ++n)
+            for(std::size_t c = 0; c < o[1]; ++c)
+                for(std::size_t do_ = 0; do_ < o[2]; ++do_)
+                    for(std::size_t ho = 0; ho < o[3]; ++ho)
+                        for(std::size_t wo = 0; wo < o[4]; ++wo)
+                            for(index_t z = 0; z < p.window[0]; ++z)
+                                for(index_t y = 0; y < p.window[1]; ++y)
+                                    for(index_t x = 0; x < p.window[2]; ++x)
+                                    {
+                                        const long di = naive_position(p, 0, do_, z);
+                                        const long hi = naive_position(p, 1, ho, y);
+                                        const long wi = naive_position(p, 2, wo, x);
+                                        if(inside(di, l[2]) && inside(hi, l[3]) &&
+                                           inside(wi, l[4]))
+                                            sums(n, c, di, hi, wi) += dout(n, c, do_, ho, wo);
+                                    }
+        din_ref.ForEach([&](auto& self, auto idx) {
+            self(idx) = sums(idx) / (p.window[0] * p.window[1] * p.window[2]);
+        });
+
+        EXPECT_TRUE(ck::utils::check_err(din.mData, din_ref.mData));
+    }
+}
+
+TEST(ReferenceMaxPoolBwd, GatherMatchesScatter)
+{
+    using ReferencePoolBwd = ck::tensor_operation::host::
+        ReferenceMaxPoolBwd<ck::half_t, int32_t, float, ck::half_t, PassThrough>;
+
+    std::mt19937 gen(15);
+
+    Tensor<ck::half_t> dout({5, 7, 11});
+    Tensor<int32_t> indices({5, 7, 11});
+    Tensor<ck::half_t> din({4, 9, 6});
+    ck::utils::FillUniformDistributionIntegerValue<ck::half_t>{-4.f, 4.f}(dout.mData);
+
+    // many outputs per input, and indices outside din that are skipped
+    std::uniform_int_distribution<int32_t> index_dist(-2, din.GetElementSpaceSize() / 3);
+    for(auto& i : indices.mData)
+        i = index_dist(gen);
+
+    auto ref_pool     = ReferencePoolBwd{};
+    auto ref_invoker  = ref_pool.MakeInvoker();
+    auto ref_argument = ref_pool.MakeArgument(dout, indices, din, PassThrough{});
+    ref_invoker.Run(ref_argument);
+
+    std::vector<float> din_ref(din.GetElementSpaceSize(), 0);
+    for(std::size_t i = 0; i < dout.mData.size(); ++i)
+        if(indices.mData[i] >= 0 && indices.mData[i] < static_cast<int32_t>(din_ref.size()))
+            din_ref[indices.mData[i]] += ck::type_convert<float>(dout.mData[i]);
+
+    std::vector<ck::half_t> din_ref_half(din_ref.size());
+    for(std::size_t i = 0; i < din_ref.size(); ++i)
+        din_ref_half[i] = ck::type_convert<ck::half_t>(din_ref[i]);
+
+    EXPECT_TRUE(ck::utils::check_err(din.mData, din_ref_half));
+}
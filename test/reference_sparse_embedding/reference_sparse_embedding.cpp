@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+
+#include "ck/library/utility/check_err.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_generator.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_sparse_embedding3_forward_layernorm.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_sparse_embeddings_forward_layernorm.hpp"
+
+namespace {
+
+using ck::index_t;
+
+Tensor<index_t> make_indexes(std::size_t length, index_t num_rows)
+{
+    Tensor<index_t> indexes({length});
+    indexes.GenerateTensorValue(GeneratorTensor_2<index_t>{0, num_rows});
+    return indexes;
+}
+
+template <typename F, std::size_t... Is>
+auto make_array(F f, std::index_sequence<Is...>)
+{
+    return std::array<decltype(f(0)), sizeof...(Is)>{f(Is)...};
+}
+
+// {f(0), ..., f(N - 1)}, for the tensors that can not be default constructed
+template <std::size_t N, typename F>
+auto make_array(F f)
+{
+    return make_array(f, std::make_index_sequence<N>{});
+}
+
+// the tensors as the references take the tables and lookups
+template <typename T, std::size_t N>
+std::array<const Tensor<T>*, N> pointers(const std::array<Tensor<T>, N>& tensors)
+{
+    std::array<const Tensor<T>*, N> p;
+    for(std::size_t t = 0; t < N; ++t)
+        p[t] = &tensors[t];
+    return p;
+}
+
+// layernorm of the summed lookups in double, two passes
+template <typename EmbType, std::size_t N>
+Tensor<float> naive_embeddings_layernorm(const std::array<Tensor<EmbType>, N>& embs,
+                                         const std::array<Tensor<index_t>, N>& indexes,
+                                         const Tensor<float>& gamma,
+                                         const Tensor<float>& beta,
+                                         std::size_t D,
+                                         std::size_t L,
+                                         double epsilon)
+{
+    Tensor<float> out({L, D});
+    std::vector<double> x(D);
+    for(std::size_t l = 0; l < L; ++l)
+    {
+        double mean = 0;
+        for(std::size_t d = 0; d < D; ++d)
+        {
+            x[d] = 0;
+            for(std::size_t t = 0; t < N; ++t)
+                x[d] += ck::type_convert<float>(embs[t](indexes[t](l), d));
+            mean += x[d];
+        }
+        mean /= D;
+
+        double var = 0;
+        for(std::size_t d = 0; d < D; ++d)
+            var += (x[d] - mean) * (x[d] - mean);
+        var /= D;
+
+        for(std::size_t d = 0; d < D; ++d)
+            out(l, d) = (x[d] - mean) / std::sqrt(var + epsilon) * gamma(d) + beta(d);
+    }
+    return out;
+}
+
+template <typename EmbType>
+void run_embedding3(std::size_t num_rows, std::size_t D, std::size_t L)
+{
+    // an offset mean, where E[x^2] - E[x]^2 cancels
+    const auto embs = make_array<3>([&](auto) {
+        Tensor<EmbType> emb({num_rows, D});
+        emb.GenerateTensorValue(GeneratorTensor_3<EmbType>{7.f, 9.f});
+        return emb;
+    });
+    const auto indexes = make_array<3>([&](auto) { return make_indexes(L, num_rows); });
+    Tensor<float> gamma({D});
+    Tensor<float> beta({D});
+    gamma.GenerateTensorValue(GeneratorTensor_3<float>{-1.f, 1.f});
+    beta.GenerateTensorValue(GeneratorTensor_3<float>{-1.f, 1.f});
+
+    Tensor<float> out({L, D});
+    using Reference = ck::tensor_operation::host::
+        ReferenceSparseEmbedding3ForwardLayernorm<EmbType, index_t, float, float, float, float>;
+    auto argument = Reference::MakeArgument(out,
+                                            embs[0],
+                                            embs[1],
+                                            embs[2],
+                                            indexes[0],
+                                            indexes[1],
+                                            indexes[2],
+                                            gamma,
+                                            beta,
+                                            num_rows,
+                                            D,
+                                            L,
+                                            1e-4f);
+    Reference::MakeInvoker().Run(argument);
+
+    const auto ref = naive_embeddings_layernorm(embs, indexes, gamma, beta, D, L, 1e-4);
+    EXPECT_TRUE(ck::utils::check_err(out.mData, ref.mData, "Error: wrong result", 1e-4, 1e-4));
+}
+
+} // namespace
+
+TEST(ReferenceSparseEmbedding, Embedding3F32) { run_embedding3<float>(100, 300, 50); }
+
+TEST(ReferenceSparseEmbedding, Embedding3F16) { run_embedding3<ck::half_t>(64, 257, 37); }
+
+TEST(ReferenceSparseEmbedding, Embeddings5)
+{
+    constexpr index_t N    = 5;
+    const std::size_t rows = 40;
+    const std::size_t D    = 130;
+    const std::size_t L    = 21;
+
+    // transposed tables, whose rows are strided
+    const auto embs = make_array<N>([&](auto) {
+        Tensor<float> emb(std::vector<std::size_t>{rows, D}, std::vector<std::size_t>{1, rows});
+        emb.GenerateTensorValue(GeneratorTensor_3<float>{-1.f, 1.f});
+        return emb;
+    });
+    const auto indexes = make_array<N>([&](auto) { return make_indexes(L, rows); });
+    Tensor<float> gamma({D});
+    Tensor<float> beta({D});
+    gamma.GenerateTensorValue(GeneratorTensor_3<float>{-1.f, 1.f});
+    beta.GenerateTensorValue(GeneratorTensor_3<float>{-1.f, 1.f});
+
+    Tensor<float> out({L, D});
+    using Reference = ck::tensor_operation::host::
+        ReferenceSparseEmbeddingsForwardLayernorm<float, index_t, float, float, float, float, N>;
+    auto argument = Reference::MakeArgument(
+        out, pointers(embs), pointers(indexes), gamma, beta, rows, D, L, 1e-5f);
+    Reference::MakeInvoker().Run(argument);
+
+    const auto ref = naive_embeddings_layernorm(embs, indexes, gamma, beta, D, L, 1e-5);
+    EXPECT_TRUE(ck::utils::check_err(out.mData, ref.mData, "Error: wrong result", 1e-4, 1e-4));
+}
+
+TEST(ReferenceSparseEmbedding, OutOfRange)
+{
+    std::array<Tensor<float>, 2> embs{Tensor<float>({4, 8}), Tensor<float>({4, 8})};
+    std::array<Tensor<index_t>, 2> indexes{Tensor<index_t>({3}), Tensor<index_t>({3})};
+    for(auto& i : indexes[0].mData)
+        i = 1;
+    indexes[1].mData = {0, 4, 2};
+    Tensor<float> gamma({8});
+    Tensor<float> beta({8});
+    Tensor<float> out({3, 8});
+
+    using Reference = ck::tensor_operation::host::
+        ReferenceSparseEmbeddingsForwardLayernorm<float, index_t, float, float, float, float, 2>;
+    auto argument = Reference::MakeArgument(
+        out, pointers(embs), pointers(indexes), gamma, beta, 4, 8, 3, 1e-5f);
+    EXPECT_THROW(Reference::MakeInvoker().Run(argument), std::runtime_error);
+}
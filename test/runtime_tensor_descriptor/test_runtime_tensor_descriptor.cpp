@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_description/tensor_descriptor.hpp"
+#include "ck/tensor_description/tensor_descriptor_helper.hpp"
+#include "ck/tensor_description/tensor_adaptor.hpp"
+#include "ck/tensor_description/multi_index_transform_helper.hpp"
+
+#include "ck/library/utility/runtime_tensor_descriptor.hpp"
+
+using namespace ck;
+using ck::utils::RuntimeTensorDescriptor;
+using ck::utils::RuntimeTransform;
+
+namespace {
+
+// walks every visible index of the constexpr descriptor and compares offset and validity against
+// the runtime interpreter
+template <typename Desc>
+void check_against_constexpr(const Desc& desc, const RuntimeTensorDescriptor& rt_desc)
+{
+    constexpr index_t NDim = Desc::GetNumOfDimension();
+
+    ASSERT_EQ(rt_desc.GetNumOfDimension(), NDim);
+
+    std::vector<long_index_t> lengths(NDim);
+    static_for<0, NDim, 1>{}([&](auto i) { lengths[i] = desc.GetLength(i); });
+    EXPECT_EQ(rt_desc.GetLengths(), lengths);
+    EXPECT_EQ(rt_desc.GetElementSpaceSize(), static_cast<long_index_t>(desc.GetElementSpaceSize()));
+
+    const auto rt_offsets = rt_desc.CalculateAllOffsets();
+    ASSERT_EQ(rt_offsets.size(), static_cast<std::size_t>(desc.GetElementSize()));
+
+    std::vector<index_t> counter(NDim, 0);
+    for(std::size_t j = 0; j < rt_offsets.size(); ++j)
+    {
+        MultiIndex<NDim> idx;
+        static_for<0, NDim, 1>{}([&](auto i) { idx(i) = counter[i]; });
+
+        const auto coord = make_tensor_coordinate(desc, idx);
+
+        if(coordinate_has_valid_offset(desc, coord))
+            EXPECT_EQ(rt_offsets[j], coord.GetOffset()) << "at linear index " << j;
+        else
+            EXPECT_EQ(rt_offsets[j], -1) << "at linear index " << j;
+
+        for(index_t i = NDim - 1; i >= 0; --i)
+        {
+            if(++counter[i] < lengths[i])
+                break;
+            counter[i] = 0;
+        }
+    }
+}
+
+} // namespace
+
+TEST(RuntimeTensorDescriptor, NaiveStrided)
+{
+    const auto desc = make_naive_tensor_descriptor(make_tuple(3, 4, 5), make_tuple(40, 8, 1));
+    const auto rt_desc = ck::utils::make_runtime_tensor_descriptor(desc);
+
+    check_against_constexpr(desc, rt_desc);
+    EXPECT_EQ(rt_desc.CalculateOffset({2, 3, 4}), 2 * 40 + 3 * 8 + 4);
+
+    const auto built = ck::utils::make_runtime_naive_tensor_descriptor({3, 4, 5}, {40, 8, 1});
+    EXPECT_EQ(built.CalculateAllOffsets(), rt_desc.CalculateAllOffsets());
+}
+
+TEST(RuntimeTensorDescriptor, PadMergeUnMerge)
+{
+    // NHWC input viewed as the A matrix of an implicit GEMM with 1x1 filter and padding
+    constexpr index_t N = 2, Hi = 5, Wi = 6, C = 3;
+
+    const auto in_n_hi_wi_c = make_naive_tensor_descriptor_packed(make_tuple(N, Hi, Wi, C));
+
+    const auto in_n_hip_wip_c = transform_tensor_descriptor(
+        in_n_hi_wi_c,
+        make_tuple(make_pass_through_transform(N),
+                   make_pad_transform(Hi, 1, 2),
+                   make_pad_transform(Wi, 2, 1),
+                   make_pass_through_transform(C)),
+        make_tuple(Sequence<0>{}, Sequence<1>{}, Sequence<2>{}, Sequence<3>{}),
+        make_tuple(Sequence<0>{}, Sequence<1>{}, Sequence<2>{}, Sequence<3>{}));
+
+    const auto in_gemmm_gemmk = transform_tensor_descriptor(
+        in_n_hip_wip_c,
+        make_tuple(make_merge_transform(make_tuple(N, Hi + 3, Wi + 3)),
+                   make_pass_through_transform(C)),
+        make_tuple(Sequence<0, 1, 2>{}, Sequence<3>{}),
+        make_tuple(Sequence<0>{}, Sequence<1>{}));
+
+    const auto in_gemmm0_gemmm1_gemmk = transform_tensor_descriptor(
+        in_gemmm_gemmk,
+        make_tuple(make_unmerge_transform(make_tuple(N * (Hi + 3), Wi + 3)),
+                   make_pass_through_transform(C)),
+        make_tuple(Sequence<0>{}, Sequence<1>{}),
+        make_tuple(Sequence<1, 0>{}, Sequence<2>{}));
+
+    check_against_constexpr(in_gemmm_gemmk,
+                            ck::utils::make_runtime_tensor_descriptor(in_gemmm_gemmk));
+    check_against_constexpr(in_gemmm0_gemmm1_gemmk,
+                            ck::utils::make_runtime_tensor_descriptor(in_gemmm0_gemmm1_gemmk));
+
+    // the same chain built without instantiating it
+    auto rt = ck::utils::make_runtime_naive_tensor_descriptor_packed({N, Hi, Wi, C});
+    rt      = ck::utils::transform_runtime_tensor_descriptor(
+        rt,
+        {RuntimeTransform::MakePassThrough(N),
+         RuntimeTransform::MakePad(Hi, 1, 2),
+         RuntimeTransform::MakePad(Wi, 2, 1),
+         RuntimeTransform::MakePassThrough(C)},
+        {{0}, {1}, {2}, {3}},
+        {{0}, {1}, {2}, {3}});
+    rt = ck::utils::transform_runtime_tensor_descriptor(
+        rt,
+        {RuntimeTransform::MakeMerge({N, Hi + 3, Wi + 3}), RuntimeTransform::MakePassThrough(C)},
+        {{0, 1, 2}, {3}},
+        {{0}, {1}});
+
+    check_against_constexpr(in_gemmm_gemmk, rt);
+}
+
+TEST(RuntimeTensorDescriptor, FreezeEmbedAndSlice)
+{
+    const auto desc = make_naive_tensor_descriptor(make_tuple(4, 7, 9), make_tuple(100, 10, 1));
+
+    const auto frozen = transform_tensor_descriptor(
+        desc,
+        make_tuple(make_freeze_transform(2),
+                   make_embed_transform(make_tuple(3, 2), make_tuple(2, 1)),
+                   make_slice_transform(9, 2, 8)),
+        make_tuple(Sequence<0>{}, Sequence<1>{}, Sequence<2>{}),
+        make_tuple(Sequence<>{}, Sequence<0, 1>{}, Sequence<2>{}));
+
+    check_against_constexpr(frozen, ck::utils::make_runtime_tensor_descriptor(frozen));
+}
+
+TEST(RuntimeTensorDescriptor, XorSwizzle)
+{
+    const auto desc = make_naive_tensor_descriptor_packed(make_tuple(8, 8));
+
+    const auto swizzled = transform_tensor_descriptor(
+        desc,
+        make_tuple(make_xor_with_modulo_transform(make_tuple(8, 8))),
+        make_tuple(Sequence<0, 1>{}),
+        make_tuple(Sequence<0, 1>{}));
+
+    check_against_constexpr(swizzled, ck::utils::make_runtime_tensor_descriptor(swizzled));
+}
+
+TEST(RuntimeTensorDescriptor, Adaptor)
+{
+    // tile id -> (m0, n0) as used by block-to-C-tile maps
+    const auto adaptor = make_single_stage_tensor_adaptor(
+        make_tuple(make_merge_transform(make_tuple(6, 5))),
+        make_tuple(Sequence<0, 1>{}),
+        make_tuple(Sequence<0>{}));
+
+    const auto rt_adaptor = ck::utils::make_runtime_tensor_adaptor(adaptor);
+
+    for(index_t i = 0; i < 30; ++i)
+    {
+        const auto bottom = adaptor.CalculateBottomIndex(make_multi_index(i));
+        EXPECT_EQ(rt_adaptor.CalculateBottomIndex({i}),
+                  (std::vector<long_index_t>{bottom[Number<0>{}], bottom[Number<1>{}]}));
+    }
+}
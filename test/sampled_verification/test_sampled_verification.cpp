@@ -0,0 +1,320 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/library/reference_tensor_operation/cpu/reference_contraction.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_data.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_bwd_weight.hpp"
+#include "ck/library/reference_tensor_operation/cpu/reference_conv_fwd.hpp"
+#include "ck/library/utility/convolution_host_tensor_descriptor_helper.hpp"
+#include "ck/library/utility/convolution_parameter.hpp"
+#include "ck/library/utility/host_tensor.hpp"
+#include "ck/library/utility/host_tensor_view.hpp"
+#include "ck/library/utility/sampled_verification.hpp"
+
+using ck::utils::sample_indices;
+using ck::utils::SampledVerificationConfig;
+using ck::utils::TensorIndices;
+
+namespace {
+
+using PassThrough = ck::tensor_operation::element_wise::PassThrough;
+using Scale       = ck::tensor_operation::element_wise::Scale;
+
+// 3x3 filter with mixed strides, dilations and pads
+const ck::utils::conv::ConvParam conv_param{
+    2, 2, 3, 16, 8, {3, 3}, {14, 11}, {1, 2}, {2, 1}, {2, 1}, {1, 0}};
+
+SampledVerificationConfig small_sample()
+{
+    SampledVerificationConfig config;
+    config.samples = 64;
+    return config;
+}
+
+void fill_random(Tensor<float>& t, unsigned seed)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> dist(-1.f, 1.f);
+    for(auto& v : t.mData)
+        v = dist(gen);
+}
+
+// Runs `run(out, &indices)` into a tensor filled with a marker and expects exactly the elements at
+// `indices` to be written, equal to those of `run(out, nullptr)`, which computes all of them.
+// Returns the sampled result.
+template <typename Run>
+Tensor<float> expect_computes_only(const Tensor<float>& full, const TensorIndices& indices, Run run)
+{
+    EXPECT_LT(indices.size(), full.GetElementSize());
+
+    constexpr float untouched = 12345.f;
+    Tensor<float> sampled(full.mDesc);
+    std::fill(sampled.mData.begin(), sampled.mData.end(), untouched);
+    run(sampled, &indices);
+
+    for(const auto& idx : indices)
+        EXPECT_EQ(sampled(idx), full(idx));
+    EXPECT_EQ(std::count_if(sampled.mData.begin(),
+                            sampled.mData.end(),
+                            [](float v) { return v != untouched; }),
+              static_cast<std::ptrdiff_t>(indices.size()));
+    return sampled;
+}
+
+bool covers(const TensorIndices& indices, std::size_t dim, std::size_t coord)
+{
+    return std::any_of(
+        indices.begin(), indices.end(), [&](const auto& idx) { return idx[dim] == coord; });
+}
+
+} // namespace
+
+TEST(SampledVerification, SampleCoversRequiredCoordinates)
+{
+    const std::vector<std::size_t> lengths{3, 2, 100, 70};
+    std::vector<std::vector<std::size_t>> required(lengths.size());
+    required[0] = {0, 1, 2};
+    required[3] = {5, 6, 69};
+
+    SampledVerificationConfig config;
+    config.samples = 200;
+    const auto indices = sample_indices(lengths, required, config);
+
+    EXPECT_TRUE(std::is_sorted(indices.begin(), indices.end()));
+    EXPECT_EQ(std::adjacent_find(indices.begin(), indices.end()), indices.end());
+    EXPECT_LE(indices.size(), 200u + 8u);
+    for(const auto& idx : indices)
+        for(std::size_t d = 0; d < lengths.size(); ++d)
+            EXPECT_LT(idx[d], lengths[d]);
+
+    for(std::size_t d = 0; d < lengths.size(); ++d)
+    {
+        EXPECT_TRUE(covers(indices, d, 0));
+        EXPECT_TRUE(covers(indices, d, lengths[d] - 1));
+        for(std::size_t c : required[d])
+            EXPECT_TRUE(covers(indices, d, c));
+    }
+    // tile edges
+    for(std::size_t c : {31, 32, 63, 64, 95, 96})
+        EXPECT_TRUE(covers(indices, 2, c));
+
+    // every stratum of the row-major index space is sampled
+    const std::size_t size = 3 * 2 * 100 * 70;
+    std::vector<bool> hit(config.samples, false);
+    for(const auto& idx : indices)
+    {
+        const std::size_t offset = ((idx[0] * 2 + idx[1]) * 100 + idx[2]) * 70 + idx[3];
+        hit[offset * config.samples / size] = true;
+    }
+    EXPECT_TRUE(std::all_of(hit.begin(), hit.end(), [](bool h) { return h; }));
+
+    // deterministic for a seed
+    EXPECT_EQ(sample_indices(lengths, required, config), indices);
+}
+
+TEST(SampledVerification, SmallTensorsAreVerifiedCompletely)
+{
+    const std::vector<std::size_t> lengths{2, 3, 4};
+    const std::vector<std::vector<std::size_t>> required(3);
+    const auto indices = sample_indices(lengths, required, SampledVerificationConfig{});
+    ASSERT_EQ(indices.size(), 24u);
+    EXPECT_EQ(indices.front(), (std::vector<std::size_t>{0, 0, 0}));
+    EXPECT_EQ(indices.back(), (std::vector<std::size_t>{1, 2, 3}));
+}
+
+TEST(SampledVerification, OtherModesVerifyAllElements)
+{
+    const std::vector<std::size_t> lengths{8, 1000};
+    const std::vector<std::vector<std::size_t>> required(2);
+
+    EXPECT_TRUE(ck::utils::make_verify_indices(1, lengths, required, "elements").empty());
+    const auto indices = ck::utils::make_verify_indices(2, lengths, required, "elements");
+    EXPECT_EQ(indices, sample_indices(lengths, required, SampledVerificationConfig::FromEnv()));
+    ASSERT_LT(indices.size(), 8u * 1000u);
+
+    // an error outside the sample is only caught without one
+    Tensor<float> ref(lengths);
+    fill_random(ref, 10);
+    auto out = ref;
+    TensorIndices all;
+    ref.ForEach([&](auto&, auto idx) { all.push_back(idx); });
+    const auto unsampled = *std::find_if(all.begin(), all.end(), [&](const auto& idx) {
+        return !std::binary_search(indices.begin(), indices.end(), idx);
+    });
+    out(unsampled) += 1.f;
+    EXPECT_TRUE(ck::utils::check_err_sampled(out, ref, indices));
+    EXPECT_FALSE(ck::utils::check_err_sampled(out, ref, TensorIndices{}));
+}
+
+TEST(SampledVerification, ConvRequiredCoordinates)
+{
+    // 3x3 filter, stride 2, pad 1: only the first output row and column read the padding
+    const ck::utils::conv::ConvParam param{
+        2, 4, 1, 8, 8, {3, 3}, {16, 15}, {2, 2}, {1, 1}, {1, 1}, {1, 1}};
+
+    const auto fwd = ck::utils::conv::get_fwd_required_coordinates(param);
+    ASSERT_EQ(fwd.size(), 5u);
+    EXPECT_EQ(fwd[0], (std::vector<std::size_t>{0, 1, 2, 3}));
+    EXPECT_EQ(fwd[3], (std::vector<std::size_t>{0}));
+    EXPECT_EQ(fwd[4], (std::vector<std::size_t>{0, 7}));
+
+    const auto bwd_weight = ck::utils::conv::get_bwd_weight_required_coordinates(param);
+    EXPECT_EQ(bwd_weight[3], (std::vector<std::size_t>{0, 1, 2}));
+
+    // input positions reached by a tap from past the output
+    const auto bwd_data = ck::utils::conv::get_bwd_data_required_coordinates(param);
+    EXPECT_EQ(bwd_data[3], (std::vector<std::size_t>{15}));
+    EXPECT_TRUE(bwd_data[4].empty());
+}
+
+TEST(SampledVerification, ConvFwdComputesOnlyRequestedElements)
+{
+    using namespace ck::tensor_layout::convolution;
+    using ReferenceConv = ck::tensor_operation::host::
+        ReferenceConvFwd<2, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+    Tensor<float> input(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<GNHWC>(conv_param));
+    Tensor<float> weight(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<GKYXC>(conv_param));
+    Tensor<float> full(
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<GNHWK>(conv_param));
+    fill_random(input, 11);
+    fill_random(weight, 12);
+
+    auto run = [&](Tensor<float>& output, const TensorIndices* indices) {
+        auto argument = ReferenceConv::MakeArgument(input,
+                                                    weight,
+                                                    output,
+                                                    conv_param.conv_filter_strides_,
+                                                    conv_param.conv_filter_dilations_,
+                                                    conv_param.input_left_pads_,
+                                                    conv_param.input_right_pads_,
+                                                    PassThrough{},
+                                                    PassThrough{},
+                                                    PassThrough{});
+        return indices ? ReferenceConv::MakeInvoker().Run(argument, *indices)
+                       : ReferenceConv::MakeInvoker().Run(argument);
+    };
+
+    run(full, nullptr);
+    const auto indices = sample_indices(full.GetLengths(),
+                                        ck::utils::conv::get_fwd_required_coordinates(conv_param),
+                                        small_sample());
+    auto sampled = expect_computes_only(full, indices, run);
+
+    EXPECT_TRUE(ck::utils::check_err_at(sampled, full, indices));
+    sampled(indices.back()) += 1.f;
+    EXPECT_FALSE(ck::utils::check_err_at(sampled, full, indices));
+}
+
+TEST(SampledVerification, ConvBwdDataComputesOnlyRequestedElements)
+{
+    using namespace ck::tensor_layout::convolution;
+    using ReferenceConv = ck::tensor_operation::host::
+        ReferenceConvBwdData<2, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+    Tensor<float> full(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<GNHWC>(conv_param));
+    Tensor<float> weight(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<GKYXC>(conv_param));
+    Tensor<float> output(
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<GNHWK>(conv_param));
+    fill_random(weight, 13);
+    fill_random(output, 14);
+
+    auto run = [&](Tensor<float>& input, const TensorIndices* indices) {
+        auto argument = ReferenceConv::MakeArgument(input,
+                                                    weight,
+                                                    output,
+                                                    conv_param.conv_filter_strides_,
+                                                    conv_param.conv_filter_dilations_,
+                                                    conv_param.input_left_pads_,
+                                                    conv_param.input_right_pads_,
+                                                    PassThrough{},
+                                                    PassThrough{},
+                                                    PassThrough{});
+        return indices ? ReferenceConv::MakeInvoker().Run(argument, *indices)
+                       : ReferenceConv::MakeInvoker().Run(argument);
+    };
+
+    run(full, nullptr);
+    const auto indices = sample_indices(
+        full.GetLengths(),
+        ck::utils::conv::get_bwd_data_required_coordinates(conv_param),
+        small_sample());
+    expect_computes_only(full, indices, run);
+}
+
+TEST(SampledVerification, ConvBwdWeightComputesOnlyRequestedElements)
+{
+    using namespace ck::tensor_layout::convolution;
+    using ReferenceConv = ck::tensor_operation::host::
+        ReferenceConvBwdWeight<2, float, float, float, PassThrough, PassThrough, PassThrough>;
+
+    // more channels, for a weight gradient too large to be verified completely
+    const ck::utils::conv::ConvParam param{
+        2, 2, 2, 24, 16, {3, 3}, {9, 8}, {1, 2}, {2, 1}, {2, 1}, {1, 0}};
+
+    Tensor<float> input(
+        ck::utils::conv::make_input_host_tensor_descriptor_g_n_c_wis_packed<GNHWC>(param));
+    Tensor<float> full(
+        ck::utils::conv::make_weight_host_tensor_descriptor_g_k_c_xs_packed<GKYXC>(param));
+    Tensor<float> output(
+        ck::utils::conv::make_output_host_tensor_descriptor_g_n_k_wos_packed<GNHWK>(param));
+    fill_random(input, 15);
+    fill_random(output, 16);
+
+    auto run = [&](Tensor<float>& weight, const TensorIndices* indices) {
+        auto argument = ReferenceConv::MakeArgument(input,
+                                                    weight,
+                                                    output,
+                                                    param.conv_filter_strides_,
+                                                    param.conv_filter_dilations_,
+                                                    param.input_left_pads_,
+                                                    param.input_right_pads_,
+                                                    PassThrough{},
+                                                    PassThrough{},
+                                                    PassThrough{});
+        return indices ? ReferenceConv::MakeInvoker().Run(argument, *indices)
+                       : ReferenceConv::MakeInvoker().Run(argument);
+    };
+
+    run(full, nullptr);
+    const auto indices = sample_indices(full.GetLengths(),
+                                        ck::utils::conv::get_bwd_weight_required_coordinates(param),
+                                        small_sample());
+    expect_computes_only(full, indices, run);
+}
+
+TEST(SampledVerification, ContractionComputesOnlyRequestedElements)
+{
+    using ReferenceContraction = ck::tensor_operation::host::ReferenceContraction_M2_N2_K2<
+        2, 2, 2, float, float, float, float, float, Scale, PassThrough>;
+
+    // [M0, M1, K0, K1] x [N0, N1, K0, K1], with the modes of B out of order in memory
+    Tensor<float> a(std::vector<std::size_t>{6, 7, 5, 4});
+    Tensor<float> b_packed(std::vector<std::size_t>{4, 9, 5, 8});
+    fill_random(a, 17);
+    fill_random(b_packed, 18);
+    const auto b =
+        make_tensor_view(std::as_const(b_packed)).Permute(std::vector<std::size_t>{3, 1, 2, 0});
+
+    auto run = [&](Tensor<float>& c, const TensorIndices* indices) {
+        auto argument = ReferenceContraction::MakeArgument(a, b, c, Scale{0.5f}, PassThrough{});
+        return indices ? ReferenceContraction::MakeInvoker().Run(argument, *indices)
+                       : ReferenceContraction::MakeInvoker().Run(argument);
+    };
+
+    Tensor<float> full(std::vector<std::size_t>{6, 7, 8, 9});
+    run(full, nullptr);
+    const auto indices =
+        sample_indices(full.GetLengths(), std::vector<std::vector<std::size_t>>(4), small_sample());
+    expect_computes_only(full, indices, run);
+}
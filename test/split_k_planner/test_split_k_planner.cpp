@@ -0,0 +1,221 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/host_utility/split_k_planner.hpp"
+#include "ck/library/utility/tile_scheduler_simulator.hpp"
+
+using ck::index_t;
+using ck::plan_split_k;
+using ck::split_k_cost;
+using ck::SplitKModel;
+using ck::SplitKProblem;
+using ck::SplitKReduction;
+
+namespace {
+
+constexpr index_t MPerBlock = 256;
+constexpr index_t NPerBlock = 128;
+constexpr index_t KPerBlock = 32;
+
+SplitKModel make_model(index_t num_cu, index_t occupancy)
+{
+    SplitKModel model;
+    model.num_cu    = num_cu;
+    model.occupancy = occupancy;
+    return model;
+}
+
+// split-K grid as the KSplit block-to-C-tile maps lay it out (K batch outermost), run through
+// the tile scheduler simulator with the planner's cost parameters
+double simulate_split_k(const SplitKProblem& problem, index_t k_batch, const SplitKModel& model)
+{
+    const uint32_t m_tiles  = (problem.M + MPerBlock - 1) / MPerBlock;
+    const uint32_t n_tiles  = (problem.N + NPerBlock - 1) / NPerBlock;
+    const uint32_t k_iters  = (problem.K + KPerBlock - 1) / KPerBlock;
+    const uint32_t k_per_wg = (k_iters + k_batch - 1) / k_batch;
+
+    std::vector<ck::utils::WorkgroupWork> workgroups;
+    for(index_t k = 0; k < k_batch; ++k)
+    {
+        for(uint32_t m = 0; m < m_tiles; ++m)
+        {
+            for(uint32_t n = 0; n < n_tiles; ++n)
+            {
+                ck::utils::WorkgroupWork workgroup;
+                workgroup.segments.push_back(
+                    {m, n, k * k_per_wg, std::min((k + 1) * k_per_wg, k_iters), k_batch > 1});
+                workgroups.push_back(workgroup);
+            }
+        }
+    }
+
+    ck::utils::TileSchedulerModel sim_model;
+    sim_model.num_cu               = model.num_cu;
+    sim_model.occupancy            = model.occupancy;
+    sim_model.single_wg_throughput = model.single_wg_throughput;
+    sim_model.tile_cost            = model.tile_overhead;
+    sim_model.partial_tile_cost    = model.atomic_epilogue;
+
+    const auto report = ck::utils::simulate_tile_schedule(workgroups, sim_model);
+
+    double clear = 0;
+    if(k_batch > 1)
+    {
+        clear = model.clear_launch_cost +
+                m_tiles * n_tiles * model.clear_cost_per_tile / model.num_cu;
+    }
+    return report.makespan + clear;
+}
+
+} // namespace
+
+TEST(SplitKPlanner, LargeProblemIsNotSplit)
+{
+    // 16 x 32 tiles fill two full waves of 128 CUs x 2 workgroups
+    const auto model = make_model(128, 2);
+    const auto plan  = plan_split_k({{4096, 4096, 4096}}, MPerBlock, NPerBlock, KPerBlock, model);
+
+    EXPECT_EQ(plan.k_batch, 1);
+    EXPECT_NEAR(plan.efficiency, 128.0 / 132.0, 1e-9);
+}
+
+TEST(SplitKPlanner, FewTilesLongKIsSplit)
+{
+    // 2 tiles on 104 CUs
+    const SplitKProblem problem{256, 256, 16384};
+    const auto model = make_model(104, 2);
+
+    const auto plan = plan_split_k({problem}, MPerBlock, NPerBlock, KPerBlock, model);
+
+    EXPECT_GT(plan.k_batch, 8);
+    EXPECT_LT(plan.cost, split_k_cost({problem}, MPerBlock, NPerBlock, KPerBlock, 1, model) / 4);
+}
+
+TEST(SplitKPlanner, ShortKIsNotSplit)
+{
+    SplitKModel model           = make_model(104, 2);
+    model.min_k_iters_per_batch = 4;
+
+    // 4 main loop iterations cannot be split into batches of at least 4
+    const auto plan = plan_split_k({{256, 256, 128}}, MPerBlock, NPerBlock, KPerBlock, model);
+
+    EXPECT_EQ(plan.k_batch, 1);
+}
+
+TEST(SplitKPlanner, RespectsValidKBatch)
+{
+    const SplitKProblem problem{256, 256, 16384};
+    const auto model = make_model(104, 2);
+
+    const auto plan = plan_split_k({problem},
+                                   MPerBlock,
+                                   NPerBlock,
+                                   KPerBlock,
+                                   model,
+                                   SplitKReduction::AtomicOnSplit,
+                                   [](index_t k_batch) { return k_batch == 1 || k_batch == 3; });
+    EXPECT_EQ(plan.k_batch, 3);
+
+    const auto unsplit = plan_split_k({problem},
+                                      MPerBlock,
+                                      NPerBlock,
+                                      KPerBlock,
+                                      model,
+                                      SplitKReduction::AtomicOnSplit,
+                                      [](index_t) { return false; });
+    EXPECT_EQ(unsplit.k_batch, 1);
+    EXPECT_GT(unsplit.cost, 0);
+}
+
+TEST(SplitKPlanner, MatchesExhaustiveSearch)
+{
+    for(index_t num_cu : {80, 104, 120, 304})
+    {
+        for(index_t occupancy : {1, 2})
+        {
+            for(index_t M : {128, 512, 1000, 3072})
+            {
+                for(index_t K : {256, 1024, 5120, 20000})
+                {
+                    const std::vector<SplitKProblem> problems{{M, 1024, K}};
+                    const auto model = make_model(num_cu, occupancy);
+
+                    const auto plan =
+                        plan_split_k(problems, MPerBlock, NPerBlock, KPerBlock, model);
+
+                    const auto cost = [&](index_t k_batch) {
+                        return split_k_cost(
+                            problems, MPerBlock, NPerBlock, KPerBlock, k_batch, model);
+                    };
+
+                    double best = cost(1);
+                    for(index_t k_batch = 2; k_batch <= model.max_k_batch; ++k_batch)
+                    {
+                        if((K + KPerBlock - 1) / KPerBlock / k_batch < model.min_k_iters_per_batch)
+                        {
+                            break;
+                        }
+                        best = std::min(best, cost(k_batch));
+                    }
+
+                    EXPECT_LE(plan.cost, best * (1 + model.tolerance));
+                    EXPECT_LE(plan.efficiency, 1.0);
+                }
+            }
+        }
+    }
+}
+
+TEST(SplitKPlanner, NearOptimalInSimulation)
+{
+    // the planner's wave formula against the discrete-event simulator: its pick has to be
+    // within 10% of the best simulated KBatch
+    for(index_t num_cu : {80, 120})
+    {
+        for(const SplitKProblem problem : {SplitKProblem{256, 256, 8192},
+                                           SplitKProblem{1024, 1024, 4096},
+                                           SplitKProblem{2048, 1536, 2048},
+                                           SplitKProblem{768, 512, 12288}})
+        {
+            const auto model = make_model(num_cu, 2);
+            const auto plan  = plan_split_k({problem}, MPerBlock, NPerBlock, KPerBlock, model);
+
+            double best = simulate_split_k(problem, 1, model);
+            for(index_t k_batch = 2; k_batch <= 16; ++k_batch)
+            {
+                best = std::min(best, simulate_split_k(problem, k_batch, model));
+            }
+
+            EXPECT_LE(simulate_split_k(problem, plan.k_batch, model), best * 1.1)
+                << "M " << problem.M << " N " << problem.N << " K " << problem.K << " num_cu "
+                << num_cu << " k_batch " << plan.k_batch;
+        }
+    }
+}
+
+TEST(SplitKPlanner, GroupedSharesOneKBatch)
+{
+    const auto model = make_model(104, 2);
+
+    // a long-K group dominates; the short-K groups only add tiles to the waves
+    const std::vector<SplitKProblem> problems{{256, 256, 16384}, {512, 512, 256}, {256, 512, 512}};
+
+    const auto always = SplitKReduction::AlwaysAtomic;
+    const auto plan   = plan_split_k(problems, MPerBlock, NPerBlock, KPerBlock, model, always);
+
+    EXPECT_GT(plan.k_batch, 1);
+    EXPECT_LT(plan.cost, split_k_cost(problems, MPerBlock, NPerBlock, KPerBlock, 1, model, always));
+
+    // with the reduction always paid, splitting is never less attractive
+    for(index_t M : {512, 2048, 4096})
+    {
+        const std::vector<SplitKProblem> single{{M, 2048, 2048}};
+        EXPECT_GE(plan_split_k(single, MPerBlock, NPerBlock, KPerBlock, model, always).k_batch,
+                  plan_split_k(single, MPerBlock, NPerBlock, KPerBlock, model).k_batch);
+    }
+}
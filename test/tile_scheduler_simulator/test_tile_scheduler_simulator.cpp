@@ -0,0 +1,211 @@
+// SPDX-License-Identifier: MIT
+// Copyright (c) 2024, Advanced Micro Devices, Inc. All rights reserved.
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+#include <gtest/gtest.h>
+
+#include "ck/ck.hpp"
+#include "ck/tensor_operation/gpu/grid/block_to_ctile_map.hpp"
+
+#include "ck/library/utility/tile_scheduler_simulator.hpp"
+
+using namespace ck;
+using ck::utils::make_data_parallel_work;
+using ck::utils::make_stream_k_work;
+using ck::utils::simulate_tile_schedule;
+using ck::utils::TileSchedulerModel;
+using ck::utils::WorkgroupWork;
+
+namespace {
+
+constexpr index_t MPerBlock = 128;
+constexpr index_t NPerBlock = 128;
+constexpr index_t KPerBlock = 32;
+
+template <StreamKReductionStrategy Strategy>
+using StreamKMap = BlockToCTileMap_GemmStreamK<MPerBlock, NPerBlock, KPerBlock, Strategy, 8>;
+
+// every k iteration of every tile has to be computed exactly once
+void check_coverage(const std::vector<WorkgroupWork>& workgroups,
+                    uint32_t m_tiles,
+                    uint32_t n_tiles,
+                    uint32_t k_iters_per_tile)
+{
+    std::vector<int> visits(std::size_t{m_tiles} * n_tiles * k_iters_per_tile, 0);
+
+    for(const auto& workgroup : workgroups)
+    {
+        for(const auto& segment : workgroup.segments)
+        {
+            ASSERT_LT(segment.m_tile, m_tiles);
+            ASSERT_LT(segment.n_tile, n_tiles);
+            ASSERT_LE(segment.k_iter_end, k_iters_per_tile);
+            for(uint32_t k = segment.k_iter_begin; k < segment.k_iter_end; ++k)
+            {
+                ++visits[(std::size_t{segment.m_tile} * n_tiles + segment.n_tile) *
+                             k_iters_per_tile +
+                         k];
+            }
+        }
+    }
+
+    EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](int v) { return v == 1; }));
+}
+
+} // namespace
+
+TEST(TileSchedulerSimulator, DataParallelCoverage)
+{
+    const index_t M = 1000, N = 700, K = 256;
+    const index_t m_tiles = math::integer_divide_ceil(M, MPerBlock);
+    const index_t n_tiles = math::integer_divide_ceil(N, NPerBlock);
+    const index_t k_iters = K / KPerBlock;
+
+    BlockToCTileMap_M00_N0_M01Adapt<MPerBlock, NPerBlock> map(M, N, 4);
+    const auto grid_size  = map.CalculateGridSize(M, N);
+    const auto workgroups = make_data_parallel_work(map, grid_size, m_tiles, n_tiles, k_iters);
+
+    EXPECT_EQ(workgroups.size(), std::size_t(m_tiles * n_tiles));
+    check_coverage(workgroups, m_tiles, n_tiles, k_iters);
+}
+
+TEST(TileSchedulerSimulator, StreamKCoverage)
+{
+    for(uint32_t num_cu : {7u, 38u, 120u})
+    {
+        for(const auto& mnk : {std::make_tuple(1024u, 1024u, 1024u),
+                               std::make_tuple(3840u, 4096u, 4096u),
+                               std::make_tuple(640u, 384u, 8192u)})
+        {
+            const uint32_t M = std::get<0>(mnk), N = std::get<1>(mnk), K = std::get<2>(mnk);
+            const uint32_t m_tiles = math::integer_divide_ceil(M, MPerBlock);
+            const uint32_t n_tiles = math::integer_divide_ceil(N, NPerBlock);
+            const uint32_t k_iters = math::integer_divide_ceil(K, KPerBlock);
+
+            StreamKMap<StreamKReductionStrategy::Atomic> atomic_map(M, N, K, num_cu, 1);
+            check_coverage(make_stream_k_work(atomic_map, M, N), m_tiles, n_tiles, k_iters);
+
+            StreamKMap<StreamKReductionStrategy::Reduction> reduction_map(M, N, K, num_cu, 1);
+            const auto workgroups = make_stream_k_work(reduction_map, M, N);
+            check_coverage(workgroups, m_tiles, n_tiles, k_iters);
+
+            // every reduction block waits for at least one stream-K block
+            for(uint32_t i = reduction_map.reduction_start_block_idx; i < workgroups.size(); ++i)
+            {
+                EXPECT_FALSE(workgroups[i].depends_on.empty());
+                for(uint32_t dep : workgroups[i].depends_on)
+                {
+                    EXPECT_LT(dep, reduction_map.sk_num_blocks);
+                }
+            }
+
+            TileSchedulerModel model;
+            model.num_cu = num_cu;
+            EXPECT_NO_THROW(simulate_tile_schedule(workgroups, model));
+        }
+    }
+}
+
+TEST(TileSchedulerSimulator, FullWavesAreEfficient)
+{
+    std::vector<WorkgroupWork> workgroups(16);
+    for(auto& workgroup : workgroups)
+    {
+        workgroup.segments.push_back({0, 0, 0, 10, false});
+    }
+
+    TileSchedulerModel model;
+    model.num_cu    = 4;
+    model.occupancy = 2;
+
+    const auto report = simulate_tile_schedule(workgroups, model);
+
+    EXPECT_DOUBLE_EQ(report.total_work, 160.0);
+    EXPECT_DOUBLE_EQ(report.makespan, 40.0);
+    EXPECT_DOUBLE_EQ(report.efficiency, 1.0);
+    EXPECT_DOUBLE_EQ(report.waves, 2.0);
+    EXPECT_DOUBLE_EQ(report.tail_fraction, 0.0);
+    EXPECT_DOUBLE_EQ(report.cu_imbalance, 1.0);
+    for(double busy : report.cu_busy_time)
+    {
+        EXPECT_DOUBLE_EQ(busy, 40.0);
+    }
+}
+
+TEST(TileSchedulerSimulator, DependenciesDelayReduction)
+{
+    std::vector<WorkgroupWork> workgroups(3);
+    workgroups[0].segments.push_back({0, 0, 0, 4, true});
+    workgroups[1].segments.push_back({0, 0, 4, 10, true});
+    workgroups[2].segments.push_back({0, 0, 0, 0, false});
+    workgroups[2].depends_on = {0, 1};
+
+    TileSchedulerModel model;
+    model.num_cu    = 3;
+    model.tile_cost = 1;
+
+    const auto report = simulate_tile_schedule(workgroups, model);
+
+    EXPECT_DOUBLE_EQ(report.workgroup_finish[0], 5.0);
+    EXPECT_DOUBLE_EQ(report.workgroup_finish[1], 7.0);
+    EXPECT_DOUBLE_EQ(report.workgroup_start[2], 0.0);
+    EXPECT_DOUBLE_EQ(report.workgroup_finish[2], 8.0);
+
+    workgroups[0].depends_on = {2};
+    EXPECT_THROW(simulate_tile_schedule(workgroups, model), std::runtime_error);
+}
+
+TEST(TileSchedulerSimulator, StreamKBeatsDataParallelOnPartialWave)
+{
+    // 5 x 5 tiles on 24 CUs: data-parallel leaves one CU with two tiles while the others idle
+    // after the first one
+    const uint32_t M = 640, N = 640, K = 4096, num_cu = 24, occupancy = 2;
+    const uint32_t m_tiles = M / MPerBlock, n_tiles = N / NPerBlock, k_iters = K / KPerBlock;
+
+    TileSchedulerModel model;
+    model.num_cu            = num_cu;
+    model.occupancy         = occupancy;
+    model.tile_cost         = 4;
+    model.partial_tile_cost = 4;
+
+    BlockToCTileMap_M00_N0_M01Adapt<MPerBlock, NPerBlock> dp_map{static_cast<index_t>(M),
+                                                                 static_cast<index_t>(N)};
+    const auto dp_grid_size = dp_map.CalculateGridSize(M, N);
+    const auto dp           = simulate_tile_schedule(
+        make_data_parallel_work(dp_map, dp_grid_size, m_tiles, n_tiles, k_iters), model);
+
+    StreamKMap<StreamKReductionStrategy::Atomic> sk_map(M, N, K, num_cu, occupancy);
+    const auto sk = simulate_tile_schedule(make_stream_k_work(sk_map, M, N), model);
+
+    EXPECT_NEAR(dp.efficiency, 25.0 / 48.0, 1e-3);
+    EXPECT_GT(sk.efficiency, dp.efficiency);
+    EXPECT_LT(sk.makespan, dp.makespan);
+    EXPECT_EQ(sk.tile_order.size(), std::size_t{m_tiles} * n_tiles);
+}
+
+TEST(TileSchedulerSimulator, SwizzleImprovesLocality)
+{
+    // 64 x 64 tiles, 32 CUs: a row-major wave spans 1 A panel and 32 B panels, an M01 = 8
+    // swizzle wave 8 A panels and 4 B panels
+    const index_t M = 64 * MPerBlock, N = 64 * NPerBlock;
+
+    TileSchedulerModel model;
+    model.num_cu            = 32;
+    model.l2_panel_capacity = 32;
+
+    const auto run = [&](index_t M01) {
+        BlockToCTileMap_M00_N0_M01Adapt<MPerBlock, NPerBlock> map(M, N, M01);
+        return simulate_tile_schedule(
+            make_data_parallel_work(map, map.CalculateGridSize(M, N), 64, 64, 8), model);
+    };
+
+    const auto row_major = run(1);
+    const auto swizzled  = run(8);
+
+    EXPECT_DOUBLE_EQ(row_major.panels_per_wave, 33.0);
+    EXPECT_DOUBLE_EQ(swizzled.panels_per_wave, 12.0);
+    EXPECT_GT(swizzled.l2_hit_rate, row_major.l2_hit_rate);
+    EXPECT_DOUBLE_EQ(swizzled.efficiency, row_major.efficiency);
+}